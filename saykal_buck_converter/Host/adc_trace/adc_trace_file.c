@@ -0,0 +1,147 @@
+/**
+ * @file adc_trace_file.c
+ * @brief Reading and writing ADC trace files on the host.
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "adc_trace_file.h"
+#include "errno.h"
+#include "string.h"
+#include "fcntl.h"
+#include "unistd.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+
+/** @brief Granularity of release_adc_trace_records_before(), to keep madvise() calls rare. */
+#define ADC_TRACE_RELEASE_CHUNK_SIZE	(4UL * 1024UL * 1024UL)
+
+bool open_adc_trace_file(const char *path, adc_trace_file_t *trace_ptr)
+{
+	memset(trace_ptr, 0, sizeof(*trace_ptr));
+
+	int file_descriptor = open(path, O_RDONLY);
+
+	if(file_descriptor < 0)
+	{
+		fprintf(stderr, "%s: %s\n", path, strerror(errno));
+		return false;
+	}
+
+	struct stat file_stat;
+
+	if((0 != fstat(file_descriptor, &file_stat)) ||
+	   ((size_t)file_stat.st_size < sizeof(adc_trace_file_header_t)))
+	{
+		fprintf(stderr, "%s: too short for an ADC trace header\n", path);
+		close(file_descriptor);
+		return false;
+	}
+
+	void *mapping_ptr = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+	close(file_descriptor);
+
+	if(MAP_FAILED == mapping_ptr)
+	{
+		fprintf(stderr, "%s: %s\n", path, strerror(errno));
+		return false;
+	}
+
+	(void)madvise(mapping_ptr, (size_t)file_stat.st_size, MADV_SEQUENTIAL);
+
+	const adc_trace_file_header_t *header_ptr = (const adc_trace_file_header_t *)mapping_ptr;
+
+	if((ADC_TRACE_FILE_MAGIC != header_ptr->magic) ||
+	   (ADC_TRACE_FILE_VERSION != header_ptr->version) ||
+	   (sizeof(adc_trace_file_header_t) != header_ptr->header_size) ||
+	   (sizeof(adc_trace_record_t) != header_ptr->record_size))
+	{
+		fprintf(stderr, "%s: not an ADC trace of version %u\n", path, (unsigned)ADC_TRACE_FILE_VERSION);
+		munmap(mapping_ptr, (size_t)file_stat.st_size);
+		return false;
+	}
+
+	trace_ptr->header_ptr = header_ptr;
+	trace_ptr->records_ptr = (const adc_trace_record_t *)((const uint8_t *)mapping_ptr + header_ptr->header_size);
+	trace_ptr->record_cnt = ((uint64_t)file_stat.st_size - header_ptr->header_size) / header_ptr->record_size;
+	trace_ptr->mapping_ptr = mapping_ptr;
+	trace_ptr->mapping_size = (size_t)file_stat.st_size;
+
+	if((0U != header_ptr->record_cnt) && (trace_ptr->record_cnt != header_ptr->record_cnt))
+	{
+		fprintf(stderr, "%s: header announces %u records, file holds %llu\n", path,
+				(unsigned)header_ptr->record_cnt, (unsigned long long)trace_ptr->record_cnt);
+	}
+
+	return true;
+}
+
+void release_adc_trace_records_before(adc_trace_file_t *trace_ptr, uint64_t first_record_idx)
+{
+	size_t needed_offset = trace_ptr->header_ptr->header_size +
+						   (size_t)(first_record_idx * trace_ptr->header_ptr->record_size);
+	size_t release_size = needed_offset - (needed_offset % ADC_TRACE_RELEASE_CHUNK_SIZE);
+
+	if(release_size > trace_ptr->released_size)
+	{
+		(void)madvise((uint8_t *)trace_ptr->mapping_ptr + trace_ptr->released_size,
+					  release_size - trace_ptr->released_size, MADV_DONTNEED);
+		trace_ptr->released_size = release_size;
+	}
+}
+
+void close_adc_trace_file(adc_trace_file_t *trace_ptr)
+{
+	if(NULL != trace_ptr->mapping_ptr)
+	{
+		munmap(trace_ptr->mapping_ptr, trace_ptr->mapping_size);
+	}
+
+	memset(trace_ptr, 0, sizeof(*trace_ptr));
+}
+
+bool open_adc_trace_writer(const char *path,
+						   const adc_trace_file_header_t *header_ptr,
+						   adc_trace_writer_t *writer_ptr)
+{
+	memset(writer_ptr, 0, sizeof(*writer_ptr));
+
+	writer_ptr->file_ptr = fopen(path, "wb");
+
+	if(NULL == writer_ptr->file_ptr)
+	{
+		fprintf(stderr, "%s: %s\n", path, strerror(errno));
+		return false;
+	}
+
+	writer_ptr->header = *header_ptr;
+	writer_ptr->header.record_cnt = 0U;
+
+	return (1U == fwrite(&writer_ptr->header, sizeof(writer_ptr->header), 1U, writer_ptr->file_ptr));
+}
+
+bool write_adc_trace_records(adc_trace_writer_t *writer_ptr,
+							 const adc_trace_record_t *records_ptr,
+							 uint32_t record_cnt)
+{
+	size_t written_cnt = fwrite(records_ptr, sizeof(adc_trace_record_t), record_cnt, writer_ptr->file_ptr);
+
+	writer_ptr->record_cnt += written_cnt;
+
+	return (written_cnt == record_cnt);
+}
+
+bool close_adc_trace_writer(adc_trace_writer_t *writer_ptr)
+{
+	// record_cnt of 0 means unknown, the reader then relies on the file size
+	writer_ptr->header.record_cnt =
+		(writer_ptr->record_cnt <= UINT32_MAX) ? (uint32_t)writer_ptr->record_cnt : 0U;
+
+	bool is_written = (0 == fseek(writer_ptr->file_ptr, 0L, SEEK_SET)) &&
+					  (1U == fwrite(&writer_ptr->header, sizeof(writer_ptr->header), 1U, writer_ptr->file_ptr));
+
+	is_written = (0 == fclose(writer_ptr->file_ptr)) && is_written;
+	writer_ptr->file_ptr = NULL;
+
+	return is_written;
+}
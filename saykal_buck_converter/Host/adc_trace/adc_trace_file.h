@@ -0,0 +1,107 @@
+/**
+ * @file adc_trace_file.h
+ * @brief Reading and writing ADC trace files on the host.
+ *
+ * A trace file is the adc_trace_file_header_t followed by an array of
+ * adc_trace_record_t, exactly as produced by the device side recorder. Files
+ * are memory mapped read only, so a trace of many millions of samples is paged
+ * in from disk as it is replayed instead of being loaded into RAM.
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef ADC_TRACE_FILE_H_
+#define ADC_TRACE_FILE_H_
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "stddef.h"
+#include "stdio.h"
+#include "adc_trace_recorder.h"
+
+/**
+ * @brief Memory mapped trace file.
+ */
+typedef struct
+{
+	const adc_trace_file_header_t *header_ptr;	///< Header at the start of the mapping
+	const adc_trace_record_t *records_ptr;		///< First record
+	uint64_t record_cnt;						///< Number of complete records in the file
+	size_t released_size;						///< Bytes at the start of the mapping already given back
+	void *mapping_ptr;
+	size_t mapping_size;
+
+}adc_trace_file_t;
+
+/**
+ * @brief Buffered writer of a trace file.
+ */
+typedef struct
+{
+	FILE *file_ptr;
+	adc_trace_file_header_t header;				///< Header written at open, patched at close
+	uint64_t record_cnt;						///< Records written so far
+
+}adc_trace_writer_t;
+
+/**
+ * @brief Maps a trace file and validates its header.
+ *
+ * @param[in]  path      Path of the trace file.
+ * @param[out] trace_ptr Mapped trace.
+ * @retval true  The trace is mapped, release it with close_adc_trace_file().
+ * @retval false The file could not be mapped or is not a trace of this format, the reason is printed to stderr.
+ */
+bool open_adc_trace_file(const char *path, adc_trace_file_t *trace_ptr);
+
+/**
+ * @brief Tells the kernel that the records before the given one are no longer needed.
+ *
+ * Keeps the resident set of a long sequential replay bounded.
+ *
+ * @param[in] trace_ptr        Mapped trace.
+ * @param[in] first_record_idx First record that is still needed.
+ */
+void release_adc_trace_records_before(adc_trace_file_t *trace_ptr, uint64_t first_record_idx);
+
+/**
+ * @brief Unmaps a trace file.
+ *
+ * @param[in] trace_ptr Mapped trace.
+ */
+void close_adc_trace_file(adc_trace_file_t *trace_ptr);
+
+/**
+ * @brief Creates a trace file and writes its header.
+ *
+ * @param[in]  path       Path of the trace file.
+ * @param[in]  header_ptr Header of the recorder, record_cnt is filled at close.
+ * @param[out] writer_ptr Writer.
+ * @retval true  The file is created.
+ * @retval false The file could not be created, the reason is printed to stderr.
+ */
+bool open_adc_trace_writer(const char *path,
+						   const adc_trace_file_header_t *header_ptr,
+						   adc_trace_writer_t *writer_ptr);
+
+/**
+ * @brief Appends records to a trace file.
+ *
+ * @param[in] writer_ptr  Writer.
+ * @param[in] records_ptr Records to append.
+ * @param[in] record_cnt  Number of records.
+ * @return true if all records were written.
+ */
+bool write_adc_trace_records(adc_trace_writer_t *writer_ptr,
+							 const adc_trace_record_t *records_ptr,
+							 uint32_t record_cnt);
+
+/**
+ * @brief Stores the record count in the header and closes the file.
+ *
+ * @param[in] writer_ptr Writer.
+ * @return true if the file was completed without an I/O error.
+ */
+bool close_adc_trace_writer(adc_trace_writer_t *writer_ptr);
+
+#endif /* ADC_TRACE_FILE_H_ */
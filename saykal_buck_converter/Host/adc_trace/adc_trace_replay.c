@@ -0,0 +1,220 @@
+/**
+ * @file adc_trace_replay.c
+ * @brief Replays a recorded ADC trace through the unchanged firmware.
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "adc_trace_replay.h"
+#include "bsp_adc.h"
+#include "stm32f4xx_hal.h"
+#include "string.h"
+
+/** @brief Number of sensors the generated read functions below can serve. */
+#define ADC_TRACE_REPLAY_MAX_SENSOR_CNT		8U
+
+_Static_assert(TOTAL_ADC_SENSOR_ID <= ADC_TRACE_REPLAY_MAX_SENSOR_CNT,
+			   "add read functions to m_replay_read_funcs");
+
+static adc_trace_file_t *m_trace_ptr = NULL;
+
+/**
+ * @brief Index of the next record examined for each sensor.
+ */
+static uint64_t m_sensor_cursors[TOTAL_ADC_SENSOR_ID];
+
+static adc_sensor_driver_config_t m_replay_sensor_configs[TOTAL_ADC_SENSOR_ID];
+
+static adc_trace_replay_stats_t m_replay_stats;
+
+/**
+ * @brief ADC channel behind every sensor, as wired in bsp_adc.c.
+ */
+static const uint32_t m_replay_adc_channels[TOTAL_ADC_SENSOR_ID] =
+{
+	[BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID] = ADC_CHANNEL_1,
+	[BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID] = ADC_CHANNEL_2,
+	[TEMPERATURE_LM35_SENSOR_ID] = ADC_CHANNEL_3,
+	[BUCK_CONVERTOR_IN_VOLTAGE_RESISTOR_SENSOR_ID] = ADC_CHANNEL_4,
+	[BUCK_CONVERTOR_IN_CURRENT_ACS724_SENSOR_ID] = ADC_CHANNEL_5,
+};
+
+static bsp_adc_status_e read_replayed_sensor(uint8_t sensor_id, uint16_t *raw_count_ptr);
+
+/**
+ * @brief Defines the read function of one sensor, the driver passes no sensor ID.
+ */
+#define ADC_TRACE_REPLAY_READ_FUNC(sensor_id)										\
+	static bsp_adc_status_e read_replayed_sensor_##sensor_id(uint16_t *raw_count_ptr)	\
+	{																				\
+		return read_replayed_sensor(sensor_id, raw_count_ptr);						\
+	}
+
+ADC_TRACE_REPLAY_READ_FUNC(0U)
+ADC_TRACE_REPLAY_READ_FUNC(1U)
+ADC_TRACE_REPLAY_READ_FUNC(2U)
+ADC_TRACE_REPLAY_READ_FUNC(3U)
+ADC_TRACE_REPLAY_READ_FUNC(4U)
+ADC_TRACE_REPLAY_READ_FUNC(5U)
+ADC_TRACE_REPLAY_READ_FUNC(6U)
+ADC_TRACE_REPLAY_READ_FUNC(7U)
+
+static const read_sensor_adc_raw_count_function_t m_replay_read_funcs[ADC_TRACE_REPLAY_MAX_SENSOR_CNT] =
+{
+	read_replayed_sensor_0U, read_replayed_sensor_1U, read_replayed_sensor_2U, read_replayed_sensor_3U,
+	read_replayed_sensor_4U, read_replayed_sensor_5U, read_replayed_sensor_6U, read_replayed_sensor_7U,
+};
+
+bool init_adc_trace_replay(adc_trace_file_t *trace_ptr,
+						   const adc_sensor_driver_config_t *sensor_configs_ptr)
+{
+	if(TOTAL_ADC_SENSOR_ID != trace_ptr->header_ptr->sensor_cnt)
+	{
+		fprintf(stderr, "trace was recorded with %u sensors, firmware has %u\n",
+				(unsigned)trace_ptr->header_ptr->sensor_cnt, (unsigned)TOTAL_ADC_SENSOR_ID);
+		return false;
+	}
+
+	if((0U == trace_ptr->header_ptr->raw_count_bits) ||
+	   (trace_ptr->header_ptr->raw_count_bits > BSP_ADC_OVERSAMPLED_COUNT_BITS))
+	{
+		fprintf(stderr, "trace holds %u bit counts, firmware reads up to %u bits\n",
+				(unsigned)trace_ptr->header_ptr->raw_count_bits, (unsigned)BSP_ADC_OVERSAMPLED_COUNT_BITS);
+		return false;
+	}
+
+	if(0U == trace_ptr->record_cnt)
+	{
+		fprintf(stderr, "trace holds no records\n");
+		return false;
+	}
+
+	m_trace_ptr = trace_ptr;
+	memset(m_sensor_cursors, 0, sizeof(m_sensor_cursors));
+	memset(&m_replay_stats, 0, sizeof(m_replay_stats));
+
+	for(uint8_t sensor_id = 0U; sensor_id < TOTAL_ADC_SENSOR_ID; sensor_id++)
+	{
+		m_replay_sensor_configs[sensor_id] = sensor_configs_ptr[sensor_id];
+		m_replay_sensor_configs[sensor_id].read_adc_sensor_raw_count_func = m_replay_read_funcs[sensor_id];
+		// the recorded values are decimated already
+		m_replay_sensor_configs[sensor_id].oversampling_ratio = 1U;
+	}
+
+	return true;
+}
+
+const adc_sensor_driver_config_t *get_adc_trace_replay_sensor_configs(void)
+{
+	return m_replay_sensor_configs;
+}
+
+uint32_t convert_adc_trace_replay_zero_count(uint32_t adc_channel)
+{
+	for(uint8_t sensor_id = 0U; sensor_id < TOTAL_ADC_SENSOR_ID; sensor_id++)
+	{
+		if(adc_channel == m_replay_adc_channels[sensor_id])
+		{
+			uint32_t zero_count = m_trace_ptr->header_ptr->zero_counts[sensor_id];
+
+			return (zero_count + (1U << (BSP_ADC_OVERSAMPLING_SHIFT - 1U))) >> BSP_ADC_OVERSAMPLING_SHIFT;
+		}
+	}
+
+	return 0U;
+}
+
+void apply_adc_trace_replay_zero_counts(void)
+{
+	for(uint8_t sensor_id = 0U; sensor_id < TOTAL_ADC_SENSOR_ID; sensor_id++)
+	{
+		set_adc_sensor_zero_count(sensor_id, m_trace_ptr->header_ptr->zero_counts[sensor_id]);
+	}
+}
+
+uint32_t get_adc_trace_replay_calibration_time_ms(void)
+{
+	uint32_t calibration_time_ms = 0U;
+
+	for(uint8_t sensor_id = 0U; sensor_id < TOTAL_ADC_SENSOR_ID; sensor_id++)
+	{
+		if(m_replay_sensor_configs[sensor_id].zero_calibration_sample_cnt > calibration_time_ms)
+		{
+			calibration_time_ms = m_replay_sensor_configs[sensor_id].zero_calibration_sample_cnt;
+		}
+	}
+
+	return calibration_time_ms;
+}
+
+void get_adc_trace_replay_time_range(uint32_t *first_timestamp_ptr, uint32_t *last_timestamp_ptr)
+{
+	*first_timestamp_ptr = m_trace_ptr->records_ptr[0].timestamp;
+	*last_timestamp_ptr = m_trace_ptr->records_ptr[m_trace_ptr->record_cnt - 1U].timestamp;
+}
+
+void get_adc_trace_replay_stats(adc_trace_replay_stats_t *stats_ptr)
+{
+	*stats_ptr = m_replay_stats;
+}
+
+/**
+ * @brief Returns the next record of a sensor as a bsp_adc read would.
+ */
+static bsp_adc_status_e read_replayed_sensor(uint8_t sensor_id, uint16_t *raw_count_ptr)
+{
+	const adc_trace_record_t *records_ptr = m_trace_ptr->records_ptr;
+	uint64_t record_idx = m_sensor_cursors[sensor_id];
+
+	while((record_idx < m_trace_ptr->record_cnt) && (sensor_id != records_ptr[record_idx].sensor_id))
+	{
+		record_idx++;
+	}
+
+	if(record_idx >= m_trace_ptr->record_cnt)
+	{
+		m_sensor_cursors[sensor_id] = record_idx;
+		m_replay_stats.exhausted_read_cnt++;
+		return BSP_ADC_STATE_ERROR_e;
+	}
+
+	const adc_trace_record_t *record_ptr = &records_ptr[record_idx];
+	uint32_t tick = HAL_GetTick();
+
+	if(tick != record_ptr->timestamp)
+	{
+		if(0U == m_replay_stats.timestamp_mismatch_cnt)
+		{
+			m_replay_stats.first_mismatch_tick = tick;
+		}
+
+		m_replay_stats.timestamp_mismatch_cnt++;
+	}
+
+	m_sensor_cursors[sensor_id] = record_idx + 1U;
+	m_replay_stats.replayed_record_cnt++;
+
+	// pages behind the slowest sensor are not read again
+	uint64_t slowest_cursor = m_sensor_cursors[0];
+
+	for(uint8_t cursor_idx = 1U; cursor_idx < TOTAL_ADC_SENSOR_ID; cursor_idx++)
+	{
+		if(m_sensor_cursors[cursor_idx] < slowest_cursor)
+		{
+			slowest_cursor = m_sensor_cursors[cursor_idx];
+		}
+	}
+
+	release_adc_trace_records_before(m_trace_ptr, slowest_cursor);
+
+	if(ADC_TRACE_SAMPLE_OK_e != record_ptr->status)
+	{
+		return BSP_ADC_STATE_ERROR_e;
+	}
+
+	// records hold the count the driver converted, oversampled sensors with fraction bits
+	*raw_count_ptr = (uint16_t)((uint32_t)record_ptr->raw_count <<
+								(BSP_ADC_OVERSAMPLED_COUNT_BITS - m_trace_ptr->header_ptr->raw_count_bits));
+
+	return BSP_ADC_STATE_OK_e;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file adc_trace_replay.h
+ * @brief Replays a recorded ADC trace through the unchanged firmware.
+ *
+ * The replay provides one read function per sensor with the signature of
+ * read_adc_sensor_raw_count_func. Each call returns the raw count of the next
+ * record of that sensor, the count a live read converted, so the ADC
+ * sensor driver, the PID controllers and the overcurrent monitor see bit for
+ * bit the values the device saw. A sensor keeps its own cursor into the memory
+ * mapped trace, so sensors read by different timers stay independent.
+ *
+ * Each record timestamp is compared with HAL_GetTick() at the time of the read.
+ * A mismatch means the firmware did not read the sensor at the recorded time,
+ * i.e. the replay diverged from the recording.
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef ADC_TRACE_REPLAY_H_
+#define ADC_TRACE_REPLAY_H_
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "adc_trace_file.h"
+#include "adc_sensor_driver.h"
+
+/**
+ * @brief Counters of a replay.
+ */
+typedef struct
+{
+	uint64_t replayed_record_cnt;				///< Records returned to the firmware
+	uint64_t timestamp_mismatch_cnt;			///< Reads whose tick differed from the record timestamp
+	uint32_t first_mismatch_tick;				///< Tick of the first mismatch
+	uint32_t exhausted_read_cnt;				///< Reads after the last record of a sensor, answered with an error
+
+}adc_trace_replay_stats_t;
+
+/**
+ * @brief Prepares the replay of a mapped trace.
+ *
+ * @param[in] trace_ptr          Mapped trace, must stay open during the replay.
+ * @param[in] sensor_configs_ptr Product sensor configuration; scaling is kept, the read functions are replaced.
+ * @retval true  The replay is ready.
+ * @retval false The trace does not match the sensors of this firmware.
+ */
+bool init_adc_trace_replay(adc_trace_file_t *trace_ptr,
+						   const adc_sensor_driver_config_t *sensor_configs_ptr);
+
+/**
+ * @brief Returns the sensor configuration to pass to init_adc_sensor_driver().
+ *
+ * @return const adc_sensor_driver_config_t* TOTAL_ADC_SENSOR_ID sensor configurations reading from the trace.
+ */
+const adc_sensor_driver_config_t *get_adc_trace_replay_sensor_configs(void);
+
+/**
+ * @brief Host HAL ADC conversion source answering the start-up zero calibration.
+ *
+ * Returns the recorded zero count of the sensor behind the channel in 12-bit
+ * counts, so the calibration of the replayed firmware passes or fails like
+ * the recorded one. Register it before the init state runs.
+ *
+ * @param[in] adc_channel ADC channel of the conversion.
+ * @return uint32_t 12-bit ADC count.
+ */
+uint32_t convert_adc_trace_replay_zero_count(uint32_t adc_channel);
+
+/**
+ * @brief Applies the recorded zero counts to the sensor driver.
+ *
+ * Call after init_adc_sensor_driver() with the replay configuration, so the
+ * recorded counts are converted with the exact offsets of the recording.
+ */
+void apply_adc_trace_replay_zero_counts(void);
+
+/**
+ * @brief Returns how long the init state blocks in the start-up zero calibration.
+ *
+ * @return uint32_t Milliseconds, the largest zero_calibration_sample_cnt of the sensors.
+ */
+uint32_t get_adc_trace_replay_calibration_time_ms(void);
+
+/**
+ * @brief Returns the timestamp of the first and the last record.
+ *
+ * @param[out] first_timestamp_ptr First timestamp.
+ * @param[out] last_timestamp_ptr  Last timestamp.
+ */
+void get_adc_trace_replay_time_range(uint32_t *first_timestamp_ptr, uint32_t *last_timestamp_ptr);
+
+/**
+ * @brief Returns the counters of the replay.
+ *
+ * @param[out] stats_ptr Counters.
+ */
+void get_adc_trace_replay_stats(adc_trace_replay_stats_t *stats_ptr);
+
+#endif /* ADC_TRACE_REPLAY_H_ */
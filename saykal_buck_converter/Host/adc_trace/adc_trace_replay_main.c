@@ -0,0 +1,220 @@
+/**
+ * @file adc_trace_replay_main.c
+ * @brief Replays an ADC trace through the firmware and reports its reaction.
+ *
+ * The firmware is started so that its control loop reads the first recorded
+ * sample at the recorded tick, after the init state blocked in the start-up
+ * zero calibration like the recording did. The calibration is answered with
+ * the recorded zero counts, which replace the measured ones afterwards. Then
+ * the main loop runs one iteration per
+ * millisecond until the last record. All ADC sensor reads are answered from the
+ * trace. The tool prints when the overcurrent protection tripped, the final
+ * error status and whether every sample was consumed at its recorded tick.
+ *
+ * Usage: buck_adc_replay [options] TRACE
+ *   --csv PATH     write time_ms,duty,is_pwm_running per millisecond
+ *
+ * Exits nonzero if the trace can not be replayed or the replay diverged from
+ * the recording.
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "getopt.h"
+#include "adc_trace_file.h"
+#include "adc_trace_replay.h"
+#include "host_hal.h"
+#include "system_manager.h"
+#include "error_manager.h"
+#include "app_buck_converter.h"
+#include "bsp_pwm.h"
+
+/** @brief Timestamp frequency the replay can drive, one main loop iteration per tick. */
+#define ADC_TRACE_REPLAY_TIMESTAMP_FREQUENCY_HZ		1000U
+
+extern const adc_sensor_driver_config_t g_adc_sensors_configuration[];
+extern const bsp_pwm_config_t g_bsp_pwm_timer_configs[];
+extern const buck_converter_cfg_t g_buck_converter_config;
+
+static TIM_TypeDef *m_mosfet_timer_ptr = NULL;
+static uint32_t m_mosfet_timer_channel = 0U;
+
+static void locate_mosfet_timer_channel(void);
+
+int main(int argc, char *argv[])
+{
+	static const struct option long_options[] =
+	{
+		{ "csv", required_argument, NULL, 'o' },
+		{ NULL,  0,                 NULL, 0 },
+	};
+
+	const char *csv_path = NULL;
+	int option;
+
+	while(-1 != (option = getopt_long(argc, argv, "", long_options, NULL)))
+	{
+		switch(option)
+		{
+			case 'o': csv_path = optarg; break;
+			default:
+			{
+				fprintf(stderr, "usage: %s [--csv PATH] TRACE\n", argv[0]);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	if((optind + 1) != argc)
+	{
+		fprintf(stderr, "usage: %s [--csv PATH] TRACE\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	adc_trace_file_t trace;
+
+	if(false == open_adc_trace_file(argv[optind], &trace))
+	{
+		return EXIT_FAILURE;
+	}
+
+	if(ADC_TRACE_REPLAY_TIMESTAMP_FREQUENCY_HZ != trace.header_ptr->timestamp_frequency_hz)
+	{
+		fprintf(stderr, "trace timestamps run at %u Hz, the replay needs %u Hz\n",
+				(unsigned)trace.header_ptr->timestamp_frequency_hz,
+				(unsigned)ADC_TRACE_REPLAY_TIMESTAMP_FREQUENCY_HZ);
+		close_adc_trace_file(&trace);
+		return EXIT_FAILURE;
+	}
+
+	if(false == init_adc_trace_replay(&trace, g_adc_sensors_configuration))
+	{
+		close_adc_trace_file(&trace);
+		return EXIT_FAILURE;
+	}
+
+	FILE *csv_file_ptr = NULL;
+
+	if(NULL != csv_path)
+	{
+		csv_file_ptr = fopen(csv_path, "w");
+
+		if(NULL == csv_file_ptr)
+		{
+			perror(csv_path);
+			close_adc_trace_file(&trace);
+			return EXIT_FAILURE;
+		}
+
+		fprintf(csv_file_ptr, "time_ms,duty,is_pwm_running\n");
+	}
+
+	uint32_t first_timestamp = 0U;
+	uint32_t last_timestamp = 0U;
+	get_adc_trace_replay_time_range(&first_timestamp, &last_timestamp);
+
+	// the control timer started at the end of the init state expires one period later
+	uint32_t init_to_first_read_ms = get_adc_trace_replay_calibration_time_ms() +
+									 g_buck_converter_config.period_time_process_of_controller_ms;
+	uint32_t start_tick = (first_timestamp >= init_to_first_read_ms) ? (first_timestamp - init_to_first_read_ms) : 0U;
+
+	host_hal_reset();
+	host_hal_set_tick(start_tick);
+	host_hal_register_adc_conversion_func(convert_adc_trace_replay_zero_count);
+	locate_mosfet_timer_channel();
+
+	run_state_machine_of_system_manager();
+	init_adc_sensor_driver(get_adc_trace_replay_sensor_configs());
+	apply_adc_trace_replay_zero_counts();
+	host_hal_advance_tick(1U);
+
+	bool is_over_current_tripped = false;
+	uint32_t over_current_trip_tick = 0U;
+
+	while(HAL_GetTick() <= last_timestamp)
+	{
+		uint32_t tick = HAL_GetTick();
+
+		run_state_machine_of_system_manager();
+
+		if((false == is_over_current_tripped) && (true == get_system_overcurrent_error_status()))
+		{
+			is_over_current_tripped = true;
+			over_current_trip_tick = tick;
+		}
+
+		if(NULL != csv_file_ptr)
+		{
+			fprintf(csv_file_ptr, "%u,%.9g,%u\n", (unsigned)tick,
+					host_hal_get_pwm_duty(m_mosfet_timer_ptr, m_mosfet_timer_channel),
+					(unsigned)host_hal_is_pwm_running(m_mosfet_timer_ptr, m_mosfet_timer_channel));
+		}
+
+		host_hal_advance_tick(1U);
+	}
+
+	if(NULL != csv_file_ptr)
+	{
+		fclose(csv_file_ptr);
+	}
+
+	adc_trace_replay_stats_t replay_stats;
+	get_adc_trace_replay_stats(&replay_stats);
+
+	printf("records=%llu replayed=%llu first_ms=%u last_ms=%u overwritten_before_start=%u\n",
+		   (unsigned long long)trace.record_cnt,
+		   (unsigned long long)replay_stats.replayed_record_cnt,
+		   (unsigned)first_timestamp, (unsigned)last_timestamp,
+		   (unsigned)trace.header_ptr->overwritten_record_cnt);
+
+	if(true == is_over_current_tripped)
+	{
+		printf("over_current_trip_ms=%u\n", (unsigned)over_current_trip_tick);
+	}
+	else
+	{
+		printf("over_current_trip_ms=none\n");
+	}
+
+	printf("system_error_status=0x%02X final_duty=%.6f\n",
+		   (unsigned)get_system_error_status(),
+		   host_hal_get_pwm_duty(m_mosfet_timer_ptr, m_mosfet_timer_channel));
+	printf("timestamp_mismatches=%llu exhausted_reads=%u\n",
+		   (unsigned long long)replay_stats.timestamp_mismatch_cnt,
+		   (unsigned)replay_stats.exhausted_read_cnt);
+
+	bool is_diverged = (0U != replay_stats.timestamp_mismatch_cnt) || (0U != replay_stats.exhausted_read_cnt);
+
+	if(true == is_diverged)
+	{
+		fprintf(stderr, "replay diverged from the recording, first_mismatch_ms=%u\n",
+				(unsigned)replay_stats.first_mismatch_tick);
+	}
+
+	close_adc_trace_file(&trace);
+
+	return (true == is_diverged) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+ * @brief Finds the timer and channel behind PWM_TIMER_ID_FOR_BUCK_MOSFET in the PWM configuration.
+ */
+static void locate_mosfet_timer_channel(void)
+{
+	for(uint8_t timer_idx = 0U; timer_idx < PWM_TIMER_TOTAL_CNT; timer_idx++)
+	{
+		const bsp_pwm_timer_channel_config_t *channel_configs_ptr =
+			&g_bsp_pwm_timer_configs[timer_idx].timer_channel_configs;
+
+		for(uint8_t channel_idx = 0U; channel_idx < channel_configs_ptr->total_timer_channel; channel_idx++)
+		{
+			if(PWM_TIMER_ID_FOR_BUCK_MOSFET == channel_configs_ptr->pwm_channels_ptr[channel_idx].pwm_channel_id)
+			{
+				m_mosfet_timer_ptr = g_bsp_pwm_timer_configs[timer_idx].timer_instance_ptr;
+				m_mosfet_timer_channel = channel_configs_ptr->pwm_channels_ptr[channel_idx].timer_channel;
+			}
+		}
+	}
+}
@@ -0,0 +1,536 @@
+/**
+ * @file firmware_benchmark_main.c
+ * @brief Micro-benchmarks of the firmware hot paths.
+ *
+ * Measures ns/call and, where the kernel exposes a hardware instruction counter,
+ * instructions/call of the functions executed on every control period. The same
+ * source is linked against the product configuration (buck_firmware_bench) and
+ * against scaled configuration tables with more messages, signals and timers
+ * (buck_firmware_bench_m<M>_t<T>), so the cost of the linear searches and
+ * bit-by-bit loops can be followed as the tables grow.
+ *
+ * Results are written to stdout as CSV:
+ *   case,config,ns_per_call,instructions_per_call,iterations
+ * instructions_per_call is nan when no instruction counter is available.
+ *
+ * With --baseline, every case is compared to the row of the baseline file with
+ * the same case and config. The program exits with EXIT_FAILURE when a case got
+ * slower than the threshold allows. Instructions are compared when both runs
+ * counted them, because they do not depend on the load of the machine.
+ *
+ * Usage: buck_firmware_bench [options]
+ *   --min-batch-ms N       minimum duration of one measured batch (default 20)
+ *   --repeat N             measured batches per case, the fastest counts (default 5)
+ *   --baseline PATH        CSV of an earlier run to compare against
+ *   --threshold R          allowed relative slowdown (default 0.10)
+ *   --no-header            omit the CSV header, to append the output of several builds
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "math.h"
+#include "getopt.h"
+#include "time.h"
+#include "unistd.h"
+#include "sys/ioctl.h"
+#include "sys/syscall.h"
+#include "linux/perf_event.h"
+#include "host_hal.h"
+#include "pid_controller.h"
+#include "pid_saturating_math.h"
+#include "adc_sensor_driver.h"
+#include "com_driver.h"
+#include "bsp_pwm.h"
+#include "software_timer.h"
+#include "system_manager.h"
+#include "app_buck_converter.h"
+
+extern const buck_converter_cfg_t g_buck_converter_config;
+
+/** @brief Longest case or config name stored from a baseline file. */
+#define BENCHMARK_NAME_LEN_MAX		64U
+
+/** @brief Most rows read from a baseline file. */
+#define BENCHMARK_BASELINE_ROW_MAX	256U
+
+/** @brief Timeout that keeps every software timer running but never expiring. */
+#define BENCHMARK_TIMER_NEVER_MS	0x7FFFFFFFU
+
+
+/**
+ * @brief Runs the benchmarked call iteration_cnt times.
+ */
+typedef void (*benchmark_case_func_t)(uint32_t iteration_cnt);
+
+/**
+ * @brief One benchmark case.
+ */
+typedef struct
+{
+	const char *case_name;
+	benchmark_case_func_t case_func;
+
+}benchmark_case_t;
+
+/**
+ * @brief Result of one case, also used for the rows of a baseline file.
+ */
+typedef struct
+{
+	char case_name[BENCHMARK_NAME_LEN_MAX];
+	char config_name[BENCHMARK_NAME_LEN_MAX];
+	double ns_per_call;
+	double instructions_per_call;
+	unsigned long long iteration_cnt;
+
+}benchmark_result_t;
+
+static pid_controller_t m_benchmark_pid;
+static pid_controller_v2_t m_benchmark_pid_v2;
+static pid_controller_q31_t m_benchmark_pid_q31;
+static volatile float m_benchmark_sink;
+
+static void run_pid_step_case(uint32_t iteration_cnt);
+static void run_pid_step_v2_case(uint32_t iteration_cnt);
+static void run_pid_step_q31_case(uint32_t iteration_cnt);
+static void run_read_adc_sensor_value_case(uint32_t iteration_cnt);
+static void run_read_all_adc_sensor_values_case(uint32_t iteration_cnt);
+static void run_send_first_signal_case(uint32_t iteration_cnt);
+static void run_send_last_signal_case(uint32_t iteration_cnt);
+static void run_set_pwm_duty_case(uint32_t iteration_cnt);
+static void run_send_periodic_message_case(uint32_t iteration_cnt);
+static void run_all_software_timers_case(uint32_t iteration_cnt);
+static uint32_t convert_benchmark_adc_channel(uint32_t adc_channel);
+static void init_benchmark_firmware(void);
+static int open_instruction_counter(void);
+static uint64_t get_time_ns(void);
+static void measure_case(const benchmark_case_t *case_ptr,
+						 int instruction_counter_fd,
+						 uint64_t min_batch_ns,
+						 uint32_t repeat_cnt,
+						 benchmark_result_t *result_ptr);
+static uint32_t load_baseline(const char *baseline_path, benchmark_result_t *rows_ptr, uint32_t row_cnt_max);
+
+static const benchmark_case_t m_benchmark_cases[] =
+{
+	{ "PID_Step",                          run_pid_step_case },
+	{ "PID_Step_v2",                       run_pid_step_v2_case },
+	{ "PID_Step_q31",                      run_pid_step_q31_case },
+	{ "read_adc_sensor_value",             run_read_adc_sensor_value_case },
+	{ "read_all_adc_sensor_values",        run_read_all_adc_sensor_values_case },
+	{ "send_signal_over_com/first_signal", run_send_first_signal_case },
+	{ "send_signal_over_com/last_signal",  run_send_last_signal_case },
+	{ "set_pwm_duty",                      run_set_pwm_duty_case },
+	{ "send_periodic_message_timeout_cb",  run_send_periodic_message_case },
+	{ "run_all_software_timers",           run_all_software_timers_case },
+};
+
+#define BENCHMARK_CASE_CNT	(sizeof(m_benchmark_cases) / sizeof(m_benchmark_cases[0]))
+
+int main(int argc, char *argv[])
+{
+	static const struct option long_options[] =
+	{
+		{ "min-batch-ms", required_argument, NULL, 'b' },
+		{ "repeat",       required_argument, NULL, 'r' },
+		{ "baseline",     required_argument, NULL, 'B' },
+		{ "threshold",    required_argument, NULL, 't' },
+		{ "no-header",    no_argument,       NULL, 'n' },
+		{ NULL, 0, NULL, 0 },
+	};
+
+	uint32_t min_batch_ms = 20U;
+	uint32_t repeat_cnt = 5U;
+	const char *baseline_path = NULL;
+	double threshold = 0.10;
+	bool is_header_printed = true;
+	int option;
+
+	while(-1 != (option = getopt_long(argc, argv, "", long_options, NULL)))
+	{
+		switch(option)
+		{
+			case 'b': min_batch_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'r': repeat_cnt = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'B': baseline_path = optarg; break;
+			case 't': threshold = strtod(optarg, NULL); break;
+			case 'n': is_header_printed = false; break;
+			default:
+			{
+				fprintf(stderr, "usage: %s [--min-batch-ms N] [--repeat N] [--baseline PATH] "
+						"[--threshold R] [--no-header]\n", argv[0]);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	if(0U == repeat_cnt)
+	{
+		repeat_cnt = 1U;
+	}
+
+	static benchmark_result_t baseline_rows[BENCHMARK_BASELINE_ROW_MAX];
+	uint32_t baseline_row_cnt = 0U;
+
+	if(NULL != baseline_path)
+	{
+		baseline_row_cnt = load_baseline(baseline_path, baseline_rows, BENCHMARK_BASELINE_ROW_MAX);
+
+		if(0U == baseline_row_cnt)
+		{
+			fprintf(stderr, "%s: no benchmark rows\n", baseline_path);
+			return EXIT_FAILURE;
+		}
+	}
+
+	init_benchmark_firmware();
+
+	int instruction_counter_fd = open_instruction_counter();
+
+	if(instruction_counter_fd < 0)
+	{
+		fprintf(stderr, "hardware instruction counter not available, instructions_per_call is nan\n");
+	}
+
+	if(true == is_header_printed)
+	{
+		printf("case,config,ns_per_call,instructions_per_call,iterations\n");
+	}
+
+	uint32_t regression_cnt = 0U;
+
+	for(uint32_t case_idx = 0U; case_idx < BENCHMARK_CASE_CNT; case_idx++)
+	{
+		benchmark_result_t result;
+
+		measure_case(&m_benchmark_cases[case_idx], instruction_counter_fd,
+					 (uint64_t)min_batch_ms * 1000000U, repeat_cnt, &result);
+
+		printf("%s,%s,%.3f,%.1f,%llu\n", result.case_name, result.config_name,
+			   result.ns_per_call, result.instructions_per_call, result.iteration_cnt);
+		fflush(stdout);
+
+		for(uint32_t row_idx = 0U; row_idx < baseline_row_cnt; row_idx++)
+		{
+			const benchmark_result_t *baseline_ptr = &baseline_rows[row_idx];
+
+			if((0 != strcmp(baseline_ptr->case_name, result.case_name)) ||
+			   (0 != strcmp(baseline_ptr->config_name, result.config_name)))
+			{
+				continue;
+			}
+
+			bool is_instruction_compared = (false == isnan(baseline_ptr->instructions_per_call)) &&
+										   (false == isnan(result.instructions_per_call));
+			double baseline_value = (true == is_instruction_compared) ?
+				baseline_ptr->instructions_per_call : baseline_ptr->ns_per_call;
+			double current_value = (true == is_instruction_compared) ?
+				result.instructions_per_call : result.ns_per_call;
+
+			if(current_value > (baseline_value * (1.0 + threshold)))
+			{
+				fprintf(stderr, "REGRESSION %s [%s]: %s %.3f -> %.3f (+%.1f %%)\n",
+						result.case_name, result.config_name,
+						(true == is_instruction_compared) ? "instructions/call" : "ns/call",
+						baseline_value, current_value, 100.0 * ((current_value / baseline_value) - 1.0));
+				regression_cnt++;
+			}
+		}
+	}
+
+	if(instruction_counter_fd >= 0)
+	{
+		close(instruction_counter_fd);
+	}
+
+	return (0U == regression_cnt) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static void run_pid_step_case(uint32_t iteration_cnt)
+{
+	static const float sensed_values[4] = { 23.5f, 24.1f, 24.0f, 23.9f };
+	float command = 0.0f;
+
+	for(uint32_t iteration_idx = 0U; iteration_idx < iteration_cnt; iteration_idx++)
+	{
+		command += PID_Step(&m_benchmark_pid, sensed_values[iteration_idx & 3U], 24.0f);
+	}
+
+	m_benchmark_sink = command;
+}
+
+static void run_pid_step_v2_case(uint32_t iteration_cnt)
+{
+	static const float sensed_values[4] = { 23.5f, 24.1f, 24.0f, 23.9f };
+	float command = 0.0f;
+
+	for(uint32_t iteration_idx = 0U; iteration_idx < iteration_cnt; iteration_idx++)
+	{
+		command += PID_Step_v2(&m_benchmark_pid_v2, sensed_values[iteration_idx & 3U], 24.0f);
+	}
+
+	m_benchmark_sink = command;
+}
+
+static void run_pid_step_q31_case(uint32_t iteration_cnt)
+{
+	uint8_t v_out_shift = g_buck_converter_config.v_out_full_scale_shift;
+	int32_t sensed_values[4] =
+	{
+		convert_pid_value_to_q31(23.5f, v_out_shift),
+		convert_pid_value_to_q31(24.1f, v_out_shift),
+		convert_pid_value_to_q31(24.0f, v_out_shift),
+		convert_pid_value_to_q31(23.9f, v_out_shift),
+	};
+	int32_t reference_point = convert_pid_value_to_q31(24.0f, v_out_shift);
+	int32_t command = 0;
+
+	for(uint32_t iteration_idx = 0U; iteration_idx < iteration_cnt; iteration_idx++)
+	{
+		command = add_pid_q31_saturated(command, PID_Step_q31(&m_benchmark_pid_q31, sensed_values[iteration_idx & 3U], reference_point));
+	}
+
+	m_benchmark_sink = (float)command;
+}
+
+static void run_read_adc_sensor_value_case(uint32_t iteration_cnt)
+{
+	float sensor_value = 0.0f;
+	float value_sum = 0.0f;
+
+	for(uint32_t iteration_idx = 0U; iteration_idx < iteration_cnt; iteration_idx++)
+	{
+		read_adc_sensor_value(BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID, &sensor_value);
+		value_sum += sensor_value;
+	}
+
+	m_benchmark_sink = value_sum;
+}
+
+static void run_read_all_adc_sensor_values_case(uint32_t iteration_cnt)
+{
+	adc_sensor_snapshot_t sensor_snapshot;
+	float value_sum = 0.0f;
+
+	for(uint32_t iteration_idx = 0U; iteration_idx < iteration_cnt; iteration_idx++)
+	{
+		read_all_adc_sensor_values(&sensor_snapshot);
+		value_sum += sensor_snapshot.values[BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID];
+	}
+
+	m_benchmark_sink = value_sum;
+}
+
+static void run_send_first_signal_case(uint32_t iteration_cnt)
+{
+	float signal_value = 24.0f;
+
+	for(uint32_t iteration_idx = 0U; iteration_idx < iteration_cnt; iteration_idx++)
+	{
+		send_signal_over_com(0U, &signal_value);
+	}
+}
+
+static void run_send_last_signal_case(uint32_t iteration_cnt)
+{
+	uint32_t signal_value = 0x5AU;
+
+	for(uint32_t iteration_idx = 0U; iteration_idx < iteration_cnt; iteration_idx++)
+	{
+		send_signal_over_com(COM_SIGNAL_CNT - 1U, &signal_value);
+	}
+}
+
+static void run_set_pwm_duty_case(uint32_t iteration_cnt)
+{
+	for(uint32_t iteration_idx = 0U; iteration_idx < iteration_cnt; iteration_idx++)
+	{
+		set_pwm_duty(PWM_TIMER_ID_FOR_BUCK_MOSFET, (0U == (iteration_idx & 1U)) ? 0.25f : 0.75f);
+	}
+}
+
+static void run_send_periodic_message_case(uint32_t iteration_cnt)
+{
+	for(uint32_t iteration_idx = 0U; iteration_idx < iteration_cnt; iteration_idx++)
+	{
+		send_periodic_message_timeout_cb(COM_VOLTAGE_CURRENT_SYSTEM_INFO_MESSAGE_TIMER_ID);
+	}
+}
+
+static void run_all_software_timers_case(uint32_t iteration_cnt)
+{
+	for(uint32_t iteration_idx = 0U; iteration_idx < iteration_cnt; iteration_idx++)
+	{
+		run_all_software_timers();
+	}
+}
+
+static uint32_t convert_benchmark_adc_channel(uint32_t adc_channel)
+{
+	return 1000U + (adc_channel * 100U);
+}
+
+/**
+ * @brief Runs the INIT state once and parks every software timer.
+ *
+ * The virtual tick never advances while measuring, so run_all_software_timers()
+ * scans every running timer without firing a callback.
+ */
+static void init_benchmark_firmware(void)
+{
+	host_hal_reset();
+	host_hal_register_adc_conversion_func(convert_benchmark_adc_channel);
+
+	run_state_machine_of_system_manager();
+
+	for(uint32_t timer_idx = 0U; timer_idx < SOFTWARE_TIMER_CNT; timer_idx++)
+	{
+		start_software_timer((software_timer_id_t)timer_idx, BENCHMARK_TIMER_NEVER_MS);
+	}
+
+	m_benchmark_pid = *g_buck_converter_config.pid_out_voltage_cotroller_ptr;
+	init_pid_controller_v2(&m_benchmark_pid_v2, &m_benchmark_pid);
+	init_pid_controller_q31(&m_benchmark_pid_q31, &m_benchmark_pid,
+							g_buck_converter_config.v_out_full_scale_shift,
+							g_buck_converter_config.i_out_full_scale_shift);
+}
+
+/**
+ * @brief Opens a user space retired instruction counter of this process.
+ *
+ * @return int File descriptor, or -1 when the kernel does not expose the counter.
+ */
+static int open_instruction_counter(void)
+{
+	struct perf_event_attr event_attr;
+
+	memset(&event_attr, 0, sizeof(event_attr));
+	event_attr.type = PERF_TYPE_HARDWARE;
+	event_attr.size = sizeof(event_attr);
+	event_attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+	event_attr.disabled = 1;
+	event_attr.exclude_kernel = 1;
+	event_attr.exclude_hv = 1;
+
+	return (int)syscall(SYS_perf_event_open, &event_attr, 0, -1, -1, 0);
+}
+
+static uint64_t get_time_ns(void)
+{
+	struct timespec time_now;
+
+	clock_gettime(CLOCK_MONOTONIC, &time_now);
+
+	return ((uint64_t)time_now.tv_sec * 1000000000U) + (uint64_t)time_now.tv_nsec;
+}
+
+/**
+ * @brief Sizes a batch to at least min_batch_ns and keeps the fastest of repeat_cnt batches.
+ */
+static void measure_case(const benchmark_case_t *case_ptr,
+						 int instruction_counter_fd,
+						 uint64_t min_batch_ns,
+						 uint32_t repeat_cnt,
+						 benchmark_result_t *result_ptr)
+{
+	uint32_t iteration_cnt = 1U;
+	uint64_t batch_ns = 0U;
+
+	memset(result_ptr, 0, sizeof(*result_ptr));
+	snprintf(result_ptr->case_name, sizeof(result_ptr->case_name), "%s", case_ptr->case_name);
+	snprintf(result_ptr->config_name, sizeof(result_ptr->config_name), "m%u_s%u_t%u",
+			 (unsigned)COM_MESSAGE_CNT, (unsigned)COM_SIGNAL_CNT, (unsigned)SOFTWARE_TIMER_CNT);
+
+	for(;;)
+	{
+		uint64_t start_ns = get_time_ns();
+		case_ptr->case_func(iteration_cnt);
+		batch_ns = get_time_ns() - start_ns;
+
+		if((batch_ns >= min_batch_ns) || (iteration_cnt >= (UINT32_MAX / 2U)))
+		{
+			break;
+		}
+
+		iteration_cnt *= 2U;
+	}
+
+	double best_ns_per_call = (double)batch_ns / (double)iteration_cnt;
+	double best_instructions_per_call = NAN;
+
+	for(uint32_t repeat_idx = 0U; repeat_idx < repeat_cnt; repeat_idx++)
+	{
+		uint64_t instruction_cnt = 0U;
+
+		if(instruction_counter_fd >= 0)
+		{
+			ioctl(instruction_counter_fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(instruction_counter_fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+
+		uint64_t start_ns = get_time_ns();
+		case_ptr->case_func(iteration_cnt);
+		batch_ns = get_time_ns() - start_ns;
+
+		if(instruction_counter_fd >= 0)
+		{
+			ioctl(instruction_counter_fd, PERF_EVENT_IOC_DISABLE, 0);
+
+			if(sizeof(instruction_cnt) == read(instruction_counter_fd, &instruction_cnt, sizeof(instruction_cnt)))
+			{
+				double instructions_per_call = (double)instruction_cnt / (double)iteration_cnt;
+
+				if((true == isnan(best_instructions_per_call)) || (instructions_per_call < best_instructions_per_call))
+				{
+					best_instructions_per_call = instructions_per_call;
+				}
+			}
+		}
+
+		if(((double)batch_ns / (double)iteration_cnt) < best_ns_per_call)
+		{
+			best_ns_per_call = (double)batch_ns / (double)iteration_cnt;
+		}
+	}
+
+	result_ptr->ns_per_call = best_ns_per_call;
+	result_ptr->instructions_per_call = best_instructions_per_call;
+	result_ptr->iteration_cnt = iteration_cnt;
+}
+
+/**
+ * @brief Reads the rows of an earlier benchmark CSV, the header is skipped.
+ *
+ * @return uint32_t Number of rows read.
+ */
+static uint32_t load_baseline(const char *baseline_path, benchmark_result_t *rows_ptr, uint32_t row_cnt_max)
+{
+	FILE *baseline_file_ptr = fopen(baseline_path, "r");
+
+	if(NULL == baseline_file_ptr)
+	{
+		perror(baseline_path);
+		return 0U;
+	}
+
+	char line[256];
+	uint32_t row_cnt = 0U;
+
+	while((row_cnt < row_cnt_max) && (NULL != fgets(line, sizeof(line), baseline_file_ptr)))
+	{
+		benchmark_result_t *row_ptr = &rows_ptr[row_cnt];
+
+		if(5 == sscanf(line, "%63[^,],%63[^,],%lf,%lf,%llu", row_ptr->case_name, row_ptr->config_name,
+					   &row_ptr->ns_per_call, &row_ptr->instructions_per_call, &row_ptr->iteration_cnt))
+		{
+			row_cnt++;
+		}
+	}
+
+	fclose(baseline_file_ptr);
+
+	return row_cnt;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file bsp_can_cfg.c
+ * @brief Scaled CAN configuration of the benchmark builds.
+ *
+ * @date Oct 17, 2026
+ */
+
+#define g_bsp_can_configurations m_product_bsp_can_configurations
+#include "bsp_can_cfg/bsp_can_cfg.c"
+#undef g_bsp_can_configurations
+
+#define PRODUCT_CAN_TX_MESSAGE_CNT \
+	(sizeof(m_can_tx_messages_config) / sizeof(m_can_tx_messages_config[0]))
+
+static can_tx_message_cfg_t m_scaled_can_tx_messages_config[BSP_CAN_TX_MESSAGE];
+
+const bsp_can_cfg_t g_bsp_can_configurations =
+{
+		.can_gpio_pins_id = BSP_CAN_PINS_ID,
+		.can_instance_ptr = CAN1,
+		.clock_prescaler = 1U,
+		.sync_jump_bit = CAN_SJW_1TQ,
+		.time_segment_1 = CAN_BS1_6TQ,
+		.time_segment_2 = CAN_BS2_1TQ,
+		.tx_messages_ptr = m_scaled_can_tx_messages_config,
+};
+
+/**
+ * @brief Fills the scaled TX table before main() runs.
+ */
+__attribute__((constructor)) static void build_scaled_can_tx_messages(void)
+{
+	for(uint16_t tx_idx = 0U; tx_idx < BSP_CAN_TX_MESSAGE; tx_idx++)
+	{
+		if(tx_idx < PRODUCT_CAN_TX_MESSAGE_CNT)
+		{
+			m_scaled_can_tx_messages_config[tx_idx] = m_can_tx_messages_config[tx_idx];
+		}
+		else
+		{
+			m_scaled_can_tx_messages_config[tx_idx].can_id = 0x1000U + tx_idx;
+			m_scaled_can_tx_messages_config[tx_idx].id_type = CANID_EXTENDED_e;
+			m_scaled_can_tx_messages_config[tx_idx].message_id = tx_idx;
+		}
+	}
+}
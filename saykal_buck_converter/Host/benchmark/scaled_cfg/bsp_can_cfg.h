@@ -0,0 +1,17 @@
+/**
+ * @file bsp_can_cfg.h
+ * @brief Scaled CAN configuration of the benchmark builds, one TX entry per message.
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef BENCHMARK_BSP_CAN_CFG_H_
+#define BENCHMARK_BSP_CAN_CFG_H_
+
+#include "bsp_can_cfg/bsp_can_cfg.h"
+#include "com_driver_cfg.h"
+
+#undef BSP_CAN_TX_MESSAGE
+#define BSP_CAN_TX_MESSAGE	COM_MESSAGE_CNT
+
+#endif /* BENCHMARK_BSP_CAN_CFG_H_ */
@@ -0,0 +1,68 @@
+/**
+ * @file com_driver_cfg.c
+ * @brief Scaled communication configuration of the benchmark builds.
+ *
+ * The product configuration is compiled in under another name and copied in
+ * front of the filler messages, so the product signals keep their layout.
+ *
+ * @date Oct 17, 2026
+ */
+
+#define g_com_message_configs m_product_com_message_configs
+#include "com_driver_cfg/com_driver_cfg.c"
+#undef g_com_message_configs
+
+#define BENCHMARK_FILLER_MESSAGE_CNT	(COM_MESSAGE_CNT - COM_TOTAL_MESSAGE_ID)
+
+static com_message_t m_scaled_com_messages[COM_MESSAGE_CNT];
+
+static com_signal_t m_filler_signals[BENCHMARK_FILLER_MESSAGE_CNT + 1U][BENCHMARK_SIGNALS_PER_FILLER_MESSAGE];
+
+const com_configs_t g_com_message_configs =
+{
+	.messages_ptr = m_scaled_com_messages,
+};
+
+/**
+ * @brief Fills the scaled message table before main() runs.
+ */
+__attribute__((constructor)) static void build_scaled_com_messages(void)
+{
+	com_signal_id_t filler_signal_id = COM_TOTAL_SIGNAL_ID;
+
+	for(com_message_id_t msg_idx = 0U; msg_idx < COM_MESSAGE_CNT; msg_idx++)
+	{
+		if(msg_idx < COM_TOTAL_MESSAGE_ID)
+		{
+			m_scaled_com_messages[msg_idx] = m_product_com_message_configs.messages_ptr[msg_idx];
+			continue;
+		}
+
+		com_signal_t *signals_ptr = &m_filler_signals[msg_idx - COM_TOTAL_MESSAGE_ID][0];
+
+		for(uint8_t signal_idx = 0U; signal_idx < BENCHMARK_SIGNALS_PER_FILLER_MESSAGE; signal_idx++)
+		{
+			signals_ptr[signal_idx] = (com_signal_t)
+			{
+				.signal_id = filler_signal_id++,
+				.signal_base_info =
+				{
+					.com_bit_position = 8U * signal_idx,
+					.com_bit_size = 8U,
+					.com_signal_endianness = COM_SIGNAL_ENDIANNESS_LITTLE_ENDIAN_e,
+					.com_signal_variable_type = COM_SIGNAL_VARIABLE_UINT8_e,
+				},
+			};
+		}
+
+		m_scaled_com_messages[msg_idx] = (com_message_t)
+		{
+			.message_id = msg_idx,
+			.message_data_length = 8U,
+			.total_signal_cnt_in_message = BENCHMARK_SIGNALS_PER_FILLER_MESSAGE,
+			.transmission_bus_of_message = MESSAGE_BUS_CANBUS_e,
+			.periodic_send_info = &m_com_periodic_voltage_current_system_info_message,
+			.signals_ptr = signals_ptr,
+		};
+	}
+}
@@ -0,0 +1,35 @@
+/**
+ * @file com_driver_cfg.h
+ * @brief Scaled communication configuration of the benchmark builds.
+ *
+ * Keeps every message and signal of the product configuration and appends
+ * filler messages up to BENCHMARK_MESSAGE_CNT. Every filler message carries
+ * BENCHMARK_SIGNALS_PER_FILLER_MESSAGE signals of 8 bits.
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef BENCHMARK_COM_DRIVER_CFG_H_
+#define BENCHMARK_COM_DRIVER_CFG_H_
+
+#include "com_driver_cfg/com_driver_cfg.h"
+
+#ifndef BENCHMARK_MESSAGE_CNT
+#define BENCHMARK_MESSAGE_CNT				COM_TOTAL_MESSAGE_ID
+#endif
+
+#define BENCHMARK_SIGNALS_PER_FILLER_MESSAGE	8U
+
+#if (BENCHMARK_MESSAGE_CNT < COM_TOTAL_MESSAGE_ID) || (BENCHMARK_MESSAGE_CNT > 255)
+#error "BENCHMARK_MESSAGE_CNT must keep the product messages and fit the uint8_t message loops"
+#endif
+
+#undef COM_MESSAGE_CNT
+#undef COM_SIGNAL_CNT
+
+#define COM_MESSAGE_CNT						BENCHMARK_MESSAGE_CNT
+#define COM_SIGNAL_CNT						(COM_TOTAL_SIGNAL_ID + \
+											 ((BENCHMARK_MESSAGE_CNT - COM_TOTAL_MESSAGE_ID) * \
+											  BENCHMARK_SIGNALS_PER_FILLER_MESSAGE))
+
+#endif /* BENCHMARK_COM_DRIVER_CFG_H_ */
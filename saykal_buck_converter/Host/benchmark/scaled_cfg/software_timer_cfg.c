@@ -0,0 +1,47 @@
+/**
+ * @file software_timer_cfg.c
+ * @brief Scaled software timer configuration of the benchmark builds.
+ *
+ * @date Oct 17, 2026
+ */
+
+#define g_software_timer_general_config m_product_software_timer_general_config
+#include "software_timer_cfg/software_timer_cfg.c"
+#undef g_software_timer_general_config
+
+#define PRODUCT_SOFTWARE_TIMER_CNT \
+	(sizeof(m_software_timers_configs) / sizeof(m_software_timers_configs[0]))
+
+static software_timer_cfg_t m_scaled_software_timers_configs[SOFTWARE_TIMER_CNT];
+
+const software_timer_general_cfg_t g_software_timer_general_config =
+{
+	.get_timer_tick_ms_func = HAL_GetTick,
+	.software_timer_cfg_ptr = m_scaled_software_timers_configs,
+	.get_cycle_cnt_func = get_bsp_cycle_count,
+	.get_cycle_frequency_hz_func = get_bsp_cycle_counter_frequency_hz,
+};
+
+static void idle_timer_timeout_cb(software_timer_id_t sw_timer_id)
+{
+	(void)sw_timer_id;
+}
+
+/**
+ * @brief Fills the scaled timer table before main() runs.
+ */
+__attribute__((constructor)) static void build_scaled_software_timers(void)
+{
+	for(uint8_t timer_idx = 0U; timer_idx < SOFTWARE_TIMER_CNT; timer_idx++)
+	{
+		if(timer_idx < PRODUCT_SOFTWARE_TIMER_CNT)
+		{
+			m_scaled_software_timers_configs[timer_idx] = m_software_timers_configs[timer_idx];
+		}
+		else
+		{
+			m_scaled_software_timers_configs[timer_idx].reload_option = TIMER_RELOAD_PERIODIC_e;
+			m_scaled_software_timers_configs[timer_idx].timeout_callback_func = idle_timer_timeout_cb;
+		}
+	}
+}
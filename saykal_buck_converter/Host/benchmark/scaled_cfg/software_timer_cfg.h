@@ -0,0 +1,27 @@
+/**
+ * @file software_timer_cfg.h
+ * @brief Scaled software timer configuration of the benchmark builds.
+ *
+ * Keeps the product timers and appends idle periodic timers up to
+ * BENCHMARK_TIMER_CNT.
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef BENCHMARK_SOFTWARE_TIMER_CFG_H_
+#define BENCHMARK_SOFTWARE_TIMER_CFG_H_
+
+#include "software_timer_cfg/software_timer_cfg.h"
+
+#ifdef BENCHMARK_TIMER_CNT
+
+#if (BENCHMARK_TIMER_CNT < SOFTWARE_TIMER_CNT) || (BENCHMARK_TIMER_CNT > 255)
+#error "BENCHMARK_TIMER_CNT must keep the product timers and fit software_timer_id_t"
+#endif
+
+#undef SOFTWARE_TIMER_CNT
+#define SOFTWARE_TIMER_CNT			BENCHMARK_TIMER_CNT
+
+#endif
+
+#endif /* BENCHMARK_SOFTWARE_TIMER_CFG_H_ */
@@ -0,0 +1,274 @@
+/**
+ * @file can_monitor_main.c
+ * @brief Measures the CAN traffic of the firmware on the virtual CAN bus.
+ *
+ * Runs the firmware closed loop against the plant simulator and records every
+ * frame completed on the virtual bus. For every CAN ID it prints the frame rate,
+ * the interval between frames and the latency from HAL_CAN_AddTxMessage() to
+ * the end of the frame on the wire, plus the bus load and the frames refused
+ * because all three TX mailboxes were pending.
+ *
+ * Usage: buck_can_monitor [options]
+ *   --duration-ms N   virtual time to simulate (default 10000)
+ *   --vcan IFACE      also forward every frame to a SocketCAN interface (e.g. vcan0)
+ *   --dump ID         print every frame of a CAN ID (hex), or "all"
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "getopt.h"
+#include "plant_simulator.h"
+#include "virtual_can_bus.h"
+#include "bsp_can.h"
+
+/** @brief Distinct CAN IDs tracked by the monitor. */
+#define CAN_MONITOR_ID_CNT		32U
+
+extern const bsp_can_cfg_t g_bsp_can_configurations;
+
+/**
+ * @brief Traffic statistics of one CAN ID.
+ */
+typedef struct
+{
+	uint32_t can_id;
+	uint64_t frame_cnt;
+	uint64_t bit_cnt;
+	uint64_t first_end_time_ns;
+	uint64_t last_end_time_ns;
+	uint64_t interval_min_ns;
+	uint64_t interval_max_ns;
+	uint64_t latency_min_ns;
+	uint64_t latency_max_ns;
+	uint64_t latency_sum_ns;
+
+}can_monitor_id_stats_t;
+
+/**
+ * @brief State of the monitor subscription.
+ */
+typedef struct
+{
+	can_monitor_id_stats_t id_stats[CAN_MONITOR_ID_CNT];
+	uint32_t id_cnt;
+	uint64_t untracked_frame_cnt;
+	uint32_t dump_can_id;
+	bool is_dump_enabled;
+
+}can_monitor_t;
+
+static void handle_can_frame(const virtual_can_frame_t *frame_ptr, void *context_ptr);
+
+static int find_com_message_id(uint32_t can_id);
+
+int main(int argc, char *argv[])
+{
+	static const struct option long_options[] =
+	{
+		{ "duration-ms", required_argument, NULL, 'd' },
+		{ "vcan",        required_argument, NULL, 'v' },
+		{ "dump",        required_argument, NULL, 'D' },
+		{ NULL, 0, NULL, 0 },
+	};
+
+	static can_monitor_t can_monitor;
+
+	uint32_t duration_ms = 10000U;
+	const char *vcan_name = NULL;
+	int option;
+
+	memset(&can_monitor, 0, sizeof(can_monitor));
+
+	while(-1 != (option = getopt_long(argc, argv, "", long_options, NULL)))
+	{
+		switch(option)
+		{
+			case 'd': duration_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'v': vcan_name = optarg; break;
+			case 'D':
+			{
+				can_monitor.is_dump_enabled = true;
+				can_monitor.dump_can_id = (0 == strcmp(optarg, "all")) ?
+					VIRTUAL_CAN_BUS_ANY_ID : (uint32_t)strtoul(optarg, NULL, 16);
+				break;
+			}
+			default:
+			{
+				fprintf(stderr, "usage: %s [--duration-ms N] [--vcan IFACE] [--dump ID|all]\n", argv[0]);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	plant_simulator_cfg_t plant_cfg;
+	get_default_plant_simulator_cfg(&plant_cfg);
+	init_plant_simulator(&plant_cfg);
+
+	subscribe_virtual_can_bus(VIRTUAL_CAN_BUS_ANY_ID, handle_can_frame, &can_monitor);
+
+	if(NULL != vcan_name)
+	{
+		if(true == attach_virtual_can_bus_socketcan(vcan_name))
+		{
+			fprintf(stderr, "forwarding frames to %s\n", vcan_name);
+		}
+		else
+		{
+			fprintf(stderr, "%s not available, frames stay on the virtual bus\n", vcan_name);
+		}
+	}
+
+	uint32_t simulated_ms = run_plant_simulator(duration_ms, NULL, NULL);
+	double simulated_s = (double)simulated_ms * 1e-3;
+
+	virtual_can_bus_stats_t bus_stats;
+	get_virtual_can_bus_stats(&bus_stats);
+
+	printf("simulated_ms=%u bit_time_ns=%u frames=%llu rejected=%llu bus_load_percent=%.3f\n",
+		   (unsigned)simulated_ms, (unsigned)get_virtual_can_bus_bit_time_ns(),
+		   (unsigned long long)bus_stats.transmitted_frame_cnt,
+		   (unsigned long long)bus_stats.rejected_frame_cnt,
+		   (simulated_ms > 0U) ? (100.0 * (double)bus_stats.busy_time_ns / ((double)simulated_ms * 1e6)) : 0.0);
+
+	if(NULL != vcan_name)
+	{
+		printf("socketcan_forwarded=%llu socketcan_dropped=%llu\n",
+			   (unsigned long long)bus_stats.socketcan_forwarded_cnt,
+			   (unsigned long long)bus_stats.socketcan_dropped_cnt);
+	}
+
+	printf("%-10s %-7s %8s %9s %8s %11s %11s %11s %10s %10s %10s\n",
+		   "can_id", "com_msg", "frames", "rate_hz", "bits", "ival_min_ms", "ival_mean_ms", "ival_max_ms",
+		   "lat_min_us", "lat_mean_us", "lat_max_us");
+
+	for(uint32_t id_idx = 0U; id_idx < can_monitor.id_cnt; id_idx++)
+	{
+		const can_monitor_id_stats_t *id_stats_ptr = &can_monitor.id_stats[id_idx];
+		uint64_t frame_cnt = id_stats_ptr->frame_cnt;
+		double interval_mean_ms = (frame_cnt > 1U) ?
+			((double)(id_stats_ptr->last_end_time_ns - id_stats_ptr->first_end_time_ns) * 1e-6 / (double)(frame_cnt - 1U)) : 0.0;
+		int com_message_id = find_com_message_id(id_stats_ptr->can_id);
+		char com_message_text[8];
+
+		snprintf(com_message_text, sizeof(com_message_text), (com_message_id >= 0) ? "%d" : "-", com_message_id);
+
+		printf("0x%08X %-7s %8llu %9.3f %8.1f %11.3f %11.3f %11.3f %10.3f %10.3f %10.3f\n",
+			   (unsigned)id_stats_ptr->can_id, com_message_text,
+			   (unsigned long long)frame_cnt,
+			   (simulated_s > 0.0) ? ((double)frame_cnt / simulated_s) : 0.0,
+			   (double)id_stats_ptr->bit_cnt / (double)frame_cnt,
+			   (frame_cnt > 1U) ? ((double)id_stats_ptr->interval_min_ns * 1e-6) : 0.0,
+			   interval_mean_ms,
+			   (frame_cnt > 1U) ? ((double)id_stats_ptr->interval_max_ns * 1e-6) : 0.0,
+			   (double)id_stats_ptr->latency_min_ns * 1e-3,
+			   (double)id_stats_ptr->latency_sum_ns * 1e-3 / (double)frame_cnt,
+			   (double)id_stats_ptr->latency_max_ns * 1e-3);
+	}
+
+	if(0U != can_monitor.untracked_frame_cnt)
+	{
+		printf("untracked_frames=%llu (more than %u CAN IDs)\n",
+			   (unsigned long long)can_monitor.untracked_frame_cnt, (unsigned)CAN_MONITOR_ID_CNT);
+	}
+
+	attach_virtual_can_bus_socketcan(NULL);
+
+	return EXIT_SUCCESS;
+}
+
+static void handle_can_frame(const virtual_can_frame_t *frame_ptr, void *context_ptr)
+{
+	can_monitor_t *can_monitor_ptr = (can_monitor_t *)context_ptr;
+
+	if((true == can_monitor_ptr->is_dump_enabled) &&
+	   ((VIRTUAL_CAN_BUS_ANY_ID == can_monitor_ptr->dump_can_id) || (frame_ptr->can_id == can_monitor_ptr->dump_can_id)))
+	{
+		printf("%12.6f 0x%08X [%u]", (double)frame_ptr->end_time_ns * 1e-9,
+			   (unsigned)frame_ptr->can_id, (unsigned)frame_ptr->dlc);
+
+		for(uint8_t byte_idx = 0U; byte_idx < frame_ptr->dlc; byte_idx++)
+		{
+			printf(" %02X", frame_ptr->data[byte_idx]);
+		}
+
+		printf("  mailbox=%u latency_us=%.3f\n", (unsigned)frame_ptr->mailbox_idx,
+			   (double)(frame_ptr->end_time_ns - frame_ptr->queued_time_ns) * 1e-3);
+	}
+
+	uint32_t id_idx = 0U;
+
+	while((id_idx < can_monitor_ptr->id_cnt) && (frame_ptr->can_id != can_monitor_ptr->id_stats[id_idx].can_id))
+	{
+		id_idx++;
+	}
+
+	if(id_idx == can_monitor_ptr->id_cnt)
+	{
+		if(CAN_MONITOR_ID_CNT == can_monitor_ptr->id_cnt)
+		{
+			can_monitor_ptr->untracked_frame_cnt++;
+			return;
+		}
+
+		can_monitor_ptr->id_cnt++;
+		can_monitor_ptr->id_stats[id_idx].can_id = frame_ptr->can_id;
+		can_monitor_ptr->id_stats[id_idx].interval_min_ns = UINT64_MAX;
+		can_monitor_ptr->id_stats[id_idx].latency_min_ns = UINT64_MAX;
+	}
+
+	can_monitor_id_stats_t *id_stats_ptr = &can_monitor_ptr->id_stats[id_idx];
+	uint64_t latency_ns = frame_ptr->end_time_ns - frame_ptr->queued_time_ns;
+
+	if(0U == id_stats_ptr->frame_cnt)
+	{
+		id_stats_ptr->first_end_time_ns = frame_ptr->end_time_ns;
+	}
+	else
+	{
+		uint64_t interval_ns = frame_ptr->end_time_ns - id_stats_ptr->last_end_time_ns;
+
+		if(interval_ns < id_stats_ptr->interval_min_ns)
+		{
+			id_stats_ptr->interval_min_ns = interval_ns;
+		}
+
+		if(interval_ns > id_stats_ptr->interval_max_ns)
+		{
+			id_stats_ptr->interval_max_ns = interval_ns;
+		}
+	}
+
+	if(latency_ns < id_stats_ptr->latency_min_ns)
+	{
+		id_stats_ptr->latency_min_ns = latency_ns;
+	}
+
+	if(latency_ns > id_stats_ptr->latency_max_ns)
+	{
+		id_stats_ptr->latency_max_ns = latency_ns;
+	}
+
+	id_stats_ptr->frame_cnt++;
+	id_stats_ptr->bit_cnt += frame_ptr->bit_cnt;
+	id_stats_ptr->latency_sum_ns += latency_ns;
+	id_stats_ptr->last_end_time_ns = frame_ptr->end_time_ns;
+}
+
+/**
+ * @brief Returns the communication driver message sent with a CAN ID, -1 if none.
+ */
+static int find_com_message_id(uint32_t can_id)
+{
+	for(uint32_t tx_message_idx = 0U; tx_message_idx < BSP_CAN_TX_MESSAGE; tx_message_idx++)
+	{
+		if(can_id == g_bsp_can_configurations.tx_messages_ptr[tx_message_idx].can_id)
+		{
+			return (int)g_bsp_can_configurations.tx_messages_ptr[tx_message_idx].message_id;
+		}
+	}
+
+	return -1;
+}
@@ -0,0 +1,469 @@
+/**
+ * @file fault_campaign.c
+ * @brief Fault scenarios of the protection campaign and their closed-loop execution.
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "fault_campaign.h"
+#include "host_hal.h"
+#include "virtual_can_bus.h"
+#include "system_manager.h"
+#include "error_manager.h"
+#include "software_timer.h"
+#include "adc_sensor_driver.h"
+#include "app_buck_converter.h"
+#include "bsp_adc.h"
+#include "bsp_pwm.h"
+#include "string.h"
+
+extern const buck_converter_cfg_t g_buck_converter_config;
+extern const bsp_pwm_config_t g_bsp_pwm_timer_configs[];
+
+/** @brief Upper end of the drawn temperature of a stuck LM35. */
+#define FAULT_CAMPAIGN_TEMPERATURE_MAX_C	100.0f
+
+/** @brief Upper end of the drawn input voltage of a stuck divider, its full scale. */
+#define FAULT_CAMPAIGN_INPUT_VOLTAGE_MAX_V	48.0f
+
+/** @brief Relative band around the watchdog trip level whose trip depends on the ADC rounding. */
+#define FAULT_CAMPAIGN_WATCHDOG_MARGIN		0.02f
+
+static const char *const m_fault_type_names[FAULT_TYPE_CNT] =
+{
+	"adc_failure",
+	"overcurrent_pulse",
+	"stuck_sensor",
+	"can_mailbox_full",
+	"tick_wrap",
+};
+
+/**
+ * @brief Returns the next value of a xorshift32 generator.
+ */
+static uint32_t get_next_random(uint32_t *random_state_ptr);
+
+/**
+ * @brief Returns a uniform integer in min_value .. max_value.
+ */
+static uint32_t get_random_in_range(uint32_t *random_state_ptr, uint32_t min_value, uint32_t max_value);
+
+/**
+ * @brief Returns a uniform float in min_value .. max_value.
+ */
+static float get_random_float(uint32_t *random_state_ptr, float min_value, float max_value);
+
+/**
+ * @brief Returns the value a sensor reports in the current plant state.
+ */
+static float get_plant_sensor_value(uint8_t sensor_id, const plant_simulator_cfg_t *plant_cfg_ptr);
+
+/**
+ * @brief Starts the fault of a scenario.
+ */
+static void apply_fault(const fault_scenario_t *scenario_ptr, float value);
+
+/**
+ * @brief Ends a fault with a limited duration.
+ */
+static void remove_fault(const fault_scenario_t *scenario_ptr);
+
+void get_default_fault_campaign_cfg(fault_campaign_cfg_t *campaign_cfg_ptr)
+{
+	uint32_t detection_time_ms = get_fault_campaign_detection_time_ms();
+
+	campaign_cfg_ptr->model = PLANT_MODEL_AVERAGED_e;
+	campaign_cfg_ptr->seed = 1U;
+	campaign_cfg_ptr->settle_ms = 1000U;
+	campaign_cfg_ptr->fault_phase_ms = 100U;
+	campaign_cfg_ptr->observe_ms = 500U;
+	campaign_cfg_ptr->pulse_width_max_ms = 2U * detection_time_ms;
+	campaign_cfg_ptr->window_max_ms = 500U;
+	campaign_cfg_ptr->over_current_factor_min = 1.05f;
+	campaign_cfg_ptr->over_current_factor_max = 2.0f;
+}
+
+void draw_fault_scenario(const fault_campaign_cfg_t *campaign_cfg_ptr, fault_type_e type,
+						 uint32_t scenario_idx, fault_scenario_t *scenario_ptr)
+{
+	/* seeded by (seed, type, index), a scenario does not depend on the other types drawn */
+	uint32_t random_state = (campaign_cfg_ptr->seed * 0x9E3779B9U) ^
+							(((uint32_t)type + 1U) * 0xC2B2AE35U) ^
+							(scenario_idx * 0x85EBCA6BU);
+	float i_out_max = g_buck_converter_config.i_out_max;
+
+	memset(scenario_ptr, 0, sizeof(*scenario_ptr));
+	scenario_ptr->type = type;
+	scenario_ptr->fault_start_ms = campaign_cfg_ptr->settle_ms +
+		get_random_in_range(&random_state, 0U, campaign_cfg_ptr->fault_phase_ms);
+	scenario_ptr->sensor_id = BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID;
+
+	switch(type)
+	{
+		case FAULT_ADC_FAILURE_e:
+		case FAULT_CAN_MAILBOX_FULL_e:
+		{
+			scenario_ptr->width_ms = get_random_in_range(&random_state, 1U, campaign_cfg_ptr->window_max_ms);
+			break;
+		}
+		case FAULT_OVERCURRENT_PULSE_e:
+		case FAULT_TICK_WRAP_e:
+		{
+			scenario_ptr->width_ms = get_random_in_range(&random_state, 1U, campaign_cfg_ptr->pulse_width_max_ms);
+			scenario_ptr->value = i_out_max * get_random_float(&random_state,
+															   campaign_cfg_ptr->over_current_factor_min,
+															   campaign_cfg_ptr->over_current_factor_max);
+			break;
+		}
+		case FAULT_STUCK_SENSOR_e:
+		{
+			scenario_ptr->sensor_id = (uint8_t)get_random_in_range(&random_state, 0U, TOTAL_ADC_SENSOR_ID - 1U);
+			scenario_ptr->is_value_held = (0U != (get_next_random(&random_state) & 1U));
+
+			float value_max = i_out_max * 2.0f;
+
+			if(BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID == scenario_ptr->sensor_id)
+			{
+				value_max = g_buck_converter_config.v_out_ref * 2.0f;
+			}
+			else if(TEMPERATURE_LM35_SENSOR_ID == scenario_ptr->sensor_id)
+			{
+				value_max = FAULT_CAMPAIGN_TEMPERATURE_MAX_C;
+			}
+			else if(BUCK_CONVERTOR_IN_VOLTAGE_RESISTOR_SENSOR_ID == scenario_ptr->sensor_id)
+			{
+				value_max = FAULT_CAMPAIGN_INPUT_VOLTAGE_MAX_V;
+			}
+
+			scenario_ptr->value = get_random_float(&random_state, 0.0f, value_max);
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
+
+	scenario_ptr->duration_ms = scenario_ptr->fault_start_ms + scenario_ptr->width_ms + campaign_cfg_ptr->observe_ms;
+
+	if(FAULT_TICK_WRAP_e == type)
+	{
+		/* the tick wraps between start-up and the end of the pulse, timers run across it */
+		uint32_t wrap_ms = get_random_in_range(&random_state, 1U, scenario_ptr->fault_start_ms + scenario_ptr->width_ms);
+
+		scenario_ptr->start_tick_ms = 0U - wrap_ms;
+	}
+}
+
+void run_fault_scenario(const fault_campaign_cfg_t *campaign_cfg_ptr,
+						const fault_scenario_t *scenario_ptr,
+						fault_outcome_t *outcome_ptr)
+{
+	plant_simulator_cfg_t plant_cfg;
+	virtual_can_bus_stats_t bus_stats;
+	uint64_t rejected_frame_cnt_at_fault = 0U;
+#if (0U != BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED)
+	uint64_t control_step_ns = (uint64_t)((double)get_fault_campaign_control_period_ms() * 1000000.0);
+	uint64_t control_step_carry_ns = 0U;
+#else
+	software_timer_exec_stats_t exec_stats;
+	uint32_t control_call_cnt = 0U;
+#endif
+	bool is_fault_active = false;
+	float fault_value = scenario_ptr->value;
+
+	memset(outcome_ptr, 0, sizeof(*outcome_ptr));
+	outcome_ptr->time_to_error_ms = FAULT_CAMPAIGN_NEVER;
+	outcome_ptr->time_to_trip_ms = FAULT_CAMPAIGN_NEVER;
+	outcome_ptr->time_to_pwm_off_ms = FAULT_CAMPAIGN_NEVER;
+
+	get_default_plant_simulator_cfg(&plant_cfg);
+	plant_cfg.model = campaign_cfg_ptr->model;
+
+	init_plant_simulator(&plant_cfg);
+	host_hal_set_tick(scenario_ptr->start_tick_ms);
+
+	for(uint32_t time_ms = 0U; time_ms < scenario_ptr->duration_ms; time_ms++)
+	{
+		if(time_ms == scenario_ptr->fault_start_ms)
+		{
+			if(true == scenario_ptr->is_value_held)
+			{
+				fault_value = get_plant_sensor_value(scenario_ptr->sensor_id, &plant_cfg);
+			}
+
+			get_virtual_can_bus_stats(&bus_stats);
+			rejected_frame_cnt_at_fault = bus_stats.rejected_frame_cnt;
+
+			apply_fault(scenario_ptr, fault_value);
+			is_fault_active = true;
+		}
+		else if((true == is_fault_active) && (0U != scenario_ptr->width_ms) &&
+				(time_ms == (scenario_ptr->fault_start_ms + scenario_ptr->width_ms)))
+		{
+			get_virtual_can_bus_stats(&bus_stats);
+			outcome_ptr->can_rejected_frame_cnt = (uint32_t)(bus_stats.rejected_frame_cnt - rejected_frame_cnt_at_fault);
+
+			remove_fault(scenario_ptr);
+			is_fault_active = false;
+		}
+
+		run_plant_simulator(1U, NULL, NULL);
+
+		bool is_over_current_reported = (true == is_fault_active) &&
+			((FAULT_OVERCURRENT_PULSE_e == scenario_ptr->type) || (FAULT_TICK_WRAP_e == scenario_ptr->type) ||
+			 ((FAULT_STUCK_SENSOR_e == scenario_ptr->type) &&
+			  (BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID == scenario_ptr->sensor_id) &&
+			  (fault_value > g_buck_converter_config.i_out_max)));
+
+#if (0U != BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED)
+		/* the interrupt runs the steps of a tick on its conversions of the current sensor */
+		control_step_carry_ns += 1000000U;
+
+		if((true == is_over_current_reported) && (0U != control_step_ns))
+		{
+			outcome_ptr->over_current_sample_cnt += (uint32_t)(control_step_carry_ns / control_step_ns);
+		}
+
+		control_step_carry_ns = (0U != control_step_ns) ? (control_step_carry_ns % control_step_ns) : 0U;
+#else
+		if(true == get_software_timer_exec_stats(BUCK_CONVERTER_PID_SOFTWARE_TIMER_ID, &exec_stats))
+		{
+			if((true == is_over_current_reported) && (exec_stats.call_cnt != control_call_cnt))
+			{
+				outcome_ptr->over_current_sample_cnt += exec_stats.call_cnt - control_call_cnt;
+			}
+
+			control_call_cnt = exec_stats.call_cnt;
+		}
+#endif
+
+		if(time_ms < scenario_ptr->fault_start_ms)
+		{
+			continue;
+		}
+
+		int32_t time_since_fault_ms = (int32_t)(time_ms + 1U - scenario_ptr->fault_start_ms);
+		plant_simulator_sample_t sample;
+
+		get_plant_simulator_sample(&sample);
+
+		if((FAULT_CAMPAIGN_NEVER == outcome_ptr->time_to_error_ms) && (0U != get_system_error_status()))
+		{
+			outcome_ptr->time_to_error_ms = time_since_fault_ms;
+		}
+
+		if((FAULT_CAMPAIGN_NEVER == outcome_ptr->time_to_trip_ms) && (true == get_system_overcurrent_error_status()))
+		{
+			outcome_ptr->time_to_trip_ms = time_since_fault_ms;
+		}
+
+		if((FAULT_CAMPAIGN_NEVER == outcome_ptr->time_to_pwm_off_ms) && (false == sample.is_pwm_running))
+		{
+			outcome_ptr->time_to_pwm_off_ms = time_since_fault_ms;
+		}
+
+		outcome_ptr->is_pwm_running = sample.is_pwm_running;
+	}
+
+	switch(scenario_ptr->type)
+	{
+		case FAULT_OVERCURRENT_PULSE_e:
+		case FAULT_TICK_WRAP_e:
+		case FAULT_STUCK_SENSOR_e:
+		{
+			if((FAULT_STUCK_SENSOR_e == scenario_ptr->type) &&
+			   (BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID != scenario_ptr->sensor_id))
+			{
+				/* a stuck voltage or temperature sensor may drive a real overcurrent */
+				outcome_ptr->expected_trip = FAULT_TRIP_UNDECIDED_e;
+				break;
+			}
+
+			/* the pulse is continuous, so the samples that saw it are consecutive */
+			outcome_ptr->expected_trip =
+				(outcome_ptr->over_current_sample_cnt >= g_buck_converter_config.over_current_occurence_time_min) ?
+				FAULT_TRIP_EXPECTED_e : FAULT_TRIP_NOT_EXPECTED_e;
+
+#if (0U != BSP_ADC_CURRENT_WATCHDOG_ENABLED)
+			/* a single conversion above the peak limit trips the watchdog, without the
+			   DMA scan the current channel is converted only when the control loop reads it */
+			if((FAULT_TRIP_NOT_EXPECTED_e == outcome_ptr->expected_trip) &&
+			   ((0U != BSP_ADC_DMA_SCAN_ENABLED) || (0U != outcome_ptr->over_current_sample_cnt)))
+			{
+				float trip_level = g_buck_converter_config.i_out_max * g_buck_converter_config.over_current_trip_factor;
+
+				if(fault_value > (trip_level * (1.0f + FAULT_CAMPAIGN_WATCHDOG_MARGIN)))
+				{
+					outcome_ptr->expected_trip = FAULT_TRIP_EXPECTED_e;
+				}
+				else if(fault_value > (trip_level * (1.0f - FAULT_CAMPAIGN_WATCHDOG_MARGIN)))
+				{
+					outcome_ptr->expected_trip = FAULT_TRIP_UNDECIDED_e;
+				}
+			}
+#endif
+			break;
+		}
+		default:
+		{
+			outcome_ptr->expected_trip = FAULT_TRIP_NOT_EXPECTED_e;
+			break;
+		}
+	}
+
+	if(true == is_fault_active)
+	{
+		get_virtual_can_bus_stats(&bus_stats);
+		outcome_ptr->can_rejected_frame_cnt = (uint32_t)(bus_stats.rejected_frame_cnt - rejected_frame_cnt_at_fault);
+	}
+
+	outcome_ptr->final_system_state = (uint8_t)get_system_state();
+	outcome_ptr->system_error_status = get_system_error_status();
+}
+
+float get_fault_campaign_control_period_ms(void)
+{
+#if (0U != BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED)
+	const bsp_pwm_config_t *pwm_cfg_ptr = &g_bsp_pwm_timer_configs[0];
+	uint32_t divider = (0U != g_buck_converter_config.control_interrupt_divider) ?
+					   g_buck_converter_config.control_interrupt_divider : 1U;
+
+	return (float)(((double)(pwm_cfg_ptr->pwm_timer_period + 1U) * (pwm_cfg_ptr->pwm_timer_prescalar + 1U) *
+					divider * 1000.0) / HAL_RCC_GetPCLK2Freq());
+#else
+	return (float)g_buck_converter_config.period_time_process_of_controller_ms;
+#endif
+}
+
+uint32_t get_fault_campaign_detection_time_ms(void)
+{
+	float detection_time_ms = get_fault_campaign_control_period_ms() *
+							  g_buck_converter_config.over_current_occurence_time_min;
+	uint32_t whole_ms = (uint32_t)detection_time_ms;
+
+	whole_ms += ((float)whole_ms < detection_time_ms) ? 1U : 0U;
+
+	return (0U != whole_ms) ? whole_ms : 1U;
+}
+
+const char *get_fault_type_name(fault_type_e type)
+{
+	return (type < FAULT_TYPE_CNT) ? m_fault_type_names[type] : "unknown";
+}
+
+fault_type_e get_fault_type_by_name(const char *name)
+{
+	for(uint32_t type = 0U; type < FAULT_TYPE_CNT; type++)
+	{
+		if(0 == strcmp(name, m_fault_type_names[type]))
+		{
+			return (fault_type_e)type;
+		}
+	}
+
+	return FAULT_TYPE_CNT;
+}
+
+const char *get_fault_system_state_name(uint8_t system_state)
+{
+	switch(system_state)
+	{
+		case SYSTEM_STATE_INIT_e:			return "init";
+		case SYSTEM_STATE_RUNNING_e:		return "running";
+		case SYSTEM_STATE_ERROR_e:			return "error";
+		case SYSTEM_STATE_SAFE_RUNNING_e:	return "safe_running";
+		case SYSTEM_STATE_IDLE_e:			return "idle";
+		default:							return "unknown";
+	}
+}
+
+static uint32_t get_next_random(uint32_t *random_state_ptr)
+{
+	do
+	{
+		*random_state_ptr ^= *random_state_ptr << 13;
+		*random_state_ptr ^= *random_state_ptr >> 17;
+		*random_state_ptr ^= *random_state_ptr << 5;
+	}while(0U == *random_state_ptr);
+
+	return *random_state_ptr;
+}
+
+static uint32_t get_random_in_range(uint32_t *random_state_ptr, uint32_t min_value, uint32_t max_value)
+{
+	if(max_value <= min_value)
+	{
+		return min_value;
+	}
+
+	return min_value + (uint32_t)(((uint64_t)get_next_random(random_state_ptr) *
+								   ((uint64_t)(max_value - min_value) + 1U)) >> 32U);
+}
+
+static float get_random_float(uint32_t *random_state_ptr, float min_value, float max_value)
+{
+	float uniform = (float)(get_next_random(random_state_ptr) >> 8) / 16777216.0f;
+
+	return min_value + ((max_value - min_value) * uniform);
+}
+
+static float get_plant_sensor_value(uint8_t sensor_id, const plant_simulator_cfg_t *plant_cfg_ptr)
+{
+	plant_simulator_sample_t sample;
+
+	get_plant_simulator_sample(&sample);
+
+	switch(sensor_id)
+	{
+		case BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID:		return sample.output_current_a;
+		case BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID:		return sample.output_voltage_v;
+		case BUCK_CONVERTOR_IN_VOLTAGE_RESISTOR_SENSOR_ID:		return sample.input_voltage_v;
+		case BUCK_CONVERTOR_IN_CURRENT_ACS724_SENSOR_ID:		return sample.input_current_a;
+		default:												return plant_cfg_ptr->ambient_temperature_c;
+	}
+}
+
+static void apply_fault(const fault_scenario_t *scenario_ptr, float value)
+{
+	switch(scenario_ptr->type)
+	{
+		case FAULT_ADC_FAILURE_e:
+		{
+			host_hal_set_adc_poll_status(HAL_ERROR);
+			break;
+		}
+		case FAULT_CAN_MAILBOX_FULL_e:
+		{
+			set_virtual_can_bus_blocked(true);
+			break;
+		}
+		default:
+		{
+			set_plant_sensor_override(scenario_ptr->sensor_id, value);
+			break;
+		}
+	}
+}
+
+static void remove_fault(const fault_scenario_t *scenario_ptr)
+{
+	switch(scenario_ptr->type)
+	{
+		case FAULT_ADC_FAILURE_e:
+		{
+			host_hal_set_adc_poll_status(HAL_OK);
+			break;
+		}
+		case FAULT_CAN_MAILBOX_FULL_e:
+		{
+			set_virtual_can_bus_blocked(false);
+			break;
+		}
+		default:
+		{
+			clear_plant_sensor_override(scenario_ptr->sensor_id);
+			break;
+		}
+	}
+}
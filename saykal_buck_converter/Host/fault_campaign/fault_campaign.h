@@ -0,0 +1,180 @@
+/**
+ * @file fault_campaign.h
+ * @brief Fault scenarios of the protection campaign and their closed-loop execution.
+ *
+ * A scenario injects one fault into the firmware running against the plant
+ * simulator after it settled:
+ *
+ * - ADC failure: every HAL_ADC_PollForConversion() fails for a window, the
+ *   sensor reads return BSP_ADC_STATE_ERROR_e
+ * - overcurrent pulse: the output current sensor reports a current above
+ *   i_out_max for a window whose width is drawn around
+ *   over_current_occurence_time_min control periods, the interrupt steps with
+ *   BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED
+ * - stuck sensor: one sensor keeps its value at the fault time, or a drawn
+ *   value, until the end of the run
+ * - CAN mailboxes full: the virtual CAN bus acknowledges nothing for a window,
+ *   so all three TX mailboxes stay pending and HAL_CAN_AddTxMessage() fails
+ * - tick wraparound: an overcurrent pulse as above, with the tick started
+ *   shortly before 0xFFFFFFFF so it wraps between start-up and the end of the
+ *   pulse
+ *
+ * The run records when the overcurrent protection tripped and when the PWM
+ * stopped relative to the fault, the final system state and error status, and
+ * how many control loop samples saw the overcurrent, which together with the
+ * ADC watchdog peak limit decides whether a trip is expected.
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef FAULT_CAMPAIGN_H_
+#define FAULT_CAMPAIGN_H_
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "plant_simulator.h"
+
+/** @brief Time value of an event that did not happen. */
+#define FAULT_CAMPAIGN_NEVER		(-1)
+
+/**
+ * @brief Kind of the injected fault.
+ */
+typedef enum
+{
+	FAULT_ADC_FAILURE_e = 0,			///< ADC conversions fail for width_ms
+	FAULT_OVERCURRENT_PULSE_e,			///< Current sensor reports value for width_ms
+	FAULT_STUCK_SENSOR_e,				///< Sensor sensor_id reports value until the end
+	FAULT_CAN_MAILBOX_FULL_e,			///< Bus acknowledges no frame for width_ms
+	FAULT_TICK_WRAP_e,					///< Overcurrent pulse across the tick wraparound
+	FAULT_TYPE_CNT,
+
+}fault_type_e;
+
+/**
+ * @brief Expected protection response of a scenario.
+ */
+typedef enum
+{
+	FAULT_TRIP_NOT_EXPECTED_e = 0,		///< The overcurrent protection must not trip
+	FAULT_TRIP_EXPECTED_e,				///< The overcurrent protection must trip
+	FAULT_TRIP_UNDECIDED_e,				///< Depends on the plant reaction, not judged
+
+}fault_trip_expectation_e;
+
+/**
+ * @brief Ranges the scenarios are drawn from.
+ */
+typedef struct
+{
+	plant_model_e model;				///< Power stage model of every run
+	uint32_t seed;						///< Seed of the scenario draws
+	uint32_t settle_ms;					///< Earliest fault time, the converter regulates before
+	uint32_t fault_phase_ms;			///< Fault time is drawn in settle_ms .. settle_ms + fault_phase_ms
+	uint32_t observe_ms;				///< Time simulated after the fault ended
+	uint32_t pulse_width_max_ms;		///< Overcurrent pulses are 1 .. pulse_width_max_ms wide
+	uint32_t window_max_ms;				///< ADC and CAN faults are 1 .. window_max_ms long
+	float over_current_factor_min;		///< Pulse current is drawn as a factor of i_out_max
+	float over_current_factor_max;
+
+}fault_campaign_cfg_t;
+
+/**
+ * @brief One scenario.
+ */
+typedef struct
+{
+	fault_type_e type;
+	uint32_t fault_start_ms;			///< Virtual time since start-up when the fault starts
+	uint32_t width_ms;					///< Fault duration, 0 for a fault lasting until the end
+	uint32_t duration_ms;				///< Simulated time of the run
+	uint32_t start_tick_ms;				///< HAL_GetTick() at start-up
+	uint8_t sensor_id;					///< Affected sensor of a pulse or stuck sensor
+	bool is_value_held;					///< Stuck sensor keeps the value at the fault time
+	float value;						///< Reported sensor value, in the unit of the sensor
+
+}fault_scenario_t;
+
+/**
+ * @brief Outcome of one scenario.
+ */
+typedef struct
+{
+	int32_t time_to_error_ms;			///< Fault start to the first error bit, FAULT_CAMPAIGN_NEVER if none
+	int32_t time_to_trip_ms;			///< Fault start to the overcurrent error
+	int32_t time_to_pwm_off_ms;			///< Fault start to the stopped MOSFET PWM
+	uint32_t over_current_sample_cnt;	///< Control loop samples taken while the overcurrent was reported
+	uint32_t can_rejected_frame_cnt;	///< HAL_CAN_AddTxMessage() calls refused while the fault was active
+	uint8_t expected_trip;				///< fault_trip_expectation_e
+	uint8_t final_system_state;			///< system_state_e at the end of the run
+	uint8_t system_error_status;		///< get_system_error_status() at the end of the run
+	bool is_pwm_running;				///< MOSFET PWM enabled at the end of the run
+
+}fault_outcome_t;
+
+/**
+ * @brief Fills a configuration with the default campaign ranges.
+ *
+ * The pulse widths cover twice the overcurrent detection time of the product
+ * configuration, so both sides of the trip threshold are sampled.
+ *
+ * @param[out] campaign_cfg_ptr Configuration to fill.
+ */
+void get_default_fault_campaign_cfg(fault_campaign_cfg_t *campaign_cfg_ptr);
+
+/**
+ * @brief Draws a scenario, the same index and seed always give the same scenario.
+ *
+ * @param[in]  campaign_cfg_ptr Campaign ranges.
+ * @param[in]  type             Fault type.
+ * @param[in]  scenario_idx     Index of the scenario within its type.
+ * @param[out] scenario_ptr     Drawn scenario.
+ */
+void draw_fault_scenario(const fault_campaign_cfg_t *campaign_cfg_ptr, fault_type_e type,
+						 uint32_t scenario_idx, fault_scenario_t *scenario_ptr);
+
+/**
+ * @brief Runs the firmware from start-up through a scenario.
+ *
+ * Uses the firmware and the plant simulator of the calling process, which must
+ * not have run the firmware before; run every scenario in its own process.
+ *
+ * @param[in]  campaign_cfg_ptr Campaign ranges.
+ * @param[in]  scenario_ptr     Scenario to run.
+ * @param[out] outcome_ptr      Outcome of the run.
+ */
+void run_fault_scenario(const fault_campaign_cfg_t *campaign_cfg_ptr,
+						const fault_scenario_t *scenario_ptr,
+						fault_outcome_t *outcome_ptr);
+
+/**
+ * @brief Returns the step of the control loop, which runs the overcurrent monitor.
+ *
+ * The software timer period, or control_interrupt_divider switching periods
+ * with BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED.
+ *
+ * @return float Step in milliseconds.
+ */
+float get_fault_campaign_control_period_ms(void);
+
+/**
+ * @brief Returns the time the overcurrent monitor needs to trip, whole milliseconds.
+ */
+uint32_t get_fault_campaign_detection_time_ms(void);
+
+/**
+ * @brief Returns the name of a fault type.
+ */
+const char *get_fault_type_name(fault_type_e type);
+
+/**
+ * @brief Returns the fault type of a name, FAULT_TYPE_CNT if unknown.
+ */
+fault_type_e get_fault_type_by_name(const char *name);
+
+/**
+ * @brief Returns the name of a system state.
+ */
+const char *get_fault_system_state_name(uint8_t system_state);
+
+#endif /* FAULT_CAMPAIGN_H_ */
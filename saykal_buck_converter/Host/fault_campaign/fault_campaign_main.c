@@ -0,0 +1,525 @@
+/**
+ * @file fault_campaign_main.c
+ * @brief Parallel fault-injection campaign of the buck converter protection.
+ *
+ * Draws thousands of fault scenarios (fault_campaign.h) and runs every one of
+ * them from start-up in its own process forked from the pristine firmware
+ * state, spread over all cores by the work-stealing pool. For every fault type
+ * it prints the share of runs that tripped with a 95 % Wilson interval, the
+ * trip and PWM stop latency distribution, the final system states and error
+ * bits, and for the overcurrent pulses the trip probability per number of
+ * control samples that saw the pulse and per pulse width.
+ *
+ * A run is judged when the expected response is known: a pulse seen by at
+ * least over_current_occurence_time_min control samples must trip, so must a
+ * pulse above the ADC watchdog peak limit of i_out_max * over_current_trip_factor
+ * when BSP_ADC_CURRENT_WATCHDOG_ENABLED, a fault without overcurrent must not.
+ *
+ * Usage: buck_fault_campaign [options]
+ *   --runs N               scenarios per fault type (default 1000)
+ *   --type NAME            run only one fault type, e.g. overcurrent_pulse
+ *   --seed N               seed of the scenario draws (default 1)
+ *   --model M              averaged | switching (default averaged)
+ *   --pulse-width-max-ms N widest overcurrent pulse (default 2 x detection time)
+ *   --workers N            worker processes (default number of cores)
+ *   --csv PATH             write one row per run
+ *
+ * Exits 1 if a run missed an expected trip, tripped without overcurrent or crashed.
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "math.h"
+#include "getopt.h"
+#include "fault_campaign.h"
+#include "work_stealing_pool.h"
+#include "app_buck_converter.h"
+#include "error_manager.h"
+#include "system_manager.h"
+
+extern const buck_converter_cfg_t g_buck_converter_config;
+
+/** @brief Quantile of the standard normal distribution for a 95 % interval. */
+#define FAULT_CAMPAIGN_Z_95			1.959964
+
+/** @brief Number of system states reported. */
+#define FAULT_CAMPAIGN_STATE_CNT	(SYSTEM_STATE_IDLE_e + 1U)
+
+/** @brief Error bits of get_system_error_status() reported. */
+#define FAULT_CAMPAIGN_ERROR_BIT_CNT	4U
+
+/**
+ * @brief Scenarios of the campaign, shared with the jobs.
+ */
+typedef struct
+{
+	fault_campaign_cfg_t campaign_cfg;
+	fault_scenario_t *scenarios_ptr;
+
+}fault_campaign_context_t;
+
+static bool run_fault_campaign_job(uint32_t job_idx, void *result_ptr, void *context_ptr);
+
+static void print_fault_type_summary(fault_type_e type, const fault_scenario_t *scenarios_ptr,
+									 const fault_outcome_t *outcomes_ptr, const uint8_t *job_states_ptr,
+									 uint32_t job_cnt, uint32_t *failed_run_cnt_ptr);
+
+static void print_latency_distribution(const char *type_name, const char *name, int32_t *latencies_ptr,
+									   uint32_t latency_cnt);
+
+static void print_trip_rate(const char *prefix, uint32_t run_cnt, uint32_t trip_cnt);
+
+static void write_campaign_csv(FILE *file_ptr, const fault_scenario_t *scenarios_ptr,
+							   const fault_outcome_t *outcomes_ptr, const uint8_t *job_states_ptr,
+							   uint32_t job_cnt);
+
+static bool is_outcome_failed(const fault_outcome_t *outcome_ptr);
+
+static int compare_latencies(const void *left_ptr, const void *right_ptr);
+
+int main(int argc, char *argv[])
+{
+	static const struct option long_options[] =
+	{
+		{ "runs",               required_argument, NULL, 'r' },
+		{ "type",               required_argument, NULL, 't' },
+		{ "seed",               required_argument, NULL, 's' },
+		{ "model",              required_argument, NULL, 'm' },
+		{ "pulse-width-max-ms", required_argument, NULL, 'p' },
+		{ "workers",            required_argument, NULL, 'w' },
+		{ "csv",                required_argument, NULL, 'c' },
+		{ NULL, 0, NULL, 0 },
+	};
+
+	fault_campaign_context_t campaign_context;
+	uint32_t runs_per_type = 1000U;
+	uint32_t worker_cnt = 0U;
+	fault_type_e only_type = FAULT_TYPE_CNT;
+	const char *csv_path = NULL;
+	int option;
+
+	get_default_fault_campaign_cfg(&campaign_context.campaign_cfg);
+
+	while(-1 != (option = getopt_long(argc, argv, "", long_options, NULL)))
+	{
+		switch(option)
+		{
+			case 'r': runs_per_type = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 't':
+			{
+				only_type = get_fault_type_by_name(optarg);
+
+				if(FAULT_TYPE_CNT == only_type)
+				{
+					fprintf(stderr, "unknown fault type %s\n", optarg);
+					return EXIT_FAILURE;
+				}
+				break;
+			}
+			case 's': campaign_context.campaign_cfg.seed = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'm':
+			{
+				campaign_context.campaign_cfg.model = (0 == strcmp(optarg, "switching")) ?
+					PLANT_MODEL_SWITCHING_e : PLANT_MODEL_AVERAGED_e;
+				break;
+			}
+			case 'p': campaign_context.campaign_cfg.pulse_width_max_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'w': worker_cnt = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'c': csv_path = optarg; break;
+			default:
+			{
+				fprintf(stderr, "usage: %s [--runs N] [--type NAME] [--seed N] [--model M] "
+						"[--pulse-width-max-ms N] [--workers N] [--csv PATH]\n", argv[0]);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	uint32_t type_cnt = (FAULT_TYPE_CNT == only_type) ? (uint32_t)FAULT_TYPE_CNT : 1U;
+	uint32_t job_cnt = runs_per_type * type_cnt;
+
+	if(0U == job_cnt)
+	{
+		fprintf(stderr, "no runs\n");
+		return EXIT_FAILURE;
+	}
+
+	campaign_context.scenarios_ptr = calloc(job_cnt, sizeof(fault_scenario_t));
+	fault_outcome_t *outcomes_ptr = calloc(job_cnt, sizeof(fault_outcome_t));
+	uint8_t *job_states_ptr = calloc(job_cnt, sizeof(uint8_t));
+
+	if((NULL == campaign_context.scenarios_ptr) || (NULL == outcomes_ptr) || (NULL == job_states_ptr))
+	{
+		fprintf(stderr, "out of memory\n");
+		return EXIT_FAILURE;
+	}
+
+	for(uint32_t job_idx = 0U; job_idx < job_cnt; job_idx++)
+	{
+		fault_type_e type = (FAULT_TYPE_CNT == only_type) ? (fault_type_e)(job_idx / runs_per_type) : only_type;
+
+		draw_fault_scenario(&campaign_context.campaign_cfg, type, job_idx % runs_per_type,
+							&campaign_context.scenarios_ptr[job_idx]);
+	}
+
+	work_stealing_pool_cfg_t pool_cfg =
+	{
+		.job_cnt = job_cnt,
+		.worker_cnt = worker_cnt,
+		.result_size = sizeof(fault_outcome_t),
+		.is_job_isolated = true,
+		.is_progress_reported = true,
+		.job_func = run_fault_campaign_job,
+		.context_ptr = &campaign_context,
+	};
+
+	work_stealing_pool_results_t pool_results;
+
+	if(false == run_work_stealing_pool(&pool_cfg, &pool_results))
+	{
+		fprintf(stderr, "work-stealing pool failed\n");
+		return EXIT_FAILURE;
+	}
+
+	for(uint32_t job_idx = 0U; job_idx < job_cnt; job_idx++)
+	{
+		outcomes_ptr[job_idx] = *(fault_outcome_t *)get_work_stealing_job_result(&pool_results, &pool_cfg, job_idx);
+		job_states_ptr[job_idx] = pool_results.job_states_ptr[job_idx];
+	}
+
+	release_work_stealing_pool_results(&pool_results);
+
+	printf("runs=%u over_current_limit_a=%.3f detection_samples=%u control_period_ms=%g seed=%u\n",
+		   (unsigned)job_cnt, (double)g_buck_converter_config.i_out_max,
+		   (unsigned)g_buck_converter_config.over_current_occurence_time_min,
+		   (double)get_fault_campaign_control_period_ms(),
+		   (unsigned)campaign_context.campaign_cfg.seed);
+
+	uint32_t failed_run_cnt = 0U;
+
+	for(uint32_t type = 0U; type < FAULT_TYPE_CNT; type++)
+	{
+		if((FAULT_TYPE_CNT == only_type) || (type == (uint32_t)only_type))
+		{
+			print_fault_type_summary((fault_type_e)type, campaign_context.scenarios_ptr, outcomes_ptr,
+									 job_states_ptr, job_cnt, &failed_run_cnt);
+		}
+	}
+
+	printf("failed_runs=%u\n", (unsigned)failed_run_cnt);
+
+	if(NULL != csv_path)
+	{
+		FILE *csv_file_ptr = fopen(csv_path, "w");
+
+		if(NULL == csv_file_ptr)
+		{
+			perror(csv_path);
+			return EXIT_FAILURE;
+		}
+
+		write_campaign_csv(csv_file_ptr, campaign_context.scenarios_ptr, outcomes_ptr, job_states_ptr, job_cnt);
+		fclose(csv_file_ptr);
+	}
+
+	free(campaign_context.scenarios_ptr);
+	free(outcomes_ptr);
+	free(job_states_ptr);
+
+	return (0U == failed_run_cnt) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static bool run_fault_campaign_job(uint32_t job_idx, void *result_ptr, void *context_ptr)
+{
+	const fault_campaign_context_t *campaign_context_ptr = (const fault_campaign_context_t *)context_ptr;
+
+	run_fault_scenario(&campaign_context_ptr->campaign_cfg, &campaign_context_ptr->scenarios_ptr[job_idx],
+					   (fault_outcome_t *)result_ptr);
+
+	return true;
+}
+
+/**
+ * @brief Prints the statistics of all runs of one fault type.
+ */
+static void print_fault_type_summary(fault_type_e type, const fault_scenario_t *scenarios_ptr,
+									 const fault_outcome_t *outcomes_ptr, const uint8_t *job_states_ptr,
+									 uint32_t job_cnt, uint32_t *failed_run_cnt_ptr)
+{
+	const char *type_name = get_fault_type_name(type);
+	uint32_t detection_samples = g_buck_converter_config.over_current_occurence_time_min;
+	uint32_t detection_time_ms = get_fault_campaign_detection_time_ms();
+	/* width bins of one control period, at least one millisecond */
+	uint32_t width_bin_ms = (uint32_t)get_fault_campaign_control_period_ms();
+	uint32_t sample_bin_cnt = (2U * detection_samples) + 2U;
+	uint32_t run_cnt = 0U;
+	uint32_t crashed_cnt = 0U;
+	uint32_t trip_cnt = 0U;
+	uint32_t expected_trip_cnt = 0U;
+	uint32_t missed_trip_cnt = 0U;
+	uint32_t spurious_trip_cnt = 0U;
+	uint32_t undecided_cnt = 0U;
+	uint32_t can_rejected_cnt = 0U;
+	uint32_t latency_cnt = 0U;
+	uint32_t pwm_latency_cnt = 0U;
+	uint32_t error_latency_cnt = 0U;
+	uint32_t state_cnts[FAULT_CAMPAIGN_STATE_CNT] = { 0U };
+	uint32_t error_bit_cnts[FAULT_CAMPAIGN_ERROR_BIT_CNT] = { 0U };
+	uint32_t *sample_run_cnts = calloc(sample_bin_cnt, sizeof(uint32_t));
+	uint32_t *sample_trip_cnts = calloc(sample_bin_cnt, sizeof(uint32_t));
+	int32_t *latencies_ptr = calloc(job_cnt, sizeof(int32_t));
+	int32_t *pwm_latencies_ptr = calloc(job_cnt, sizeof(int32_t));
+	int32_t *error_latencies_ptr = calloc(job_cnt, sizeof(int32_t));
+
+	if((NULL == sample_run_cnts) || (NULL == sample_trip_cnts) || (NULL == latencies_ptr) ||
+	   (NULL == pwm_latencies_ptr) || (NULL == error_latencies_ptr))
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for(uint32_t job_idx = 0U; job_idx < job_cnt; job_idx++)
+	{
+		if(type != scenarios_ptr[job_idx].type)
+		{
+			continue;
+		}
+
+		run_cnt++;
+
+		if(WORK_STEALING_JOB_OK_e != job_states_ptr[job_idx])
+		{
+			crashed_cnt++;
+			continue;
+		}
+
+		const fault_outcome_t *outcome_ptr = &outcomes_ptr[job_idx];
+		bool is_tripped = (FAULT_CAMPAIGN_NEVER != outcome_ptr->time_to_trip_ms);
+
+		trip_cnt += (true == is_tripped) ? 1U : 0U;
+		can_rejected_cnt += (0U != outcome_ptr->can_rejected_frame_cnt) ? 1U : 0U;
+
+		if(FAULT_TRIP_EXPECTED_e == outcome_ptr->expected_trip)
+		{
+			expected_trip_cnt++;
+			missed_trip_cnt += (false == is_tripped) ? 1U : 0U;
+		}
+		else if(FAULT_TRIP_NOT_EXPECTED_e == outcome_ptr->expected_trip)
+		{
+			spurious_trip_cnt += (true == is_tripped) ? 1U : 0U;
+		}
+		else
+		{
+			undecided_cnt++;
+		}
+
+		if(true == is_tripped)
+		{
+			latencies_ptr[latency_cnt++] = outcome_ptr->time_to_trip_ms;
+		}
+
+		if(FAULT_CAMPAIGN_NEVER != outcome_ptr->time_to_pwm_off_ms)
+		{
+			pwm_latencies_ptr[pwm_latency_cnt++] = outcome_ptr->time_to_pwm_off_ms;
+		}
+
+		if(FAULT_CAMPAIGN_NEVER != outcome_ptr->time_to_error_ms)
+		{
+			error_latencies_ptr[error_latency_cnt++] = outcome_ptr->time_to_error_ms;
+		}
+
+		if(outcome_ptr->final_system_state < FAULT_CAMPAIGN_STATE_CNT)
+		{
+			state_cnts[outcome_ptr->final_system_state]++;
+		}
+
+		for(uint32_t bit_idx = 0U; bit_idx < FAULT_CAMPAIGN_ERROR_BIT_CNT; bit_idx++)
+		{
+			error_bit_cnts[bit_idx] += (0U != (outcome_ptr->system_error_status & (1U << bit_idx))) ? 1U : 0U;
+		}
+
+		uint32_t sample_bin = (outcome_ptr->over_current_sample_cnt < sample_bin_cnt) ?
+			outcome_ptr->over_current_sample_cnt : (sample_bin_cnt - 1U);
+
+		sample_run_cnts[sample_bin]++;
+		sample_trip_cnts[sample_bin] += (true == is_tripped) ? 1U : 0U;
+	}
+
+	*failed_run_cnt_ptr += crashed_cnt + missed_trip_cnt + spurious_trip_cnt;
+
+	printf("type=%s runs=%u crashed=%u trips=%u expected_trips=%u missed_trips=%u spurious_trips=%u "
+		   "undecided=%u can_rejected_runs=%u\n",
+		   type_name, (unsigned)run_cnt, (unsigned)crashed_cnt, (unsigned)trip_cnt, (unsigned)expected_trip_cnt,
+		   (unsigned)missed_trip_cnt, (unsigned)spurious_trip_cnt, (unsigned)undecided_cnt,
+		   (unsigned)can_rejected_cnt);
+
+	char prefix[64];
+
+	snprintf(prefix, sizeof(prefix), "type=%s", type_name);
+	print_trip_rate(prefix, run_cnt - crashed_cnt, trip_cnt);
+
+	print_latency_distribution(type_name, "trip_latency", latencies_ptr, latency_cnt);
+	print_latency_distribution(type_name, "pwm_off_latency", pwm_latencies_ptr, pwm_latency_cnt);
+	print_latency_distribution(type_name, "error_latency", error_latencies_ptr, error_latency_cnt);
+
+	printf("type=%s final_state", type_name);
+
+	for(uint32_t state = 0U; state < FAULT_CAMPAIGN_STATE_CNT; state++)
+	{
+		printf(" %s=%u", get_fault_system_state_name((uint8_t)state), (unsigned)state_cnts[state]);
+	}
+
+	printf("\ntype=%s error_bits sensor=%u development=%u overcurrent=%u initialize=%u\n", type_name,
+		   (unsigned)error_bit_cnts[ERROR_TYPE_SENSOR], (unsigned)error_bit_cnts[ERROR_TYPE_DEVELOPMENT],
+		   (unsigned)error_bit_cnts[ERROR_TYPE_OVERCURRENT], (unsigned)error_bit_cnts[ERROR_TYPE_INITIALIZE]);
+
+	if((FAULT_OVERCURRENT_PULSE_e == type) || (FAULT_TICK_WRAP_e == type))
+	{
+		for(uint32_t sample_bin = 0U; sample_bin < sample_bin_cnt; sample_bin++)
+		{
+			if(0U != sample_run_cnts[sample_bin])
+			{
+				snprintf(prefix, sizeof(prefix), "type=%s samples%s=%u", type_name,
+						 ((sample_bin_cnt - 1U) == sample_bin) ? ">" : "",
+						 (unsigned)(((sample_bin_cnt - 1U) == sample_bin) ? (sample_bin - 1U) : sample_bin));
+				print_trip_rate(prefix, sample_run_cnts[sample_bin], sample_trip_cnts[sample_bin]);
+			}
+		}
+
+		/* the width decides the sample count only together with the phase to the control loop */
+		width_bin_ms = (0U != width_bin_ms) ? width_bin_ms : 1U;
+
+		for(uint32_t width_from_ms = 0U; width_from_ms < (2U * detection_time_ms);
+			width_from_ms += width_bin_ms)
+		{
+			uint32_t width_run_cnt = 0U;
+			uint32_t width_trip_cnt = 0U;
+
+			for(uint32_t job_idx = 0U; job_idx < job_cnt; job_idx++)
+			{
+				if((type == scenarios_ptr[job_idx].type) && (WORK_STEALING_JOB_OK_e == job_states_ptr[job_idx]) &&
+				   (scenarios_ptr[job_idx].width_ms >= width_from_ms) &&
+				   (scenarios_ptr[job_idx].width_ms < (width_from_ms + width_bin_ms)))
+				{
+					width_run_cnt++;
+					width_trip_cnt += (FAULT_CAMPAIGN_NEVER != outcomes_ptr[job_idx].time_to_trip_ms) ? 1U : 0U;
+				}
+			}
+
+			if(0U != width_run_cnt)
+			{
+				snprintf(prefix, sizeof(prefix), "type=%s width_ms=%u..%u", type_name,
+						 (unsigned)width_from_ms, (unsigned)(width_from_ms + width_bin_ms - 1U));
+				print_trip_rate(prefix, width_run_cnt, width_trip_cnt);
+			}
+		}
+	}
+
+	free(sample_run_cnts);
+	free(sample_trip_cnts);
+	free(latencies_ptr);
+	free(pwm_latencies_ptr);
+	free(error_latencies_ptr);
+}
+
+/**
+ * @brief Prints min, mean with its 95 % interval, nearest-rank percentiles and max of a latency.
+ */
+static void print_latency_distribution(const char *type_name, const char *name, int32_t *latencies_ptr,
+									   uint32_t latency_cnt)
+{
+	if(0U == latency_cnt)
+	{
+		printf("type=%s %s_ms samples=0\n", type_name, name);
+		return;
+	}
+
+	qsort(latencies_ptr, latency_cnt, sizeof(int32_t), compare_latencies);
+
+	double sum = 0.0;
+	double square_sum = 0.0;
+
+	for(uint32_t latency_idx = 0U; latency_idx < latency_cnt; latency_idx++)
+	{
+		sum += (double)latencies_ptr[latency_idx];
+		square_sum += (double)latencies_ptr[latency_idx] * (double)latencies_ptr[latency_idx];
+	}
+
+	double mean = sum / (double)latency_cnt;
+	double variance = (latency_cnt > 1U) ?
+		fmax(0.0, (square_sum - (sum * mean)) / (double)(latency_cnt - 1U)) : 0.0;
+	double mean_half_width = FAULT_CAMPAIGN_Z_95 * sqrt(variance / (double)latency_cnt);
+	uint32_t p50_idx = (uint32_t)ceil(0.50 * (double)latency_cnt) - 1U;
+	uint32_t p99_idx = (uint32_t)ceil(0.99 * (double)latency_cnt) - 1U;
+
+	printf("type=%s %s_ms samples=%u min=%d mean=%.2f mean_ci95=%.2f..%.2f p50=%d p99=%d max=%d\n",
+		   type_name, name, (unsigned)latency_cnt, (int)latencies_ptr[0], mean,
+		   mean - mean_half_width, mean + mean_half_width,
+		   (int)latencies_ptr[p50_idx], (int)latencies_ptr[p99_idx], (int)latencies_ptr[latency_cnt - 1U]);
+}
+
+/**
+ * @brief Prints a trip rate with its 95 % Wilson score interval.
+ */
+static void print_trip_rate(const char *prefix, uint32_t run_cnt, uint32_t trip_cnt)
+{
+	double rate = (run_cnt > 0U) ? ((double)trip_cnt / (double)run_cnt) : 0.0;
+	double z_square_per_run = (run_cnt > 0U) ? ((FAULT_CAMPAIGN_Z_95 * FAULT_CAMPAIGN_Z_95) / (double)run_cnt) : 0.0;
+	double center = (rate + (z_square_per_run / 2.0)) / (1.0 + z_square_per_run);
+	double half_width = (run_cnt > 0U) ?
+		((FAULT_CAMPAIGN_Z_95 * sqrt(((rate * (1.0 - rate)) / (double)run_cnt) +
+									 (z_square_per_run / (4.0 * (double)run_cnt)))) / (1.0 + z_square_per_run)) : 0.0;
+
+	printf("%s runs=%u trips=%u trip_rate=%.4f trip_rate_ci95=%.4f..%.4f\n", prefix, (unsigned)run_cnt,
+		   (unsigned)trip_cnt, rate, fmax(0.0, center - half_width), fmin(1.0, center + half_width));
+}
+
+static void write_campaign_csv(FILE *file_ptr, const fault_scenario_t *scenarios_ptr,
+							   const fault_outcome_t *outcomes_ptr, const uint8_t *job_states_ptr,
+							   uint32_t job_cnt)
+{
+	fprintf(file_ptr, "run,type,fault_start_ms,width_ms,start_tick_ms,sensor_id,value_held,value,"
+			"over_current_samples,expected_trip,time_to_error_ms,time_to_trip_ms,time_to_pwm_off_ms,"
+			"final_state,error_status,pwm_running,can_rejected_frames,job_state,failed\n");
+
+	for(uint32_t job_idx = 0U; job_idx < job_cnt; job_idx++)
+	{
+		const fault_scenario_t *scenario_ptr = &scenarios_ptr[job_idx];
+		const fault_outcome_t *outcome_ptr = &outcomes_ptr[job_idx];
+		bool is_job_ok = (WORK_STEALING_JOB_OK_e == job_states_ptr[job_idx]);
+
+		fprintf(file_ptr, "%u,%s,%u,%u,%u,%u,%u,%.4f,%u,%u,%d,%d,%d,%s,%u,%u,%u,%u,%u\n",
+				(unsigned)job_idx, get_fault_type_name(scenario_ptr->type),
+				(unsigned)scenario_ptr->fault_start_ms, (unsigned)scenario_ptr->width_ms,
+				(unsigned)scenario_ptr->start_tick_ms, (unsigned)scenario_ptr->sensor_id,
+				(unsigned)scenario_ptr->is_value_held, (double)scenario_ptr->value,
+				(unsigned)outcome_ptr->over_current_sample_cnt, (unsigned)outcome_ptr->expected_trip,
+				(int)outcome_ptr->time_to_error_ms, (int)outcome_ptr->time_to_trip_ms,
+				(int)outcome_ptr->time_to_pwm_off_ms, get_fault_system_state_name(outcome_ptr->final_system_state),
+				(unsigned)outcome_ptr->system_error_status, (unsigned)outcome_ptr->is_pwm_running,
+				(unsigned)outcome_ptr->can_rejected_frame_cnt, (unsigned)job_states_ptr[job_idx],
+				(unsigned)((false == is_job_ok) || (true == is_outcome_failed(outcome_ptr))));
+	}
+}
+
+/**
+ * @brief Tells whether a run contradicts its expected protection response.
+ */
+static bool is_outcome_failed(const fault_outcome_t *outcome_ptr)
+{
+	bool is_tripped = (FAULT_CAMPAIGN_NEVER != outcome_ptr->time_to_trip_ms);
+
+	return ((FAULT_TRIP_EXPECTED_e == outcome_ptr->expected_trip) && (false == is_tripped)) ||
+		   ((FAULT_TRIP_NOT_EXPECTED_e == outcome_ptr->expected_trip) && (true == is_tripped));
+}
+
+static int compare_latencies(const void *left_ptr, const void *right_ptr)
+{
+	int32_t left = *(const int32_t *)left_ptr;
+	int32_t right = *(const int32_t *)right_ptr;
+
+	return (left > right) - (left < right);
+}
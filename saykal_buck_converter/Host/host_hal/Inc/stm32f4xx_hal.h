@@ -0,0 +1,699 @@
+/**
+ * @file stm32f4xx_hal.h
+ * @brief Host replacement of the STM32F4xx HAL interface.
+ *
+ * This header is only on the include path of the host build. It provides the
+ * subset of HAL types, constants and functions that the bsp layer and the
+ * project configurations use, so that every module above it compiles natively
+ * without any change. Peripheral instances (ADC1, DMA2_Stream0, TIM1, CAN1,
+ * GPIOx) point to plain RAM register blocks owned by host_hal.c instead of
+ * memory mapped hardware.
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef HOST_HAL_STM32F4XX_HAL_H_
+#define HOST_HAL_STM32F4XX_HAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* ------------------------------------------------------------------------- */
+/* Common definitions                                                        */
+/* ------------------------------------------------------------------------- */
+
+typedef enum
+{
+	HAL_OK       = 0x00U,
+	HAL_ERROR    = 0x01U,
+	HAL_BUSY     = 0x02U,
+	HAL_TIMEOUT  = 0x03U
+
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+	DISABLE = 0U,
+	ENABLE = !DISABLE
+
+} FunctionalState;
+
+#define HAL_MAX_DELAY      0xFFFFFFFFU
+
+HAL_StatusTypeDef HAL_Init(void);
+void HAL_IncTick(void);
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+
+/* ------------------------------------------------------------------------- */
+/* RCC / PWR / FLASH                                                         */
+/* ------------------------------------------------------------------------- */
+
+typedef struct
+{
+	uint32_t PLLState;
+	uint32_t PLLSource;
+	uint32_t PLLM;
+	uint32_t PLLN;
+	uint32_t PLLP;
+	uint32_t PLLQ;
+
+} RCC_PLLInitTypeDef;
+
+typedef struct
+{
+	uint32_t OscillatorType;
+	uint32_t HSEState;
+	uint32_t LSEState;
+	uint32_t HSIState;
+	uint32_t HSICalibrationValue;
+	uint32_t LSIState;
+	RCC_PLLInitTypeDef PLL;
+
+} RCC_OscInitTypeDef;
+
+typedef struct
+{
+	uint32_t ClockType;
+	uint32_t SYSCLKSource;
+	uint32_t AHBCLKDivider;
+	uint32_t APB1CLKDivider;
+	uint32_t APB2CLKDivider;
+
+} RCC_ClkInitTypeDef;
+
+#if !defined(HSE_VALUE)
+#define HSE_VALUE                       8000000U	/* external oscillator of the board, as in stm32f4xx_hal_conf.h */
+#endif
+
+#define RCC_OSCILLATORTYPE_HSE          0x00000001U
+#define RCC_HSE_ON                      0x00010000U
+#define RCC_PLL_NONE                    0x00000000U
+#define RCC_CLOCKTYPE_SYSCLK            0x00000001U
+#define RCC_CLOCKTYPE_HCLK              0x00000002U
+#define RCC_CLOCKTYPE_PCLK1             0x00000004U
+#define RCC_CLOCKTYPE_PCLK2             0x00000008U
+#define RCC_SYSCLKSOURCE_HSE            0x00000001U
+#define RCC_SYSCLK_DIV1                 0x00000000U
+#define RCC_HCLK_DIV1                   0x00000000U
+#define FLASH_LATENCY_0                 0x00000000U
+#define PWR_REGULATOR_VOLTAGE_SCALE1    0x0000C000U
+
+/* The host core clock is 1 GHz so that one DWT cycle is one nanosecond */
+extern uint32_t SystemCoreClock;
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency);
+uint32_t HAL_RCC_GetHCLKFreq(void);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+
+#define __HAL_RCC_PWR_CLK_ENABLE()              do { } while(0)
+#define __HAL_PWR_VOLTAGESCALING_CONFIG(__REG__) do { (void)(__REG__); } while(0)
+#define __HAL_RCC_GPIOA_CLK_ENABLE()            do { } while(0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE()            do { } while(0)
+#define __HAL_RCC_GPIOC_CLK_ENABLE()            do { } while(0)
+#define __HAL_RCC_GPIOH_CLK_ENABLE()            do { } while(0)
+#define __HAL_RCC_DMA2_CLK_ENABLE()             do { } while(0)
+
+/* ------------------------------------------------------------------------- */
+/* Cortex-M4 core debug: DWT cycle counter                                   */
+/* ------------------------------------------------------------------------- */
+
+typedef struct
+{
+	volatile uint32_t CTRL;
+	volatile uint32_t CYCCNT;
+
+} DWT_Type;
+
+typedef struct
+{
+	volatile uint32_t DEMCR;
+
+} CoreDebug_Type;
+
+#define CoreDebug_DEMCR_TRCENA_Msk      (1UL << 24U)
+#define DWT_CTRL_CYCCNTENA_Msk          (1UL << 0U)
+
+extern CoreDebug_Type g_host_hal_core_debug;
+
+/**
+ * Every access through DWT first advances CYCCNT by the CLOCK_MONOTONIC time
+ * elapsed since the previous access, as long as the counter is enabled.
+ */
+DWT_Type *host_hal_sync_dwt(void);
+
+#define DWT       (host_hal_sync_dwt())
+#define CoreDebug (&g_host_hal_core_debug)
+
+/* ------------------------------------------------------------------------- */
+/* Cortex-M4 core: memory barrier                                            */
+/* ------------------------------------------------------------------------- */
+
+#define __DMB()   __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/* ------------------------------------------------------------------------- */
+/* Cortex-M4 core: interrupt mask                                            */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * The host raises interrupts only from within HAL calls, never between two
+ * instructions of the firmware, so masking them has nothing to do.
+ */
+static inline uint32_t __get_PRIMASK(void) { return 0U; }
+static inline void __set_PRIMASK(uint32_t priMask) { (void)priMask; }
+static inline void __disable_irq(void) { }
+
+/**
+ * Exception number of the interrupt the host is running, 16 + IRQn, 0 outside
+ * of raised interrupts like the thread mode of the core.
+ */
+uint32_t __get_IPSR(void);
+
+/* ------------------------------------------------------------------------- */
+/* NVIC                                                                      */
+/* ------------------------------------------------------------------------- */
+
+typedef enum
+{
+	ADC_IRQn = 18,
+	DMA2_Stream0_IRQn = 56,
+
+} IRQn_Type;
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
+
+/* ------------------------------------------------------------------------- */
+/* GPIO                                                                      */
+/* ------------------------------------------------------------------------- */
+
+typedef struct
+{
+	volatile uint32_t MODER;
+	volatile uint32_t IDR;
+	volatile uint32_t ODR;
+
+} GPIO_TypeDef;
+
+typedef struct
+{
+	uint32_t Pin;
+	uint32_t Mode;
+	uint32_t Pull;
+	uint32_t Speed;
+	uint32_t Alternate;
+
+} GPIO_InitTypeDef;
+
+typedef enum
+{
+	GPIO_PIN_RESET = 0,
+	GPIO_PIN_SET
+
+} GPIO_PinState;
+
+extern GPIO_TypeDef g_host_hal_gpioa;
+extern GPIO_TypeDef g_host_hal_gpiob;
+extern GPIO_TypeDef g_host_hal_gpioc;
+extern GPIO_TypeDef g_host_hal_gpioh;
+
+#define GPIOA (&g_host_hal_gpioa)
+#define GPIOB (&g_host_hal_gpiob)
+#define GPIOC (&g_host_hal_gpioc)
+#define GPIOH (&g_host_hal_gpioh)
+
+#define GPIO_PIN_0                 ((uint16_t)0x0001)
+#define GPIO_PIN_1                 ((uint16_t)0x0002)
+#define GPIO_PIN_2                 ((uint16_t)0x0004)
+#define GPIO_PIN_3                 ((uint16_t)0x0008)
+#define GPIO_PIN_4                 ((uint16_t)0x0010)
+#define GPIO_PIN_5                 ((uint16_t)0x0020)
+#define GPIO_PIN_6                 ((uint16_t)0x0040)
+#define GPIO_PIN_7                 ((uint16_t)0x0080)
+#define GPIO_PIN_8                 ((uint16_t)0x0100)
+#define GPIO_PIN_9                 ((uint16_t)0x0200)
+#define GPIO_PIN_10                ((uint16_t)0x0400)
+#define GPIO_PIN_11                ((uint16_t)0x0800)
+#define GPIO_PIN_12                ((uint16_t)0x1000)
+#define GPIO_PIN_13                ((uint16_t)0x2000)
+#define GPIO_PIN_14                ((uint16_t)0x4000)
+#define GPIO_PIN_15                ((uint16_t)0x8000)
+
+#define GPIO_MODE_INPUT            0x00000000U
+#define GPIO_MODE_OUTPUT_PP        0x00000001U
+#define GPIO_MODE_AF_PP            0x00000002U
+#define GPIO_MODE_ANALOG           0x00000003U
+#define GPIO_NOPULL                0x00000000U
+#define GPIO_SPEED_FREQ_LOW        0x00000000U
+#define GPIO_SPEED_FREQ_VERY_HIGH  0x00000003U
+#define GPIO_AF9_CAN1              ((uint8_t)0x09)
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
+/* ------------------------------------------------------------------------- */
+/* DMA                                                                       */
+/* ------------------------------------------------------------------------- */
+
+typedef struct
+{
+	volatile uint32_t CR;
+	volatile uint32_t NDTR;
+	volatile uint32_t PAR;
+	volatile uint32_t M0AR;
+	volatile uint32_t M1AR;
+	volatile uint32_t FCR;
+
+} DMA_Stream_TypeDef;
+
+typedef struct
+{
+	uint32_t Channel;
+	uint32_t Direction;
+	uint32_t PeriphInc;
+	uint32_t MemInc;
+	uint32_t PeriphDataAlignment;
+	uint32_t MemDataAlignment;
+	uint32_t Mode;
+	uint32_t Priority;
+	uint32_t FIFOMode;
+	uint32_t FIFOThreshold;
+	uint32_t MemBurst;
+	uint32_t PeriphBurst;
+
+} DMA_InitTypeDef;
+
+typedef struct __DMA_HandleTypeDef
+{
+	DMA_Stream_TypeDef *Instance;
+	DMA_InitTypeDef Init;
+	void *Parent;
+	void (*XferCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+	void (*XferHalfCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+	volatile uint32_t State;
+	volatile uint32_t ErrorCode;
+
+} DMA_HandleTypeDef;
+
+extern DMA_Stream_TypeDef g_host_hal_dma2_stream0;
+
+#define DMA2_Stream0 (&g_host_hal_dma2_stream0)
+
+#define DMA_CHANNEL_0                   0x00000000U
+#define DMA_PERIPH_TO_MEMORY            0x00000000U
+#define DMA_PINC_DISABLE                0x00000000U
+#define DMA_MINC_ENABLE                 0x00000400U
+#define DMA_PDATAALIGN_HALFWORD         0x00000800U
+#define DMA_PDATAALIGN_WORD             0x00001000U
+#define DMA_MDATAALIGN_HALFWORD         0x00002000U
+#define DMA_MDATAALIGN_WORD             0x00004000U
+#define DMA_CIRCULAR                    0x00000100U
+#define DMA_PRIORITY_HIGH               0x00020000U
+#define DMA_FIFOMODE_DISABLE            0x00000000U
+#define DMA_SxCR_EN                     0x00000001U
+#define DMA_SxCR_HTIE                   0x00000008U
+#define DMA_SxCR_TCIE                   0x00000010U
+
+#define __HAL_LINKDMA(__HANDLE__, __PPP_DMA_FIELD__, __DMA_HANDLE__) \
+	do { (__HANDLE__)->__PPP_DMA_FIELD__ = &(__DMA_HANDLE__); (__DMA_HANDLE__).Parent = (__HANDLE__); } while(0)
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma);
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma);
+
+/* ------------------------------------------------------------------------- */
+/* ADC                                                                       */
+/* ------------------------------------------------------------------------- */
+
+typedef struct
+{
+	volatile uint32_t SR;
+	volatile uint32_t CR1;
+	volatile uint32_t CR2;
+	volatile uint32_t HTR;
+	volatile uint32_t LTR;
+	volatile uint32_t SQR1;
+	volatile uint32_t SQR3;
+	volatile uint32_t DR;
+	volatile uint32_t JDR1;
+
+} ADC_TypeDef;
+
+typedef struct
+{
+	uint32_t ClockPrescaler;
+	uint32_t Resolution;
+	uint32_t DataAlign;
+	uint32_t ScanConvMode;
+	uint32_t EOCSelection;
+	FunctionalState ContinuousConvMode;
+	uint32_t NbrOfConversion;
+	FunctionalState DiscontinuousConvMode;
+	uint32_t NbrOfDiscConversion;
+	uint32_t ExternalTrigConv;
+	uint32_t ExternalTrigConvEdge;
+	FunctionalState DMAContinuousRequests;
+
+} ADC_InitTypeDef;
+
+typedef struct
+{
+	ADC_TypeDef *Instance;
+	ADC_InitTypeDef Init;
+	volatile uint32_t NbrOfCurrentConversionRank;
+	DMA_HandleTypeDef *DMA_Handle;
+	volatile uint32_t State;
+	volatile uint32_t ErrorCode;
+
+} ADC_HandleTypeDef;
+
+typedef struct
+{
+	uint32_t Channel;
+	uint32_t Rank;
+	uint32_t SamplingTime;
+	uint32_t Offset;
+
+} ADC_ChannelConfTypeDef;
+
+typedef struct
+{
+	uint32_t InjectedChannel;
+	uint32_t InjectedRank;
+	uint32_t InjectedSamplingTime;
+	uint32_t InjectedOffset;
+	uint32_t InjectedNbrOfConversion;
+	FunctionalState InjectedDiscontinuousConvMode;
+	FunctionalState AutoInjectedConv;
+	uint32_t ExternalTrigInjecConv;
+	uint32_t ExternalTrigInjecConvEdge;
+
+} ADC_InjectionConfTypeDef;
+
+typedef struct
+{
+	uint32_t WatchdogMode;
+	uint32_t HighThreshold;
+	uint32_t LowThreshold;
+	uint32_t Channel;
+	FunctionalState ITMode;
+	uint32_t WatchdogNumber;
+
+} ADC_AnalogWDGConfTypeDef;
+
+extern ADC_TypeDef g_host_hal_adc1;
+
+#define ADC1 (&g_host_hal_adc1)
+
+#define ADC_CLOCK_SYNC_PCLK_DIV2        0x00000000U
+#define ADC_CLOCK_SYNC_PCLK_DIV4        0x00010000U
+#define ADC_CLOCK_SYNC_PCLK_DIV6        0x00020000U
+#define ADC_CLOCK_SYNC_PCLK_DIV8        0x00030000U
+#define ADC_RESOLUTION_12B              0x00000000U
+#define ADC_RESOLUTION_10B              0x01000000U
+#define ADC_RESOLUTION_8B               0x02000000U
+#define ADC_RESOLUTION_6B               0x03000000U
+#define ADC_EXTERNALTRIGCONVEDGE_NONE   0x00000000U
+#define ADC_EXTERNALTRIGCONVEDGE_RISING 0x10000000U
+#define ADC_EXTERNALTRIGCONV_T1_CC1     0x00000000U
+#define ADC_EXTERNALTRIGCONV_T1_CC2     0x01000000U
+#define ADC_EXTERNALTRIGCONV_T1_CC3     0x02000000U
+#define ADC_SOFTWARE_START              0x0F000001U
+#define ADC_DATAALIGN_RIGHT             0x00000000U
+#define ADC_EOC_SEQ_CONV                0x00000000U
+#define ADC_EOC_SINGLE_CONV             0x00000001U
+#define ADC_FLAG_AWD                    0x00000001U
+#define ADC_FLAG_JEOC                   0x00000004U
+#define ADC_FLAG_OVR                    0x00000020U
+#define ADC_IT_AWD                      0x00000040U
+#define ADC_IT_JEOC                     0x00000080U
+#define ADC_IT_OVR                      0x04000000U
+#define ADC_INJECTED_RANK_1             0x00000001U
+#define ADC_EXTERNALTRIGINJECCONV_T1_TRGO       0x00010000U
+#define ADC_EXTERNALTRIGINJECCONVEDGE_NONE      0x00000000U
+#define ADC_EXTERNALTRIGINJECCONVEDGE_RISING    0x00100000U
+#define ADC_INJECTED_SOFTWARE_START             0x000F0001U
+#define ADC_ANALOGWATCHDOG_NONE                 0x00000000U
+#define ADC_ANALOGWATCHDOG_SINGLE_REG           0x00800200U
+#define ADC_ANALOGWATCHDOG_SINGLE_INJEC         0x00400200U
+#define ADC_ANALOGWATCHDOG_SINGLE_REGINJEC      0x00C00200U
+
+#define __HAL_ADC_GET_FLAG(__HANDLE__, __FLAG__)   ((((__HANDLE__)->Instance->SR) & (__FLAG__)) == (__FLAG__))
+#define __HAL_ADC_CLEAR_FLAG(__HANDLE__, __FLAG__) (((__HANDLE__)->Instance->SR) &= ~(__FLAG__))
+#define __HAL_ADC_ENABLE_IT(__HANDLE__, __INTERRUPT__)  (((__HANDLE__)->Instance->CR1) |= (__INTERRUPT__))
+#define __HAL_ADC_DISABLE_IT(__HANDLE__, __INTERRUPT__) (((__HANDLE__)->Instance->CR1) &= ~(__INTERRUPT__))
+#define __HAL_ADC_GET_IT_SOURCE(__HANDLE__, __INTERRUPT__) ((((__HANDLE__)->Instance->CR1) & (__INTERRUPT__)) == (__INTERRUPT__))
+
+#define ADC_CHANNEL_0                   0x00000000U
+#define ADC_CHANNEL_1                   0x00000001U
+#define ADC_CHANNEL_2                   0x00000002U
+#define ADC_CHANNEL_3                   0x00000003U
+#define ADC_CHANNEL_4                   0x00000004U
+#define ADC_CHANNEL_5                   0x00000005U
+#define ADC_CHANNEL_6                   0x00000006U
+#define ADC_CHANNEL_7                   0x00000007U
+#define ADC_CHANNEL_8                   0x00000008U
+#define ADC_CHANNEL_16                  0x00000010U
+#define ADC_CHANNEL_17                  0x00000011U
+#define ADC_CHANNEL_18                  0x00000012U
+#define ADC_CHANNEL_TEMPSENSOR          ADC_CHANNEL_16
+#define ADC_CHANNEL_VREFINT             ADC_CHANNEL_17
+
+/* Factory calibration in system memory, as in stm32f4xx_ll_adc.h; host_hal.c holds typical values */
+extern const uint16_t g_host_hal_vrefint_cal;
+extern const uint16_t g_host_hal_tempsensor_cal1;
+extern const uint16_t g_host_hal_tempsensor_cal2;
+
+#define VREFINT_CAL_ADDR                ((const uint16_t *)&g_host_hal_vrefint_cal)
+#define VREFINT_CAL_VREF                (3300UL)
+#define TEMPSENSOR_CAL1_ADDR            ((const uint16_t *)&g_host_hal_tempsensor_cal1)
+#define TEMPSENSOR_CAL2_ADDR            ((const uint16_t *)&g_host_hal_tempsensor_cal2)
+#define TEMPSENSOR_CAL1_TEMP            ((int32_t)30)
+#define TEMPSENSOR_CAL2_TEMP            ((int32_t)110)
+#define TEMPSENSOR_CAL_VREFANALOG       (3300UL)
+
+#define ADC_SAMPLETIME_3CYCLES          0x00000000U
+#define ADC_SAMPLETIME_15CYCLES         0x00000001U
+#define ADC_SAMPLETIME_28CYCLES         0x00000002U
+#define ADC_SAMPLETIME_56CYCLES         0x00000003U
+#define ADC_SAMPLETIME_84CYCLES         0x00000004U
+#define ADC_SAMPLETIME_112CYCLES        0x00000005U
+#define ADC_SAMPLETIME_144CYCLES        0x00000006U
+#define ADC_SAMPLETIME_480CYCLES        0x00000007U
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig);
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Timeout);
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length);
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *hadc);
+void HAL_ADC_IRQHandler(ADC_HandleTypeDef *hadc);
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc);
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc);
+void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_AnalogWDGConfig(ADC_HandleTypeDef *hadc, ADC_AnalogWDGConfTypeDef *AnalogWDGConfig);
+void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADCEx_InjectedConfigChannel(ADC_HandleTypeDef *hadc, ADC_InjectionConfTypeDef *sConfigInjected);
+HAL_StatusTypeDef HAL_ADCEx_InjectedStart_IT(ADC_HandleTypeDef *hadc);
+uint32_t HAL_ADCEx_InjectedGetValue(ADC_HandleTypeDef *hadc, uint32_t InjectedRank);
+void HAL_ADCEx_InjectedConvCpltCallback(ADC_HandleTypeDef *hadc);
+
+/* ------------------------------------------------------------------------- */
+/* TIM                                                                       */
+/* ------------------------------------------------------------------------- */
+
+typedef struct
+{
+	volatile uint32_t CR1;
+	volatile uint32_t CR2;
+	volatile uint32_t CCER;
+	volatile uint32_t CNT;
+	volatile uint32_t PSC;
+	volatile uint32_t ARR;
+	volatile uint32_t CCR1;
+	volatile uint32_t CCR2;
+	volatile uint32_t CCR3;
+	volatile uint32_t CCR4;
+	volatile uint32_t BDTR;
+
+} TIM_TypeDef;
+
+typedef struct
+{
+	uint32_t Prescaler;
+	uint32_t CounterMode;
+	uint32_t Period;
+	uint32_t ClockDivision;
+	uint32_t RepetitionCounter;
+	uint32_t AutoReloadPreload;
+
+} TIM_Base_InitTypeDef;
+
+typedef struct
+{
+	TIM_TypeDef *Instance;
+	TIM_Base_InitTypeDef Init;
+
+} TIM_HandleTypeDef;
+
+typedef struct
+{
+	uint32_t ClockSource;
+	uint32_t ClockPolarity;
+	uint32_t ClockPrescaler;
+	uint32_t ClockFilter;
+
+} TIM_ClockConfigTypeDef;
+
+typedef struct
+{
+	uint32_t MasterOutputTrigger;
+	uint32_t MasterSlaveMode;
+
+} TIM_MasterConfigTypeDef;
+
+typedef struct
+{
+	uint32_t OffStateRunMode;
+	uint32_t OffStateIDLEMode;
+	uint32_t LockLevel;
+	uint32_t DeadTime;
+	uint32_t BreakState;
+	uint32_t BreakPolarity;
+	uint32_t BreakFilter;
+	uint32_t AutomaticOutput;
+
+} TIM_BreakDeadTimeConfigTypeDef;
+
+typedef struct
+{
+	uint32_t OCMode;
+	uint32_t Pulse;
+	uint32_t OCPolarity;
+	uint32_t OCNPolarity;
+	uint32_t OCFastMode;
+	uint32_t OCIdleState;
+	uint32_t OCNIdleState;
+
+} TIM_OC_InitTypeDef;
+
+extern TIM_TypeDef g_host_hal_tim1;
+
+#define TIM1 (&g_host_hal_tim1)
+
+#define TIM_CHANNEL_1                   0x00000000U
+#define TIM_CHANNEL_2                   0x00000004U
+#define TIM_CHANNEL_3                   0x00000008U
+#define TIM_CHANNEL_4                   0x0000000CU
+
+#define TIM_COUNTERMODE_UP              0x00000000U
+#define TIM_CLOCKDIVISION_DIV1          0x00000000U
+#define TIM_AUTORELOAD_PRELOAD_DISABLE  0x00000000U
+#define TIM_CLOCKSOURCE_INTERNAL        0x00001000U
+#define TIM_TRGO_RESET                  0x00000000U
+#define TIM_TRGO_UPDATE                 0x00000020U
+#define TIM_TRGO_OC1REF                 0x00000040U
+#define TIM_TRGO_OC2REF                 0x00000050U
+#define TIM_TRGO_OC3REF                 0x00000060U
+#define TIM_TRGO_OC4REF                 0x00000070U
+#define TIM_MASTERSLAVEMODE_DISABLE     0x00000000U
+#define TIM_OSSR_DISABLE                0x00000000U
+#define TIM_OSSI_DISABLE                0x00000000U
+#define TIM_LOCKLEVEL_OFF               0x00000000U
+#define TIM_BREAK_DISABLE               0x00000000U
+#define TIM_BREAKPOLARITY_HIGH          0x00002000U
+#define TIM_AUTOMATICOUTPUT_DISABLE     0x00000000U
+#define TIM_OCMODE_PWM1                 0x00000060U
+#define TIM_OCMODE_PWM2                 0x00000070U
+#define TIM_OCPOLARITY_HIGH             0x00000000U
+#define TIM_OCNPOLARITY_HIGH            0x00000000U
+#define TIM_OCFAST_DISABLE              0x00000000U
+#define TIM_OCIDLESTATE_RESET           0x00000000U
+#define TIM_OCNIDLESTATE_RESET          0x00000000U
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *htim, TIM_ClockConfigTypeDef *sClockSourceConfig);
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *htim, TIM_MasterConfigTypeDef *sMasterConfig);
+HAL_StatusTypeDef HAL_TIMEx_ConfigBreakDeadTime(TIM_HandleTypeDef *htim, TIM_BreakDeadTimeConfigTypeDef *sBreakDeadTimeConfig);
+
+/* ------------------------------------------------------------------------- */
+/* CAN                                                                       */
+/* ------------------------------------------------------------------------- */
+
+typedef struct
+{
+	volatile uint32_t MCR;
+	volatile uint32_t MSR;
+	volatile uint32_t TSR;
+
+} CAN_TypeDef;
+
+typedef struct
+{
+	uint32_t Prescaler;
+	uint32_t Mode;
+	uint32_t SyncJumpWidth;
+	uint32_t TimeSeg1;
+	uint32_t TimeSeg2;
+	FunctionalState TimeTriggeredMode;
+	FunctionalState AutoBusOff;
+	FunctionalState AutoWakeUp;
+	FunctionalState AutoRetransmission;
+	FunctionalState ReceiveFifoLocked;
+	FunctionalState TransmitFifoPriority;
+
+} CAN_InitTypeDef;
+
+typedef struct
+{
+	CAN_TypeDef *Instance;
+	CAN_InitTypeDef Init;
+	volatile uint32_t State;
+	volatile uint32_t ErrorCode;
+
+} CAN_HandleTypeDef;
+
+typedef struct
+{
+	uint32_t StdId;
+	uint32_t ExtId;
+	uint32_t IDE;
+	uint32_t RTR;
+	uint32_t DLC;
+	FunctionalState TransmitGlobalTime;
+
+} CAN_TxHeaderTypeDef;
+
+extern CAN_TypeDef g_host_hal_can1;
+
+#define CAN1 (&g_host_hal_can1)
+
+#define CAN_MODE_NORMAL                 0x00000000U
+#define CAN_SJW_1TQ                     0x00000000U
+#define CAN_BS1_6TQ                     0x00050000U
+#define CAN_BS2_1TQ                     0x00000000U
+#define CAN_ID_STD                      0x00000000U
+#define CAN_ID_EXT                      0x00000004U
+#define CAN_RTR_DATA                    0x00000000U
+#define CAN_TX_MAILBOX0                 0x00000001U
+#define CAN_TX_MAILBOX1                 0x00000002U
+#define CAN_TX_MAILBOX2                 0x00000004U
+
+HAL_StatusTypeDef HAL_CAN_Init(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_Start(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan,
+									   CAN_TxHeaderTypeDef *pHeader,
+									   uint8_t aData[],
+									   uint32_t *pTxMailbox);
+uint32_t HAL_CAN_GetTxMailboxesFreeLevel(CAN_HandleTypeDef *hcan);
+
+#endif /* HOST_HAL_STM32F4XX_HAL_H_ */
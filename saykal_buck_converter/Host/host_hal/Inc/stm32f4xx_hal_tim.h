@@ -0,0 +1,16 @@
+/**
+ * @file stm32f4xx_hal_tim.h
+ * @brief Host replacement of the STM32F4xx HAL TIM header.
+ *
+ * All host HAL declarations live in stm32f4xx_hal.h, this header only keeps the
+ * include directives of the project configurations valid.
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef HOST_HAL_STM32F4XX_HAL_TIM_H_
+#define HOST_HAL_STM32F4XX_HAL_TIM_H_
+
+#include "stm32f4xx_hal.h"
+
+#endif /* HOST_HAL_STM32F4XX_HAL_TIM_H_ */
@@ -0,0 +1,1266 @@
+/**
+ * @file host_hal.c
+ * @brief Host implementation of the STM32F4xx HAL calls used by the firmware.
+ *
+ * Every HAL function used by the bsp layer is implemented here on top of plain
+ * RAM register blocks. The millisecond tick is virtual and only moves when the
+ * host program advances it, ADC conversions are served by a registered
+ * conversion source and CAN frames are transmitted on the virtual CAN bus.
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "host_hal.h"
+#include "virtual_can_bus.h"
+#include "string.h"
+#include "time.h"
+
+/** @brief Number of regular ranks kept by the ADC sequencer model. */
+#define HOST_HAL_ADC_RANK_CNT 16U
+
+/** @brief Supply the factory calibration values and the conversion source counts refer to. */
+#define HOST_HAL_ADC_NOMINAL_SUPPLY_VOLTAGE 3.3f
+
+/** @brief Largest 12-bit conversion result. */
+#define HOST_HAL_ADC_MAX_RAW_COUNT 4095U
+
+/** @brief Number of modelled NVIC interrupt lines. */
+#define HOST_HAL_IRQ_CNT 96U
+
+/** @brief Analog watchdog bits of ADC_CR1: channel, single channel, injected and regular enable. */
+#define HOST_HAL_ADC_CR1_AWDCH 0x0000001FU
+#define HOST_HAL_ADC_CR1_AWDSGL 0x00000200U
+#define HOST_HAL_ADC_CR1_JAWDEN 0x00400000U
+#define HOST_HAL_ADC_CR1_AWDEN 0x00800000U
+
+/** @brief Half and full transfer flags of the ADC DMA stream (LISR HTIF0/TCIF0). */
+#define HOST_HAL_DMA_FLAG_HT 0x10U
+#define HOST_HAL_DMA_FLAG_TC 0x20U
+
+/** @brief Peripheral register blocks referenced by the peripheral macros. */
+GPIO_TypeDef g_host_hal_gpioa;
+GPIO_TypeDef g_host_hal_gpiob;
+GPIO_TypeDef g_host_hal_gpioc;
+GPIO_TypeDef g_host_hal_gpioh;
+ADC_TypeDef g_host_hal_adc1;
+DMA_Stream_TypeDef g_host_hal_dma2_stream0;
+TIM_TypeDef g_host_hal_tim1;
+CAN_TypeDef g_host_hal_can1;
+CoreDebug_Type g_host_hal_core_debug;
+
+/** @brief Factory calibration of a typical device: VREFINT 1.21 V, sensor 0.76 V at 25 C and 2.5 mV/C. */
+const uint16_t g_host_hal_vrefint_cal = 1502U;
+const uint16_t g_host_hal_tempsensor_cal1 = 959U;
+const uint16_t g_host_hal_tempsensor_cal2 = 1207U;
+
+/** @brief Core clock seen by the firmware, HAL_RCC_ClockConfig() leaves it unchanged. */
+uint32_t SystemCoreClock = 1000000000U;
+
+/** @brief DWT register block returned by host_hal_sync_dwt(). */
+static DWT_Type m_host_dwt;
+
+/** @brief CLOCK_MONOTONIC time of the previous DWT access. */
+static uint64_t m_dwt_last_sync_ns = 0U;
+
+/** @brief Virtual millisecond tick returned by HAL_GetTick(). */
+static uint32_t m_host_tick_ms = 0U;
+
+/** @brief Virtual time since host_hal_reset(), keeps counting when the tick wraps around. */
+static uint64_t m_host_elapsed_ms = 0U;
+
+/** @brief ADC channel configured on each regular rank (index 0 is rank 1). */
+static uint32_t m_adc_rank_channels[HOST_HAL_ADC_RANK_CNT];
+
+/** @brief Sampling time (ADC_SAMPLETIME_x) configured on each regular rank. */
+static uint32_t m_adc_rank_sampling_times[HOST_HAL_ADC_RANK_CNT];
+
+/** @brief Rank written by the last HAL_ADC_ConfigChannel() call. */
+static uint32_t m_adc_last_configured_rank = 1U;
+
+/** @brief ExternalTrigConv of the last HAL_ADC_Init(). */
+static uint32_t m_adc_external_trigger = ADC_SOFTWARE_START;
+
+/** @brief ADC running a DMA scan started by HAL_ADC_Start_DMA(), NULL if none. */
+static ADC_HandleTypeDef *m_adc_dma_handle_ptr = NULL;
+
+/** @brief Destination of the DMA scan, one element per conversion, circular. */
+static void *m_adc_dma_buffer_ptr = NULL;
+static uint32_t m_adc_dma_length = 0U;
+
+/** @brief Element of m_adc_dma_buffer_ptr written by the next conversion. */
+static uint32_t m_adc_dma_write_idx = 0U;
+
+/** @brief Virtual time of the DMA scan not yet covered by a whole sequence. */
+static uint64_t m_adc_dma_carry_ns = 0U;
+
+/** @brief Pending HOST_HAL_DMA_FLAG_x of the ADC DMA stream. */
+static uint32_t m_adc_dma_flags = 0U;
+
+/** @brief Injected channel, its sampling time and trigger of the last HAL_ADCEx_InjectedConfigChannel(). */
+static uint32_t m_adc_injected_channel = ADC_CHANNEL_0;
+static uint32_t m_adc_injected_trigger = ADC_INJECTED_SOFTWARE_START;
+
+/** @brief ADC started by HAL_ADCEx_InjectedStart_IT(), NULL if none. */
+static ADC_HandleTypeDef *m_adc_injected_handle_ptr = NULL;
+
+/** @brief Virtual time of the injected trigger not yet covered by a whole TIM1 period. */
+static uint64_t m_adc_injected_carry_ns = 0U;
+
+/** @brief Enabled NVIC lines and the handlers registered for them. */
+static bool m_is_irq_enabled[HOST_HAL_IRQ_CNT];
+static host_hal_irq_handler_t m_irq_handlers[HOST_HAL_IRQ_CNT];
+
+/** @brief Exception number of the running raised interrupt, 0 outside of them. */
+static uint32_t m_active_exception_number = 0U;
+
+/** @brief Status returned by HAL_ADC_PollForConversion(). */
+static HAL_StatusTypeDef m_adc_poll_status = HAL_OK;
+
+/** @brief Source of conversion results. */
+static host_hal_adc_conversion_func_t m_adc_conversion_func = NULL;
+
+/** @brief Analog supply VDDA and die temperature of the modelled MCU. */
+static float m_adc_supply_voltage = HOST_HAL_ADC_NOMINAL_SUPPLY_VOLTAGE;
+static float m_mcu_temperature = (float)TEMPSENSOR_CAL1_TEMP;
+
+/** @brief Observer of the blocking conversions. */
+static host_hal_adc_poll_func_t m_adc_poll_func = NULL;
+
+/** @brief Receiver of transmitted CAN frames. */
+static host_hal_can_tx_func_t m_can_tx_func = NULL;
+
+/**
+ * @brief Lets the virtual CAN bus transmit up to the elapsed virtual time.
+ */
+static void advance_virtual_can_bus_to_tick(void);
+
+/**
+ * @brief Returns the conversion result of a channel at the modelled supply.
+ *
+ * @param[in] adc_channel ADC channel (ADC_CHANNEL_x) that is being converted.
+ * @return uint32_t Conversion result in counts, 0 for an external channel without a conversion source.
+ */
+static uint32_t convert_adc_channel(uint32_t adc_channel);
+
+/**
+ * @brief Converts sequences of a running DMA scan into its buffer.
+ *
+ * Every conversion advances the DMA like on the target: NDTR counts down, the
+ * buffer wraps around and the half and full transfer flags raise the DMA
+ * interrupt. A timer triggered scan converts nothing while its trigger does
+ * not run.
+ * A failing conversion status stops the scan with an overrun like the target
+ * ADC when the DMA does not keep up.
+ *
+ * @param[in] sequence_cnt Number of sequences to convert.
+ */
+static void run_adc_dma_scan(uint32_t sequence_cnt);
+
+/**
+ * @brief Returns how many sequences the target scan converts in the elapsed time.
+ *
+ * A continuous scan repeats back to back; a triggered scan starts on the first
+ * trigger after the previous sequence ended. The remainder is carried over to
+ * the next call.
+ *
+ * @param[in] elapsed_ms Virtual time since the previous call.
+ * @return uint32_t Number of sequences, 0 without a running DMA scan.
+ */
+static uint32_t get_adc_dma_scan_sequence_cnt(uint32_t elapsed_ms);
+
+/**
+ * @brief Transfer complete callback the target HAL links to the ADC DMA handle.
+ */
+static void complete_adc_dma_transfer(DMA_HandleTypeDef *hdma);
+
+/**
+ * @brief Half transfer callback the target HAL links to the ADC DMA handle.
+ */
+static void complete_adc_dma_half_transfer(DMA_HandleTypeDef *hdma);
+
+/**
+ * @brief Returns the time the target ADC needs for one conversion of a rank.
+ *
+ * @param[in] hadc ADC handle with the settings of HAL_ADC_Init().
+ * @param[in] rank Converted rank, 1..HOST_HAL_ADC_RANK_CNT.
+ * @return uint32_t Sampling plus conversion time in nanoseconds.
+ */
+static uint32_t get_adc_conversion_time_ns(const ADC_HandleTypeDef *hadc, uint32_t rank);
+
+/**
+ * @brief Returns whether a conversion gets started.
+ *
+ * Software started conversions always start; a timer triggered ADC converts
+ * only while its trigger channel is enabled on a running counter.
+ */
+static bool is_adc_triggered(void);
+
+/**
+ * @brief Returns the period of the TIM1 counter, the switching period.
+ *
+ * @return uint64_t Period in nanoseconds.
+ */
+static uint64_t get_tim1_period_ns(void);
+
+/**
+ * @brief Returns whether TIM1 TRGO triggers the started injected group.
+ */
+static bool is_adc_injected_triggered(void);
+
+/**
+ * @brief Converts the injected channel on a running TIM1 TRGO.
+ *
+ * Like the target it converts once per switching period of the elapsed time,
+ * all conversions of a tick see the plant state of that tick. The remainder
+ * is carried over to the next call.
+ *
+ * @param[in] elapsed_ms Virtual time since the previous call.
+ */
+static void run_adc_injected_conversion(uint32_t elapsed_ms);
+
+/**
+ * @brief Converts the injected channel, sets JEOC and raises the ADC interrupt.
+ *
+ * @param[in] hadc ADC handle of HAL_ADCEx_InjectedStart_IT().
+ */
+static void convert_adc_injected_channel(ADC_HandleTypeDef *hadc);
+
+/**
+ * @brief Compares a conversion against the analog watchdog window.
+ *
+ * Sets AWD and raises the ADC interrupt if the channel is guarded and the
+ * count lies outside LTR..HTR, on every such conversion like the target.
+ *
+ * @param[in] hadc        ADC handle of the conversion.
+ * @param[in] adc_channel Converted channel.
+ * @param[in] raw_count   Conversion result.
+ * @param[in] is_injected Whether the conversion belongs to the injected group.
+ */
+static void check_adc_analog_watchdog(ADC_HandleTypeDef *hadc, uint32_t adc_channel,
+									  uint32_t raw_count, bool is_injected);
+
+/**
+ * @brief Calls the handler of an enabled interrupt line like a taken interrupt.
+ *
+ * @param[in] irqn Interrupt line.
+ */
+static void raise_irq(IRQn_Type irqn);
+
+/**
+ * @brief Returns the address of the compare register of a timer channel.
+ *
+ * @param[in] timer_ptr     Timer instance.
+ * @param[in] timer_channel Timer channel (TIM_CHANNEL_x).
+ * @return const volatile uint32_t* Compare register, NULL for an unknown channel.
+ */
+static const volatile uint32_t *get_compare_register(const TIM_TypeDef *timer_ptr,
+													  uint32_t timer_channel);
+
+void host_hal_reset(void)
+{
+	m_host_tick_ms = 0U;
+	m_host_elapsed_ms = 0U;
+	memset(&g_host_hal_gpioa, 0, sizeof(g_host_hal_gpioa));
+	memset(&g_host_hal_gpiob, 0, sizeof(g_host_hal_gpiob));
+	memset(&g_host_hal_gpioc, 0, sizeof(g_host_hal_gpioc));
+	memset(&g_host_hal_gpioh, 0, sizeof(g_host_hal_gpioh));
+	memset(&g_host_hal_adc1, 0, sizeof(g_host_hal_adc1));
+	memset(&g_host_hal_dma2_stream0, 0, sizeof(g_host_hal_dma2_stream0));
+	memset(&g_host_hal_tim1, 0, sizeof(g_host_hal_tim1));
+	memset(&g_host_hal_can1, 0, sizeof(g_host_hal_can1));
+	memset(&g_host_hal_core_debug, 0, sizeof(g_host_hal_core_debug));
+	memset(&m_host_dwt, 0, sizeof(m_host_dwt));
+	m_dwt_last_sync_ns = 0U;
+	memset(m_adc_rank_channels, 0, sizeof(m_adc_rank_channels));
+	memset(m_adc_rank_sampling_times, 0, sizeof(m_adc_rank_sampling_times));
+	m_adc_last_configured_rank = 1U;
+	m_adc_external_trigger = ADC_SOFTWARE_START;
+	m_adc_dma_handle_ptr = NULL;
+	m_adc_dma_buffer_ptr = NULL;
+	m_adc_dma_length = 0U;
+	m_adc_dma_write_idx = 0U;
+	m_adc_dma_carry_ns = 0U;
+	m_adc_dma_flags = 0U;
+	m_adc_injected_channel = ADC_CHANNEL_0;
+	m_adc_injected_trigger = ADC_INJECTED_SOFTWARE_START;
+	m_adc_injected_handle_ptr = NULL;
+	m_adc_injected_carry_ns = 0U;
+	memset(m_is_irq_enabled, 0, sizeof(m_is_irq_enabled));
+	memset(m_irq_handlers, 0, sizeof(m_irq_handlers));
+	m_active_exception_number = 0U;
+	m_adc_poll_status = HAL_OK;
+	m_adc_conversion_func = NULL;
+	m_adc_supply_voltage = HOST_HAL_ADC_NOMINAL_SUPPLY_VOLTAGE;
+	m_mcu_temperature = (float)TEMPSENSOR_CAL1_TEMP;
+	m_adc_poll_func = NULL;
+	m_can_tx_func = NULL;
+	reset_virtual_can_bus();
+}
+
+void host_hal_set_tick(uint32_t tick_ms)
+{
+	m_host_tick_ms = tick_ms;
+}
+
+void host_hal_advance_tick(uint32_t elapsed_ms)
+{
+	m_host_tick_ms += elapsed_ms;
+	m_host_elapsed_ms += elapsed_ms;
+	run_adc_dma_scan(get_adc_dma_scan_sequence_cnt(elapsed_ms));
+	run_adc_injected_conversion(elapsed_ms);
+	advance_virtual_can_bus_to_tick();
+}
+
+void host_hal_register_adc_conversion_func(host_hal_adc_conversion_func_t conversion_func)
+{
+	m_adc_conversion_func = conversion_func;
+}
+
+void host_hal_set_adc_supply_voltage(float supply_voltage)
+{
+	m_adc_supply_voltage = supply_voltage;
+}
+
+void host_hal_set_mcu_temperature(float temperature)
+{
+	m_mcu_temperature = temperature;
+}
+
+void host_hal_set_adc_poll_status(HAL_StatusTypeDef poll_status)
+{
+	m_adc_poll_status = poll_status;
+	run_adc_dma_scan(1U);
+}
+
+void host_hal_refresh_adc_dma_scan(void)
+{
+	run_adc_dma_scan(1U);
+}
+
+void host_hal_register_adc_poll_func(host_hal_adc_poll_func_t poll_func)
+{
+	m_adc_poll_func = poll_func;
+}
+
+void host_hal_register_irq_handler(IRQn_Type irqn, host_hal_irq_handler_t irq_handler)
+{
+	if((uint32_t)irqn < HOST_HAL_IRQ_CNT)
+	{
+		m_irq_handlers[irqn] = irq_handler;
+	}
+}
+
+void host_hal_register_can_tx_func(host_hal_can_tx_func_t can_tx_func)
+{
+	m_can_tx_func = can_tx_func;
+}
+
+float host_hal_get_pwm_duty(const TIM_TypeDef *timer_ptr, uint32_t timer_channel)
+{
+	const volatile uint32_t *compare_register_ptr = get_compare_register(timer_ptr, timer_channel);
+
+	if((NULL == compare_register_ptr) || (false == host_hal_is_pwm_running(timer_ptr, timer_channel)))
+	{
+		return 0.0f;
+	}
+
+	/* PWM mode 1 on an up counter: output is high while CNT < CCR, period is ARR + 1 counts */
+	float duty = (float)(*compare_register_ptr) / (float)(timer_ptr->ARR + 1U);
+
+	return (duty > 1.0f) ? 1.0f : duty;
+}
+
+bool host_hal_is_pwm_running(const TIM_TypeDef *timer_ptr, uint32_t timer_channel)
+{
+	if(NULL == timer_ptr)
+	{
+		return false;
+	}
+
+	return (0U != (timer_ptr->CCER & (1UL << timer_channel)));
+}
+
+/* ------------------------------------------------------------------------- */
+/* HAL core                                                                  */
+/* ------------------------------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_Init(void)
+{
+	return HAL_OK;
+}
+
+void HAL_IncTick(void)
+{
+	m_host_tick_ms++;
+	m_host_elapsed_ms++;
+	run_adc_dma_scan(get_adc_dma_scan_sequence_cnt(1U));
+	run_adc_injected_conversion(1U);
+	advance_virtual_can_bus_to_tick();
+}
+
+uint32_t HAL_GetTick(void)
+{
+	return m_host_tick_ms;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+	m_host_tick_ms += Delay;
+	m_host_elapsed_ms += Delay;
+	run_adc_dma_scan(get_adc_dma_scan_sequence_cnt(Delay));
+	run_adc_injected_conversion(Delay);
+	advance_virtual_can_bus_to_tick();
+}
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct)
+{
+	return (NULL != RCC_OscInitStruct) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency)
+{
+	(void)FLatency;
+	return (NULL != RCC_ClkInitStruct) ? HAL_OK : HAL_ERROR;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+	/* product clock tree: SYSCLK from HSE without PLL, APB1 undivided */
+	return HSE_VALUE;
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+	/* product clock tree: SYSCLK from HSE without PLL, APB2 undivided */
+	return HSE_VALUE;
+}
+
+uint32_t HAL_RCC_GetHCLKFreq(void)
+{
+	return SystemCoreClock;
+}
+
+/* ------------------------------------------------------------------------- */
+/* NVIC                                                                      */
+/* ------------------------------------------------------------------------- */
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+	/* handlers are called synchronously, priorities do not matter on the host */
+	(void)IRQn;
+	(void)PreemptPriority;
+	(void)SubPriority;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	if((uint32_t)IRQn < HOST_HAL_IRQ_CNT)
+	{
+		m_is_irq_enabled[IRQn] = true;
+	}
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+	if((uint32_t)IRQn < HOST_HAL_IRQ_CNT)
+	{
+		m_is_irq_enabled[IRQn] = false;
+	}
+}
+
+/* ------------------------------------------------------------------------- */
+/* Cortex-M4 core debug                                                      */
+/* ------------------------------------------------------------------------- */
+
+DWT_Type *host_hal_sync_dwt(void)
+{
+	struct timespec time_now;
+
+	clock_gettime(CLOCK_MONOTONIC, &time_now);
+
+	uint64_t now_ns = ((uint64_t)time_now.tv_sec * 1000000000U) + (uint64_t)time_now.tv_nsec;
+
+	if((0U != (g_host_hal_core_debug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk)) &&
+	   (0U != (m_host_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk)) &&
+	   (0U != m_dwt_last_sync_ns))
+	{
+		uint64_t elapsed_ns = now_ns - m_dwt_last_sync_ns;
+
+		m_host_dwt.CYCCNT += (uint32_t)(((elapsed_ns / 1000000000U) * SystemCoreClock) +
+										(((elapsed_ns % 1000000000U) * SystemCoreClock) / 1000000000U));
+	}
+
+	m_dwt_last_sync_ns = now_ns;
+
+	return &m_host_dwt;
+}
+
+/* ------------------------------------------------------------------------- */
+/* GPIO                                                                      */
+/* ------------------------------------------------------------------------- */
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+	(void)GPIOx;
+	(void)GPIO_Init;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+	return (0U != (GPIOx->IDR & GPIO_Pin)) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+	if(GPIO_PIN_RESET != PinState)
+	{
+		GPIOx->ODR |= GPIO_Pin;
+	}
+	else
+	{
+		GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+	}
+}
+
+/* ------------------------------------------------------------------------- */
+/* ADC                                                                       */
+/* ------------------------------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc)
+{
+	if((NULL == hadc) || (NULL == hadc->Instance))
+	{
+		return HAL_ERROR;
+	}
+
+	m_adc_external_trigger = hadc->Init.ExternalTrigConv;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig)
+{
+	if((NULL == hadc) || (NULL == sConfig) ||
+	   (0U == sConfig->Rank) || (sConfig->Rank > HOST_HAL_ADC_RANK_CNT))
+	{
+		return HAL_ERROR;
+	}
+
+	m_adc_rank_channels[sConfig->Rank - 1U] = sConfig->Channel;
+	m_adc_rank_sampling_times[sConfig->Rank - 1U] = sConfig->SamplingTime;
+	m_adc_last_configured_rank = sConfig->Rank;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc)
+{
+	hadc->Instance->CR2 |= 1U;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef *hadc)
+{
+	hadc->Instance->CR2 &= ~1U;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Timeout)
+{
+	(void)Timeout;
+
+	if(HAL_OK != m_adc_poll_status)
+	{
+		return m_adc_poll_status;
+	}
+
+	if(false == is_adc_triggered())
+	{
+		return HAL_TIMEOUT;
+	}
+
+	/* The bsp reconfigures one rank before each single conversion, convert that rank */
+	uint32_t adc_channel = m_adc_rank_channels[m_adc_last_configured_rank - 1U];
+
+	if(NULL != m_adc_poll_func)
+	{
+		m_adc_poll_func(adc_channel, get_adc_conversion_time_ns(hadc, m_adc_last_configured_rank));
+	}
+
+	hadc->Instance->DR = convert_adc_channel(adc_channel);
+	check_adc_analog_watchdog(hadc, adc_channel, hadc->Instance->DR, false);
+
+	return HAL_OK;
+}
+
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc)
+{
+	return hadc->Instance->DR;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length)
+{
+	if((NULL == hadc) || (NULL == hadc->DMA_Handle) || (NULL == hadc->DMA_Handle->Instance) ||
+	   (NULL == pData) || (0U == Length) || (0U == hadc->Init.NbrOfConversion) ||
+	   (hadc->Init.NbrOfConversion > HOST_HAL_ADC_RANK_CNT))
+	{
+		return HAL_ERROR;
+	}
+
+	m_adc_dma_handle_ptr = hadc;
+	m_adc_dma_buffer_ptr = pData;
+	m_adc_dma_length = Length;
+	m_adc_dma_write_idx = 0U;
+	m_adc_dma_carry_ns = 0U;
+	m_adc_dma_flags = 0U;
+
+	hadc->DMA_Handle->XferCpltCallback = complete_adc_dma_transfer;
+	hadc->DMA_Handle->XferHalfCpltCallback = complete_adc_dma_half_transfer;
+	hadc->DMA_Handle->Instance->NDTR = Length;
+	hadc->DMA_Handle->Instance->M0AR = (uint32_t)(uintptr_t)pData;
+	hadc->DMA_Handle->Instance->CR |= DMA_SxCR_EN | DMA_SxCR_HTIE | DMA_SxCR_TCIE;
+	hadc->Instance->CR1 |= ADC_IT_OVR;
+	hadc->Instance->CR2 |= 1U;
+
+	run_adc_dma_scan(1U);
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *hadc)
+{
+	if((NULL == hadc) || (NULL == hadc->DMA_Handle) || (NULL == hadc->DMA_Handle->Instance))
+	{
+		return HAL_ERROR;
+	}
+
+	hadc->DMA_Handle->Instance->CR &= ~(DMA_SxCR_EN | DMA_SxCR_HTIE | DMA_SxCR_TCIE);
+	hadc->Instance->CR1 &= ~ADC_IT_OVR;
+	hadc->Instance->CR2 &= ~1U;
+
+	if(hadc == m_adc_dma_handle_ptr)
+	{
+		m_adc_dma_handle_ptr = NULL;
+	}
+
+	return HAL_OK;
+}
+
+void HAL_ADC_IRQHandler(ADC_HandleTypeDef *hadc)
+{
+	if((true == __HAL_ADC_GET_FLAG(hadc, ADC_FLAG_JEOC)) && (true == __HAL_ADC_GET_IT_SOURCE(hadc, ADC_IT_JEOC)))
+	{
+		/* a software started injected conversion is single, the HAL disables its interrupt */
+		if(ADC_INJECTED_SOFTWARE_START == m_adc_injected_trigger)
+		{
+			__HAL_ADC_DISABLE_IT(hadc, ADC_IT_JEOC);
+		}
+
+		__HAL_ADC_CLEAR_FLAG(hadc, ADC_FLAG_JEOC);
+		HAL_ADCEx_InjectedConvCpltCallback(hadc);
+	}
+
+	if((true == __HAL_ADC_GET_FLAG(hadc, ADC_FLAG_AWD)) && (true == __HAL_ADC_GET_IT_SOURCE(hadc, ADC_IT_AWD)))
+	{
+		HAL_ADC_LevelOutOfWindowCallback(hadc);
+		__HAL_ADC_CLEAR_FLAG(hadc, ADC_FLAG_AWD);
+	}
+
+	if((true == __HAL_ADC_GET_FLAG(hadc, ADC_FLAG_OVR)) && (true == __HAL_ADC_GET_IT_SOURCE(hadc, ADC_IT_OVR)))
+	{
+		__HAL_ADC_CLEAR_FLAG(hadc, ADC_FLAG_OVR);
+		HAL_ADC_ErrorCallback(hadc);
+	}
+}
+
+__attribute__((weak)) void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+	(void)hadc;
+}
+
+__attribute__((weak)) void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+	(void)hadc;
+}
+
+__attribute__((weak)) void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc)
+{
+	(void)hadc;
+}
+
+HAL_StatusTypeDef HAL_ADC_AnalogWDGConfig(ADC_HandleTypeDef *hadc, ADC_AnalogWDGConfTypeDef *AnalogWDGConfig)
+{
+	if((NULL == hadc) || (NULL == hadc->Instance) || (NULL == AnalogWDGConfig) ||
+	   (AnalogWDGConfig->HighThreshold > HOST_HAL_ADC_MAX_RAW_COUNT) ||
+	   (AnalogWDGConfig->LowThreshold > HOST_HAL_ADC_MAX_RAW_COUNT))
+	{
+		return HAL_ERROR;
+	}
+
+	if(ENABLE == AnalogWDGConfig->ITMode)
+	{
+		__HAL_ADC_ENABLE_IT(hadc, ADC_IT_AWD);
+	}
+	else
+	{
+		__HAL_ADC_DISABLE_IT(hadc, ADC_IT_AWD);
+	}
+
+	hadc->Instance->CR1 &= ~(HOST_HAL_ADC_CR1_AWDCH | HOST_HAL_ADC_CR1_AWDSGL |
+							 HOST_HAL_ADC_CR1_JAWDEN | HOST_HAL_ADC_CR1_AWDEN);
+	hadc->Instance->CR1 |= AnalogWDGConfig->WatchdogMode;
+	hadc->Instance->HTR = AnalogWDGConfig->HighThreshold;
+	hadc->Instance->LTR = AnalogWDGConfig->LowThreshold;
+	hadc->Instance->CR1 |= AnalogWDGConfig->Channel & HOST_HAL_ADC_CR1_AWDCH;
+
+	return HAL_OK;
+}
+
+__attribute__((weak)) void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef *hadc)
+{
+	(void)hadc;
+}
+
+HAL_StatusTypeDef HAL_ADCEx_InjectedConfigChannel(ADC_HandleTypeDef *hadc, ADC_InjectionConfTypeDef *sConfigInjected)
+{
+	if((NULL == hadc) || (NULL == sConfigInjected) || (ADC_INJECTED_RANK_1 != sConfigInjected->InjectedRank))
+	{
+		return HAL_ERROR;
+	}
+
+	m_adc_injected_channel = sConfigInjected->InjectedChannel;
+	m_adc_injected_trigger = sConfigInjected->ExternalTrigInjecConv;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADCEx_InjectedStart_IT(ADC_HandleTypeDef *hadc)
+{
+	if((NULL == hadc) || (NULL == hadc->Instance))
+	{
+		return HAL_ERROR;
+	}
+
+	m_adc_injected_handle_ptr = hadc;
+	__HAL_ADC_CLEAR_FLAG(hadc, ADC_FLAG_JEOC);
+	__HAL_ADC_ENABLE_IT(hadc, ADC_IT_JEOC);
+	hadc->Instance->CR2 |= 1U;
+
+	if(ADC_INJECTED_SOFTWARE_START == m_adc_injected_trigger)
+	{
+		convert_adc_injected_channel(hadc);
+	}
+
+	return HAL_OK;
+}
+
+uint32_t HAL_ADCEx_InjectedGetValue(ADC_HandleTypeDef *hadc, uint32_t InjectedRank)
+{
+	return (ADC_INJECTED_RANK_1 == InjectedRank) ? hadc->Instance->JDR1 : 0U;
+}
+
+__attribute__((weak)) void HAL_ADCEx_InjectedConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+	(void)hadc;
+}
+
+/* ------------------------------------------------------------------------- */
+/* DMA                                                                       */
+/* ------------------------------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma)
+{
+	if((NULL == hdma) || (NULL == hdma->Instance))
+	{
+		return HAL_ERROR;
+	}
+
+	hdma->Instance->CR = hdma->Init.Channel | hdma->Init.Direction | hdma->Init.PeriphInc |
+						 hdma->Init.MemInc | hdma->Init.PeriphDataAlignment |
+						 hdma->Init.MemDataAlignment | hdma->Init.Mode | hdma->Init.Priority;
+
+	return HAL_OK;
+}
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma)
+{
+	/* only the ADC stream is modelled, its flags are the ones of DMA2 Stream0 */
+	if((0U != (m_adc_dma_flags & HOST_HAL_DMA_FLAG_HT)) && (0U != (hdma->Instance->CR & DMA_SxCR_HTIE)))
+	{
+		m_adc_dma_flags &= ~HOST_HAL_DMA_FLAG_HT;
+
+		if(NULL != hdma->XferHalfCpltCallback)
+		{
+			hdma->XferHalfCpltCallback(hdma);
+		}
+	}
+
+	if((0U != (m_adc_dma_flags & HOST_HAL_DMA_FLAG_TC)) && (0U != (hdma->Instance->CR & DMA_SxCR_TCIE)))
+	{
+		m_adc_dma_flags &= ~HOST_HAL_DMA_FLAG_TC;
+
+		if(NULL != hdma->XferCpltCallback)
+		{
+			hdma->XferCpltCallback(hdma);
+		}
+	}
+}
+
+/* ------------------------------------------------------------------------- */
+/* TIM                                                                       */
+/* ------------------------------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim)
+{
+	if((NULL == htim) || (NULL == htim->Instance))
+	{
+		return HAL_ERROR;
+	}
+
+	htim->Instance->PSC = htim->Init.Prescaler;
+	htim->Instance->ARR = htim->Init.Period;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *htim, TIM_ClockConfigTypeDef *sClockSourceConfig)
+{
+	(void)sClockSourceConfig;
+	return (NULL != htim) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *htim)
+{
+	return HAL_TIM_Base_Init(htim);
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig, uint32_t Channel)
+{
+	if((NULL == htim) || (NULL == sConfig) || (Channel > TIM_CHANNEL_4))
+	{
+		return HAL_ERROR;
+	}
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+	htim->Instance->CCER |= (1UL << Channel);
+	htim->Instance->CR1 |= 1U;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+	htim->Instance->CCER &= ~(1UL << Channel);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *htim, TIM_MasterConfigTypeDef *sMasterConfig)
+{
+	if((NULL == htim) || (NULL == sMasterConfig))
+	{
+		return HAL_ERROR;
+	}
+
+	htim->Instance->CR2 = sMasterConfig->MasterOutputTrigger;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_ConfigBreakDeadTime(TIM_HandleTypeDef *htim, TIM_BreakDeadTimeConfigTypeDef *sBreakDeadTimeConfig)
+{
+	if((NULL == htim) || (NULL == sBreakDeadTimeConfig))
+	{
+		return HAL_ERROR;
+	}
+
+	htim->Instance->BDTR = sBreakDeadTimeConfig->DeadTime;
+
+	return HAL_OK;
+}
+
+static const volatile uint32_t *get_compare_register(const TIM_TypeDef *timer_ptr,
+													  uint32_t timer_channel)
+{
+	if(NULL == timer_ptr)
+	{
+		return NULL;
+	}
+
+	switch(timer_channel)
+	{
+		case TIM_CHANNEL_1: return &timer_ptr->CCR1;
+		case TIM_CHANNEL_2: return &timer_ptr->CCR2;
+		case TIM_CHANNEL_3: return &timer_ptr->CCR3;
+		case TIM_CHANNEL_4: return &timer_ptr->CCR4;
+		default: return NULL;
+	}
+}
+
+/* ------------------------------------------------------------------------- */
+/* CAN                                                                       */
+/* ------------------------------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_CAN_Init(CAN_HandleTypeDef *hcan)
+{
+	if((NULL == hcan) || (NULL == hcan->Instance))
+	{
+		return HAL_ERROR;
+	}
+
+	configure_virtual_can_bus(HAL_RCC_GetPCLK1Freq(), &hcan->Init);
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_Start(CAN_HandleTypeDef *hcan)
+{
+	return ((NULL != hcan) && (NULL != hcan->Instance)) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan,
+									   CAN_TxHeaderTypeDef *pHeader,
+									   uint8_t aData[],
+									   uint32_t *pTxMailbox)
+{
+	if((NULL == hcan) || (NULL == pHeader) || (NULL == aData) || (NULL == pTxMailbox))
+	{
+		return HAL_ERROR;
+	}
+
+	HAL_StatusTypeDef queue_status =
+		queue_virtual_can_frame(pHeader, aData, m_host_elapsed_ms * 1000000ULL, pTxMailbox);
+
+	if((HAL_OK == queue_status) && (NULL != m_can_tx_func))
+	{
+		m_can_tx_func(pHeader, aData);
+	}
+
+	return queue_status;
+}
+
+uint32_t HAL_CAN_GetTxMailboxesFreeLevel(CAN_HandleTypeDef *hcan)
+{
+	(void)hcan;
+	return get_virtual_can_bus_free_mailbox_cnt();
+}
+
+static void advance_virtual_can_bus_to_tick(void)
+{
+	advance_virtual_can_bus(m_host_elapsed_ms * 1000000ULL);
+}
+
+static void run_adc_dma_scan(uint32_t sequence_cnt)
+{
+	ADC_HandleTypeDef *hadc = m_adc_dma_handle_ptr;
+
+	if((NULL == hadc) || (0U == (hadc->DMA_Handle->Instance->CR & DMA_SxCR_EN)) ||
+	   (true == __HAL_ADC_GET_FLAG(hadc, ADC_FLAG_OVR)))
+	{
+		return;
+	}
+
+	if(HAL_OK != m_adc_poll_status)
+	{
+		/* RM0090: on an overrun the DMA requests stop until the scan is restarted */
+		hadc->Instance->SR |= ADC_FLAG_OVR;
+		raise_irq(ADC_IRQn);
+		return;
+	}
+
+	if(false == is_adc_triggered())
+	{
+		return;
+	}
+
+	bool is_halfword = (DMA_MDATAALIGN_HALFWORD == hadc->DMA_Handle->Init.MemDataAlignment);
+	DMA_Stream_TypeDef *stream_ptr = hadc->DMA_Handle->Instance;
+
+	for(uint32_t conversion_idx = 0U; conversion_idx < (sequence_cnt * hadc->Init.NbrOfConversion); conversion_idx++)
+	{
+		uint32_t rank_idx = conversion_idx % hadc->Init.NbrOfConversion;
+		uint32_t raw_count = convert_adc_channel(m_adc_rank_channels[rank_idx]);
+
+		if(true == is_halfword)
+		{
+			((volatile uint16_t *)m_adc_dma_buffer_ptr)[m_adc_dma_write_idx] = (uint16_t)raw_count;
+		}
+		else
+		{
+			((volatile uint32_t *)m_adc_dma_buffer_ptr)[m_adc_dma_write_idx] = raw_count;
+		}
+
+		hadc->Instance->DR = raw_count;
+		check_adc_analog_watchdog(hadc, m_adc_rank_channels[rank_idx], raw_count, false);
+		m_adc_dma_write_idx++;
+
+		if((m_adc_dma_length / 2U) == m_adc_dma_write_idx)
+		{
+			m_adc_dma_flags |= HOST_HAL_DMA_FLAG_HT;
+		}
+		else if(m_adc_dma_length == m_adc_dma_write_idx)
+		{
+			/* circular mode reloads NDTR and wraps to the start of the buffer */
+			m_adc_dma_write_idx = 0U;
+			m_adc_dma_flags |= HOST_HAL_DMA_FLAG_TC;
+		}
+
+		stream_ptr->NDTR = m_adc_dma_length - m_adc_dma_write_idx;
+
+		if(0U != m_adc_dma_flags)
+		{
+			raise_irq(DMA2_Stream0_IRQn);
+		}
+
+		if((hadc != m_adc_dma_handle_ptr) || (0U == (stream_ptr->CR & DMA_SxCR_EN)))
+		{
+			/* the interrupt stopped the scan */
+			return;
+		}
+	}
+}
+
+static uint32_t get_adc_dma_scan_sequence_cnt(uint32_t elapsed_ms)
+{
+	ADC_HandleTypeDef *hadc = m_adc_dma_handle_ptr;
+
+	if((NULL == hadc) || (0U == (hadc->DMA_Handle->Instance->CR & DMA_SxCR_EN)))
+	{
+		return 0U;
+	}
+
+	uint64_t sequence_ns = 0U;
+
+	for(uint32_t rank = 1U; rank <= hadc->Init.NbrOfConversion; rank++)
+	{
+		sequence_ns += get_adc_conversion_time_ns(hadc, rank);
+	}
+
+	if(ADC_SOFTWARE_START != m_adc_external_trigger)
+	{
+		/* a trigger during the sequence is ignored, the next one starts it */
+		uint64_t trigger_period_ns = get_tim1_period_ns();
+
+		if(0U != trigger_period_ns)
+		{
+			sequence_ns = ((sequence_ns + trigger_period_ns - 1U) / trigger_period_ns) * trigger_period_ns;
+		}
+	}
+
+	if(0U == sequence_ns)
+	{
+		return 0U;
+	}
+
+	m_adc_dma_carry_ns += (uint64_t)elapsed_ms * 1000000ULL;
+
+	uint64_t sequence_cnt = m_adc_dma_carry_ns / sequence_ns;
+	m_adc_dma_carry_ns -= sequence_cnt * sequence_ns;
+
+	return (uint32_t)sequence_cnt;
+}
+
+static void complete_adc_dma_transfer(DMA_HandleTypeDef *hdma)
+{
+	HAL_ADC_ConvCpltCallback((ADC_HandleTypeDef *)hdma->Parent);
+}
+
+static void complete_adc_dma_half_transfer(DMA_HandleTypeDef *hdma)
+{
+	HAL_ADC_ConvHalfCpltCallback((ADC_HandleTypeDef *)hdma->Parent);
+}
+
+static uint32_t get_adc_conversion_time_ns(const ADC_HandleTypeDef *hadc, uint32_t rank)
+{
+	static const uint16_t sampling_cycles[] = { 3U, 15U, 28U, 56U, 84U, 112U, 144U, 480U };
+
+	/* RM0090: the conversion takes the sampling time plus one ADC clock per result bit */
+	uint32_t prescaler = 2U * (((hadc->Init.ClockPrescaler >> 16U) & 0x3U) + 1U);
+	uint32_t resolution_bits = 12U - (2U * ((hadc->Init.Resolution >> 24U) & 0x3U));
+	uint32_t adc_cycles = sampling_cycles[m_adc_rank_sampling_times[rank - 1U] & 0x7U] + resolution_bits;
+
+	return (uint32_t)(((uint64_t)adc_cycles * prescaler * 1000000000U) / HAL_RCC_GetPCLK2Freq());
+}
+
+bool host_hal_get_adc_trigger_phase(float *phase_ptr)
+{
+	uint32_t timer_channel = TIM_CHANNEL_1;
+
+	switch(m_adc_external_trigger)
+	{
+		case ADC_EXTERNALTRIGCONV_T1_CC1:
+		{
+			timer_channel = TIM_CHANNEL_1;
+			break;
+		}
+		case ADC_EXTERNALTRIGCONV_T1_CC2:
+		{
+			timer_channel = TIM_CHANNEL_2;
+			break;
+		}
+		case ADC_EXTERNALTRIGCONV_T1_CC3:
+		{
+			timer_channel = TIM_CHANNEL_3;
+			break;
+		}
+		default:
+		{
+			return false;
+		}
+	}
+
+	const volatile uint32_t *compare_register_ptr = get_compare_register(TIM1, timer_channel);
+
+	if((0U == (TIM1->CR1 & 1U)) || (0U == (TIM1->CCER & (1UL << timer_channel))) ||
+	   (*compare_register_ptr > TIM1->ARR))
+	{
+		return false;
+	}
+
+	if(NULL != phase_ptr)
+	{
+		*phase_ptr = (float)(*compare_register_ptr) / (float)(TIM1->ARR + 1U);
+	}
+
+	return true;
+}
+
+static bool is_adc_triggered(void)
+{
+	return (ADC_SOFTWARE_START == m_adc_external_trigger) || (true == host_hal_get_adc_trigger_phase(NULL));
+}
+
+static uint64_t get_tim1_period_ns(void)
+{
+	return ((uint64_t)(TIM1->ARR + 1U) * (TIM1->PSC + 1U) * 1000000000ULL) / HAL_RCC_GetPCLK2Freq();
+}
+
+static bool is_adc_injected_triggered(void)
+{
+	ADC_HandleTypeDef *hadc = m_adc_injected_handle_ptr;
+
+	if((NULL == hadc) || (ADC_EXTERNALTRIGINJECCONV_T1_TRGO != m_adc_injected_trigger) ||
+	   (false == __HAL_ADC_GET_IT_SOURCE(hadc, ADC_IT_JEOC)) || (0U == (hadc->Instance->CR2 & 1U)) ||
+	   (0U == (TIM1->CR1 & 1U)))
+	{
+		return false;
+	}
+
+	/* TRGO follows OCxREF of a channel, which only toggles while the channel is enabled */
+	uint32_t trigger_output = TIM1->CR2;
+
+	if((trigger_output >= TIM_TRGO_OC1REF) && (trigger_output <= TIM_TRGO_OC4REF))
+	{
+		uint32_t timer_channel = (trigger_output - TIM_TRGO_OC1REF) >> 2U;
+
+		return (0U != (TIM1->CCER & (1UL << timer_channel)));
+	}
+
+	return (TIM_TRGO_UPDATE == trigger_output);
+}
+
+static void run_adc_injected_conversion(uint32_t elapsed_ms)
+{
+	uint64_t trigger_period_ns = get_tim1_period_ns();
+
+	if((false == is_adc_injected_triggered()) || (0U == trigger_period_ns))
+	{
+		m_adc_injected_carry_ns = 0U;
+		return;
+	}
+
+	m_adc_injected_carry_ns += (uint64_t)elapsed_ms * 1000000ULL;
+
+	/* the interrupt may stop the group or the timer, the later triggers do not happen then */
+	while((m_adc_injected_carry_ns >= trigger_period_ns) && (true == is_adc_injected_triggered()))
+	{
+		m_adc_injected_carry_ns -= trigger_period_ns;
+		convert_adc_injected_channel(m_adc_injected_handle_ptr);
+	}
+}
+
+static void convert_adc_injected_channel(ADC_HandleTypeDef *hadc)
+{
+	if(HAL_OK != m_adc_poll_status)
+	{
+		return;
+	}
+
+	hadc->Instance->JDR1 = convert_adc_channel(m_adc_injected_channel);
+	hadc->Instance->SR |= ADC_FLAG_JEOC;
+	check_adc_analog_watchdog(hadc, m_adc_injected_channel, hadc->Instance->JDR1, true);
+
+	raise_irq(ADC_IRQn);
+}
+
+static void check_adc_analog_watchdog(ADC_HandleTypeDef *hadc, uint32_t adc_channel,
+									  uint32_t raw_count, bool is_injected)
+{
+	uint32_t control = hadc->Instance->CR1;
+	uint32_t group_enable = (true == is_injected) ? HOST_HAL_ADC_CR1_JAWDEN : HOST_HAL_ADC_CR1_AWDEN;
+
+	if((0U == (control & group_enable)) ||
+	   ((0U != (control & HOST_HAL_ADC_CR1_AWDSGL)) && ((control & HOST_HAL_ADC_CR1_AWDCH) != adc_channel)) ||
+	   ((raw_count <= hadc->Instance->HTR) && (raw_count >= hadc->Instance->LTR)))
+	{
+		return;
+	}
+
+	hadc->Instance->SR |= ADC_FLAG_AWD;
+
+	/* the injected conversion raises the interrupt for both flags itself */
+	if((false == is_injected) && (true == __HAL_ADC_GET_IT_SOURCE(hadc, ADC_IT_AWD)))
+	{
+		raise_irq(ADC_IRQn);
+	}
+}
+
+static uint32_t convert_adc_channel(uint32_t adc_channel)
+{
+	float count_at_nominal_supply = 0.0f;
+
+	if(ADC_CHANNEL_VREFINT == adc_channel)
+	{
+		count_at_nominal_supply = (float)g_host_hal_vrefint_cal;
+	}
+	else if(ADC_CHANNEL_TEMPSENSOR == adc_channel)
+	{
+		count_at_nominal_supply = (float)g_host_hal_tempsensor_cal1 +
+			(((m_mcu_temperature - (float)TEMPSENSOR_CAL1_TEMP) *
+			  (float)(g_host_hal_tempsensor_cal2 - g_host_hal_tempsensor_cal1)) /
+			 (float)(TEMPSENSOR_CAL2_TEMP - TEMPSENSOR_CAL1_TEMP));
+	}
+	else if(NULL != m_adc_conversion_func)
+	{
+		count_at_nominal_supply = (float)(m_adc_conversion_func(adc_channel) & 0x0FFFU);
+	}
+
+	float raw_count = ((count_at_nominal_supply * HOST_HAL_ADC_NOMINAL_SUPPLY_VOLTAGE) / m_adc_supply_voltage) + 0.5f;
+
+	if(raw_count < 0.5f)
+	{
+		return 0U;
+	}
+
+	return (raw_count < (float)HOST_HAL_ADC_MAX_RAW_COUNT) ? (uint32_t)raw_count : HOST_HAL_ADC_MAX_RAW_COUNT;
+}
+
+static void raise_irq(IRQn_Type irqn)
+{
+	if(((uint32_t)irqn < HOST_HAL_IRQ_CNT) && (true == m_is_irq_enabled[irqn]) &&
+	   (NULL != m_irq_handlers[irqn]))
+	{
+		uint32_t preempted_exception_number = m_active_exception_number;
+
+		m_active_exception_number = 16U + (uint32_t)irqn;
+		m_irq_handlers[irqn]();
+		m_active_exception_number = preempted_exception_number;
+	}
+}
+
+uint32_t __get_IPSR(void)
+{
+	return m_active_exception_number;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file host_hal.h
+ * @brief Host side control interface of the HAL shim.
+ *
+ * The host HAL implements the STM32 HAL calls used by the bsp layer on plain
+ * RAM. This header lets host programs drive that fake hardware: advance the
+ * millisecond tick returned by HAL_GetTick(), provide the counts converted by
+ * ADC1, observe the PWM compare registers and receive the CAN frames queued by
+ * HAL_CAN_AddTxMessage().
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef HOST_HAL_H_
+#define HOST_HAL_H_
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "stm32f4xx_hal.h"
+
+/**
+ * @brief Provides the raw 12-bit conversion result of an ADC channel.
+ *
+ * @param[in] adc_channel ADC channel (ADC_CHANNEL_x) that is being converted.
+ * @return uint32_t Conversion result in counts (0..4095).
+ */
+typedef uint32_t (*host_hal_adc_conversion_func_t)(uint32_t adc_channel);
+
+/**
+ * @brief Receives every frame accepted by HAL_CAN_AddTxMessage().
+ *
+ * @param[in] tx_header_ptr Transmit header of the frame.
+ * @param[in] data_ptr      Payload of the frame (DLC bytes).
+ */
+typedef void (*host_hal_can_tx_func_t)(const CAN_TxHeaderTypeDef *tx_header_ptr,
+									   const uint8_t *data_ptr);
+
+/**
+ * @brief Observes every HAL_ADC_PollForConversion() call.
+ *
+ * @param[in] adc_channel        ADC channel (ADC_CHANNEL_x) that is being converted.
+ * @param[in] conversion_time_ns Time the target ADC needs for this conversion, the
+ *                               time the firmware blocks in the poll on the target.
+ */
+typedef void (*host_hal_adc_poll_func_t)(uint32_t adc_channel, uint32_t conversion_time_ns);
+
+/**
+ * @brief Interrupt handler of the vector table, e.g. ADC_IRQHandler().
+ */
+typedef void (*host_hal_irq_handler_t)(void);
+
+/**
+ * @brief Resets the tick, peripheral registers and registered hooks.
+ */
+void host_hal_reset(void);
+
+/**
+ * @brief Sets the millisecond tick returned by HAL_GetTick().
+ *
+ * Only the tick value changes, the elapsed virtual time used by the virtual CAN
+ * bus does not jump, so the tick may be set close to its wraparound.
+ *
+ * @param[in] tick_ms New tick value.
+ */
+void host_hal_set_tick(uint32_t tick_ms);
+
+/**
+ * @brief Advances the millisecond tick returned by HAL_GetTick().
+ *
+ * @param[in] elapsed_ms Number of milliseconds to add to the tick.
+ */
+void host_hal_advance_tick(uint32_t elapsed_ms);
+
+/**
+ * @brief Registers the source of ADC conversion results.
+ *
+ * If no source is registered every conversion returns 0 counts.
+ *
+ * @param[in] conversion_func Conversion source, NULL to unregister.
+ */
+void host_hal_register_adc_conversion_func(host_hal_adc_conversion_func_t conversion_func);
+
+/**
+ * @brief Sets the analog supply voltage VDDA the ADC is referenced to.
+ *
+ * The counts of the conversion source are taken as converted at the nominal
+ * 3.3 V and scaled to the set supply; VREFINT and the temperature sensor are
+ * converted by the host HAL from the factory calibration values. The supply
+ * is 3.3 V after host_hal_reset().
+ *
+ * @param[in] supply_voltage VDDA in volts.
+ */
+void host_hal_set_adc_supply_voltage(float supply_voltage);
+
+/**
+ * @brief Sets the die temperature seen by the MCU temperature sensor, 30 C after host_hal_reset().
+ *
+ * @param[in] temperature Die temperature in degrees Celsius.
+ */
+void host_hal_set_mcu_temperature(float temperature);
+
+/**
+ * @brief Sets the status returned by HAL_ADC_PollForConversion().
+ *
+ * A DMA scan started by HAL_ADC_Start_DMA() stops with the overrun flag while
+ * the status is not HAL_OK.
+ *
+ * @param[in] poll_status HAL_OK for a normal conversion, any other value to fail it.
+ */
+void host_hal_set_adc_poll_status(HAL_StatusTypeDef poll_status);
+
+/**
+ * @brief Converts one more sequence of a running DMA scan.
+ *
+ * The scan converts the sequences of the elapsed time whenever the tick
+ * advances; a host program that changes the conversion source between two
+ * ticks calls this so the latest sequence read by the firmware shows the
+ * change at once, like the continuous scan of the target.
+ */
+void host_hal_refresh_adc_dma_scan(void);
+
+/**
+ * @brief Registers an observer of the blocking ADC conversions.
+ *
+ * The conversion time follows from the ADC clock (PCLK2 and the prescaler of
+ * HAL_ADC_Init()), the resolution and the sampling time of the converted rank.
+ *
+ * @param[in] poll_func Observer, NULL to unregister.
+ */
+void host_hal_register_adc_poll_func(host_hal_adc_poll_func_t poll_func);
+
+/**
+ * @brief Registers the handler of an interrupt line, the host vector table.
+ *
+ * While the line is enabled by HAL_NVIC_EnableIRQ() the host HAL calls the
+ * handler when the peripheral raises the interrupt: at an injected end of
+ * conversion, once per TIM1 period for a TIM1 TRGO triggered injected group, at
+ * every conversion outside the analog watchdog window and at an ADC overrun.
+ * The handler runs synchronously inside the HAL call or tick
+ * advance that raised it.
+ *
+ * @param[in] irqn        Interrupt line.
+ * @param[in] irq_handler Handler, NULL to unregister.
+ */
+void host_hal_register_irq_handler(IRQn_Type irqn, host_hal_irq_handler_t irq_handler);
+
+/**
+ * @brief Registers the receiver of transmitted CAN frames.
+ *
+ * @param[in] can_tx_func Frame receiver, NULL to unregister.
+ */
+void host_hal_register_can_tx_func(host_hal_can_tx_func_t can_tx_func);
+
+/**
+ * @brief Returns the duty cycle currently programmed on a timer channel.
+ *
+ * @param[in] timer_ptr     Timer instance (e.g. TIM1).
+ * @param[in] timer_channel Timer channel (TIM_CHANNEL_x).
+ * @return float Duty cycle in the range 0.0 .. 1.0, 0.0 when the channel is stopped.
+ */
+float host_hal_get_pwm_duty(const TIM_TypeDef *timer_ptr, uint32_t timer_channel);
+
+/**
+ * @brief Returns whether the PWM output of a timer channel is enabled.
+ *
+ * @param[in] timer_ptr     Timer instance (e.g. TIM1).
+ * @param[in] timer_channel Timer channel (TIM_CHANNEL_x).
+ * @retval true  PWM output is running.
+ * @retval false PWM output is stopped.
+ */
+bool host_hal_is_pwm_running(const TIM_TypeDef *timer_ptr, uint32_t timer_channel);
+
+/**
+ * @brief Returns where in the switching period a timer triggered ADC converts.
+ *
+ * Only the TIM1 compare triggers of the regular group are modelled. Without a
+ * running trigger channel the ADC converts nothing: the DMA scan buffer keeps
+ * its values and HAL_ADC_PollForConversion() times out.
+ *
+ * @param[out] phase_ptr Compare value of the trigger channel as a fraction of
+ *                       the timer period, may be NULL.
+ * @retval true  The ADC is triggered by an enabled compare channel of a running TIM1.
+ * @retval false Conversions are started by software, or the trigger does not run.
+ */
+bool host_hal_get_adc_trigger_phase(float *phase_ptr);
+
+#endif /* HOST_HAL_H_ */
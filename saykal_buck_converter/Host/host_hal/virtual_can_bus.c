@@ -0,0 +1,483 @@
+/**
+ * @file virtual_can_bus.c
+ * @brief In-memory CAN bus behind HAL_CAN_AddTxMessage() of the host HAL.
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "virtual_can_bus.h"
+#include "string.h"
+
+#if defined(__linux__)
+#include "unistd.h"
+#include "fcntl.h"
+#include "net/if.h"
+#include "sys/ioctl.h"
+#include "sys/socket.h"
+#include "linux/can.h"
+#include "linux/can/raw.h"
+#endif
+
+/** @brief CRC delimiter, ACK slot, ACK delimiter, end of frame and intermission, never stuffed. */
+#define VIRTUAL_CAN_FRAME_TAIL_BIT_CNT	13U
+
+/** @brief Generator polynomial of the CAN CRC-15. */
+#define VIRTUAL_CAN_CRC15_POLYNOMIAL	0x4599U
+
+/** @brief Bit positions of the segment fields of CAN_InitTypeDef. */
+#define VIRTUAL_CAN_BS1_POS				16U
+#define VIRTUAL_CAN_BS2_POS				20U
+
+/**
+ * @brief A mailbox of the transmit path.
+ */
+typedef struct
+{
+	virtual_can_frame_t frame;
+	bool is_pending;
+
+}virtual_can_mailbox_t;
+
+/**
+ * @brief A subscription to frames of one CAN ID.
+ */
+typedef struct
+{
+	uint32_t can_id;
+	virtual_can_bus_rx_func_t rx_func;
+	void *context_ptr;
+
+}virtual_can_subscription_t;
+
+/**
+ * @brief Accumulates the stuffed bit stream of a frame and its CRC.
+ */
+typedef struct
+{
+	uint16_t bit_cnt;
+	uint16_t crc;
+	uint8_t run_length;
+	uint8_t last_bit;
+
+}virtual_can_bit_stream_t;
+
+static virtual_can_mailbox_t m_mailboxes[VIRTUAL_CAN_BUS_TX_MAILBOX_CNT];
+
+static virtual_can_subscription_t m_subscriptions[VIRTUAL_CAN_BUS_SUBSCRIBER_CNT];
+
+static uint32_t m_subscription_cnt = 0U;
+
+/** @brief Nominal bit time, 0 transmits frames without delay. */
+static uint32_t m_bit_time_ns = 0U;
+
+/** @brief Time the bus has been advanced to. */
+static uint64_t m_bus_time_ns = 0U;
+
+/** @brief Time the frame on the bus ends, or the bus went idle. */
+static uint64_t m_bus_free_time_ns = 0U;
+
+/** @brief Mailbox whose frame is on the bus, VIRTUAL_CAN_BUS_TX_MAILBOX_CNT when idle. */
+static uint32_t m_transmitting_mailbox_idx = VIRTUAL_CAN_BUS_TX_MAILBOX_CNT;
+
+/** @brief No node acknowledges, every frame is retransmitted and the mailboxes stay pending. */
+static bool m_is_bus_blocked = false;
+
+static virtual_can_bus_stats_t m_bus_stats;
+
+/** @brief Bound SocketCAN socket, -1 when not attached. */
+static int m_socketcan_fd = -1;
+
+static void add_frame_bits(virtual_can_bit_stream_t *bit_stream_ptr, uint32_t value, uint8_t bit_cnt,
+						   bool is_crc_covered);
+
+static uint16_t count_frame_bits(const virtual_can_frame_t *frame_ptr);
+
+static uint32_t get_arbitration_key(const virtual_can_frame_t *frame_ptr);
+
+static void start_next_frame(void);
+
+static void deliver_frame(const virtual_can_frame_t *frame_ptr);
+
+void reset_virtual_can_bus(void)
+{
+	memset(m_mailboxes, 0, sizeof(m_mailboxes));
+	memset(m_subscriptions, 0, sizeof(m_subscriptions));
+	memset(&m_bus_stats, 0, sizeof(m_bus_stats));
+	m_subscription_cnt = 0U;
+	m_bit_time_ns = 0U;
+	m_bus_time_ns = 0U;
+	m_bus_free_time_ns = 0U;
+	m_transmitting_mailbox_idx = VIRTUAL_CAN_BUS_TX_MAILBOX_CNT;
+	m_is_bus_blocked = false;
+}
+
+void configure_virtual_can_bus(uint32_t can_clock_hz, const CAN_InitTypeDef *init_ptr)
+{
+	uint32_t time_segment_1_tq = ((init_ptr->TimeSeg1 >> VIRTUAL_CAN_BS1_POS) & 0x0FU) + 1U;
+	uint32_t time_segment_2_tq = ((init_ptr->TimeSeg2 >> VIRTUAL_CAN_BS2_POS) & 0x07U) + 1U;
+	uint64_t tq_per_bit = 1U + time_segment_1_tq + time_segment_2_tq;
+
+	m_bit_time_ns = (0U != can_clock_hz) ?
+		(uint32_t)((init_ptr->Prescaler * tq_per_bit * 1000000000ULL) / can_clock_hz) : 0U;
+}
+
+HAL_StatusTypeDef queue_virtual_can_frame(const CAN_TxHeaderTypeDef *tx_header_ptr,
+										  const uint8_t *data_ptr,
+										  uint64_t now_ns,
+										  uint32_t *tx_mailbox_ptr)
+{
+	if(tx_header_ptr->DLC > 8U)
+	{
+		return HAL_ERROR;
+	}
+
+	advance_virtual_can_bus(now_ns);
+
+	uint32_t mailbox_idx = 0U;
+
+	while((mailbox_idx < VIRTUAL_CAN_BUS_TX_MAILBOX_CNT) && (true == m_mailboxes[mailbox_idx].is_pending))
+	{
+		mailbox_idx++;
+	}
+
+	if(VIRTUAL_CAN_BUS_TX_MAILBOX_CNT == mailbox_idx)
+	{
+		m_bus_stats.rejected_frame_cnt++;
+		return HAL_ERROR;
+	}
+
+	virtual_can_frame_t *frame_ptr = &m_mailboxes[mailbox_idx].frame;
+
+	memset(frame_ptr, 0, sizeof(*frame_ptr));
+	frame_ptr->is_extended = (CAN_ID_EXT == tx_header_ptr->IDE);
+	frame_ptr->can_id = (true == frame_ptr->is_extended) ?
+		(tx_header_ptr->ExtId & 0x1FFFFFFFUL) : (tx_header_ptr->StdId & 0x7FFUL);
+	frame_ptr->dlc = (uint8_t)tx_header_ptr->DLC;
+	memcpy(frame_ptr->data, data_ptr, frame_ptr->dlc);
+	frame_ptr->mailbox_idx = (uint8_t)mailbox_idx;
+	frame_ptr->bit_cnt = count_frame_bits(frame_ptr);
+	frame_ptr->queued_time_ns = m_bus_time_ns;
+
+	m_mailboxes[mailbox_idx].is_pending = true;
+	*tx_mailbox_ptr = CAN_TX_MAILBOX0 << mailbox_idx;
+
+	/* an idle bus starts the frame at once, before later frames of the same instant arrive */
+	advance_virtual_can_bus(now_ns);
+
+	return HAL_OK;
+}
+
+void advance_virtual_can_bus(uint64_t now_ns)
+{
+	if(now_ns > m_bus_time_ns)
+	{
+		m_bus_time_ns = now_ns;
+	}
+
+	while(true)
+	{
+		if(true == m_is_bus_blocked)
+		{
+			break;
+		}
+
+		if(VIRTUAL_CAN_BUS_TX_MAILBOX_CNT == m_transmitting_mailbox_idx)
+		{
+			start_next_frame();
+
+			if(VIRTUAL_CAN_BUS_TX_MAILBOX_CNT == m_transmitting_mailbox_idx)
+			{
+				break;
+			}
+		}
+
+		virtual_can_mailbox_t *mailbox_ptr = &m_mailboxes[m_transmitting_mailbox_idx];
+
+		if(mailbox_ptr->frame.end_time_ns > m_bus_time_ns)
+		{
+			break;
+		}
+
+		/* the mailbox is free before the receivers run, as after the TX complete interrupt */
+		virtual_can_frame_t completed_frame = mailbox_ptr->frame;
+
+		mailbox_ptr->is_pending = false;
+		m_transmitting_mailbox_idx = VIRTUAL_CAN_BUS_TX_MAILBOX_CNT;
+		m_bus_free_time_ns = completed_frame.end_time_ns;
+		m_bus_stats.transmitted_frame_cnt++;
+		m_bus_stats.busy_time_ns += completed_frame.end_time_ns - completed_frame.start_time_ns;
+
+		deliver_frame(&completed_frame);
+	}
+}
+
+void set_virtual_can_bus_blocked(bool is_blocked)
+{
+	if(is_blocked == m_is_bus_blocked)
+	{
+		return;
+	}
+
+	if(true == is_blocked)
+	{
+		/* the frame on the bus loses its acknowledge and stays pending for a retransmission */
+		m_transmitting_mailbox_idx = VIRTUAL_CAN_BUS_TX_MAILBOX_CNT;
+	}
+	else if(m_bus_time_ns > m_bus_free_time_ns)
+	{
+		m_bus_free_time_ns = m_bus_time_ns;
+	}
+
+	m_is_bus_blocked = is_blocked;
+	advance_virtual_can_bus(m_bus_time_ns);
+}
+
+uint32_t get_virtual_can_bus_free_mailbox_cnt(void)
+{
+	uint32_t free_mailbox_cnt = 0U;
+
+	for(uint32_t mailbox_idx = 0U; mailbox_idx < VIRTUAL_CAN_BUS_TX_MAILBOX_CNT; mailbox_idx++)
+	{
+		if(false == m_mailboxes[mailbox_idx].is_pending)
+		{
+			free_mailbox_cnt++;
+		}
+	}
+
+	return free_mailbox_cnt;
+}
+
+bool subscribe_virtual_can_bus(uint32_t can_id, virtual_can_bus_rx_func_t rx_func, void *context_ptr)
+{
+	if((NULL == rx_func) || (VIRTUAL_CAN_BUS_SUBSCRIBER_CNT == m_subscription_cnt))
+	{
+		return false;
+	}
+
+	m_subscriptions[m_subscription_cnt].can_id = can_id;
+	m_subscriptions[m_subscription_cnt].rx_func = rx_func;
+	m_subscriptions[m_subscription_cnt].context_ptr = context_ptr;
+	m_subscription_cnt++;
+
+	return true;
+}
+
+void get_virtual_can_bus_stats(virtual_can_bus_stats_t *stats_ptr)
+{
+	*stats_ptr = m_bus_stats;
+}
+
+uint32_t get_virtual_can_bus_bit_time_ns(void)
+{
+	return m_bit_time_ns;
+}
+
+bool attach_virtual_can_bus_socketcan(const char *interface_name)
+{
+#if defined(__linux__)
+	if(m_socketcan_fd >= 0)
+	{
+		close(m_socketcan_fd);
+		m_socketcan_fd = -1;
+	}
+
+	if(NULL == interface_name)
+	{
+		return true;
+	}
+
+	unsigned int interface_idx = if_nametoindex(interface_name);
+
+	if(0U == interface_idx)
+	{
+		return false;
+	}
+
+	int socket_fd = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK, CAN_RAW);
+
+	if(socket_fd < 0)
+	{
+		return false;
+	}
+
+	struct sockaddr_can socket_address;
+
+	memset(&socket_address, 0, sizeof(socket_address));
+	socket_address.can_family = AF_CAN;
+	socket_address.can_ifindex = (int)interface_idx;
+
+	if(0 != bind(socket_fd, (struct sockaddr *)&socket_address, sizeof(socket_address)))
+	{
+		close(socket_fd);
+		return false;
+	}
+
+	m_socketcan_fd = socket_fd;
+
+	return true;
+#else
+	(void)interface_name;
+	return false;
+#endif
+}
+
+/**
+ * @brief Appends bits MSB first, inserting a stuff bit after five equal bits.
+ */
+static void add_frame_bits(virtual_can_bit_stream_t *bit_stream_ptr, uint32_t value, uint8_t bit_cnt,
+						   bool is_crc_covered)
+{
+	for(int8_t bit_idx = (int8_t)(bit_cnt - 1U); bit_idx >= 0; bit_idx--)
+	{
+		uint8_t bit = (uint8_t)((value >> bit_idx) & 1U);
+
+		if(true == is_crc_covered)
+		{
+			uint16_t crc_next = (uint16_t)(bit ^ ((bit_stream_ptr->crc >> 14) & 1U));
+
+			bit_stream_ptr->crc = (uint16_t)((bit_stream_ptr->crc << 1) & 0x7FFFU);
+
+			if(0U != crc_next)
+			{
+				bit_stream_ptr->crc ^= VIRTUAL_CAN_CRC15_POLYNOMIAL;
+			}
+		}
+
+		if((bit_stream_ptr->bit_cnt > 0U) && (bit == bit_stream_ptr->last_bit))
+		{
+			bit_stream_ptr->run_length++;
+		}
+		else
+		{
+			bit_stream_ptr->run_length = 1U;
+		}
+
+		bit_stream_ptr->last_bit = bit;
+		bit_stream_ptr->bit_cnt++;
+
+		if(5U == bit_stream_ptr->run_length)
+		{
+			/* the complementary stuff bit starts the next run */
+			bit_stream_ptr->last_bit = (uint8_t)(bit ^ 1U);
+			bit_stream_ptr->run_length = 1U;
+			bit_stream_ptr->bit_cnt++;
+		}
+	}
+}
+
+/**
+ * @brief Returns the length of a data frame on the wire, stuff bits included.
+ */
+static uint16_t count_frame_bits(const virtual_can_frame_t *frame_ptr)
+{
+	virtual_can_bit_stream_t bit_stream = { 0 };
+
+	add_frame_bits(&bit_stream, 0U, 1U, true);									// SOF
+
+	if(true == frame_ptr->is_extended)
+	{
+		add_frame_bits(&bit_stream, frame_ptr->can_id >> 18, 11U, true);		// base ID
+		add_frame_bits(&bit_stream, 0x3U, 2U, true);							// SRR, IDE recessive
+		add_frame_bits(&bit_stream, frame_ptr->can_id & 0x3FFFFUL, 18U, true);	// ID extension
+		add_frame_bits(&bit_stream, 0U, 3U, true);								// RTR, r1, r0
+	}
+	else
+	{
+		add_frame_bits(&bit_stream, frame_ptr->can_id, 11U, true);				// ID
+		add_frame_bits(&bit_stream, 0U, 3U, true);								// RTR, IDE, r0
+	}
+
+	add_frame_bits(&bit_stream, frame_ptr->dlc, 4U, true);
+
+	for(uint8_t byte_idx = 0U; byte_idx < frame_ptr->dlc; byte_idx++)
+	{
+		add_frame_bits(&bit_stream, frame_ptr->data[byte_idx], 8U, true);
+	}
+
+	add_frame_bits(&bit_stream, bit_stream.crc, 15U, false);
+
+	return (uint16_t)(bit_stream.bit_cnt + VIRTUAL_CAN_FRAME_TAIL_BIT_CNT);
+}
+
+/**
+ * @brief Returns the value the identifier field puts on the bus, lower wins arbitration.
+ *
+ * A standard frame beats an extended frame with the same base ID through its dominant IDE bit.
+ */
+static uint32_t get_arbitration_key(const virtual_can_frame_t *frame_ptr)
+{
+	if(true == frame_ptr->is_extended)
+	{
+		return ((frame_ptr->can_id >> 18) << 20) | (1UL << 19) | (frame_ptr->can_id & 0x3FFFFUL);
+	}
+
+	return frame_ptr->can_id << 20;
+}
+
+/**
+ * @brief Puts the highest priority pending frame on an idle bus.
+ */
+static void start_next_frame(void)
+{
+	uint32_t best_mailbox_idx = VIRTUAL_CAN_BUS_TX_MAILBOX_CNT;
+
+	for(uint32_t mailbox_idx = 0U; mailbox_idx < VIRTUAL_CAN_BUS_TX_MAILBOX_CNT; mailbox_idx++)
+	{
+		if((true == m_mailboxes[mailbox_idx].is_pending) &&
+		   ((VIRTUAL_CAN_BUS_TX_MAILBOX_CNT == best_mailbox_idx) ||
+			(get_arbitration_key(&m_mailboxes[mailbox_idx].frame) <
+			 get_arbitration_key(&m_mailboxes[best_mailbox_idx].frame))))
+		{
+			best_mailbox_idx = mailbox_idx;
+		}
+	}
+
+	if(VIRTUAL_CAN_BUS_TX_MAILBOX_CNT == best_mailbox_idx)
+	{
+		return;
+	}
+
+	virtual_can_frame_t *frame_ptr = &m_mailboxes[best_mailbox_idx].frame;
+
+	frame_ptr->start_time_ns = (m_bus_free_time_ns > frame_ptr->queued_time_ns) ?
+		m_bus_free_time_ns : frame_ptr->queued_time_ns;
+	frame_ptr->end_time_ns = frame_ptr->start_time_ns + ((uint64_t)frame_ptr->bit_cnt * m_bit_time_ns);
+	m_transmitting_mailbox_idx = best_mailbox_idx;
+}
+
+/**
+ * @brief Hands a completed frame to the subscribers and the SocketCAN interface.
+ */
+static void deliver_frame(const virtual_can_frame_t *frame_ptr)
+{
+	for(uint32_t subscription_idx = 0U; subscription_idx < m_subscription_cnt; subscription_idx++)
+	{
+		const virtual_can_subscription_t *subscription_ptr = &m_subscriptions[subscription_idx];
+
+		if((VIRTUAL_CAN_BUS_ANY_ID == subscription_ptr->can_id) || (frame_ptr->can_id == subscription_ptr->can_id))
+		{
+			subscription_ptr->rx_func(frame_ptr, subscription_ptr->context_ptr);
+		}
+	}
+
+#if defined(__linux__)
+	if(m_socketcan_fd >= 0)
+	{
+		struct can_frame socketcan_frame;
+
+		memset(&socketcan_frame, 0, sizeof(socketcan_frame));
+		socketcan_frame.can_id = frame_ptr->can_id | ((true == frame_ptr->is_extended) ? CAN_EFF_FLAG : 0U);
+		socketcan_frame.can_dlc = frame_ptr->dlc;
+		memcpy(socketcan_frame.data, frame_ptr->data, frame_ptr->dlc);
+
+		if(sizeof(socketcan_frame) == write(m_socketcan_fd, &socketcan_frame, sizeof(socketcan_frame)))
+		{
+			m_bus_stats.socketcan_forwarded_cnt++;
+		}
+		else
+		{
+			m_bus_stats.socketcan_dropped_cnt++;
+		}
+	}
+#endif
+}
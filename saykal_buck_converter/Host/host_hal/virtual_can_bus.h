@@ -0,0 +1,165 @@
+/**
+ * @file virtual_can_bus.h
+ * @brief In-memory CAN bus behind HAL_CAN_AddTxMessage() of the host HAL.
+ *
+ * The bus models the bxCAN transmit path of the STM32F4: three TX mailboxes,
+ * identifier priority between pending mailboxes and a serial bus whose frame
+ * durations follow from the bit timing programmed by HAL_CAN_Init(), including
+ * bit stuffing of the actual frame contents. HAL_CAN_AddTxMessage() fails with
+ * HAL_ERROR when all three mailboxes are pending, exactly like the real HAL.
+ *
+ * Time is the elapsed virtual time of the host HAL in nanoseconds, which keeps
+ * counting when the 32-bit millisecond tick wraps around: frames queued during
+ * a main loop iteration are queued at the start of that millisecond, and the
+ * bus transmits while the host program advances the tick. Every frame carries
+ * the time it was queued and the time its transmission started and ended, so
+ * frame rates, bus load and queuing latency of the firmware messages can be
+ * measured. Host programs subscribe to frames by CAN ID; subscribers are called
+ * when a frame completes on the bus. Delivered frames are optionally forwarded
+ * to a Linux SocketCAN interface such as vcan0.
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef VIRTUAL_CAN_BUS_H_
+#define VIRTUAL_CAN_BUS_H_
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "stm32f4xx_hal.h"
+
+/** @brief Number of transmit mailboxes of bxCAN. */
+#define VIRTUAL_CAN_BUS_TX_MAILBOX_CNT		3U
+
+/** @brief Maximum number of subscriptions. */
+#define VIRTUAL_CAN_BUS_SUBSCRIBER_CNT		16U
+
+/** @brief CAN ID of a subscription that receives every frame. */
+#define VIRTUAL_CAN_BUS_ANY_ID				0xFFFFFFFFUL
+
+/**
+ * @brief Frame transmitted on the virtual bus.
+ */
+typedef struct
+{
+	uint32_t can_id;						///< 11 or 29 bit identifier
+	bool is_extended;						///< 29 bit identifier
+	uint8_t dlc;							///< Data length code, 0..8
+	uint8_t data[8];						///< Payload
+	uint8_t mailbox_idx;					///< TX mailbox the frame was queued in
+	uint16_t bit_cnt;						///< Bits on the wire including stuff bits and interframe space
+	uint64_t queued_time_ns;				///< Time HAL_CAN_AddTxMessage() accepted the frame
+	uint64_t start_time_ns;					///< Time the frame won arbitration
+	uint64_t end_time_ns;					///< Time the frame was completed on the bus
+
+}virtual_can_frame_t;
+
+/**
+ * @brief Receives a frame completed on the bus.
+ *
+ * @param[in] frame_ptr   Transmitted frame.
+ * @param[in] context_ptr Context given at subscription.
+ */
+typedef void (*virtual_can_bus_rx_func_t)(const virtual_can_frame_t *frame_ptr, void *context_ptr);
+
+/**
+ * @brief Counters of the bus since the last reset.
+ */
+typedef struct
+{
+	uint64_t transmitted_frame_cnt;			///< Frames completed on the bus
+	uint64_t rejected_frame_cnt;			///< HAL_CAN_AddTxMessage() calls refused with all mailboxes pending
+	uint64_t busy_time_ns;					///< Time the bus carried frames
+	uint64_t socketcan_forwarded_cnt;		///< Frames written to the SocketCAN interface
+	uint64_t socketcan_dropped_cnt;			///< Frames the SocketCAN interface did not accept
+
+}virtual_can_bus_stats_t;
+
+/**
+ * @brief Empties the mailboxes, removes the subscriptions and restarts the bus time at 0.
+ *
+ * The SocketCAN adapter stays attached. Called by host_hal_reset().
+ */
+void reset_virtual_can_bus(void);
+
+/**
+ * @brief Sets the bit time from the bit timing of HAL_CAN_Init().
+ *
+ * @param[in] can_clock_hz CAN kernel clock (PCLK1).
+ * @param[in] init_ptr     Bit timing written by the firmware.
+ */
+void configure_virtual_can_bus(uint32_t can_clock_hz, const CAN_InitTypeDef *init_ptr);
+
+/**
+ * @brief Queues a frame in a free mailbox, the backend of HAL_CAN_AddTxMessage().
+ *
+ * @param[in]  tx_header_ptr   Transmit header.
+ * @param[in]  data_ptr        Payload of DLC bytes.
+ * @param[in]  now_ns          Current virtual time.
+ * @param[out] tx_mailbox_ptr  CAN_TX_MAILBOXx of the used mailbox.
+ * @retval HAL_OK    The frame is queued.
+ * @retval HAL_ERROR All mailboxes are pending or the header is invalid.
+ */
+HAL_StatusTypeDef queue_virtual_can_frame(const CAN_TxHeaderTypeDef *tx_header_ptr,
+										  const uint8_t *data_ptr,
+										  uint64_t now_ns,
+										  uint32_t *tx_mailbox_ptr);
+
+/**
+ * @brief Transmits the pending frames up to the given virtual time.
+ *
+ * @param[in] now_ns Current virtual time, earlier times are ignored.
+ */
+void advance_virtual_can_bus(uint64_t now_ns);
+
+/**
+ * @brief Blocks or releases the bus, e.g. to fill the TX mailboxes of the firmware.
+ *
+ * A blocked bus behaves like a bus without any other node: no frame is
+ * acknowledged, the frame being transmitted is aborted and every frame stays
+ * pending in its mailbox until the bus is released.
+ *
+ * @param[in] is_blocked true to block the bus, false to release it at the current time.
+ */
+void set_virtual_can_bus_blocked(bool is_blocked);
+
+/**
+ * @brief Returns the number of free TX mailboxes.
+ *
+ * @return uint32_t Free mailboxes, 0..VIRTUAL_CAN_BUS_TX_MAILBOX_CNT.
+ */
+uint32_t get_virtual_can_bus_free_mailbox_cnt(void);
+
+/**
+ * @brief Subscribes to the frames of one CAN ID.
+ *
+ * @param[in] can_id      Identifier, VIRTUAL_CAN_BUS_ANY_ID for every frame.
+ * @param[in] rx_func     Receiver, called in the order of subscription.
+ * @param[in] context_ptr Context passed to rx_func.
+ * @return true if the subscription was added, false if all slots are used.
+ */
+bool subscribe_virtual_can_bus(uint32_t can_id, virtual_can_bus_rx_func_t rx_func, void *context_ptr);
+
+/**
+ * @brief Returns the counters of the bus.
+ *
+ * @param[out] stats_ptr Counters.
+ */
+void get_virtual_can_bus_stats(virtual_can_bus_stats_t *stats_ptr);
+
+/**
+ * @brief Returns the nominal bit time configured by HAL_CAN_Init().
+ *
+ * @return uint32_t Bit time in nanoseconds, 0 before HAL_CAN_Init().
+ */
+uint32_t get_virtual_can_bus_bit_time_ns(void);
+
+/**
+ * @brief Forwards every completed frame to a SocketCAN interface.
+ *
+ * @param[in] interface_name Interface such as "vcan0", NULL to detach.
+ * @return true if the interface exists and is bound, false otherwise (the bus keeps working).
+ */
+bool attach_virtual_can_bus_socketcan(const char *interface_name);
+
+#endif /* VIRTUAL_CAN_BUS_H_ */
@@ -0,0 +1,49 @@
+/**
+ * @file host_main.c
+ * @brief Host entry point of the firmware.
+ *
+ * Runs the same main loop as Core/Src/main.c on top of the host HAL. The loop
+ * is bounded by a virtual run time so that the firmware can be executed as a
+ * normal Linux program. Every loop iteration advances the virtual tick by one
+ * millisecond.
+ *
+ * Usage: buck_converter_host [run_time_ms]
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "host_hal.h"
+#include "system_manager.h"
+#include "error_manager.h"
+#include "bsp_adc.h"
+
+/** @brief Virtual run time used when no argument is given. */
+#define HOST_MAIN_DEFAULT_RUN_TIME_MS 10000U
+
+int main(int argc, char *argv[])
+{
+	uint32_t run_time_ms = HOST_MAIN_DEFAULT_RUN_TIME_MS;
+
+	if(argc > 1)
+	{
+		run_time_ms = (uint32_t)strtoul(argv[1], NULL, 10);
+	}
+
+	host_hal_reset();
+	host_hal_register_irq_handler(ADC_IRQn, handle_bsp_adc_interrupt);
+	host_hal_register_irq_handler(DMA2_Stream0_IRQn, handle_bsp_adc_dma_interrupt);
+
+	for(uint32_t elapsed_ms = 0U; elapsed_ms < run_time_ms; elapsed_ms++)
+	{
+		run_state_machine_of_system_manager();
+		host_hal_advance_tick(1U);
+	}
+
+	printf("run_time_ms=%u system_error_status=0x%02X\n",
+		   (unsigned)run_time_ms,
+		   (unsigned)get_system_error_status());
+
+	return EXIT_SUCCESS;
+}
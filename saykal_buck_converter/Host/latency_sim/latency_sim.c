@@ -0,0 +1,562 @@
+/**
+ * @file latency_sim.c
+ * @brief Discrete-event model of the main loop and the interrupts of the firmware.
+ *
+ * The CPU is a stack of contexts: the main loop at the bottom and the interrupt
+ * handlers that preempted it above. Between two events only the top context makes
+ * progress, so the model jumps from event to event: the next interrupt arrival or
+ * the end of the work of the top context, whichever comes first.
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "latency_sim.h"
+#include "stdlib.h"
+#include "string.h"
+#include "math.h"
+
+/** @brief Priority of the main loop, below every NVIC priority. */
+#define LATENCY_SIM_MAIN_PRIORITY		0x100U
+
+/** @brief Context index of the main loop. */
+#define LATENCY_SIM_MAIN_CONTEXT		LATENCY_SIM_ISR_CNT
+
+/**
+ * @brief Work of the main loop that is currently executed.
+ */
+typedef enum
+{
+	LATENCY_SIM_MAIN_OVERHEAD_e,			///< State machine and timer scan of one iteration
+	LATENCY_SIM_MAIN_CALLBACK_e,			///< Timer callback
+
+}latency_sim_main_phase_e;
+
+/**
+ * @brief Context on the CPU stack.
+ */
+typedef struct
+{
+	uint32_t context_idx;					///< latency_sim_isr_e or LATENCY_SIM_MAIN_CONTEXT
+	uint32_t priority;
+	uint64_t remaining_ns;
+	uint64_t arrival_ns;
+
+}latency_sim_context_t;
+
+/**
+ * @brief Growable array of durations.
+ */
+typedef struct
+{
+	uint64_t *values_ns;
+	uint32_t cnt;
+	uint32_t capacity;
+	bool is_out_of_memory;
+
+}latency_sim_samples_t;
+
+/**
+ * @brief State of one model run.
+ */
+typedef struct
+{
+	const latency_sim_cfg_t *cfg_ptr;
+	uint64_t now_ns;
+	uint32_t tick_ms;
+	uint32_t random_state;
+
+	latency_sim_context_t stack[LATENCY_SIM_ISR_CNT + 1U];
+	uint32_t stack_depth;
+
+	uint64_t isr_next_arrival_ns[LATENCY_SIM_ISR_CNT];
+	uint32_t isr_arrival_idx[LATENCY_SIM_ISR_CNT];
+	bool is_isr_pending[LATENCY_SIM_ISR_CNT];
+	uint64_t isr_pending_arrival_ns[LATENCY_SIM_ISR_CNT];
+	uint64_t isr_cost_ns[LATENCY_SIM_ISR_CNT];
+
+	latency_sim_main_phase_e main_phase;
+	uint32_t main_timer_idx;
+	uint32_t main_tick_snapshot_ms;
+	uint64_t main_iteration_start_ns;
+	uint64_t loop_cost_ns;
+	uint32_t timer_start_ticks_ms[LATENCY_SIM_TIMER_CNT];
+
+	bool is_observed_started;
+	uint64_t observed_last_start_ns;
+	latency_sim_samples_t gaps;
+	latency_sim_samples_t latencies;
+
+	uint64_t busy_ns;
+	uint64_t max_loop_iteration_ns;
+	latency_sim_result_t *result_ptr;
+
+}latency_sim_t;
+
+static const char *const m_isr_names[LATENCY_SIM_ISR_CNT] =
+{
+	"systick",
+	"pwm",
+	"adc",
+	"can",
+};
+
+static uint64_t convert_cycles_to_ns(const latency_sim_cfg_t *cfg_ptr, double cycles);
+
+static double draw_callback_cost_cycles(latency_sim_t *sim_ptr, const latency_sim_timer_cfg_t *timer_cfg_ptr);
+
+static void schedule_next_isr_arrival(latency_sim_t *sim_ptr, uint32_t isr_idx);
+
+static uint32_t find_next_isr_arrival(const latency_sim_t *sim_ptr);
+
+static void dispatch_pending_isrs(latency_sim_t *sim_ptr);
+
+static void complete_top_context(latency_sim_t *sim_ptr);
+
+static void advance_main_loop(latency_sim_t *sim_ptr);
+
+static bool is_main_loop_busy(const latency_sim_t *sim_ptr);
+
+static void add_sample(latency_sim_samples_t *samples_ptr, uint64_t value_ns);
+
+static void summarize_samples(latency_sim_samples_t *samples_ptr, latency_sim_distribution_t *distribution_ptr);
+
+static int compare_durations(const void *left_ptr, const void *right_ptr);
+
+bool run_latency_sim(const latency_sim_cfg_t *cfg_ptr, latency_sim_result_t *result_ptr)
+{
+	if((NULL == cfg_ptr) || (NULL == result_ptr) || (0U == cfg_ptr->core_clock_hz) ||
+	   (cfg_ptr->timer_cnt > LATENCY_SIM_TIMER_CNT) || (cfg_ptr->observed_timer_id >= cfg_ptr->timer_cnt))
+	{
+		return false;
+	}
+
+	latency_sim_t *sim_ptr = calloc(1U, sizeof(latency_sim_t));
+
+	if(NULL == sim_ptr)
+	{
+		return false;
+	}
+
+	memset(result_ptr, 0, sizeof(*result_ptr));
+
+	sim_ptr->cfg_ptr = cfg_ptr;
+	sim_ptr->result_ptr = result_ptr;
+	sim_ptr->random_state = (0U != cfg_ptr->seed) ? cfg_ptr->seed : 1U;
+	sim_ptr->loop_cost_ns = convert_cycles_to_ns(cfg_ptr, (double)cfg_ptr->loop_cost_cycles);
+
+	/* a main loop iteration must take time, otherwise an idle loop would never let time pass */
+	if(0U == sim_ptr->loop_cost_ns)
+	{
+		sim_ptr->loop_cost_ns = 1U;
+	}
+
+	for(uint32_t isr_idx = 0U; isr_idx < LATENCY_SIM_ISR_CNT; isr_idx++)
+	{
+		sim_ptr->isr_cost_ns[isr_idx] = convert_cycles_to_ns(cfg_ptr, (double)cfg_ptr->isrs[isr_idx].cost_cycles);
+		sim_ptr->isr_next_arrival_ns[isr_idx] = UINT64_MAX;
+		schedule_next_isr_arrival(sim_ptr, isr_idx);
+	}
+
+	for(uint32_t timer_idx = 0U; timer_idx < cfg_ptr->timer_cnt; timer_idx++)
+	{
+		sim_ptr->timer_start_ticks_ms[timer_idx] = cfg_ptr->timers[timer_idx].start_tick_ms;
+	}
+
+	sim_ptr->stack[0].context_idx = LATENCY_SIM_MAIN_CONTEXT;
+	sim_ptr->stack[0].priority = LATENCY_SIM_MAIN_PRIORITY;
+	sim_ptr->stack[0].remaining_ns = sim_ptr->loop_cost_ns;
+	sim_ptr->stack_depth = 1U;
+	sim_ptr->main_phase = LATENCY_SIM_MAIN_OVERHEAD_e;
+
+	while(sim_ptr->now_ns < cfg_ptr->duration_ns)
+	{
+		latency_sim_context_t *top_ptr = &sim_ptr->stack[sim_ptr->stack_depth - 1U];
+		uint64_t completion_ns = sim_ptr->now_ns + top_ptr->remaining_ns;
+		uint32_t arriving_isr = find_next_isr_arrival(sim_ptr);
+		uint64_t arrival_ns = (LATENCY_SIM_ISR_CNT != arriving_isr) ?
+			sim_ptr->isr_next_arrival_ns[arriving_isr] : UINT64_MAX;
+		uint64_t event_ns = (arrival_ns <= completion_ns) ? arrival_ns : completion_ns;
+
+		if(event_ns > cfg_ptr->duration_ns)
+		{
+			event_ns = cfg_ptr->duration_ns;
+		}
+
+		uint64_t elapsed_ns = event_ns - sim_ptr->now_ns;
+		bool is_top_busy = (LATENCY_SIM_MAIN_CONTEXT != top_ptr->context_idx) || is_main_loop_busy(sim_ptr);
+
+		if(true == is_top_busy)
+		{
+			sim_ptr->busy_ns += elapsed_ns;
+		}
+
+		top_ptr->remaining_ns -= elapsed_ns;
+		sim_ptr->now_ns = event_ns;
+
+		if(event_ns == cfg_ptr->duration_ns)
+		{
+			break;
+		}
+
+		if(event_ns == arrival_ns)
+		{
+			if(true == sim_ptr->is_isr_pending[arriving_isr])
+			{
+				result_ptr->isr_lost_cnt[arriving_isr]++;
+			}
+			else
+			{
+				sim_ptr->is_isr_pending[arriving_isr] = true;
+				sim_ptr->isr_pending_arrival_ns[arriving_isr] = arrival_ns;
+			}
+
+			schedule_next_isr_arrival(sim_ptr, arriving_isr);
+		}
+		else
+		{
+			complete_top_context(sim_ptr);
+		}
+
+		dispatch_pending_isrs(sim_ptr);
+	}
+
+	summarize_samples(&sim_ptr->gaps, &result_ptr->gap);
+	summarize_samples(&sim_ptr->latencies, &result_ptr->latency);
+
+	result_ptr->cpu_load_percent = (0U != cfg_ptr->duration_ns) ?
+		(100.0 * (double)sim_ptr->busy_ns / (double)cfg_ptr->duration_ns) : 0.0;
+	result_ptr->max_loop_iteration_us = (double)sim_ptr->max_loop_iteration_ns * 1e-3;
+	result_ptr->final_tick_ms = sim_ptr->tick_ms;
+
+	bool is_out_of_memory = sim_ptr->gaps.is_out_of_memory || sim_ptr->latencies.is_out_of_memory;
+
+	free(sim_ptr->gaps.values_ns);
+	free(sim_ptr->latencies.values_ns);
+	free(sim_ptr);
+
+	return (false == is_out_of_memory);
+}
+
+const char *get_latency_sim_isr_name(latency_sim_isr_e isr)
+{
+	return (isr < LATENCY_SIM_ISR_CNT) ? m_isr_names[isr] : "unknown";
+}
+
+static uint64_t convert_cycles_to_ns(const latency_sim_cfg_t *cfg_ptr, double cycles)
+{
+	return (uint64_t)llround(cycles * 1e9 / (double)cfg_ptr->core_clock_hz);
+}
+
+/**
+ * @brief Draws a callback cost between the measured minimum and maximum with the measured mean.
+ *
+ * A triangular distribution is used when its mode can match the mean. Costs with
+ * rare long executions have a mean too close to the minimum for that; they are
+ * drawn from an exponential tail above the minimum, cut at the maximum.
+ */
+static double draw_callback_cost_cycles(latency_sim_t *sim_ptr, const latency_sim_timer_cfg_t *timer_cfg_ptr)
+{
+	double cost_min = timer_cfg_ptr->cost_min_cycles;
+	double cost_mean = timer_cfg_ptr->cost_mean_cycles;
+	double cost_max = timer_cfg_ptr->cost_max_cycles;
+
+	if(true == sim_ptr->cfg_ptr->is_worst_case)
+	{
+		return cost_max;
+	}
+
+	if((cost_max <= cost_min) || (cost_mean <= cost_min))
+	{
+		return cost_min;
+	}
+
+	/* xorshift32 */
+	sim_ptr->random_state ^= sim_ptr->random_state << 13U;
+	sim_ptr->random_state ^= sim_ptr->random_state >> 17U;
+	sim_ptr->random_state ^= sim_ptr->random_state << 5U;
+
+	double uniform = ((double)sim_ptr->random_state + 0.5) / 4294967296.0;
+	double cost_range = cost_max - cost_min;
+
+	/* the mean of a triangular distribution is (min + mode + max) / 3 */
+	double cost_mode = (3.0 * cost_mean) - cost_min - cost_max;
+
+	if(cost_mode < cost_min)
+	{
+		return fmin(cost_min - ((cost_mean - cost_min) * log(uniform)), cost_max);
+	}
+
+	cost_mode = fmin(cost_mode, cost_max);
+
+	if(uniform < ((cost_mode - cost_min) / cost_range))
+	{
+		return cost_min + sqrt(uniform * cost_range * (cost_mode - cost_min));
+	}
+
+	return cost_max - sqrt((1.0 - uniform) * cost_range * (cost_max - cost_mode));
+}
+
+static void schedule_next_isr_arrival(latency_sim_t *sim_ptr, uint32_t isr_idx)
+{
+	const latency_sim_isr_cfg_t *isr_cfg_ptr = &sim_ptr->cfg_ptr->isrs[isr_idx];
+	uint32_t arrival_idx = sim_ptr->isr_arrival_idx[isr_idx];
+
+	sim_ptr->isr_next_arrival_ns[isr_idx] = UINT64_MAX;
+
+	if(false == isr_cfg_ptr->is_enabled)
+	{
+		return;
+	}
+
+	if(0U != isr_cfg_ptr->period_ns)
+	{
+		sim_ptr->isr_next_arrival_ns[isr_idx] = isr_cfg_ptr->first_arrival_ns + ((uint64_t)arrival_idx * isr_cfg_ptr->period_ns);
+	}
+	else if((NULL != isr_cfg_ptr->arrival_times_ns) && (arrival_idx < isr_cfg_ptr->arrival_cnt))
+	{
+		sim_ptr->isr_next_arrival_ns[isr_idx] = isr_cfg_ptr->arrival_times_ns[arrival_idx];
+	}
+	else
+	{
+		return;
+	}
+
+	sim_ptr->isr_arrival_idx[isr_idx] = arrival_idx + 1U;
+}
+
+static uint32_t find_next_isr_arrival(const latency_sim_t *sim_ptr)
+{
+	uint32_t next_isr = LATENCY_SIM_ISR_CNT;
+	uint64_t next_arrival_ns = UINT64_MAX;
+
+	for(uint32_t isr_idx = 0U; isr_idx < LATENCY_SIM_ISR_CNT; isr_idx++)
+	{
+		if(sim_ptr->isr_next_arrival_ns[isr_idx] < next_arrival_ns)
+		{
+			next_arrival_ns = sim_ptr->isr_next_arrival_ns[isr_idx];
+			next_isr = isr_idx;
+		}
+	}
+
+	return next_isr;
+}
+
+/**
+ * @brief Starts pending interrupts that preempt the top context, highest priority first.
+ *
+ * Equal priorities do not preempt each other; among pending interrupts of equal
+ * priority the lower source index wins, like the lower IRQ number on the NVIC.
+ */
+static void dispatch_pending_isrs(latency_sim_t *sim_ptr)
+{
+	while(true)
+	{
+		uint32_t top_priority = sim_ptr->stack[sim_ptr->stack_depth - 1U].priority;
+		uint32_t selected_isr = LATENCY_SIM_ISR_CNT;
+		uint32_t selected_priority = top_priority;
+
+		for(uint32_t isr_idx = 0U; isr_idx < LATENCY_SIM_ISR_CNT; isr_idx++)
+		{
+			if((true == sim_ptr->is_isr_pending[isr_idx]) &&
+			   (sim_ptr->cfg_ptr->isrs[isr_idx].priority < selected_priority))
+			{
+				selected_isr = isr_idx;
+				selected_priority = sim_ptr->cfg_ptr->isrs[isr_idx].priority;
+			}
+		}
+
+		if(LATENCY_SIM_ISR_CNT == selected_isr)
+		{
+			return;
+		}
+
+		latency_sim_context_t *context_ptr = &sim_ptr->stack[sim_ptr->stack_depth];
+
+		context_ptr->context_idx = selected_isr;
+		context_ptr->priority = selected_priority;
+		context_ptr->remaining_ns = sim_ptr->isr_cost_ns[selected_isr];
+		context_ptr->arrival_ns = sim_ptr->isr_pending_arrival_ns[selected_isr];
+
+		sim_ptr->is_isr_pending[selected_isr] = false;
+		sim_ptr->stack_depth++;
+	}
+}
+
+static void complete_top_context(latency_sim_t *sim_ptr)
+{
+	latency_sim_context_t *top_ptr = &sim_ptr->stack[sim_ptr->stack_depth - 1U];
+
+	if(LATENCY_SIM_MAIN_CONTEXT == top_ptr->context_idx)
+	{
+		advance_main_loop(sim_ptr);
+		return;
+	}
+
+	latency_sim_result_t *result_ptr = sim_ptr->result_ptr;
+	double response_us = (double)(sim_ptr->now_ns - top_ptr->arrival_ns) * 1e-3;
+
+	result_ptr->isr_cnt[top_ptr->context_idx]++;
+
+	if(response_us > result_ptr->isr_max_response_us[top_ptr->context_idx])
+	{
+		result_ptr->isr_max_response_us[top_ptr->context_idx] = response_us;
+	}
+
+	if(LATENCY_SIM_ISR_SYSTICK_e == top_ptr->context_idx)
+	{
+		sim_ptr->tick_ms++;
+	}
+
+	sim_ptr->stack_depth--;
+}
+
+/**
+ * @brief Finishes the current main loop work and selects the next one.
+ *
+ * Mirrors run_all_software_timers(): the tick is read once per iteration, the
+ * timers are checked in id order and a timer is reloaded after its callback.
+ */
+static void advance_main_loop(latency_sim_t *sim_ptr)
+{
+	const latency_sim_cfg_t *cfg_ptr = sim_ptr->cfg_ptr;
+	latency_sim_context_t *main_ptr = &sim_ptr->stack[0];
+
+	if(LATENCY_SIM_MAIN_OVERHEAD_e == sim_ptr->main_phase)
+	{
+		sim_ptr->main_tick_snapshot_ms = sim_ptr->tick_ms;
+		sim_ptr->main_timer_idx = 0U;
+	}
+	else
+	{
+		const latency_sim_timer_cfg_t *timer_cfg_ptr = &cfg_ptr->timers[sim_ptr->main_timer_idx];
+
+		if(true == timer_cfg_ptr->is_auto_reload)
+		{
+			sim_ptr->timer_start_ticks_ms[sim_ptr->main_timer_idx] = sim_ptr->tick_ms;
+		}
+		else
+		{
+			sim_ptr->timer_start_ticks_ms[sim_ptr->main_timer_idx] += timer_cfg_ptr->period_ms;
+		}
+
+		sim_ptr->main_timer_idx++;
+	}
+
+	for(; sim_ptr->main_timer_idx < cfg_ptr->timer_cnt; sim_ptr->main_timer_idx++)
+	{
+		uint32_t timer_idx = sim_ptr->main_timer_idx;
+		const latency_sim_timer_cfg_t *timer_cfg_ptr = &cfg_ptr->timers[timer_idx];
+
+		if((false == timer_cfg_ptr->is_enabled) ||
+		   ((sim_ptr->main_tick_snapshot_ms - sim_ptr->timer_start_ticks_ms[timer_idx]) < timer_cfg_ptr->period_ms))
+		{
+			continue;
+		}
+
+		if(cfg_ptr->observed_timer_id == timer_idx)
+		{
+			uint64_t due_ns = (uint64_t)(sim_ptr->timer_start_ticks_ms[timer_idx] + timer_cfg_ptr->period_ms) * 1000000U;
+			uint64_t latency_ns = (sim_ptr->now_ns > due_ns) ? (sim_ptr->now_ns - due_ns) : 0U;
+
+			if(true == sim_ptr->is_observed_started)
+			{
+				add_sample(&sim_ptr->gaps, sim_ptr->now_ns - sim_ptr->observed_last_start_ns);
+			}
+
+			add_sample(&sim_ptr->latencies, latency_ns);
+
+			if(latency_ns >= ((uint64_t)timer_cfg_ptr->period_ms * 1000000U))
+			{
+				sim_ptr->result_ptr->missed_period_cnt++;
+			}
+
+			sim_ptr->is_observed_started = true;
+			sim_ptr->observed_last_start_ns = sim_ptr->now_ns;
+		}
+
+		sim_ptr->main_phase = LATENCY_SIM_MAIN_CALLBACK_e;
+		main_ptr->remaining_ns = convert_cycles_to_ns(cfg_ptr, draw_callback_cost_cycles(sim_ptr, timer_cfg_ptr));
+		return;
+	}
+
+	uint64_t iteration_ns = sim_ptr->now_ns - sim_ptr->main_iteration_start_ns;
+
+	if(iteration_ns > sim_ptr->max_loop_iteration_ns)
+	{
+		sim_ptr->max_loop_iteration_ns = iteration_ns;
+	}
+
+	sim_ptr->main_iteration_start_ns = sim_ptr->now_ns;
+	sim_ptr->main_phase = LATENCY_SIM_MAIN_OVERHEAD_e;
+	main_ptr->remaining_ns = sim_ptr->loop_cost_ns;
+}
+
+/**
+ * @brief Returns whether the main loop executes a callback rather than idling through the timer scan.
+ */
+static bool is_main_loop_busy(const latency_sim_t *sim_ptr)
+{
+	return (LATENCY_SIM_MAIN_CALLBACK_e == sim_ptr->main_phase);
+}
+
+static void add_sample(latency_sim_samples_t *samples_ptr, uint64_t value_ns)
+{
+	if(samples_ptr->cnt == samples_ptr->capacity)
+	{
+		uint32_t capacity = (0U != samples_ptr->capacity) ? (2U * samples_ptr->capacity) : 1024U;
+		uint64_t *values_ns = realloc(samples_ptr->values_ns, capacity * sizeof(uint64_t));
+
+		if(NULL == values_ns)
+		{
+			samples_ptr->is_out_of_memory = true;
+			return;
+		}
+
+		samples_ptr->values_ns = values_ns;
+		samples_ptr->capacity = capacity;
+	}
+
+	samples_ptr->values_ns[samples_ptr->cnt++] = value_ns;
+}
+
+/**
+ * @brief Computes the distribution of the samples, nearest-rank percentiles.
+ */
+static void summarize_samples(latency_sim_samples_t *samples_ptr, latency_sim_distribution_t *distribution_ptr)
+{
+	uint32_t sample_cnt = samples_ptr->cnt;
+
+	memset(distribution_ptr, 0, sizeof(*distribution_ptr));
+	distribution_ptr->sample_cnt = sample_cnt;
+
+	if(0U == sample_cnt)
+	{
+		return;
+	}
+
+	qsort(samples_ptr->values_ns, sample_cnt, sizeof(uint64_t), compare_durations);
+
+	double sum_ns = 0.0;
+
+	for(uint32_t sample_idx = 0U; sample_idx < sample_cnt; sample_idx++)
+	{
+		sum_ns += (double)samples_ptr->values_ns[sample_idx];
+	}
+
+	const uint64_t *values_ns = samples_ptr->values_ns;
+
+	distribution_ptr->min_us = (double)values_ns[0] * 1e-3;
+	distribution_ptr->mean_us = sum_ns * 1e-3 / (double)sample_cnt;
+	distribution_ptr->p50_us = (double)values_ns[(uint32_t)ceil(0.5 * sample_cnt) - 1U] * 1e-3;
+	distribution_ptr->p99_us = (double)values_ns[(uint32_t)ceil(0.99 * sample_cnt) - 1U] * 1e-3;
+	distribution_ptr->p999_us = (double)values_ns[(uint32_t)ceil(0.999 * sample_cnt) - 1U] * 1e-3;
+	distribution_ptr->max_us = (double)values_ns[sample_cnt - 1U] * 1e-3;
+}
+
+static int compare_durations(const void *left_ptr, const void *right_ptr)
+{
+	uint64_t left_ns = *(const uint64_t *)left_ptr;
+	uint64_t right_ns = *(const uint64_t *)right_ptr;
+
+	return (left_ns > right_ns) - (left_ns < right_ns);
+}
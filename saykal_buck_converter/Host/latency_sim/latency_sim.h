@@ -0,0 +1,144 @@
+/**
+ * @file latency_sim.h
+ * @brief Discrete-event model of the main loop and the interrupts of the firmware.
+ *
+ * The firmware runs everything from while(1) run_state_machine_of_system_manager():
+ * the software timer callbacks execute one after another in the main loop and every
+ * enabled interrupt preempts them. The model replays that on a virtual CPU with a
+ * nanosecond time base:
+ *
+ * - interrupt sources arrive periodically or at given times, preempt the main loop
+ *   and each other by NVIC priority (lower value preempts higher), and an arrival
+ *   while the same source is still pending is lost like a pending bit set twice
+ * - the SysTick source advances the millisecond tick seen by the main loop
+ * - every main loop iteration costs loop_cost_cycles, then reads the tick once and
+ *   runs the due timer callbacks in timer order with the same reload rules as
+ *   software_timer.c; the cost of a callback is drawn from the measured minimum,
+ *   mean and maximum, or is always the maximum in the worst case mode, and
+ *   includes any blocking ADC polling
+ *
+ * The result is the distribution of the gap between two invocations of one
+ * observed timer, normally the control loop, and its start latency relative to
+ * the millisecond the timer became due.
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef LATENCY_SIM_H_
+#define LATENCY_SIM_H_
+
+#include "stdint.h"
+#include "stdbool.h"
+
+/** @brief Maximum number of modelled software timers. */
+#define LATENCY_SIM_TIMER_CNT		16U
+
+/**
+ * @brief Modelled interrupt sources.
+ */
+typedef enum
+{
+	LATENCY_SIM_ISR_SYSTICK_e = 0,		///< HAL tick, advances the millisecond tick
+	LATENCY_SIM_ISR_PWM_e,				///< TIM1 update of the buck MOSFET PWM
+	LATENCY_SIM_ISR_ADC_e,				///< ADC end of conversion
+	LATENCY_SIM_ISR_CAN_e,				///< CAN TX mailbox empty
+	LATENCY_SIM_ISR_CNT,
+
+}latency_sim_isr_e;
+
+/**
+ * @brief Configuration of one interrupt source.
+ */
+typedef struct
+{
+	bool is_enabled;
+	uint8_t priority;						///< NVIC preemption priority, 0 is the highest
+	uint32_t cost_cycles;					///< Entry, handler and exit
+	uint64_t period_ns;						///< Arrival period, 0 selects arrival_times_ns
+	uint64_t first_arrival_ns;				///< First arrival of a periodic source
+	const uint64_t *arrival_times_ns;		///< Sorted arrival times of an aperiodic source
+	uint32_t arrival_cnt;					///< Number of arrival_times_ns
+
+}latency_sim_isr_cfg_t;
+
+/**
+ * @brief Configuration of one software timer.
+ */
+typedef struct
+{
+	bool is_enabled;
+	bool is_auto_reload;					///< TIMER_RELOAD_AUTO_e, otherwise TIMER_RELOAD_PERIODIC_e
+	uint32_t period_ms;						///< Timeout value given to start_software_timer()
+	uint32_t start_tick_ms;					///< Tick at start_software_timer()
+	float cost_min_cycles;					///< Shortest callback execution
+	float cost_mean_cycles;					///< Mean callback execution
+	float cost_max_cycles;					///< Longest callback execution
+
+}latency_sim_timer_cfg_t;
+
+/**
+ * @brief Model configuration.
+ */
+typedef struct
+{
+	uint32_t core_clock_hz;					///< Target core clock, converts the cycle costs to time
+	uint64_t duration_ns;					///< Simulated time
+	uint32_t loop_cost_cycles;				///< Main loop iteration without callbacks
+	uint32_t seed;							///< Seed of the callback cost draws
+	bool is_worst_case;						///< Every callback costs its maximum instead of a draw
+	latency_sim_isr_cfg_t isrs[LATENCY_SIM_ISR_CNT];
+	latency_sim_timer_cfg_t timers[LATENCY_SIM_TIMER_CNT];
+	uint32_t timer_cnt;
+	uint32_t observed_timer_id;				///< Timer whose invocation gaps are reported
+
+}latency_sim_cfg_t;
+
+/**
+ * @brief Distribution of a measured time.
+ */
+typedef struct
+{
+	uint32_t sample_cnt;
+	double min_us;
+	double mean_us;
+	double p50_us;
+	double p99_us;
+	double p999_us;
+	double max_us;
+
+}latency_sim_distribution_t;
+
+/**
+ * @brief Result of a model run.
+ */
+typedef struct
+{
+	latency_sim_distribution_t gap;			///< Time between two starts of the observed timer callback
+	latency_sim_distribution_t latency;		///< Callback start minus the millisecond it became due
+	uint32_t missed_period_cnt;				///< Invocations that started a full period or more after becoming due
+	double cpu_load_percent;				///< Share of the time spent in callbacks and interrupts
+	double max_loop_iteration_us;			///< Longest main loop iteration including preemption
+	uint64_t isr_cnt[LATENCY_SIM_ISR_CNT];	///< Handled interrupts per source
+	uint64_t isr_lost_cnt[LATENCY_SIM_ISR_CNT];	///< Arrivals merged into an already pending interrupt
+	double isr_max_response_us[LATENCY_SIM_ISR_CNT];	///< Longest arrival to handler end time
+	uint32_t final_tick_ms;					///< Millisecond tick at the end, lags the time if SysTick was lost
+
+}latency_sim_result_t;
+
+/**
+ * @brief Runs the model.
+ *
+ * The function has no global state and may run in several threads at once.
+ *
+ * @param[in]  cfg_ptr    Model configuration.
+ * @param[out] result_ptr Result.
+ * @return true on success, false on an invalid configuration or out of memory.
+ */
+bool run_latency_sim(const latency_sim_cfg_t *cfg_ptr, latency_sim_result_t *result_ptr);
+
+/**
+ * @brief Returns the name of an interrupt source.
+ */
+const char *get_latency_sim_isr_name(latency_sim_isr_e isr);
+
+#endif /* LATENCY_SIM_H_ */
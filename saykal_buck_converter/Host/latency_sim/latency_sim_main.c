@@ -0,0 +1,602 @@
+/**
+ * @file latency_sim_main.c
+ * @brief Control loop latency of the firmware main loop under interrupt load.
+ *
+ * Measures the software timer callbacks of the firmware in the closed-loop plant
+ * simulator: their periods, reload options and execution costs, plus the ADC
+ * conversions they block on in HAL_ADC_PollForConversion(). The discrete-event
+ * model of latency_sim.h then replays the main loop with these costs on the
+ * target core clock, preempted by the enabled interrupt sources, and reports
+ * the distribution of the gap between two control loop invocations and their
+ * start latency. With --sweep the model is repeated for every shorter control
+ * period to find the shortest one that is never missed.
+ *
+ * The callback statistics are reset after a warm-up, so the first calls with
+ * cold caches and page faults on the host do not become the maximum cost.
+ * Host callback times are converted with --cpu-scale target cycles per host
+ * nanosecond, a rough estimate. --costs replaces them by the statistics measured
+ * on the target (the timer execution statistics message), which already contain
+ * the ADC polling.
+ *
+ * Only SysTick is enabled by default, like in the firmware. The other sources
+ * are enabled with --isr NAME:COST_CYCLES[:PRIORITY[:PERIOD_US]]; the PWM and ADC
+ * sources default to the PWM period of TIM1 and the CAN source to the completion
+ * times of the frames on the virtual CAN bus.
+ *
+ * Usage: buck_latency_sim [options]
+ *   --duration-ms N        measured and simulated time (default 60000)
+ *   --core-clock-hz F      target core clock (default HSE_VALUE, the product clock tree)
+ *   --cpu-scale S          target cycles per host nanosecond of callback time (default 1)
+ *   --costs PATH           CSV timer_id,min_us,mean_us,max_us measured on the target
+ *   --loop-cycles N        main loop iteration without callbacks (default 200)
+ *   --isr SPEC             enable or override an interrupt source, NAME:off disables it
+ *   --seed N               seed of the callback cost draws (default 1)
+ *   --worst-case           every callback costs its measured maximum
+ *   --warmup-ms N          callback statistics are reset after N ms (default 1000)
+ *   --sweep                repeat for every control period from 1 ms to the configured one
+ *   --max-latency-us X     exit 1 if the worst control loop start latency exceeds X
+ *
+ * Exits 1 if the configured control period is missed at least once.
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "math.h"
+#include "getopt.h"
+#include "plant_simulator.h"
+#include "latency_sim.h"
+#include "host_hal.h"
+#include "virtual_can_bus.h"
+#include "software_timer.h"
+
+extern const software_timer_general_cfg_t g_software_timer_general_config;
+
+/**
+ * @brief What the measurement run learned about one software timer.
+ */
+typedef struct
+{
+	uint32_t call_cnt;
+	uint32_t first_call_ms;
+	uint32_t last_call_ms;
+	uint32_t adc_call_idx;					///< Completed calls when the current ADC sum started
+	uint64_t adc_call_ns;					///< ADC conversion time of the current call
+	uint64_t adc_total_ns;
+	uint64_t adc_min_ns;
+	uint64_t adc_max_ns;
+	uint32_t adc_call_cnt;					///< Calls with at least one conversion
+
+}latency_measured_timer_t;
+
+/**
+ * @brief State of the measurement run.
+ */
+typedef struct
+{
+	latency_measured_timer_t timers[SOFTWARE_TIMER_CNT];
+	uint64_t *can_end_times_ns;
+	uint32_t can_frame_cnt;
+	uint32_t can_frame_capacity;
+
+}latency_measurement_t;
+
+static latency_measurement_t m_measurement;
+
+static bool handle_plant_sample(const plant_simulator_sample_t *sample_ptr, void *context_ptr);
+
+static void handle_adc_poll(uint32_t adc_channel, uint32_t conversion_time_ns);
+
+static void handle_can_frame(const virtual_can_frame_t *frame_ptr, void *context_ptr);
+
+static void close_adc_call(latency_measured_timer_t *measured_ptr);
+
+static bool read_target_costs(const char *path, latency_sim_cfg_t *cfg_ptr);
+
+static bool parse_isr_spec(const char *spec, latency_sim_cfg_t *cfg_ptr);
+
+static void print_distribution(const char *name, const latency_sim_distribution_t *distribution_ptr);
+
+int main(int argc, char *argv[])
+{
+	static const struct option long_options[] =
+	{
+		{ "duration-ms",    required_argument, NULL, 'd' },
+		{ "core-clock-hz",  required_argument, NULL, 'f' },
+		{ "cpu-scale",      required_argument, NULL, 'S' },
+		{ "costs",          required_argument, NULL, 'c' },
+		{ "loop-cycles",    required_argument, NULL, 'l' },
+		{ "isr",            required_argument, NULL, 'i' },
+		{ "seed",           required_argument, NULL, 's' },
+		{ "worst-case",     no_argument,       NULL, 'W' },
+		{ "warmup-ms",      required_argument, NULL, 'u' },
+		{ "sweep",          no_argument,       NULL, 'w' },
+		{ "max-latency-us", required_argument, NULL, 'm' },
+		{ NULL, 0, NULL, 0 },
+	};
+
+	static latency_sim_cfg_t sim_cfg;
+
+	const char *isr_specs[16];
+	uint32_t isr_spec_cnt = 0U;
+	uint32_t duration_ms = 60000U;
+	uint32_t warmup_ms = 1000U;
+	double cpu_scale = 1.0;
+	const char *costs_path = NULL;
+	bool is_sweep_enabled = false;
+	double max_latency_us = INFINITY;
+	int option;
+
+	sim_cfg.core_clock_hz = HSE_VALUE;
+	sim_cfg.loop_cost_cycles = 200U;
+	sim_cfg.seed = 1U;
+
+	while(-1 != (option = getopt_long(argc, argv, "", long_options, NULL)))
+	{
+		switch(option)
+		{
+			case 'd': duration_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'f': sim_cfg.core_clock_hz = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'S': cpu_scale = strtod(optarg, NULL); break;
+			case 'c': costs_path = optarg; break;
+			case 'l': sim_cfg.loop_cost_cycles = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 's': sim_cfg.seed = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'W': sim_cfg.is_worst_case = true; break;
+			case 'u': warmup_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'w': is_sweep_enabled = true; break;
+			case 'm': max_latency_us = strtod(optarg, NULL); break;
+			case 'i':
+			{
+				if(isr_spec_cnt < (sizeof(isr_specs) / sizeof(isr_specs[0])))
+				{
+					isr_specs[isr_spec_cnt++] = optarg;
+				}
+				break;
+			}
+			default:
+			{
+				fprintf(stderr, "usage: %s [--duration-ms N] [--costs PATH] [--isr NAME:COST_CYCLES[:PRIORITY[:PERIOD_US]]] [--sweep] ...\n", argv[0]);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	if((0U == duration_ms) || (0U == sim_cfg.core_clock_hz) || (cpu_scale < 0.0))
+	{
+		fprintf(stderr, "--duration-ms, --core-clock-hz and --cpu-scale must be positive\n");
+		return EXIT_FAILURE;
+	}
+
+	if(warmup_ms >= duration_ms)
+	{
+		fprintf(stderr, "--warmup-ms must be shorter than --duration-ms\n");
+		return EXIT_FAILURE;
+	}
+
+	/* measurement: the firmware closed loop with the callback costs and ADC conversions observed */
+	plant_simulator_cfg_t plant_cfg;
+	get_default_plant_simulator_cfg(&plant_cfg);
+	init_plant_simulator(&plant_cfg);
+
+	host_hal_register_adc_poll_func(handle_adc_poll);
+	subscribe_virtual_can_bus(VIRTUAL_CAN_BUS_ANY_ID, handle_can_frame, &m_measurement);
+
+	uint32_t simulated_ms = run_plant_simulator(warmup_ms, NULL, NULL);
+
+	reset_software_timer_exec_stats();
+	memset(m_measurement.timers, 0, sizeof(m_measurement.timers));
+
+	simulated_ms += run_plant_simulator(duration_ms - warmup_ms, handle_plant_sample, &m_measurement);
+
+	sim_cfg.duration_ns = (uint64_t)simulated_ms * 1000000U;
+	sim_cfg.timer_cnt = SOFTWARE_TIMER_CNT;
+	sim_cfg.observed_timer_id = BUCK_CONVERTER_PID_SOFTWARE_TIMER_ID;
+
+	double cycles_per_us = (double)sim_cfg.core_clock_hz * 1e-6;
+
+	for(software_timer_id_t timer_id = 0U; timer_id < SOFTWARE_TIMER_CNT; timer_id++)
+	{
+		latency_measured_timer_t *measured_ptr = &m_measurement.timers[timer_id];
+		latency_sim_timer_cfg_t *timer_cfg_ptr = &sim_cfg.timers[timer_id];
+		software_timer_exec_stats_t exec_stats;
+
+		close_adc_call(measured_ptr);
+
+		/* two calls give the period, the first call gives the phase of the timer */
+		if(measured_ptr->call_cnt < 2U)
+		{
+			continue;
+		}
+
+		timer_cfg_ptr->is_enabled = true;
+		timer_cfg_ptr->is_auto_reload =
+			(TIMER_RELOAD_AUTO_e == g_software_timer_general_config.software_timer_cfg_ptr[timer_id].reload_option);
+		timer_cfg_ptr->period_ms = (uint32_t)lround((double)(measured_ptr->last_call_ms - measured_ptr->first_call_ms) /
+													 (double)(measured_ptr->call_cnt - 1U));
+		/* the model starts at tick 0, keep the phase of the measured calls */
+		timer_cfg_ptr->start_tick_ms = measured_ptr->first_call_ms % timer_cfg_ptr->period_ms;
+
+		if((true == get_software_timer_exec_stats(timer_id, &exec_stats)) && (0U != exec_stats.cycle_frequency_hz))
+		{
+			double host_ns_per_cycle = 1e9 / (double)exec_stats.cycle_frequency_hz;
+			double adc_mean_ns = (0U != measured_ptr->call_cnt) ?
+				((double)measured_ptr->adc_total_ns / (double)measured_ptr->call_cnt) : 0.0;
+			double adc_min_ns = (measured_ptr->adc_call_cnt == measured_ptr->call_cnt) ? (double)measured_ptr->adc_min_ns : 0.0;
+
+			timer_cfg_ptr->cost_min_cycles = (float)(((double)exec_stats.min_cycles * host_ns_per_cycle * cpu_scale) +
+													 (adc_min_ns * cycles_per_us * 1e-3));
+			timer_cfg_ptr->cost_mean_cycles = (float)(((double)exec_stats.mean_cycles * host_ns_per_cycle * cpu_scale) +
+													  (adc_mean_ns * cycles_per_us * 1e-3));
+			timer_cfg_ptr->cost_max_cycles = (float)(((double)exec_stats.max_cycles * host_ns_per_cycle * cpu_scale) +
+													 ((double)measured_ptr->adc_max_ns * cycles_per_us * 1e-3));
+		}
+	}
+
+	if((NULL != costs_path) && (false == read_target_costs(costs_path, &sim_cfg)))
+	{
+		return EXIT_FAILURE;
+	}
+
+	if(false == sim_cfg.timers[sim_cfg.observed_timer_id].is_enabled)
+	{
+		fprintf(stderr, "the control loop timer %u did not run during the measurement\n",
+				(unsigned)sim_cfg.observed_timer_id);
+		return EXIT_FAILURE;
+	}
+
+	/* interrupt sources: only SysTick is enabled by the firmware */
+	uint64_t pwm_period_ns = ((uint64_t)(TIM1->PSC + 1U) * (uint64_t)(TIM1->ARR + 1U) * 1000000000U) /
+							 HAL_RCC_GetPCLK2Freq();
+
+	sim_cfg.isrs[LATENCY_SIM_ISR_SYSTICK_e] = (latency_sim_isr_cfg_t)
+	{
+		.is_enabled = true, .priority = 15U, .cost_cycles = 50U,
+		.period_ns = 1000000U, .first_arrival_ns = 1000000U,
+	};
+	sim_cfg.isrs[LATENCY_SIM_ISR_PWM_e] = (latency_sim_isr_cfg_t)
+	{
+		.is_enabled = false, .priority = 0U, .cost_cycles = 60U,
+		.period_ns = pwm_period_ns, .first_arrival_ns = pwm_period_ns,
+	};
+	sim_cfg.isrs[LATENCY_SIM_ISR_ADC_e] = (latency_sim_isr_cfg_t)
+	{
+		.is_enabled = false, .priority = 1U, .cost_cycles = 80U,
+		.period_ns = pwm_period_ns, .first_arrival_ns = pwm_period_ns,
+	};
+	sim_cfg.isrs[LATENCY_SIM_ISR_CAN_e] = (latency_sim_isr_cfg_t)
+	{
+		.is_enabled = false, .priority = 5U, .cost_cycles = 120U,
+		.arrival_times_ns = m_measurement.can_end_times_ns, .arrival_cnt = m_measurement.can_frame_cnt,
+	};
+
+	for(uint32_t spec_idx = 0U; spec_idx < isr_spec_cnt; spec_idx++)
+	{
+		if(false == parse_isr_spec(isr_specs[spec_idx], &sim_cfg))
+		{
+			fprintf(stderr, "invalid --isr %s, expected NAME:COST_CYCLES[:PRIORITY[:PERIOD_US]] or NAME:off\n",
+					isr_specs[spec_idx]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	printf("cost_source=%s cpu_scale=%.3f core_clock_hz=%u loop_cycles=%u cost_draw=%s simulated_ms=%u\n",
+		   (NULL != costs_path) ? costs_path : "host", cpu_scale, (unsigned)sim_cfg.core_clock_hz,
+		   (unsigned)sim_cfg.loop_cost_cycles, (true == sim_cfg.is_worst_case) ? "worst_case" : "random",
+		   (unsigned)simulated_ms);
+	printf("%-6s %-9s %9s %11s %12s %11s %10s\n",
+		   "timer", "reload", "period_ms", "cost_min_us", "cost_mean_us", "cost_max_us", "adc_max_us");
+
+	for(uint32_t timer_id = 0U; timer_id < sim_cfg.timer_cnt; timer_id++)
+	{
+		const latency_sim_timer_cfg_t *timer_cfg_ptr = &sim_cfg.timers[timer_id];
+
+		if(true == timer_cfg_ptr->is_enabled)
+		{
+			printf("%-6u %-9s %9u %11.2f %12.2f %11.2f %10.2f\n",
+				   (unsigned)timer_id, (true == timer_cfg_ptr->is_auto_reload) ? "auto" : "periodic",
+				   (unsigned)timer_cfg_ptr->period_ms,
+				   timer_cfg_ptr->cost_min_cycles / cycles_per_us,
+				   timer_cfg_ptr->cost_mean_cycles / cycles_per_us,
+				   timer_cfg_ptr->cost_max_cycles / cycles_per_us,
+				   (double)m_measurement.timers[timer_id].adc_max_ns * 1e-3);
+		}
+	}
+
+	latency_sim_result_t result;
+
+	if(false == run_latency_sim(&sim_cfg, &result))
+	{
+		fprintf(stderr, "latency model failed\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("%-8s %-7s %8s %8s %10s %10s %6s %15s\n",
+		   "isr", "enabled", "priority", "cost_us", "period_us", "handled", "lost", "max_response_us");
+
+	for(uint32_t isr_idx = 0U; isr_idx < LATENCY_SIM_ISR_CNT; isr_idx++)
+	{
+		const latency_sim_isr_cfg_t *isr_cfg_ptr = &sim_cfg.isrs[isr_idx];
+
+		printf("%-8s %-7s %8u %8.2f %10.1f %10llu %6llu %15.2f\n",
+			   get_latency_sim_isr_name((latency_sim_isr_e)isr_idx),
+			   (true == isr_cfg_ptr->is_enabled) ? "yes" : "no",
+			   (unsigned)isr_cfg_ptr->priority,
+			   (double)isr_cfg_ptr->cost_cycles / cycles_per_us,
+			   (0U != isr_cfg_ptr->period_ns) ? ((double)isr_cfg_ptr->period_ns * 1e-3) : 0.0,
+			   (unsigned long long)result.isr_cnt[isr_idx],
+			   (unsigned long long)result.isr_lost_cnt[isr_idx],
+			   result.isr_max_response_us[isr_idx]);
+	}
+
+	uint32_t control_period_ms = sim_cfg.timers[sim_cfg.observed_timer_id].period_ms;
+
+	printf("control_timer=%u period_ms=%u invocations=%u missed_periods=%u cpu_load_percent=%.3f max_loop_iteration_us=%.2f\n",
+		   (unsigned)sim_cfg.observed_timer_id, (unsigned)control_period_ms, (unsigned)result.latency.sample_cnt,
+		   (unsigned)result.missed_period_cnt, result.cpu_load_percent, result.max_loop_iteration_us);
+	print_distribution("gap_us", &result.gap);
+	print_distribution("latency_us", &result.latency);
+
+	bool is_gate_failed = (0U != result.missed_period_cnt) || (result.latency.max_us > max_latency_us);
+
+	if(true == is_sweep_enabled)
+	{
+		uint32_t min_feasible_period_ms = 0U;
+		bool is_period_missed = false;
+
+		printf("%-9s %10s %10s %14s %14s %6s %16s\n",
+			   "period_ms", "gap_p99_us", "gap_max_us", "latency_p99_us", "latency_max_us", "missed", "cpu_load_percent");
+
+		for(uint32_t period_ms = control_period_ms; period_ms >= 1U; period_ms--)
+		{
+			latency_sim_cfg_t sweep_cfg = sim_cfg;
+			latency_sim_result_t sweep_result;
+
+			sweep_cfg.timers[sweep_cfg.observed_timer_id].period_ms = period_ms;
+
+			if(false == run_latency_sim(&sweep_cfg, &sweep_result))
+			{
+				fprintf(stderr, "latency model failed\n");
+				return EXIT_FAILURE;
+			}
+
+			printf("%-9u %10.2f %10.2f %14.2f %14.2f %6u %16.3f\n",
+				   (unsigned)period_ms, sweep_result.gap.p99_us, sweep_result.gap.max_us,
+				   sweep_result.latency.p99_us, sweep_result.latency.max_us,
+				   (unsigned)sweep_result.missed_period_cnt, sweep_result.cpu_load_percent);
+
+			is_period_missed = is_period_missed || (0U != sweep_result.missed_period_cnt);
+
+			if(false == is_period_missed)
+			{
+				min_feasible_period_ms = period_ms;
+			}
+		}
+
+		printf("min_feasible_period_ms=%u\n", (unsigned)min_feasible_period_ms);
+	}
+
+	free(m_measurement.can_end_times_ns);
+
+	return (true == is_gate_failed) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+ * @brief Records the milliseconds in which each timer callback ran.
+ */
+static bool handle_plant_sample(const plant_simulator_sample_t *sample_ptr, void *context_ptr)
+{
+	latency_measurement_t *measurement_ptr = (latency_measurement_t *)context_ptr;
+
+	for(software_timer_id_t timer_id = 0U; timer_id < SOFTWARE_TIMER_CNT; timer_id++)
+	{
+		latency_measured_timer_t *measured_ptr = &measurement_ptr->timers[timer_id];
+		software_timer_exec_stats_t exec_stats;
+
+		if((false == get_software_timer_exec_stats(timer_id, &exec_stats)) ||
+		   (exec_stats.call_cnt == measured_ptr->call_cnt))
+		{
+			continue;
+		}
+
+		if(0U == measured_ptr->call_cnt)
+		{
+			measured_ptr->first_call_ms = sample_ptr->time_ms;
+		}
+
+		measured_ptr->call_cnt = exec_stats.call_cnt;
+		measured_ptr->last_call_ms = sample_ptr->time_ms;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Charges a blocking conversion to the timer callback that polls it.
+ *
+ * While a callback runs its timer is the only one in TIMER_STATE_TIMEOUT_e, the
+ * state is left after the callback returns.
+ */
+static void handle_adc_poll(uint32_t adc_channel, uint32_t conversion_time_ns)
+{
+	(void)adc_channel;
+
+	for(software_timer_id_t timer_id = 0U; timer_id < SOFTWARE_TIMER_CNT; timer_id++)
+	{
+		software_timer_exec_stats_t exec_stats;
+
+		if((TIMER_STATE_TIMEOUT_e != check_status_of_software_timer(timer_id)) ||
+		   (false == get_software_timer_exec_stats(timer_id, &exec_stats)))
+		{
+			continue;
+		}
+
+		latency_measured_timer_t *measured_ptr = &m_measurement.timers[timer_id];
+
+		if(exec_stats.call_cnt != measured_ptr->adc_call_idx)
+		{
+			close_adc_call(measured_ptr);
+			measured_ptr->adc_call_idx = exec_stats.call_cnt;
+		}
+
+		measured_ptr->adc_call_ns += conversion_time_ns;
+		measured_ptr->adc_total_ns += conversion_time_ns;
+		return;
+	}
+}
+
+static void handle_can_frame(const virtual_can_frame_t *frame_ptr, void *context_ptr)
+{
+	latency_measurement_t *measurement_ptr = (latency_measurement_t *)context_ptr;
+
+	if(measurement_ptr->can_frame_cnt == measurement_ptr->can_frame_capacity)
+	{
+		uint32_t capacity = (0U != measurement_ptr->can_frame_capacity) ? (2U * measurement_ptr->can_frame_capacity) : 1024U;
+		uint64_t *end_times_ns = realloc(measurement_ptr->can_end_times_ns, capacity * sizeof(uint64_t));
+
+		if(NULL == end_times_ns)
+		{
+			return;
+		}
+
+		measurement_ptr->can_end_times_ns = end_times_ns;
+		measurement_ptr->can_frame_capacity = capacity;
+	}
+
+	measurement_ptr->can_end_times_ns[measurement_ptr->can_frame_cnt++] = frame_ptr->end_time_ns;
+}
+
+/**
+ * @brief Adds the ADC time of the finished call to the per-call minimum and maximum.
+ */
+static void close_adc_call(latency_measured_timer_t *measured_ptr)
+{
+	if(0U == measured_ptr->adc_call_ns)
+	{
+		return;
+	}
+
+	if((0U == measured_ptr->adc_call_cnt) || (measured_ptr->adc_call_ns < measured_ptr->adc_min_ns))
+	{
+		measured_ptr->adc_min_ns = measured_ptr->adc_call_ns;
+	}
+
+	if(measured_ptr->adc_call_ns > measured_ptr->adc_max_ns)
+	{
+		measured_ptr->adc_max_ns = measured_ptr->adc_call_ns;
+	}
+
+	measured_ptr->adc_call_cnt++;
+	measured_ptr->adc_call_ns = 0U;
+}
+
+/**
+ * @brief Replaces the callback costs by statistics measured on the target.
+ *
+ * Every line is timer_id,min_us,mean_us,max_us; lines that do not start with a
+ * number, such as a header, are skipped.
+ */
+static bool read_target_costs(const char *path, latency_sim_cfg_t *cfg_ptr)
+{
+	FILE *costs_file_ptr = fopen(path, "r");
+
+	if(NULL == costs_file_ptr)
+	{
+		perror(path);
+		return false;
+	}
+
+	double cycles_per_us = (double)cfg_ptr->core_clock_hz * 1e-6;
+	char line[256];
+	uint32_t line_idx = 0U;
+	bool is_read_ok = true;
+
+	while(NULL != fgets(line, sizeof(line), costs_file_ptr))
+	{
+		unsigned timer_id;
+		double min_us;
+		double mean_us;
+		double max_us;
+
+		line_idx++;
+
+		if(4 != sscanf(line, "%u,%lf,%lf,%lf", &timer_id, &min_us, &mean_us, &max_us))
+		{
+			continue;
+		}
+
+		if((timer_id >= cfg_ptr->timer_cnt) || (min_us > mean_us) || (mean_us > max_us))
+		{
+			fprintf(stderr, "%s:%u: invalid cost line\n", path, (unsigned)line_idx);
+			is_read_ok = false;
+			break;
+		}
+
+		cfg_ptr->timers[timer_id].cost_min_cycles = (float)(min_us * cycles_per_us);
+		cfg_ptr->timers[timer_id].cost_mean_cycles = (float)(mean_us * cycles_per_us);
+		cfg_ptr->timers[timer_id].cost_max_cycles = (float)(max_us * cycles_per_us);
+	}
+
+	fclose(costs_file_ptr);
+
+	return is_read_ok;
+}
+
+static bool parse_isr_spec(const char *spec, latency_sim_cfg_t *cfg_ptr)
+{
+	char name[16];
+	char rest[64];
+
+	if(2 != sscanf(spec, "%15[^:]:%63s", name, rest))
+	{
+		return false;
+	}
+
+	for(uint32_t isr_idx = 0U; isr_idx < LATENCY_SIM_ISR_CNT; isr_idx++)
+	{
+		if(0 != strcmp(name, get_latency_sim_isr_name((latency_sim_isr_e)isr_idx)))
+		{
+			continue;
+		}
+
+		latency_sim_isr_cfg_t *isr_cfg_ptr = &cfg_ptr->isrs[isr_idx];
+
+		if(0 == strcmp(rest, "off"))
+		{
+			isr_cfg_ptr->is_enabled = false;
+			return true;
+		}
+
+		unsigned cost_cycles;
+		unsigned priority = isr_cfg_ptr->priority;
+		double period_us = -1.0;
+
+		if(sscanf(rest, "%u:%u:%lf", &cost_cycles, &priority, &period_us) < 1)
+		{
+			return false;
+		}
+
+		isr_cfg_ptr->is_enabled = true;
+		isr_cfg_ptr->cost_cycles = cost_cycles;
+		isr_cfg_ptr->priority = (uint8_t)priority;
+
+		if(period_us > 0.0)
+		{
+			isr_cfg_ptr->period_ns = (uint64_t)llround(period_us * 1e3);
+			isr_cfg_ptr->first_arrival_ns = isr_cfg_ptr->period_ns;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+static void print_distribution(const char *name, const latency_sim_distribution_t *distribution_ptr)
+{
+	printf("%s samples=%u min=%.2f mean=%.2f p50=%.2f p99=%.2f p999=%.2f max=%.2f\n",
+		   name, (unsigned)distribution_ptr->sample_cnt,
+		   distribution_ptr->min_us, distribution_ptr->mean_us, distribution_ptr->p50_us,
+		   distribution_ptr->p99_us, distribution_ptr->p999_us, distribution_ptr->max_us);
+}
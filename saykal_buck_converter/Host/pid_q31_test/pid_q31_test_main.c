@@ -0,0 +1,156 @@
+/**
+ * @file pid_q31_test_main.c
+ * @brief Equivalence test of the Q31 PID kernel against PID_Step_v2().
+ *
+ * Checks the saturating additions of pid_saturating_math.h at and around the
+ * INT32 limits, then steps PID_Step_q31() and PID_Step_v2() side by side
+ * through the same input sequence with the tuning and full scales of both
+ * product controllers. A fixed-point output further than
+ * PID_Q31_TEST_DEVIATION_MAX of its full scale from the float reference fails
+ * the test. Registered with CTest, the exit status is the result.
+ *
+ * Usage: buck_pid_q31_test
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "math.h"
+#include "pid_controller.h"
+#include "pid_saturating_math.h"
+#include "app_buck_converter.h"
+
+extern const buck_converter_cfg_t g_buck_converter_config;
+
+/** @brief Steps of the fixed-point to float comparison. */
+#define PID_Q31_TEST_STEP_CNT			20000U
+
+/** @brief Allowed PID_Step_q31() deviation from PID_Step_v2(), fraction of the output full scale. */
+#define PID_Q31_TEST_DEVIATION_MAX		1.0e-6
+
+/**
+ * @brief One saturating addition and its expected result.
+ */
+typedef struct
+{
+	int32_t op1;
+	int32_t op2;
+	int32_t sum;
+	int32_t difference;
+
+}pid_q31_test_saturation_case_t;
+
+static const pid_q31_test_saturation_case_t m_pid_q31_test_saturation_cases[] =
+{
+	{ 1000,       -3000,      -2000,          4000          },
+	{ INT32_MAX,  1,          INT32_MAX,      INT32_MAX - 1 },
+	{ INT32_MAX,  -1,         INT32_MAX - 1,  INT32_MAX     },
+	{ INT32_MIN,  -1,         INT32_MIN,      INT32_MIN + 1 },
+	{ INT32_MIN,  1,          INT32_MIN + 1,  INT32_MIN     },
+	{ INT32_MAX,  INT32_MAX,  INT32_MAX,      0             },
+	{ INT32_MIN,  INT32_MAX,  -1,             INT32_MIN     },
+	{ 0,          INT32_MIN,  INT32_MIN,      INT32_MAX     },
+};
+
+#define PID_Q31_TEST_SATURATION_CASE_CNT \
+	(sizeof(m_pid_q31_test_saturation_cases) / sizeof(m_pid_q31_test_saturation_cases[0]))
+
+static bool test_pid_saturating_math(void);
+static double get_pid_q31_deviation(const pid_controller_t *pid_parameters_ptr, float reference_point,
+									uint8_t input_shift, uint8_t output_shift);
+static bool test_pid_q31_deviation(const char *controller_name, const pid_controller_t *pid_parameters_ptr,
+								   float reference_point, uint8_t input_shift, uint8_t output_shift);
+
+int main(void)
+{
+	bool is_passed = test_pid_saturating_math();
+
+	is_passed &= test_pid_q31_deviation("voltage", g_buck_converter_config.pid_out_voltage_cotroller_ptr,
+										g_buck_converter_config.v_out_ref,
+										g_buck_converter_config.v_out_full_scale_shift,
+										g_buck_converter_config.i_out_full_scale_shift);
+	is_passed &= test_pid_q31_deviation("current", g_buck_converter_config.pid_out_current_cotroller_ptr,
+										g_buck_converter_config.i_out_max * 0.5f,
+										g_buck_converter_config.i_out_full_scale_shift,
+										g_buck_converter_config.duty_full_scale_shift);
+
+	return (true == is_passed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static bool test_pid_saturating_math(void)
+{
+	bool is_passed = true;
+
+	for(uint32_t case_idx = 0U; case_idx < PID_Q31_TEST_SATURATION_CASE_CNT; case_idx++)
+	{
+		const pid_q31_test_saturation_case_t *case_ptr = &m_pid_q31_test_saturation_cases[case_idx];
+		int32_t sum = add_pid_q31_saturated(case_ptr->op1, case_ptr->op2);
+		int32_t difference = sub_pid_q31_saturated(case_ptr->op1, case_ptr->op2);
+
+		if((sum != case_ptr->sum) || (difference != case_ptr->difference))
+		{
+			fprintf(stderr, "FAIL saturating math %ld, %ld: sum %ld (expected %ld), difference %ld (expected %ld)\n",
+					(long)case_ptr->op1, (long)case_ptr->op2, (long)sum, (long)case_ptr->sum,
+					(long)difference, (long)case_ptr->difference);
+			is_passed = false;
+		}
+	}
+
+	return is_passed;
+}
+
+/**
+ * @brief Steps a float and a fixed-point copy of a controller through the same inputs.
+ *
+ * The sensed value swings from 0 to twice the reference point with a slow
+ * sine and a fast triangle, so the run covers both output limits, the
+ * anti-windup and the derivative term.
+ *
+ * @return double Largest output difference, fraction of the output full scale.
+ */
+static double get_pid_q31_deviation(const pid_controller_t *pid_parameters_ptr, float reference_point,
+									uint8_t input_shift, uint8_t output_shift)
+{
+	pid_controller_v2_t pid_v2;
+	pid_controller_q31_t pid_q31;
+	double deviation_max = 0.0;
+
+	init_pid_controller_v2(&pid_v2, pid_parameters_ptr);
+	init_pid_controller_q31(&pid_q31, pid_parameters_ptr, input_shift, output_shift);
+
+	for(uint32_t step_idx = 0U; step_idx < PID_Q31_TEST_STEP_CNT; step_idx++)
+	{
+		float triangle = (float)(step_idx % 16U) / 16.0f;
+		float sensed_value = reference_point *
+			(1.0f + (0.9f * sinf((float)step_idx * 0.002f)) + (0.1f * (triangle - 0.5f)));
+
+		float command = PID_Step_v2(&pid_v2, sensed_value, reference_point);
+		int32_t command_q31 = PID_Step_q31(&pid_q31,
+										   convert_pid_value_to_q31(sensed_value, input_shift),
+										   convert_pid_value_to_q31(reference_point, input_shift));
+
+		double deviation = fabs((double)convert_pid_q31_to_value(command_q31, output_shift) - (double)command) /
+						   (double)(1UL << output_shift);
+
+		if(deviation > deviation_max)
+		{
+			deviation_max = deviation;
+		}
+	}
+
+	return deviation_max;
+}
+
+static bool test_pid_q31_deviation(const char *controller_name, const pid_controller_t *pid_parameters_ptr,
+								   float reference_point, uint8_t input_shift, uint8_t output_shift)
+{
+	double deviation = get_pid_q31_deviation(pid_parameters_ptr, reference_point, input_shift, output_shift);
+	bool is_passed = (deviation <= PID_Q31_TEST_DEVIATION_MAX);
+
+	fprintf(stderr, "%s PID_Step_q31 deviation of the %s controller from PID_Step_v2: %.3g of full scale (limit %.3g)\n",
+			(true == is_passed) ? "PASS" : "FAIL", controller_name, deviation, PID_Q31_TEST_DEVIATION_MAX);
+
+	return is_passed;
+}
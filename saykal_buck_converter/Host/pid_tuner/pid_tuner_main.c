@@ -0,0 +1,719 @@
+/**
+ * @file pid_tuner_main.c
+ * @brief Parallel PID gain sweep and Monte Carlo tuner of the cascaded buck controller.
+ *
+ * Every gain set of a grid over the eight gains of the voltage and current
+ * controllers is simulated from start-up against a number of power stage
+ * samples. Sample 0 is the nominal plant; the other samples draw inductance,
+ * capacitance, ESR and load uniformly inside the given tolerances. The same
+ * sample index gives the same plant for every gain set (common random numbers),
+ * so gain sets are compared against identical plants.
+ *
+ * Every (gain set, sample) pair is one job of the work-stealing pool and runs in
+ * its own process forked from the pristine firmware state. A gain set is scored
+ * by its worst case over all samples and is infeasible if any sample trips the
+ * overcurrent protection, does not settle or crashes. The feasible gain sets are
+ * ranked into Pareto fronts over settling time, overshoot and ripple.
+ *
+ * Usage: buck_pid_tuner [options]
+ *   --v-kp|--v-ki|--v-kd|--v-kaw SPEC   voltage controller gain grid
+ *   --i-kp|--i-ki|--i-kd|--i-kaw SPEC   current controller gain grid
+ *                          SPEC is VALUE, MIN:MAX:N or MIN:MAX:N:log
+ *                          (default: the gain of the firmware configuration)
+ *   --samples N            plant samples per gain set (default 1, nominal only)
+ *   --tol-l R              relative inductance tolerance (default 0.2)
+ *   --tol-c R              relative capacitance tolerance (default 0.2)
+ *   --tol-esr R            relative ESR tolerance (default 0.5)
+ *   --tol-load R           relative load tolerance (default 0.5)
+ *   --seed N               seed of the plant samples (default 1)
+ *   --duration-ms N        simulated time per job (default 3000)
+ *   --steady-window-ms N   length of the steady state window at the end (default 500)
+ *   --band R               relative settling band (default 0.02)
+ *   --model M              averaged | switching (default averaged)
+ *   --jobs N               worker processes (default: online cores)
+ *   --top N                print the best N gain sets (default 10)
+ *   --csv PATH             write every gain set with its rank as CSV
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "math.h"
+#include "getopt.h"
+#include "time.h"
+#include "plant_simulator.h"
+#include "step_response.h"
+#include "work_stealing_pool.h"
+#include "app_buck_converter.h"
+#include "error_manager.h"
+
+extern const buck_converter_cfg_t g_buck_converter_config;
+
+/** @brief Number of swept gains, four per controller. */
+#define PID_TUNER_GAIN_CNT			8U
+
+/** @brief Number of Pareto objectives. */
+#define PID_TUNER_OBJECTIVE_CNT		3U
+
+/** @brief Rank given to infeasible gain sets. */
+#define PID_TUNER_RANK_INFEASIBLE	UINT32_MAX
+
+/**
+ * @brief Sweep range of one gain.
+ */
+typedef struct
+{
+	float min;
+	float max;
+	uint32_t point_cnt;
+	bool is_logarithmic;
+
+}pid_tuner_axis_t;
+
+/**
+ * @brief Settings shared by all jobs.
+ */
+typedef struct
+{
+	pid_tuner_axis_t axes[PID_TUNER_GAIN_CNT];
+	uint32_t gain_set_cnt;
+	uint32_t sample_cnt;
+	uint32_t seed;
+	float tolerance_inductance;
+	float tolerance_capacitance;
+	float tolerance_esr;
+	float tolerance_load;
+	uint32_t duration_ms;
+	uint32_t steady_window_ms;
+	float settling_band_ratio;
+	plant_simulator_cfg_t nominal_plant_cfg;
+
+}pid_tuner_context_t;
+
+/**
+ * @brief Result of one (gain set, sample) job.
+ */
+typedef struct
+{
+	step_response_metrics_t metrics;
+	uint8_t system_error_status;
+	bool is_over_current_tripped;
+
+}pid_tuner_job_result_t;
+
+/**
+ * @brief Worst case score of one gain set over all samples.
+ */
+typedef struct
+{
+	float gains[PID_TUNER_GAIN_CNT];
+	float objectives[PID_TUNER_OBJECTIVE_CNT];	///< settling time, overshoot, ripple
+	float steady_state_error;
+	uint32_t failed_sample_cnt;
+	uint32_t rank;
+
+}pid_tuner_gain_set_t;
+
+static const char *const m_gain_names[PID_TUNER_GAIN_CNT] =
+{
+	"v_kp", "v_ki", "v_kd", "v_kaw", "i_kp", "i_ki", "i_kd", "i_kaw",
+};
+
+static bool parse_axis(const char *spec_ptr, pid_tuner_axis_t *axis_ptr);
+static float get_axis_value(const pid_tuner_axis_t *axis_ptr, uint32_t point_idx);
+static void get_gain_set(const pid_tuner_context_t *context_ptr, uint32_t gain_set_idx, float *gains_ptr);
+static void get_plant_sample_cfg(const pid_tuner_context_t *context_ptr,
+								 uint32_t sample_idx,
+								 plant_simulator_cfg_t *plant_cfg_ptr);
+static bool run_pid_tuner_job(uint32_t job_idx, void *result_ptr, void *context_ptr);
+static bool handle_tuner_sample(const plant_simulator_sample_t *sample_ptr, void *context_ptr);
+static bool is_dominating(const pid_tuner_gain_set_t *first_ptr, const pid_tuner_gain_set_t *second_ptr);
+static int compare_objectives(const void *first_ptr, const void *second_ptr);
+static int compare_rank(const void *first_ptr, const void *second_ptr);
+static uint32_t rank_pareto_fronts(pid_tuner_gain_set_t *gain_sets_ptr, uint32_t gain_set_cnt);
+
+int main(int argc, char *argv[])
+{
+	static const struct option long_options[] =
+	{
+		{ "v-kp",             required_argument, NULL, 0 },
+		{ "v-ki",             required_argument, NULL, 1 },
+		{ "v-kd",             required_argument, NULL, 2 },
+		{ "v-kaw",            required_argument, NULL, 3 },
+		{ "i-kp",             required_argument, NULL, 4 },
+		{ "i-ki",             required_argument, NULL, 5 },
+		{ "i-kd",             required_argument, NULL, 6 },
+		{ "i-kaw",            required_argument, NULL, 7 },
+		{ "samples",          required_argument, NULL, 'n' },
+		{ "tol-l",            required_argument, NULL, 'L' },
+		{ "tol-c",            required_argument, NULL, 'C' },
+		{ "tol-esr",          required_argument, NULL, 'e' },
+		{ "tol-load",         required_argument, NULL, 'r' },
+		{ "seed",             required_argument, NULL, 's' },
+		{ "duration-ms",      required_argument, NULL, 'd' },
+		{ "steady-window-ms", required_argument, NULL, 'w' },
+		{ "band",             required_argument, NULL, 'b' },
+		{ "model",            required_argument, NULL, 'm' },
+		{ "jobs",             required_argument, NULL, 'j' },
+		{ "top",              required_argument, NULL, 't' },
+		{ "csv",              required_argument, NULL, 'o' },
+		{ NULL, 0, NULL, 0 },
+	};
+
+	static pid_tuner_context_t tuner_context =
+	{
+		.sample_cnt = 1U,
+		.seed = 1U,
+		.tolerance_inductance = 0.2f,
+		.tolerance_capacitance = 0.2f,
+		.tolerance_esr = 0.5f,
+		.tolerance_load = 0.5f,
+		.duration_ms = 3000U,
+		.steady_window_ms = 500U,
+		.settling_band_ratio = 0.02f,
+	};
+
+	const pid_controller_t *voltage_pid_ptr = g_buck_converter_config.pid_out_voltage_cotroller_ptr;
+	const pid_controller_t *current_pid_ptr = g_buck_converter_config.pid_out_current_cotroller_ptr;
+	const float firmware_gains[PID_TUNER_GAIN_CNT] =
+	{
+		voltage_pid_ptr->Kp, voltage_pid_ptr->Ki, voltage_pid_ptr->Kd, voltage_pid_ptr->Kaw,
+		current_pid_ptr->Kp, current_pid_ptr->Ki, current_pid_ptr->Kd, current_pid_ptr->Kaw,
+	};
+
+	for(uint32_t gain_idx = 0U; gain_idx < PID_TUNER_GAIN_CNT; gain_idx++)
+	{
+		tuner_context.axes[gain_idx] = (pid_tuner_axis_t){ firmware_gains[gain_idx], firmware_gains[gain_idx], 1U, false };
+	}
+
+	get_default_plant_simulator_cfg(&tuner_context.nominal_plant_cfg);
+
+	uint32_t worker_cnt = 0U;
+	uint32_t top_cnt = 10U;
+	const char *csv_path = NULL;
+	int option;
+
+	while(-1 != (option = getopt_long(argc, argv, "", long_options, NULL)))
+	{
+		if((option >= 0) && (option < (int)PID_TUNER_GAIN_CNT))
+		{
+			if(false == parse_axis(optarg, &tuner_context.axes[option]))
+			{
+				fprintf(stderr, "invalid gain range '%s'\n", optarg);
+				return EXIT_FAILURE;
+			}
+			continue;
+		}
+
+		switch(option)
+		{
+			case 'n': tuner_context.sample_cnt = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'L': tuner_context.tolerance_inductance = strtof(optarg, NULL); break;
+			case 'C': tuner_context.tolerance_capacitance = strtof(optarg, NULL); break;
+			case 'e': tuner_context.tolerance_esr = strtof(optarg, NULL); break;
+			case 'r': tuner_context.tolerance_load = strtof(optarg, NULL); break;
+			case 's': tuner_context.seed = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'd': tuner_context.duration_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'w': tuner_context.steady_window_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'b': tuner_context.settling_band_ratio = strtof(optarg, NULL); break;
+			case 'm':
+			{
+				tuner_context.nominal_plant_cfg.model = (0 == strcmp(optarg, "switching")) ?
+					PLANT_MODEL_SWITCHING_e : PLANT_MODEL_AVERAGED_e;
+				break;
+			}
+			case 'j': worker_cnt = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 't': top_cnt = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'o': csv_path = optarg; break;
+			default:
+			{
+				fprintf(stderr, "usage: %s [--v-kp MIN:MAX:N] ... [--samples N] [--jobs N] [--csv PATH]\n", argv[0]);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	if((0U == tuner_context.sample_cnt) || (tuner_context.steady_window_ms >= tuner_context.duration_ms))
+	{
+		fprintf(stderr, "--samples must be positive and --steady-window-ms shorter than --duration-ms\n");
+		return EXIT_FAILURE;
+	}
+
+	uint64_t gain_set_cnt = 1U;
+
+	for(uint32_t gain_idx = 0U; gain_idx < PID_TUNER_GAIN_CNT; gain_idx++)
+	{
+		gain_set_cnt *= tuner_context.axes[gain_idx].point_cnt;
+	}
+
+	if((gain_set_cnt * tuner_context.sample_cnt) > UINT32_MAX)
+	{
+		fprintf(stderr, "sweep too large: %llu gain sets x %u samples\n",
+				(unsigned long long)gain_set_cnt, (unsigned)tuner_context.sample_cnt);
+		return EXIT_FAILURE;
+	}
+
+	tuner_context.gain_set_cnt = (uint32_t)gain_set_cnt;
+
+	work_stealing_pool_cfg_t pool_cfg =
+	{
+		.job_cnt = tuner_context.gain_set_cnt * tuner_context.sample_cnt,
+		.worker_cnt = worker_cnt,
+		.result_size = sizeof(pid_tuner_job_result_t),
+		.is_job_isolated = true,
+		.is_progress_reported = true,
+		.job_func = run_pid_tuner_job,
+		.context_ptr = &tuner_context,
+	};
+
+	work_stealing_pool_results_t pool_results;
+	struct timespec wall_start;
+	struct timespec wall_end;
+
+	fprintf(stderr, "%u gain sets x %u samples\n",
+			(unsigned)tuner_context.gain_set_cnt, (unsigned)tuner_context.sample_cnt);
+
+	clock_gettime(CLOCK_MONOTONIC, &wall_start);
+
+	if(false == run_work_stealing_pool(&pool_cfg, &pool_results))
+	{
+		fprintf(stderr, "work-stealing pool failed\n");
+		return EXIT_FAILURE;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &wall_end);
+
+	pid_tuner_gain_set_t *gain_sets_ptr = calloc(tuner_context.gain_set_cnt, sizeof(pid_tuner_gain_set_t));
+
+	if(NULL == gain_sets_ptr)
+	{
+		perror("calloc");
+		return EXIT_FAILURE;
+	}
+
+	/* worst case over all plant samples */
+	for(uint32_t gain_set_idx = 0U; gain_set_idx < tuner_context.gain_set_cnt; gain_set_idx++)
+	{
+		pid_tuner_gain_set_t *gain_set_ptr = &gain_sets_ptr[gain_set_idx];
+
+		get_gain_set(&tuner_context, gain_set_idx, gain_set_ptr->gains);
+
+		for(uint32_t sample_idx = 0U; sample_idx < tuner_context.sample_cnt; sample_idx++)
+		{
+			uint32_t job_idx = (gain_set_idx * tuner_context.sample_cnt) + sample_idx;
+			const pid_tuner_job_result_t *job_result_ptr =
+				get_work_stealing_job_result(&pool_results, &pool_cfg, job_idx);
+			const step_response_metrics_t *metrics_ptr = &job_result_ptr->metrics;
+
+			if((WORK_STEALING_JOB_OK_e != pool_results.job_states_ptr[job_idx]) ||
+			   (true == job_result_ptr->is_over_current_tripped) ||
+			   (0U != job_result_ptr->system_error_status) ||
+			   (false == metrics_ptr->is_settled))
+			{
+				gain_set_ptr->failed_sample_cnt++;
+				continue;
+			}
+
+			gain_set_ptr->objectives[0] = fmaxf(gain_set_ptr->objectives[0], metrics_ptr->settling_time_ms);
+			gain_set_ptr->objectives[1] = fmaxf(gain_set_ptr->objectives[1], metrics_ptr->overshoot_percent);
+			gain_set_ptr->objectives[2] = fmaxf(gain_set_ptr->objectives[2], metrics_ptr->ripple_peak_to_peak);
+
+			if(fabsf(metrics_ptr->steady_state_error) > fabsf(gain_set_ptr->steady_state_error))
+			{
+				gain_set_ptr->steady_state_error = metrics_ptr->steady_state_error;
+			}
+		}
+	}
+
+	uint32_t stolen_range_cnt = pool_results.stolen_range_cnt;
+
+	release_work_stealing_pool_results(&pool_results);
+
+	uint32_t front_cnt = rank_pareto_fronts(gain_sets_ptr, tuner_context.gain_set_cnt);
+	uint32_t feasible_cnt = 0U;
+	uint32_t first_front_cnt = 0U;
+
+	for(uint32_t gain_set_idx = 0U; gain_set_idx < tuner_context.gain_set_cnt; gain_set_idx++)
+	{
+		if(PID_TUNER_RANK_INFEASIBLE != gain_sets_ptr[gain_set_idx].rank)
+		{
+			feasible_cnt++;
+		}
+
+		if(0U == gain_sets_ptr[gain_set_idx].rank)
+		{
+			first_front_cnt++;
+		}
+	}
+
+	double wall_s = (double)(wall_end.tv_sec - wall_start.tv_sec) +
+					((double)(wall_end.tv_nsec - wall_start.tv_nsec) * 1e-9);
+
+	printf("jobs=%u wall_s=%.3f jobs_per_s=%.0f stolen_ranges=%u\n",
+		   (unsigned)pool_cfg.job_cnt, wall_s, (wall_s > 0.0) ? ((double)pool_cfg.job_cnt / wall_s) : 0.0,
+		   (unsigned)stolen_range_cnt);
+	printf("gain_sets=%u feasible=%u pareto_fronts=%u first_front=%u\n",
+		   (unsigned)tuner_context.gain_set_cnt, (unsigned)feasible_cnt,
+		   (unsigned)front_cnt, (unsigned)first_front_cnt);
+
+	printf("%4s %9s %9s %9s %9s %9s %9s %9s %9s %11s %11s %9s %9s\n", "rank",
+		   m_gain_names[0], m_gain_names[1], m_gain_names[2], m_gain_names[3],
+		   m_gain_names[4], m_gain_names[5], m_gain_names[6], m_gain_names[7],
+		   "settling_ms", "overshoot_%", "ripple_v", "sse_v");
+
+	for(uint32_t gain_set_idx = 0U; (gain_set_idx < feasible_cnt) && (gain_set_idx < top_cnt); gain_set_idx++)
+	{
+		const pid_tuner_gain_set_t *gain_set_ptr = &gain_sets_ptr[gain_set_idx];
+
+		printf("%4u", (unsigned)gain_set_ptr->rank);
+
+		for(uint32_t gain_idx = 0U; gain_idx < PID_TUNER_GAIN_CNT; gain_idx++)
+		{
+			printf(" %9.4g", gain_set_ptr->gains[gain_idx]);
+		}
+
+		printf(" %11.0f %11.3f %9.4f %9.4f\n", gain_set_ptr->objectives[0], gain_set_ptr->objectives[1],
+			   gain_set_ptr->objectives[2], gain_set_ptr->steady_state_error);
+	}
+
+	if(NULL != csv_path)
+	{
+		FILE *csv_file_ptr = fopen(csv_path, "w");
+
+		if(NULL == csv_file_ptr)
+		{
+			perror(csv_path);
+			free(gain_sets_ptr);
+			return EXIT_FAILURE;
+		}
+
+		fprintf(csv_file_ptr, "rank");
+
+		for(uint32_t gain_idx = 0U; gain_idx < PID_TUNER_GAIN_CNT; gain_idx++)
+		{
+			fprintf(csv_file_ptr, ",%s", m_gain_names[gain_idx]);
+		}
+
+		fprintf(csv_file_ptr, ",settling_time_ms,overshoot_percent,ripple_v,steady_state_error_v,failed_samples\n");
+
+		for(uint32_t gain_set_idx = 0U; gain_set_idx < tuner_context.gain_set_cnt; gain_set_idx++)
+		{
+			const pid_tuner_gain_set_t *gain_set_ptr = &gain_sets_ptr[gain_set_idx];
+
+			if(PID_TUNER_RANK_INFEASIBLE == gain_set_ptr->rank)
+			{
+				fprintf(csv_file_ptr, "infeasible");
+			}
+			else
+			{
+				fprintf(csv_file_ptr, "%u", (unsigned)gain_set_ptr->rank);
+			}
+
+			for(uint32_t gain_idx = 0U; gain_idx < PID_TUNER_GAIN_CNT; gain_idx++)
+			{
+				fprintf(csv_file_ptr, ",%.6g", gain_set_ptr->gains[gain_idx]);
+			}
+
+			fprintf(csv_file_ptr, ",%.0f,%.4f,%.5f,%.5f,%u\n", gain_set_ptr->objectives[0],
+					gain_set_ptr->objectives[1], gain_set_ptr->objectives[2],
+					gain_set_ptr->steady_state_error, (unsigned)gain_set_ptr->failed_sample_cnt);
+		}
+
+		fclose(csv_file_ptr);
+	}
+
+	free(gain_sets_ptr);
+
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Parses VALUE, MIN:MAX:N or MIN:MAX:N:log.
+ */
+static bool parse_axis(const char *spec_ptr, pid_tuner_axis_t *axis_ptr)
+{
+	char scale_name[8] = { 0 };
+	float range_min = 0.0f;
+	float range_max = 0.0f;
+	unsigned point_cnt = 0U;
+	int field_cnt = sscanf(spec_ptr, "%f:%f:%u:%7s", &range_min, &range_max, &point_cnt, scale_name);
+
+	if(1 == field_cnt)
+	{
+		*axis_ptr = (pid_tuner_axis_t){ range_min, range_min, 1U, false };
+		return true;
+	}
+
+	if((field_cnt < 3) || (0U == point_cnt))
+	{
+		return false;
+	}
+
+	bool is_logarithmic = (4 == field_cnt) && (0 == strcmp(scale_name, "log"));
+
+	if((true == is_logarithmic) && ((range_min <= 0.0f) || (range_max <= 0.0f)))
+	{
+		return false;
+	}
+
+	*axis_ptr = (pid_tuner_axis_t){ range_min, range_max, point_cnt, is_logarithmic };
+
+	return true;
+}
+
+static float get_axis_value(const pid_tuner_axis_t *axis_ptr, uint32_t point_idx)
+{
+	if(1U == axis_ptr->point_cnt)
+	{
+		return axis_ptr->min;
+	}
+
+	float position = (float)point_idx / (float)(axis_ptr->point_cnt - 1U);
+
+	if(true == axis_ptr->is_logarithmic)
+	{
+		return axis_ptr->min * powf(axis_ptr->max / axis_ptr->min, position);
+	}
+
+	return axis_ptr->min + ((axis_ptr->max - axis_ptr->min) * position);
+}
+
+/**
+ * @brief Decodes a gain set index, the last gain varies fastest.
+ */
+static void get_gain_set(const pid_tuner_context_t *context_ptr, uint32_t gain_set_idx, float *gains_ptr)
+{
+	for(uint32_t gain_idx = PID_TUNER_GAIN_CNT; gain_idx > 0U; gain_idx--)
+	{
+		const pid_tuner_axis_t *axis_ptr = &context_ptr->axes[gain_idx - 1U];
+
+		gains_ptr[gain_idx - 1U] = get_axis_value(axis_ptr, gain_set_idx % axis_ptr->point_cnt);
+		gain_set_idx /= axis_ptr->point_cnt;
+	}
+}
+
+/**
+ * @brief Draws the power stage of a plant sample, sample 0 is the nominal plant.
+ */
+static void get_plant_sample_cfg(const pid_tuner_context_t *context_ptr,
+								 uint32_t sample_idx,
+								 plant_simulator_cfg_t *plant_cfg_ptr)
+{
+	*plant_cfg_ptr = context_ptr->nominal_plant_cfg;
+	plant_cfg_ptr->noise_seed = context_ptr->seed + sample_idx;
+
+	if(0U == sample_idx)
+	{
+		return;
+	}
+
+	/* xorshift32 seeded by (seed, sample), identical for every gain set */
+	uint32_t random_state = (context_ptr->seed * 0x9E3779B9U) ^ (sample_idx * 0x85EBCA6BU);
+	float uniform[4];
+
+	for(uint32_t draw_idx = 0U; draw_idx < 4U; draw_idx++)
+	{
+		do
+		{
+			random_state ^= random_state << 13;
+			random_state ^= random_state >> 17;
+			random_state ^= random_state << 5;
+		}while(0U == random_state);
+
+		uniform[draw_idx] = ((float)(random_state >> 8) / 8388608.0f) - 1.0f;
+	}
+
+	plant_cfg_ptr->inductance_h *= 1.0f + (context_ptr->tolerance_inductance * uniform[0]);
+	plant_cfg_ptr->capacitance_f *= 1.0f + (context_ptr->tolerance_capacitance * uniform[1]);
+	plant_cfg_ptr->capacitor_esr_ohm *= 1.0f + (context_ptr->tolerance_esr * uniform[2]);
+	plant_cfg_ptr->load_resistance_ohm *= 1.0f + (context_ptr->tolerance_load * uniform[3]);
+}
+
+/**
+ * @brief Simulates one (gain set, sample) pair, runs in its own process.
+ */
+static bool run_pid_tuner_job(uint32_t job_idx, void *result_ptr, void *context_ptr)
+{
+	const pid_tuner_context_t *tuner_context_ptr = (const pid_tuner_context_t *)context_ptr;
+	pid_tuner_job_result_t *job_result_ptr = (pid_tuner_job_result_t *)result_ptr;
+	uint32_t gain_set_idx = job_idx / tuner_context_ptr->sample_cnt;
+	uint32_t sample_idx = job_idx % tuner_context_ptr->sample_cnt;
+	pid_controller_t *voltage_pid_ptr = g_buck_converter_config.pid_out_voltage_cotroller_ptr;
+	pid_controller_t *current_pid_ptr = g_buck_converter_config.pid_out_current_cotroller_ptr;
+	float gains[PID_TUNER_GAIN_CNT];
+	plant_simulator_cfg_t plant_cfg;
+
+	get_gain_set(tuner_context_ptr, gain_set_idx, gains);
+	get_plant_sample_cfg(tuner_context_ptr, sample_idx, &plant_cfg);
+
+	voltage_pid_ptr->Kp = gains[0];
+	voltage_pid_ptr->Ki = gains[1];
+	voltage_pid_ptr->Kd = gains[2];
+	voltage_pid_ptr->Kaw = gains[3];
+	current_pid_ptr->Kp = gains[4];
+	current_pid_ptr->Ki = gains[5];
+	current_pid_ptr->Kd = gains[6];
+	current_pid_ptr->Kaw = gains[7];
+
+	step_response_t step_response;
+	step_response_cfg_t step_response_cfg =
+	{
+		.reference = g_buck_converter_config.v_out_ref,
+		.settling_band_ratio = tuner_context_ptr->settling_band_ratio,
+		.start_ms = 0U,
+		.steady_state_start_ms = tuner_context_ptr->duration_ms - tuner_context_ptr->steady_window_ms,
+	};
+
+	init_step_response(&step_response, &step_response_cfg);
+	init_plant_simulator(&plant_cfg);
+	run_plant_simulator(tuner_context_ptr->duration_ms, handle_tuner_sample, &step_response);
+
+	get_step_response_metrics(&step_response, &job_result_ptr->metrics);
+	job_result_ptr->system_error_status = get_system_error_status();
+	job_result_ptr->is_over_current_tripped = get_system_overcurrent_error_status();
+
+	return true;
+}
+
+static bool handle_tuner_sample(const plant_simulator_sample_t *sample_ptr, void *context_ptr)
+{
+	add_step_response_sample((step_response_t *)context_ptr, sample_ptr->time_ms,
+							 sample_ptr->output_voltage_v,
+							 sample_ptr->output_voltage_min_v,
+							 sample_ptr->output_voltage_max_v);
+
+	/* a tripped converter stays off, the rest of the run carries no information */
+	return (false == get_system_overcurrent_error_status());
+}
+
+static bool is_dominating(const pid_tuner_gain_set_t *first_ptr, const pid_tuner_gain_set_t *second_ptr)
+{
+	bool is_better_once = false;
+
+	for(uint32_t objective_idx = 0U; objective_idx < PID_TUNER_OBJECTIVE_CNT; objective_idx++)
+	{
+		if(first_ptr->objectives[objective_idx] > second_ptr->objectives[objective_idx])
+		{
+			return false;
+		}
+
+		if(first_ptr->objectives[objective_idx] < second_ptr->objectives[objective_idx])
+		{
+			is_better_once = true;
+		}
+	}
+
+	return is_better_once;
+}
+
+/**
+ * @brief Lexicographic order: feasible first, then by the objectives in turn.
+ */
+static int compare_objectives(const void *first_ptr, const void *second_ptr)
+{
+	const pid_tuner_gain_set_t *first_set_ptr = (const pid_tuner_gain_set_t *)first_ptr;
+	const pid_tuner_gain_set_t *second_set_ptr = (const pid_tuner_gain_set_t *)second_ptr;
+
+	if((0U == first_set_ptr->failed_sample_cnt) != (0U == second_set_ptr->failed_sample_cnt))
+	{
+		return (0U == first_set_ptr->failed_sample_cnt) ? -1 : 1;
+	}
+
+	for(uint32_t objective_idx = 0U; objective_idx < PID_TUNER_OBJECTIVE_CNT; objective_idx++)
+	{
+		if(first_set_ptr->objectives[objective_idx] != second_set_ptr->objectives[objective_idx])
+		{
+			return (first_set_ptr->objectives[objective_idx] < second_set_ptr->objectives[objective_idx]) ? -1 : 1;
+		}
+	}
+
+	return 0;
+}
+
+static int compare_rank(const void *first_ptr, const void *second_ptr)
+{
+	const pid_tuner_gain_set_t *first_set_ptr = (const pid_tuner_gain_set_t *)first_ptr;
+	const pid_tuner_gain_set_t *second_set_ptr = (const pid_tuner_gain_set_t *)second_ptr;
+
+	if(first_set_ptr->rank != second_set_ptr->rank)
+	{
+		return (first_set_ptr->rank < second_set_ptr->rank) ? -1 : 1;
+	}
+
+	return compare_objectives(first_ptr, second_ptr);
+}
+
+/**
+ * @brief Assigns the Pareto front rank and sorts the gain sets best first.
+ *
+ * Efficient non-dominated sort with sequential search: after a lexicographic
+ * sort no gain set can be dominated by a later one, so each gain set joins the
+ * first front that holds no gain set dominating it. Only the front members have
+ * to be compared instead of all pairs.
+ *
+ * @return uint32_t Number of fronts.
+ */
+static uint32_t rank_pareto_fronts(pid_tuner_gain_set_t *gain_sets_ptr, uint32_t gain_set_cnt)
+{
+	qsort(gain_sets_ptr, gain_set_cnt, sizeof(pid_tuner_gain_set_t), compare_objectives);
+
+	/* front members are kept as linked lists threaded through next_member_idx */
+	uint32_t *next_member_idx = malloc(sizeof(uint32_t) * ((size_t)gain_set_cnt + 1U));
+	uint32_t *front_head_idx = malloc(sizeof(uint32_t) * ((size_t)gain_set_cnt + 1U));
+	uint32_t front_cnt = 0U;
+
+	if((NULL == next_member_idx) || (NULL == front_head_idx))
+	{
+		perror("malloc");
+		exit(EXIT_FAILURE);
+	}
+
+	for(uint32_t gain_set_idx = 0U; gain_set_idx < gain_set_cnt; gain_set_idx++)
+	{
+		pid_tuner_gain_set_t *gain_set_ptr = &gain_sets_ptr[gain_set_idx];
+
+		if(0U != gain_set_ptr->failed_sample_cnt)
+		{
+			gain_set_ptr->rank = PID_TUNER_RANK_INFEASIBLE;
+			continue;
+		}
+
+		uint32_t front_idx = 0U;
+
+		for(; front_idx < front_cnt; front_idx++)
+		{
+			bool is_dominated = false;
+
+			for(uint32_t member_idx = front_head_idx[front_idx];
+				(UINT32_MAX != member_idx) && (false == is_dominated);
+				member_idx = next_member_idx[member_idx])
+			{
+				is_dominated = is_dominating(&gain_sets_ptr[member_idx], gain_set_ptr);
+			}
+
+			if(false == is_dominated)
+			{
+				break;
+			}
+		}
+
+		if(front_idx == front_cnt)
+		{
+			front_head_idx[front_cnt] = UINT32_MAX;
+			front_cnt++;
+		}
+
+		gain_set_ptr->rank = front_idx;
+		next_member_idx[gain_set_idx] = front_head_idx[front_idx];
+		front_head_idx[front_idx] = gain_set_idx;
+	}
+
+	free(next_member_idx);
+	free(front_head_idx);
+
+	qsort(gain_sets_ptr, gain_set_cnt, sizeof(pid_tuner_gain_set_t), compare_rank);
+
+	return front_cnt;
+}
@@ -0,0 +1,614 @@
+/**
+ * @file plant_simulator.c
+ * @brief Closed-loop buck converter plant simulator for the host build.
+ *
+ * State vector of the power stage is x = [inductor current, capacitor voltage],
+ * the input is the switch node voltage u:
+ * @code
+ *     L  diL/dt = u - RL*iL - vout
+ *     C  dvC/dt = (R*iL - vC) / (R + Rc)
+ *     vout      = R*(vC + Rc*iL) / (R + Rc)
+ * @endcode
+ * The diode of the buck stage does not allow a negative inductor current, which
+ * is applied as a clamp after every integration step.
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "plant_simulator.h"
+#include "host_hal.h"
+#include "system_manager.h"
+#include "bsp_pwm.h"
+#include "adc_sensor_driver.h"
+#include "bsp_adc.h"
+#include "math.h"
+#include "string.h"
+
+/** @brief Full scale of the 12-bit ADC. */
+#define PLANT_ADC_MAX_COUNT			4095.0f
+
+/** @brief ADC reference voltage assumed by bsp_adc. */
+#define PLANT_ADC_REFERENCE_V		3.3f
+
+/** @brief Number of Taylor terms used by the matrix exponential. */
+#define PLANT_EXPM_TAYLOR_TERMS		16U
+
+/**
+ * @brief Exact zero order hold discretization of the power stage for one step length.
+ *
+ * x[k+1] = state_matrix * x[k] + input_vector * u
+ */
+typedef struct
+{
+	double state_matrix[2][2];
+	double input_vector[2];
+	double step_time_s;
+	float load_resistance_ohm;
+
+}plant_discrete_model_t;
+
+/**
+ * @brief Connection between an ADC channel and the simulated quantity it measures.
+ */
+typedef struct
+{
+	uint32_t adc_channel;
+	uint8_t sensor_id;
+
+}plant_adc_channel_t;
+
+/**
+ * @brief ADC sensors configuration, used to convert physical values back into counts.
+ */
+extern const adc_sensor_driver_config_t g_adc_sensors_configuration[];
+
+/**
+ * @brief PWM timer configuration, used to locate the buck MOSFET timer channel.
+ */
+extern const bsp_pwm_config_t g_bsp_pwm_timer_configs[];
+
+/**
+ * @brief ADC channels wired to the sensors on the board (see bsp_adc.c).
+ */
+static const plant_adc_channel_t m_plant_adc_channels[] =
+{
+	{ .adc_channel = ADC_CHANNEL_1, .sensor_id = BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID },
+	{ .adc_channel = ADC_CHANNEL_2, .sensor_id = BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID },
+	{ .adc_channel = ADC_CHANNEL_3, .sensor_id = TEMPERATURE_LM35_SENSOR_ID },
+	{ .adc_channel = ADC_CHANNEL_4, .sensor_id = BUCK_CONVERTOR_IN_VOLTAGE_RESISTOR_SENSOR_ID },
+	{ .adc_channel = ADC_CHANNEL_5, .sensor_id = BUCK_CONVERTOR_IN_CURRENT_ACS724_SENSOR_ID },
+};
+
+static plant_simulator_cfg_t m_plant_cfg;
+
+/** @brief Inductor current and capacitor voltage. */
+static double m_plant_state[2];
+
+/** @brief Discrete models of the averaged step and of the on / off segments. */
+static plant_discrete_model_t m_averaged_model;
+static plant_discrete_model_t m_on_segment_model;
+static plant_discrete_model_t m_off_segment_model;
+
+/** @brief Discrete model from the start of the on or off segment to the ADC trigger. */
+static plant_discrete_model_t m_trigger_segment_model;
+
+/** @brief Output voltage at the ADC trigger of the last switching period, see host_hal_get_adc_trigger_phase(). */
+static double m_triggered_output_v = 0.0;
+static bool m_is_output_triggered = false;
+
+/** @brief Buck MOSFET timer channel observed by the simulator. */
+static const TIM_TypeDef *m_mosfet_timer_ptr = NULL;
+static uint32_t m_mosfet_timer_channel = TIM_CHANNEL_1;
+
+/** @brief Last simulated millisecond. */
+static plant_simulator_sample_t m_last_sample;
+
+/** @brief Sensor values forced by set_plant_sensor_override(), e.g. a stuck sensor. */
+static float m_sensor_override_values[TOTAL_ADC_SENSOR_ID];
+static bool m_is_sensor_overridden[TOTAL_ADC_SENSOR_ID];
+
+/** @brief State of the xorshift noise generator. */
+static uint32_t m_noise_state = 1U;
+
+static void locate_mosfet_timer_channel(void);
+static uint32_t convert_plant_quantity_to_adc_count(uint32_t adc_channel);
+static void step_plant_one_ms(float duty, bool is_pwm_running);
+static void apply_discrete_model(plant_discrete_model_t *model_ptr, double step_time_s, double input_v);
+static void discretize_plant(plant_discrete_model_t *model_ptr, double step_time_s);
+static double get_output_voltage(void);
+static double get_output_voltage_at_trigger(double period_s, double on_time_s, double input_v, float trigger_phase);
+static float get_gaussian_noise(void);
+
+void get_default_plant_simulator_cfg(plant_simulator_cfg_t *plant_cfg_ptr)
+{
+	plant_cfg_ptr->model = PLANT_MODEL_AVERAGED_e;
+	plant_cfg_ptr->input_voltage_v = 36.0f;
+	plant_cfg_ptr->inductance_h = 330e-6f;
+	plant_cfg_ptr->inductor_resistance_ohm = 0.03f;
+	plant_cfg_ptr->capacitance_f = 470e-6f;
+	plant_cfg_ptr->capacitor_esr_ohm = 0.03f;
+	plant_cfg_ptr->load_resistance_ohm = 4.8f;
+	plant_cfg_ptr->switching_frequency_hz = 20000.0f;
+	plant_cfg_ptr->ambient_temperature_c = 25.0f;
+	plant_cfg_ptr->adc_noise_counts = 0.0f;
+	plant_cfg_ptr->noise_seed = 1U;
+	plant_cfg_ptr->averaged_substeps_per_ms = 10U;
+}
+
+void init_plant_simulator(const plant_simulator_cfg_t *plant_cfg_ptr)
+{
+	m_plant_cfg = *plant_cfg_ptr;
+
+	if(0U == m_plant_cfg.averaged_substeps_per_ms)
+	{
+		m_plant_cfg.averaged_substeps_per_ms = 1U;
+	}
+
+	m_noise_state = (0U != m_plant_cfg.noise_seed) ? m_plant_cfg.noise_seed : 1U;
+
+	m_plant_state[0] = 0.0;
+	m_plant_state[1] = 0.0;
+
+	memset(&m_averaged_model, 0, sizeof(m_averaged_model));
+	memset(&m_on_segment_model, 0, sizeof(m_on_segment_model));
+	memset(&m_off_segment_model, 0, sizeof(m_off_segment_model));
+	memset(&m_trigger_segment_model, 0, sizeof(m_trigger_segment_model));
+	m_triggered_output_v = 0.0;
+	m_is_output_triggered = false;
+	memset(&m_last_sample, 0, sizeof(m_last_sample));
+	memset(m_is_sensor_overridden, 0, sizeof(m_is_sensor_overridden));
+
+	host_hal_reset();
+	host_hal_register_adc_conversion_func(convert_plant_quantity_to_adc_count);
+	host_hal_register_irq_handler(ADC_IRQn, handle_bsp_adc_interrupt);
+	host_hal_register_irq_handler(DMA2_Stream0_IRQn, handle_bsp_adc_dma_interrupt);
+	locate_mosfet_timer_channel();
+
+	get_plant_simulator_sample(&m_last_sample);
+}
+
+uint32_t run_plant_simulator(uint32_t duration_ms,
+							 plant_simulator_sample_func_t sample_func,
+							 void *context_ptr)
+{
+	uint32_t simulated_ms = 0U;
+
+	while(simulated_ms < duration_ms)
+	{
+		uint32_t tick_before_ms = HAL_GetTick();
+
+		run_state_machine_of_system_manager();
+
+		float duty = host_hal_get_pwm_duty(m_mosfet_timer_ptr, m_mosfet_timer_channel);
+		bool is_pwm_running = host_hal_is_pwm_running(m_mosfet_timer_ptr, m_mosfet_timer_channel);
+
+		/* the plant keeps running while the firmware waits in HAL_Delay() */
+		for(uint32_t blocked_ms = HAL_GetTick() - tick_before_ms; blocked_ms > 0U; blocked_ms--)
+		{
+			step_plant_one_ms(duty, is_pwm_running);
+			simulated_ms++;
+		}
+
+		step_plant_one_ms(duty, is_pwm_running);
+		host_hal_advance_tick(1U);
+		simulated_ms++;
+
+		if((NULL != sample_func) && (false == sample_func(&m_last_sample, context_ptr)))
+		{
+			break;
+		}
+	}
+
+	return simulated_ms;
+}
+
+void set_plant_load_resistance(float load_resistance_ohm)
+{
+	m_plant_cfg.load_resistance_ohm = load_resistance_ohm;
+}
+
+void set_plant_input_voltage(float input_voltage_v)
+{
+	m_plant_cfg.input_voltage_v = input_voltage_v;
+}
+
+void set_plant_sensor_override(uint8_t sensor_id, float sensor_value)
+{
+	if(sensor_id < TOTAL_ADC_SENSOR_ID)
+	{
+		m_sensor_override_values[sensor_id] = sensor_value;
+		m_is_sensor_overridden[sensor_id] = true;
+		host_hal_refresh_adc_dma_scan();
+	}
+}
+
+void clear_plant_sensor_override(uint8_t sensor_id)
+{
+	if(sensor_id < TOTAL_ADC_SENSOR_ID)
+	{
+		m_is_sensor_overridden[sensor_id] = false;
+		host_hal_refresh_adc_dma_scan();
+	}
+}
+
+void get_plant_simulator_sample(plant_simulator_sample_t *sample_ptr)
+{
+	float output_voltage = (float)get_output_voltage();
+
+	sample_ptr->time_ms = HAL_GetTick();
+	sample_ptr->output_voltage_v = output_voltage;
+	sample_ptr->output_voltage_min_v = output_voltage;
+	sample_ptr->output_voltage_max_v = output_voltage;
+	sample_ptr->inductor_current_a = (float)m_plant_state[0];
+	sample_ptr->output_current_a = output_voltage / m_plant_cfg.load_resistance_ohm;
+	sample_ptr->duty = m_last_sample.duty;
+	sample_ptr->input_voltage_v = m_plant_cfg.input_voltage_v;
+	sample_ptr->input_current_a = m_last_sample.duty * (float)m_plant_state[0];
+	sample_ptr->load_resistance_ohm = m_plant_cfg.load_resistance_ohm;
+	sample_ptr->is_pwm_running = m_last_sample.is_pwm_running;
+}
+
+/**
+ * @brief Finds the timer and channel behind PWM_TIMER_ID_FOR_BUCK_MOSFET in the PWM configuration.
+ */
+static void locate_mosfet_timer_channel(void)
+{
+	for(uint8_t timer_idx = 0U; timer_idx < PWM_TIMER_TOTAL_CNT; timer_idx++)
+	{
+		const bsp_pwm_timer_channel_config_t *channel_configs_ptr =
+			&g_bsp_pwm_timer_configs[timer_idx].timer_channel_configs;
+
+		for(uint8_t channel_idx = 0U; channel_idx < channel_configs_ptr->total_timer_channel; channel_idx++)
+		{
+			if(PWM_TIMER_ID_FOR_BUCK_MOSFET == channel_configs_ptr->pwm_channels_ptr[channel_idx].pwm_channel_id)
+			{
+				m_mosfet_timer_ptr = g_bsp_pwm_timer_configs[timer_idx].timer_instance_ptr;
+				m_mosfet_timer_channel = channel_configs_ptr->pwm_channels_ptr[channel_idx].timer_channel;
+			}
+		}
+	}
+}
+
+/**
+ * @brief ADC conversion source registered to the host HAL.
+ *
+ * Converts the simulated quantity behind the channel into the pin voltage using
+ * the inverse of the sensor configuration, then into 12-bit counts.
+ */
+static uint32_t convert_plant_quantity_to_adc_count(uint32_t adc_channel)
+{
+	for(uint8_t channel_idx = 0U;
+		channel_idx < (sizeof(m_plant_adc_channels) / sizeof(m_plant_adc_channels[0]));
+		channel_idx++)
+	{
+		if(adc_channel != m_plant_adc_channels[channel_idx].adc_channel)
+		{
+			continue;
+		}
+
+		uint8_t sensor_id = m_plant_adc_channels[channel_idx].sensor_id;
+		float sensor_value = 0.0f;
+		double output_v = (true == m_is_output_triggered) ? m_triggered_output_v : get_output_voltage();
+
+		switch(sensor_id)
+		{
+			case BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID:
+			{
+				sensor_value = (float)(output_v / m_plant_cfg.load_resistance_ohm);
+				break;
+			}
+			case BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID:
+			{
+				sensor_value = (float)output_v;
+				break;
+			}
+			case TEMPERATURE_LM35_SENSOR_ID:
+			{
+				sensor_value = m_plant_cfg.ambient_temperature_c;
+				break;
+			}
+			case BUCK_CONVERTOR_IN_VOLTAGE_RESISTOR_SENSOR_ID:
+			{
+				sensor_value = m_plant_cfg.input_voltage_v;
+				break;
+			}
+			case BUCK_CONVERTOR_IN_CURRENT_ACS724_SENSOR_ID:
+			{
+				sensor_value = m_last_sample.input_current_a;
+				break;
+			}
+			default:
+			{
+				break;
+			}
+		}
+
+		if(true == m_is_sensor_overridden[sensor_id])
+		{
+			sensor_value = m_sensor_override_values[sensor_id];
+		}
+
+		const adc_sensor_driver_config_t *sensor_cfg_ptr = &g_adc_sensors_configuration[sensor_id];
+
+		float pin_voltage =
+			((sensor_value * sensor_cfg_ptr->sensitivity_volt_per_output_unit) +
+			 sensor_cfg_ptr->reference_voltage_for_zero_output) / sensor_cfg_ptr->raw_voltage_factor;
+
+		float adc_count = (pin_voltage * PLANT_ADC_MAX_COUNT / PLANT_ADC_REFERENCE_V) + get_gaussian_noise();
+
+		if(adc_count < 0.0f)
+		{
+			adc_count = 0.0f;
+		}
+		else if(adc_count > PLANT_ADC_MAX_COUNT)
+		{
+			adc_count = PLANT_ADC_MAX_COUNT;
+		}
+
+		return (uint32_t)lroundf(adc_count);
+	}
+
+	return 0U;
+}
+
+/**
+ * @brief Integrates the power stage over one millisecond with a constant duty.
+ */
+static void step_plant_one_ms(float duty, bool is_pwm_running)
+{
+	double input_v = m_plant_cfg.input_voltage_v;
+	double output_v = get_output_voltage();
+	double output_min_v = output_v;
+	double output_max_v = output_v;
+
+	if(false == is_pwm_running)
+	{
+		duty = 0.0f;
+	}
+
+	if(PLANT_MODEL_SWITCHING_e == m_plant_cfg.model)
+	{
+		long periods_per_ms = lround(m_plant_cfg.switching_frequency_hz / 1000.0f);
+		double period_s = 1e-3 / (double)((periods_per_ms > 0) ? periods_per_ms : 1);
+		double on_time_s = period_s * duty;
+		float trigger_phase = 0.0f;
+
+		m_is_output_triggered = host_hal_get_adc_trigger_phase(&trigger_phase);
+
+		for(long period_idx = 0; period_idx < periods_per_ms; period_idx++)
+		{
+			if((true == m_is_output_triggered) && ((periods_per_ms - 1) == period_idx))
+			{
+				m_triggered_output_v = get_output_voltage_at_trigger(period_s, on_time_s, input_v, trigger_phase);
+			}
+
+			apply_discrete_model(&m_on_segment_model, on_time_s, input_v);
+			output_v = get_output_voltage();
+			output_max_v = fmax(output_max_v, output_v);
+			output_min_v = fmin(output_min_v, output_v);
+
+			apply_discrete_model(&m_off_segment_model, period_s - on_time_s, 0.0);
+			output_v = get_output_voltage();
+			output_max_v = fmax(output_max_v, output_v);
+			output_min_v = fmin(output_min_v, output_v);
+		}
+	}
+	else
+	{
+		double step_time_s = 1e-3 / (double)m_plant_cfg.averaged_substeps_per_ms;
+
+		/* without ripple every trigger point sees the averaged state */
+		m_is_output_triggered = false;
+
+		for(uint16_t step_idx = 0U; step_idx < m_plant_cfg.averaged_substeps_per_ms; step_idx++)
+		{
+			apply_discrete_model(&m_averaged_model, step_time_s, input_v * duty);
+			output_v = get_output_voltage();
+			output_max_v = fmax(output_max_v, output_v);
+			output_min_v = fmin(output_min_v, output_v);
+		}
+	}
+
+	get_plant_simulator_sample(&m_last_sample);
+	m_last_sample.output_voltage_min_v = (float)output_min_v;
+	m_last_sample.output_voltage_max_v = (float)output_max_v;
+	m_last_sample.duty = duty;
+	m_last_sample.input_current_a = duty * (float)m_plant_state[0];
+	m_last_sample.is_pwm_running = is_pwm_running;
+}
+
+/**
+ * @brief Advances the plant state by one step, rediscretizing when the step or load changed.
+ */
+static void apply_discrete_model(plant_discrete_model_t *model_ptr, double step_time_s, double input_v)
+{
+	if(step_time_s <= 0.0)
+	{
+		return;
+	}
+
+	if((step_time_s != model_ptr->step_time_s) ||
+	   (m_plant_cfg.load_resistance_ohm != model_ptr->load_resistance_ohm))
+	{
+		discretize_plant(model_ptr, step_time_s);
+	}
+
+	double inductor_current =
+		(model_ptr->state_matrix[0][0] * m_plant_state[0]) +
+		(model_ptr->state_matrix[0][1] * m_plant_state[1]) +
+		(model_ptr->input_vector[0] * input_v);
+
+	double capacitor_voltage =
+		(model_ptr->state_matrix[1][0] * m_plant_state[0]) +
+		(model_ptr->state_matrix[1][1] * m_plant_state[1]) +
+		(model_ptr->input_vector[1] * input_v);
+
+	// the diode blocks a negative inductor current (discontinuous conduction)
+	m_plant_state[0] = (inductor_current > 0.0) ? inductor_current : 0.0;
+	m_plant_state[1] = capacitor_voltage;
+}
+
+/**
+ * @brief Computes the exact zero order hold discretization for one step length.
+ *
+ * The input vector is obtained together with the state matrix from the
+ * exponential of the augmented matrix [[A, B], [0, 0]] * step_time.
+ */
+static void discretize_plant(plant_discrete_model_t *model_ptr, double step_time_s)
+{
+	double inductance = m_plant_cfg.inductance_h;
+	double capacitance = m_plant_cfg.capacitance_f;
+	double load = m_plant_cfg.load_resistance_ohm;
+	double esr = m_plant_cfg.capacitor_esr_ohm;
+	double inductor_resistance = m_plant_cfg.inductor_resistance_ohm;
+
+	double augmented[3][3] =
+	{
+		{ -(inductor_resistance + (load * esr / (load + esr))) / inductance,
+		  -(load / (load + esr)) / inductance,
+		  1.0 / inductance },
+		{ (load / (load + esr)) / capacitance,
+		  -(1.0 / (load + esr)) / capacitance,
+		  0.0 },
+		{ 0.0, 0.0, 0.0 },
+	};
+
+	/* scaling and squaring: bring the norm below 0.5 before the Taylor series */
+	double norm = 0.0;
+	for(uint8_t row = 0U; row < 3U; row++)
+	{
+		double row_sum = 0.0;
+		for(uint8_t col = 0U; col < 3U; col++)
+		{
+			augmented[row][col] *= step_time_s;
+			row_sum += fabs(augmented[row][col]);
+		}
+		norm = fmax(norm, row_sum);
+	}
+
+	int squaring_cnt = 0;
+	while(norm > 0.5)
+	{
+		norm *= 0.5;
+		squaring_cnt++;
+	}
+
+	double scale = ldexp(1.0, -squaring_cnt);
+	double exponential[3][3] = { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } };
+	double term[3][3] = { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } };
+
+	for(uint8_t term_idx = 1U; term_idx <= PLANT_EXPM_TAYLOR_TERMS; term_idx++)
+	{
+		double next_term[3][3] = { { 0.0 } };
+
+		for(uint8_t row = 0U; row < 3U; row++)
+		{
+			for(uint8_t col = 0U; col < 3U; col++)
+			{
+				for(uint8_t k = 0U; k < 3U; k++)
+				{
+					next_term[row][col] += term[row][k] * augmented[k][col] * scale;
+				}
+				next_term[row][col] /= (double)term_idx;
+			}
+		}
+
+		memcpy(term, next_term, sizeof(term));
+
+		for(uint8_t row = 0U; row < 3U; row++)
+		{
+			for(uint8_t col = 0U; col < 3U; col++)
+			{
+				exponential[row][col] += term[row][col];
+			}
+		}
+	}
+
+	for(int squaring_idx = 0; squaring_idx < squaring_cnt; squaring_idx++)
+	{
+		double squared[3][3] = { { 0.0 } };
+
+		for(uint8_t row = 0U; row < 3U; row++)
+		{
+			for(uint8_t col = 0U; col < 3U; col++)
+			{
+				for(uint8_t k = 0U; k < 3U; k++)
+				{
+					squared[row][col] += exponential[row][k] * exponential[k][col];
+				}
+			}
+		}
+
+		memcpy(exponential, squared, sizeof(exponential));
+	}
+
+	model_ptr->state_matrix[0][0] = exponential[0][0];
+	model_ptr->state_matrix[0][1] = exponential[0][1];
+	model_ptr->state_matrix[1][0] = exponential[1][0];
+	model_ptr->state_matrix[1][1] = exponential[1][1];
+	model_ptr->input_vector[0] = exponential[0][2];
+	model_ptr->input_vector[1] = exponential[1][2];
+	model_ptr->step_time_s = step_time_s;
+	model_ptr->load_resistance_ohm = m_plant_cfg.load_resistance_ohm;
+}
+
+/**
+ * @brief Returns the output voltage at the trigger point of the switching period that starts now.
+ *
+ * The plant state is left unchanged.
+ */
+static double get_output_voltage_at_trigger(double period_s, double on_time_s, double input_v, float trigger_phase)
+{
+	double period_start_state[2] = { m_plant_state[0], m_plant_state[1] };
+	double trigger_time_s = period_s * (double)trigger_phase;
+
+	if(trigger_time_s < on_time_s)
+	{
+		apply_discrete_model(&m_trigger_segment_model, trigger_time_s, input_v);
+	}
+	else
+	{
+		apply_discrete_model(&m_on_segment_model, on_time_s, input_v);
+		apply_discrete_model(&m_trigger_segment_model, trigger_time_s - on_time_s, 0.0);
+	}
+
+	double output_v = get_output_voltage();
+
+	m_plant_state[0] = period_start_state[0];
+	m_plant_state[1] = period_start_state[1];
+
+	return output_v;
+}
+
+static double get_output_voltage(void)
+{
+	double load = m_plant_cfg.load_resistance_ohm;
+	double esr = m_plant_cfg.capacitor_esr_ohm;
+
+	return load * (m_plant_state[1] + (esr * m_plant_state[0])) / (load + esr);
+}
+
+/**
+ * @brief Returns normally distributed ADC noise (Box-Muller on a xorshift32 generator).
+ */
+static float get_gaussian_noise(void)
+{
+	if(m_plant_cfg.adc_noise_counts <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	double uniform[2];
+
+	for(uint8_t idx = 0U; idx < 2U; idx++)
+	{
+		m_noise_state ^= m_noise_state << 13;
+		m_noise_state ^= m_noise_state >> 17;
+		m_noise_state ^= m_noise_state << 5;
+		uniform[idx] = ((double)m_noise_state + 1.0) / 4294967297.0;
+	}
+
+	double gaussian = sqrt(-2.0 * log(uniform[0])) * cos(2.0 * M_PI * uniform[1]);
+
+	return (float)(gaussian * m_plant_cfg.adc_noise_counts);
+}
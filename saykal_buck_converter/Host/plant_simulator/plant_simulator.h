@@ -0,0 +1,164 @@
+/**
+ * @file plant_simulator.h
+ * @brief Closed-loop buck converter plant simulator for the host build.
+ *
+ * The simulator closes the loop around the unmodified firmware: it reads the
+ * duty cycle that set_pwm_duty() programs into the buck MOSFET timer, integrates
+ * an L-C-R model of the power stage and serves the resulting output voltage,
+ * output current and temperature as ADC counts to the bsp_adc read functions.
+ * Time is virtual; every simulated millisecond runs one main loop iteration of
+ * the system manager and advances the tick returned by HAL_GetTick().
+ *
+ * Two plant models are available:
+ * - Averaged model: the switch node is replaced by duty * input voltage.
+ * - Switching model: every PWM period is integrated as an on and an off segment,
+ *   so the output carries the real switching ripple. A timer triggered ADC
+ *   converts the output at its trigger point of the last switching period.
+ *
+ * Both models are discretized exactly (zero order hold matrix exponential), so the
+ * step size only affects when the diode clamp (no negative inductor current) is
+ * applied, not the accuracy of the linear dynamics.
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef PLANT_SIMULATOR_H_
+#define PLANT_SIMULATOR_H_
+
+#include "stdint.h"
+#include "stdbool.h"
+
+/**
+ * @brief Selects the power stage model used by the simulator.
+ */
+typedef enum
+{
+	PLANT_MODEL_AVERAGED_e,		///< State space averaged model
+	PLANT_MODEL_SWITCHING_e,	///< Switching level model, one on and one off segment per PWM period
+
+}plant_model_e;
+
+/**
+ * @brief Physical parameters and options of the simulated power stage.
+ */
+typedef struct
+{
+	plant_model_e model;					///< Power stage model
+	float input_voltage_v;					///< DC input voltage
+	float inductance_h;						///< Output inductor
+	float inductor_resistance_ohm;			///< Inductor DC resistance plus switch conduction resistance
+	float capacitance_f;					///< Output capacitor
+	float capacitor_esr_ohm;				///< Output capacitor equivalent series resistance
+	float load_resistance_ohm;				///< Resistive load
+	float switching_frequency_hz;			///< PWM frequency, used by the switching model
+	float ambient_temperature_c;			///< Temperature seen by the LM35 sensor
+	float adc_noise_counts;					///< Standard deviation of the noise added to every conversion
+	uint32_t noise_seed;					///< Seed of the deterministic noise generator
+	uint16_t averaged_substeps_per_ms;		///< Integration steps per millisecond of the averaged model
+
+}plant_simulator_cfg_t;
+
+/**
+ * @brief State of the simulated converter at the end of a millisecond.
+ */
+typedef struct
+{
+	uint32_t time_ms;						///< Virtual time (HAL_GetTick())
+	float output_voltage_v;					///< Output voltage at the end of the millisecond
+	float output_voltage_min_v;				///< Minimum output voltage seen during the millisecond
+	float output_voltage_max_v;				///< Maximum output voltage seen during the millisecond
+	float inductor_current_a;				///< Inductor current
+	float output_current_a;					///< Load current
+	float duty;								///< Duty cycle applied during the millisecond
+	float input_voltage_v;					///< Input voltage
+	float input_current_a;					///< Average input current, the inductor current while the MOSFET conducts
+	float load_resistance_ohm;				///< Load resistance
+	bool is_pwm_running;					///< Whether the MOSFET PWM output was enabled
+
+}plant_simulator_sample_t;
+
+/**
+ * @brief Called once per simulated millisecond with the plant state.
+ *
+ * @param[in] sample_ptr  State of the plant at the end of the millisecond.
+ * @param[in] context_ptr User context given to run_plant_simulator().
+ * @return true to continue the simulation, false to stop it early.
+ */
+typedef bool (*plant_simulator_sample_func_t)(const plant_simulator_sample_t *sample_ptr,
+											  void *context_ptr);
+
+/**
+ * @brief Fills a configuration with the nominal bench power stage.
+ *
+ * @param[out] plant_cfg_ptr Configuration to fill.
+ */
+void get_default_plant_simulator_cfg(plant_simulator_cfg_t *plant_cfg_ptr);
+
+/**
+ * @brief Initializes the simulator and connects it to the host HAL.
+ *
+ * Resets the host HAL, starts the plant discharged and registers the ADC
+ * conversion source. The firmware itself is started by the first main loop
+ * iteration executed by run_plant_simulator().
+ *
+ * @param[in] plant_cfg_ptr Power stage configuration. Must not be NULL.
+ */
+void init_plant_simulator(const plant_simulator_cfg_t *plant_cfg_ptr);
+
+/**
+ * @brief Runs the firmware and the plant for the given virtual time.
+ *
+ * Milliseconds the firmware spends blocked in HAL_Delay(), e.g. the start-up
+ * zero calibration, are simulated with the PWM state at the end of the wait
+ * and count as simulated time, without a sample_func call.
+ *
+ * @param[in] duration_ms Virtual time to simulate.
+ * @param[in] sample_func Called after every simulated millisecond, may be NULL.
+ * @param[in] context_ptr User context passed to sample_func.
+ * @return uint32_t Number of milliseconds actually simulated.
+ */
+uint32_t run_plant_simulator(uint32_t duration_ms,
+							 plant_simulator_sample_func_t sample_func,
+							 void *context_ptr);
+
+/**
+ * @brief Changes the load resistance, e.g. to apply a load step.
+ *
+ * @param[in] load_resistance_ohm New load resistance.
+ */
+void set_plant_load_resistance(float load_resistance_ohm);
+
+/**
+ * @brief Changes the input voltage, e.g. to apply a line step.
+ *
+ * @param[in] input_voltage_v New input voltage.
+ */
+void set_plant_input_voltage(float input_voltage_v);
+
+/**
+ * @brief Forces the value a sensor reports, e.g. a stuck sensor or a current pulse.
+ *
+ * The value is given in the unit of the sensor (A, V, degC) and goes through the
+ * same conversion into ADC counts as the simulated quantity; the plant itself is
+ * not affected.
+ *
+ * @param[in] sensor_id    Sensor ID of the adc_sensor_driver configuration.
+ * @param[in] sensor_value Value reported until clear_plant_sensor_override().
+ */
+void set_plant_sensor_override(uint8_t sensor_id, float sensor_value);
+
+/**
+ * @brief Lets a sensor report the simulated quantity again.
+ *
+ * @param[in] sensor_id Sensor ID of the adc_sensor_driver configuration.
+ */
+void clear_plant_sensor_override(uint8_t sensor_id);
+
+/**
+ * @brief Returns the plant state at the current virtual time.
+ *
+ * @param[out] sample_ptr State of the plant.
+ */
+void get_plant_simulator_sample(plant_simulator_sample_t *sample_ptr);
+
+#endif /* PLANT_SIMULATOR_H_ */
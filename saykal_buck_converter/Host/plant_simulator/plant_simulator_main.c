@@ -0,0 +1,298 @@
+/**
+ * @file plant_simulator_main.c
+ * @brief Command line front end of the closed-loop plant simulator.
+ *
+ * Runs the firmware against the simulated power stage and prints a summary.
+ * Optionally writes the per-millisecond plant trace as CSV.
+ *
+ * Usage: buck_plant_sim [options]
+ *   --duration-ms N        virtual time to simulate (default 10000)
+ *   --model M              averaged | switching (default averaged)
+ *   --vin V                input voltage
+ *   --inductance H         output inductor
+ *   --capacitance F        output capacitor
+ *   --esr OHM              output capacitor ESR
+ *   --load OHM             load resistance
+ *   --load-step-ms N       time of a load step
+ *   --load-step-ohm OHM    load resistance after the step
+ *   --noise COUNTS         ADC noise standard deviation
+ *   --vdda V               analog supply of the MCU ADC (default 3.3)
+ *   --seed N               noise seed
+ *   --csv PATH             write the trace as CSV
+ *   --decimate N           write every Nth millisecond to the CSV (default 1)
+ *   --record-trace PATH    write every ADC sensor sample as an ADC trace (see buck_adc_replay)
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "getopt.h"
+#include "time.h"
+#include "plant_simulator.h"
+#include "host_hal.h"
+#include "bsp_adc.h"
+#include "error_manager.h"
+#include "software_timer.h"
+#include "adc_trace_file.h"
+
+/**
+ * @brief Context of the per-millisecond sample callback.
+ */
+typedef struct
+{
+	FILE *csv_file_ptr;
+	uint32_t decimation;
+	uint32_t load_step_ms;
+	float load_step_ohm;
+	bool is_load_step_enabled;
+	const char *trace_path;
+	adc_trace_writer_t trace_writer;
+	bool is_trace_opened;
+	bool is_trace_failed;
+
+}plant_simulator_run_context_t;
+
+static bool handle_plant_sample(const plant_simulator_sample_t *sample_ptr, void *context_ptr);
+
+static void drain_adc_trace_recorder(plant_simulator_run_context_t *run_context_ptr);
+
+int main(int argc, char *argv[])
+{
+	static const struct option long_options[] =
+	{
+		{ "duration-ms",   required_argument, NULL, 'd' },
+		{ "model",         required_argument, NULL, 'm' },
+		{ "vin",           required_argument, NULL, 'v' },
+		{ "inductance",    required_argument, NULL, 'L' },
+		{ "capacitance",   required_argument, NULL, 'C' },
+		{ "esr",           required_argument, NULL, 'e' },
+		{ "load",          required_argument, NULL, 'r' },
+		{ "load-step-ms",  required_argument, NULL, 't' },
+		{ "load-step-ohm", required_argument, NULL, 'R' },
+		{ "noise",         required_argument, NULL, 'n' },
+		{ "vdda",          required_argument, NULL, 'a' },
+		{ "seed",          required_argument, NULL, 's' },
+		{ "csv",           required_argument, NULL, 'o' },
+		{ "decimate",      required_argument, NULL, 'k' },
+		{ "record-trace",  required_argument, NULL, 'T' },
+		{ NULL, 0, NULL, 0 },
+	};
+
+	plant_simulator_cfg_t plant_cfg;
+	get_default_plant_simulator_cfg(&plant_cfg);
+
+	plant_simulator_run_context_t run_context =
+	{
+		.csv_file_ptr = NULL,
+		.decimation = 1U,
+	};
+
+	uint32_t duration_ms = 10000U;
+	float adc_supply_voltage = BSP_ADC_REFERENCE_VOLTAGE;
+	const char *csv_path = NULL;
+	int option;
+
+	while(-1 != (option = getopt_long(argc, argv, "", long_options, NULL)))
+	{
+		switch(option)
+		{
+			case 'd': duration_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'm':
+			{
+				plant_cfg.model = (0 == strcmp(optarg, "switching")) ?
+					PLANT_MODEL_SWITCHING_e : PLANT_MODEL_AVERAGED_e;
+				break;
+			}
+			case 'v': plant_cfg.input_voltage_v = strtof(optarg, NULL); break;
+			case 'L': plant_cfg.inductance_h = strtof(optarg, NULL); break;
+			case 'C': plant_cfg.capacitance_f = strtof(optarg, NULL); break;
+			case 'e': plant_cfg.capacitor_esr_ohm = strtof(optarg, NULL); break;
+			case 'r': plant_cfg.load_resistance_ohm = strtof(optarg, NULL); break;
+			case 't':
+			{
+				run_context.load_step_ms = (uint32_t)strtoul(optarg, NULL, 10);
+				run_context.is_load_step_enabled = true;
+				break;
+			}
+			case 'R': run_context.load_step_ohm = strtof(optarg, NULL); break;
+			case 'n': plant_cfg.adc_noise_counts = strtof(optarg, NULL); break;
+			case 'a': adc_supply_voltage = strtof(optarg, NULL); break;
+			case 's': plant_cfg.noise_seed = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'o': csv_path = optarg; break;
+			case 'k': run_context.decimation = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'T': run_context.trace_path = optarg; break;
+			default:
+			{
+				fprintf(stderr, "usage: %s [--duration-ms N] [--model averaged|switching] ...\n", argv[0]);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	if(0U == run_context.decimation)
+	{
+		run_context.decimation = 1U;
+	}
+
+	if(true == run_context.is_load_step_enabled && run_context.load_step_ohm <= 0.0f)
+	{
+		fprintf(stderr, "--load-step-ms needs a positive --load-step-ohm\n");
+		return EXIT_FAILURE;
+	}
+
+	if(NULL != csv_path)
+	{
+		run_context.csv_file_ptr = fopen(csv_path, "w");
+
+		if(NULL == run_context.csv_file_ptr)
+		{
+			perror(csv_path);
+			return EXIT_FAILURE;
+		}
+
+		fprintf(run_context.csv_file_ptr,
+				"time_ms,output_voltage_v,output_voltage_min_v,output_voltage_max_v,"
+				"inductor_current_a,output_current_a,duty,input_voltage_v,load_resistance_ohm\n");
+	}
+
+	struct timespec wall_start;
+	struct timespec wall_end;
+
+	init_plant_simulator(&plant_cfg);
+	host_hal_set_adc_supply_voltage(adc_supply_voltage);
+
+	clock_gettime(CLOCK_MONOTONIC, &wall_start);
+	uint32_t simulated_ms = run_plant_simulator(duration_ms, handle_plant_sample, &run_context);
+	clock_gettime(CLOCK_MONOTONIC, &wall_end);
+
+	if(NULL != run_context.csv_file_ptr)
+	{
+		fclose(run_context.csv_file_ptr);
+	}
+
+	if(true == run_context.is_trace_opened)
+	{
+		drain_adc_trace_recorder(&run_context);
+
+		uint64_t trace_record_cnt = run_context.trace_writer.record_cnt;
+
+		if(false == close_adc_trace_writer(&run_context.trace_writer))
+		{
+			run_context.is_trace_failed = true;
+		}
+
+		printf("trace_records=%llu\n", (unsigned long long)trace_record_cnt);
+	}
+
+	if(true == run_context.is_trace_failed)
+	{
+		fprintf(stderr, "%s: could not write the ADC trace\n", run_context.trace_path);
+		return EXIT_FAILURE;
+	}
+
+	double wall_s = (double)(wall_end.tv_sec - wall_start.tv_sec) +
+					((double)(wall_end.tv_nsec - wall_start.tv_nsec) * 1e-9);
+
+	plant_simulator_sample_t final_sample;
+	get_plant_simulator_sample(&final_sample);
+
+	printf("simulated_ms=%u wall_s=%.3f realtime_factor=%.0f\n",
+		   (unsigned)simulated_ms, wall_s,
+		   (wall_s > 0.0) ? ((double)simulated_ms * 1e-3 / wall_s) : 0.0);
+	printf("output_voltage_v=%.4f output_current_a=%.4f inductor_current_a=%.4f duty=%.4f\n",
+		   final_sample.output_voltage_v, final_sample.output_current_a,
+		   final_sample.inductor_current_a, final_sample.duty);
+	printf("system_error_status=0x%02X\n", (unsigned)get_system_error_status());
+
+	float mcu_temperature = 0.0f;
+
+	if(BSP_ADC_STATE_OK_e == read_mcu_temperature(&mcu_temperature))
+	{
+		printf("adc_supply_voltage_v=%.4f mcu_temperature_c=%.1f\n", get_bsp_adc_supply_voltage(), mcu_temperature);
+	}
+
+	for(software_timer_id_t timer_id = 0U; timer_id < SOFTWARE_TIMER_CNT; timer_id++)
+	{
+		software_timer_exec_stats_t exec_stats;
+
+		if((true == get_software_timer_exec_stats(timer_id, &exec_stats)) &&
+		   (0U != exec_stats.cycle_frequency_hz))
+		{
+			double us_per_cycle = 1e6 / (double)exec_stats.cycle_frequency_hz;
+
+			printf("timer_%u calls=%u min_us=%.3f mean_us=%.3f max_us=%.3f\n",
+				   (unsigned)timer_id, (unsigned)exec_stats.call_cnt,
+				   exec_stats.min_cycles * us_per_cycle,
+				   exec_stats.mean_cycles * us_per_cycle,
+				   exec_stats.max_cycles * us_per_cycle);
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static bool handle_plant_sample(const plant_simulator_sample_t *sample_ptr, void *context_ptr)
+{
+	plant_simulator_run_context_t *run_context_ptr = (plant_simulator_run_context_t *)context_ptr;
+
+	if((true == run_context_ptr->is_load_step_enabled) &&
+	   (sample_ptr->time_ms == run_context_ptr->load_step_ms))
+	{
+		set_plant_load_resistance(run_context_ptr->load_step_ohm);
+	}
+
+	if((NULL != run_context_ptr->csv_file_ptr) &&
+	   (0U == (sample_ptr->time_ms % run_context_ptr->decimation)))
+	{
+		fprintf(run_context_ptr->csv_file_ptr, "%u,%.5f,%.5f,%.5f,%.5f,%.5f,%.5f,%.3f,%.4f\n",
+				(unsigned)sample_ptr->time_ms,
+				sample_ptr->output_voltage_v,
+				sample_ptr->output_voltage_min_v,
+				sample_ptr->output_voltage_max_v,
+				sample_ptr->inductor_current_a,
+				sample_ptr->output_current_a,
+				sample_ptr->duty,
+				sample_ptr->input_voltage_v,
+				sample_ptr->load_resistance_ohm);
+	}
+
+	if((NULL != run_context_ptr->trace_path) && (false == run_context_ptr->is_trace_failed))
+	{
+		drain_adc_trace_recorder(run_context_ptr);
+	}
+
+	return true;
+}
+
+/**
+ * @brief Moves the records of the firmware ADC trace recorder into the trace file.
+ *
+ * The file is created on the first call, once the firmware initialized the recorder.
+ */
+static void drain_adc_trace_recorder(plant_simulator_run_context_t *run_context_ptr)
+{
+	adc_trace_record_t records[256];
+	uint32_t record_cnt;
+
+	if(false == run_context_ptr->is_trace_opened)
+	{
+		adc_trace_file_header_t trace_header;
+		get_adc_trace_file_header(&trace_header);
+
+		run_context_ptr->is_trace_opened =
+			open_adc_trace_writer(run_context_ptr->trace_path, &trace_header, &run_context_ptr->trace_writer);
+		run_context_ptr->is_trace_failed = (false == run_context_ptr->is_trace_opened);
+	}
+
+	while((true == run_context_ptr->is_trace_opened) &&
+		  (0U != (record_cnt = read_adc_trace_records(records, sizeof(records) / sizeof(records[0])))))
+	{
+		if(false == write_adc_trace_records(&run_context_ptr->trace_writer, records, record_cnt))
+		{
+			run_context_ptr->is_trace_failed = true;
+			break;
+		}
+	}
+}
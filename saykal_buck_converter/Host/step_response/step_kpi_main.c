@@ -0,0 +1,903 @@
+/**
+ * @file step_kpi_main.c
+ * @brief Step response KPI gate of the buck converter controller.
+ *
+ * Runs a fixed set of reference and load step scenarios of the closed-loop
+ * plant simulator with the firmware configuration as built and scores every
+ * scenario with rise time, overshoot, settling time, steady state error,
+ * output ripple, peak deviation and duty saturation time. Every scenario runs
+ * in its own process forked from the pristine firmware state.
+ *
+ * A load step is applied to the converter in regulation: the output voltage
+ * is observed for the steady state window before the step and the step is
+ * scored from the mean measured there, so only the response to the step itself
+ * is scored. A scenario that is not settled is flagged on stderr: outside the
+ * settling band at the end, duty at a limit for most of the scored time, or a
+ * load step applied before the loop settled. Its KPIs then describe a limit
+ * cycle or saturation instead of the step, so such a baseline is only written
+ * with --allow-unsettled and every row records whether it was settled.
+ *
+ * The product gains drive the duty between its limits, so those scenarios
+ * score the saturated loop only and are flagged. The linear scenarios replace
+ * the gains of both controllers by a slower set that keeps the duty inside its
+ * limits. A single run of them reacts to the flip of one ADC LSB, so each is
+ * averaged over STEP_KPI_REPEAT_CNT runs with shifted step times and dithered
+ * ADC counts. The averages resolve a 10 % change of the integral action or a
+ * 20 % cut of the proportional action; smaller changes of the control law,
+ * e.g. PID_Step() against PID_Step_v2(), stay inside the tolerances.
+ *
+ * The KPIs can be written as a baseline and later compared against it. A
+ * baseline belongs to one controller configuration: every row carries an ID
+ * hashed from the gains, limits and references of g_buck_converter_config as
+ * the scenario ran with them, the linear rows with their own gains, so a
+ * baseline recorded for different settings is rejected instead of silently
+ * compared.
+ *
+ * Alternatively a CSV written by buck_plant_sim --csv is scored as one step.
+ *
+ * Usage: buck_step_kpi [options]
+ *   --write-baseline PATH  write the KPIs of all scenarios as a baseline
+ *   --baseline PATH        compare against a baseline, exit 1 on a regression
+ *   --threshold R          allowed relative degradation (default 0.05)
+ *   --model M              averaged | switching (default averaged)
+ *   --band R               relative settling band (default 0.02)
+ *   --input PATH           score a buck_plant_sim CSV instead of the scenarios
+ *   --step-ms N            step time inside --input (default 0)
+ *   --initial V            output voltage before the step inside --input (default 0)
+ *   --steady-window-ms N   steady state window at the end and before a load step (default 500)
+ *   --allow-unsettled      write a baseline even if a scenario is not settled
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "math.h"
+#include "getopt.h"
+#include "plant_simulator.h"
+#include "step_response.h"
+#include "work_stealing_pool.h"
+#include "app_buck_converter.h"
+#include "error_manager.h"
+
+extern const buck_converter_cfg_t g_buck_converter_config;
+
+/** @brief Number of scored KPIs. */
+#define STEP_KPI_CNT					7U
+
+/** @brief Duty within this distance of a controller limit counts as saturated, covers the PWM resolution. */
+#define STEP_KPI_DUTY_SATURATION_MARGIN	0.005f
+
+/** @brief Duty at a limit for more than this share of the scored time marks a scenario as not settled. */
+#define STEP_KPI_DUTY_SATURATION_RATIO_MAX	0.5f
+
+/** @brief Runs averaged per linear scenario, a single run reacts to the flip of one ADC LSB. */
+#define STEP_KPI_REPEAT_CNT					16U
+
+/** @brief Step time shift between the runs of a scenario, moves the step against the controller period. */
+#define STEP_KPI_REPEAT_SHIFT_MS			7U
+
+/** @brief ADC noise of the repeated runs in counts, dithers the quantization so every run sees other LSB flips. */
+#define STEP_KPI_REPEAT_NOISE_COUNTS		0.25f
+
+/** @brief Columns of a baseline, the KPIs follow the scenario and the configuration ID. */
+#define STEP_KPI_CSV_HEADER \
+	"scenario,config_id,rise_time_ms,overshoot_percent,settling_time_ms,steady_state_error_v," \
+	"ripple_v,max_deviation_v,duty_saturation_ms,over_current_tripped,settled"
+
+/**
+ * @brief Reasons a scenario is not settled, its KPIs then do not describe the step.
+ */
+typedef enum
+{
+	STEP_KPI_UNSETTLED_AFTER_STEP_e		= 0x01U,	///< Outside the settling band inside the steady state window
+	STEP_KPI_DUTY_SATURATED_e			= 0x02U,	///< Duty at a limit for most of the scored time
+	STEP_KPI_UNSETTLED_BEFORE_STEP_e	= 0x04U,	///< Load step applied outside the settling band
+
+}step_kpi_unsettled_flag_e;
+
+/**
+ * @brief Gains of one controller.
+ */
+typedef struct
+{
+	float Kp;
+	float Ki;
+	float Kd;
+	float Kaw;
+
+}step_kpi_gains_t;
+
+/**
+ * @brief One step scenario.
+ */
+typedef struct
+{
+	const char *name;
+	uint32_t step_ms;						///< Time of the step
+	uint32_t duration_ms;					///< Simulated time
+	float load_before_ohm;					///< Load until the step
+	float load_after_ohm;					///< Load after the step
+	bool is_reference_step;					///< Step of the reference from 0 V at start-up instead of a load step
+	const step_kpi_gains_t *gains_ptr;		///< Voltage and current controller gains, NULL for the configured ones
+	uint32_t repeat_cnt;					///< Runs averaged with shifted step times and dithered ADC counts, 1 for a single run
+
+}step_kpi_scenario_t;
+
+/**
+ * @brief KPIs of one scenario, located in the shared result slot of the job.
+ */
+typedef struct
+{
+	float kpis[STEP_KPI_CNT];
+	uint32_t config_id;						///< get_controller_config_id() with the gains the scenario ran with
+	uint8_t unsettled_flags;				///< step_kpi_unsettled_flag_e bits, 0 for a settled scenario
+	bool is_over_current_tripped;
+
+}step_kpi_result_t;
+
+/**
+ * @brief Description of one KPI for printing and comparing.
+ */
+typedef struct
+{
+	const char *name;
+	float absolute_tolerance;				///< Degradation always accepted, covers quantization of the metric
+	bool is_magnitude_compared;				///< Compare the absolute value, for signed errors
+
+}step_kpi_info_t;
+
+/**
+ * @brief Context shared by the scenario jobs.
+ */
+typedef struct
+{
+	plant_model_e model;
+	float settling_band_ratio;
+	uint32_t steady_window_ms;
+
+}step_kpi_context_t;
+
+/**
+ * @brief Voltage and current controller gains of the linear scenarios, settled within 3 s of start-up.
+ */
+static const step_kpi_gains_t m_step_kpi_linear_gains[2] =
+{
+	{ 0.05f,  0.005f, 0.5f,   0.02f },
+	{ 0.005f, 0.004f, 0.025f, 0.02f },
+};
+
+static const step_kpi_scenario_t m_step_kpi_scenarios[] =
+{
+	{ "reference_step",        0U,    3000U, 4.8f, 4.8f, true,  NULL,                    1U },
+	{ "load_step_up",          3000U, 6000U, 9.6f, 4.8f, false, NULL,                    1U },
+	{ "load_step_down",        3000U, 6000U, 4.8f, 9.6f, false, NULL,                    1U },
+	{ "linear_load_step_up",   3000U, 6000U, 9.6f, 8.0f, false, m_step_kpi_linear_gains, STEP_KPI_REPEAT_CNT },
+	{ "linear_load_step_down", 3000U, 6000U, 8.0f, 9.6f, false, m_step_kpi_linear_gains, STEP_KPI_REPEAT_CNT },
+};
+
+#define STEP_KPI_SCENARIO_CNT	(sizeof(m_step_kpi_scenarios) / sizeof(m_step_kpi_scenarios[0]))
+
+/*
+ * The absolute tolerances cover about three standard deviations of the averaged
+ * linear scenarios across independent noise seeds and are never below one LSB
+ * of the output voltage sense (11.7 mV, 0.05 % of 24 V).
+ */
+static const step_kpi_info_t m_step_kpi_infos[STEP_KPI_CNT] =
+{
+	{ "rise_time_ms",        1.0f,   false },
+	{ "overshoot_percent",   0.25f,  false },
+	{ "settling_time_ms",    10.0f,  false },
+	{ "steady_state_error_v", 0.012f, true },
+	{ "ripple_v",            0.06f,  false },
+	{ "max_deviation_v",     0.06f,  false },
+	{ "duty_saturation_ms",  1.0f,   false },
+};
+
+static uint32_t get_step_kpi_job_cnt(void);
+
+static uint32_t get_step_kpi_job_scenario_idx(uint32_t job_idx, uint32_t *repeat_idx_ptr);
+
+static bool run_step_kpi_job(uint32_t job_idx, void *result_ptr, void *context_ptr);
+
+static void average_step_kpi_results(const step_kpi_result_t *job_results_ptr, uint32_t job_result_cnt,
+									 step_kpi_result_t *result_ptr);
+
+static bool handle_step_kpi_sample(const plant_simulator_sample_t *sample_ptr, void *context_ptr);
+
+static void init_step_kpi_response(step_response_t *step_response_ptr, float initial_value,
+								   uint32_t step_ms, uint32_t end_ms,
+								   const step_kpi_context_t *step_kpi_context_ptr);
+
+static void convert_metrics_to_kpis(const step_response_metrics_t *metrics_ptr, float *kpis_ptr);
+
+static uint8_t get_unsettled_flags(const step_response_metrics_t *metrics_ptr, uint32_t scored_ms);
+
+static bool report_unsettled_scenario(const char *scenario_name, uint8_t unsettled_flags);
+
+static uint32_t get_controller_config_id(void);
+
+static void print_step_kpi_row(FILE *file_ptr, const char *scenario_name, const step_kpi_result_t *result_ptr);
+
+static bool score_plant_csv(const char *input_path, uint32_t step_ms, float initial_value,
+							const step_kpi_context_t *step_kpi_context_ptr);
+
+static bool is_kpi_regressed(const step_kpi_info_t *kpi_info_ptr, float baseline_value,
+							 float value, float threshold);
+
+static int compare_with_baseline(const char *baseline_path, const step_kpi_result_t *results_ptr,
+								 float threshold);
+
+int main(int argc, char *argv[])
+{
+	static const struct option long_options[] =
+	{
+		{ "write-baseline",   required_argument, NULL, 'w' },
+		{ "baseline",         required_argument, NULL, 'b' },
+		{ "threshold",        required_argument, NULL, 't' },
+		{ "model",            required_argument, NULL, 'm' },
+		{ "band",             required_argument, NULL, 'B' },
+		{ "input",            required_argument, NULL, 'i' },
+		{ "step-ms",          required_argument, NULL, 's' },
+		{ "initial",          required_argument, NULL, 'I' },
+		{ "steady-window-ms", required_argument, NULL, 'W' },
+		{ "allow-unsettled",  no_argument,       NULL, 'u' },
+		{ NULL, 0, NULL, 0 },
+	};
+
+	step_kpi_context_t step_kpi_context =
+	{
+		.model = PLANT_MODEL_AVERAGED_e,
+		.settling_band_ratio = 0.02f,
+		.steady_window_ms = 500U,
+	};
+
+	const char *write_baseline_path = NULL;
+	const char *baseline_path = NULL;
+	const char *input_path = NULL;
+	float threshold = 0.05f;
+	uint32_t input_step_ms = 0U;
+	float input_initial_value = 0.0f;
+	bool is_unsettled_allowed = false;
+	int option;
+
+	while(-1 != (option = getopt_long(argc, argv, "", long_options, NULL)))
+	{
+		switch(option)
+		{
+			case 'w': write_baseline_path = optarg; break;
+			case 'b': baseline_path = optarg; break;
+			case 't': threshold = strtof(optarg, NULL); break;
+			case 'm':
+			{
+				step_kpi_context.model = (0 == strcmp(optarg, "switching")) ?
+					PLANT_MODEL_SWITCHING_e : PLANT_MODEL_AVERAGED_e;
+				break;
+			}
+			case 'B': step_kpi_context.settling_band_ratio = strtof(optarg, NULL); break;
+			case 'i': input_path = optarg; break;
+			case 's': input_step_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'I': input_initial_value = strtof(optarg, NULL); break;
+			case 'W': step_kpi_context.steady_window_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'u': is_unsettled_allowed = true; break;
+			default:
+			{
+				fprintf(stderr, "usage: %s [--baseline PATH | --write-baseline PATH | --input CSV] ...\n", argv[0]);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	if(NULL != input_path)
+	{
+		return (true == score_plant_csv(input_path, input_step_ms, input_initial_value, &step_kpi_context)) ?
+			EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	work_stealing_pool_cfg_t pool_cfg =
+	{
+		.job_cnt = get_step_kpi_job_cnt(),
+		.worker_cnt = 0U,
+		.result_size = sizeof(step_kpi_result_t),
+		.is_job_isolated = true,
+		.is_progress_reported = false,
+		.job_func = run_step_kpi_job,
+		.context_ptr = &step_kpi_context,
+	};
+
+	work_stealing_pool_results_t pool_results;
+
+	if(false == run_work_stealing_pool(&pool_cfg, &pool_results))
+	{
+		fprintf(stderr, "work-stealing pool failed\n");
+		return EXIT_FAILURE;
+	}
+
+	step_kpi_result_t results[STEP_KPI_SCENARIO_CNT];
+	bool is_every_job_ok = true;
+	uint32_t first_job_idx = 0U;
+
+	for(uint32_t scenario_idx = 0U; scenario_idx < STEP_KPI_SCENARIO_CNT; scenario_idx++)
+	{
+		uint32_t repeat_cnt = m_step_kpi_scenarios[scenario_idx].repeat_cnt;
+
+		for(uint32_t job_idx = first_job_idx; job_idx < (first_job_idx + repeat_cnt); job_idx++)
+		{
+			if(WORK_STEALING_JOB_OK_e != pool_results.job_states_ptr[job_idx])
+			{
+				fprintf(stderr, "scenario %s did not complete\n", m_step_kpi_scenarios[scenario_idx].name);
+				is_every_job_ok = false;
+			}
+		}
+
+		/* the results of the runs of one scenario are adjacent in the result slots */
+		average_step_kpi_results(
+			(const step_kpi_result_t *)get_work_stealing_job_result(&pool_results, &pool_cfg, first_job_idx),
+			repeat_cnt, &results[scenario_idx]);
+
+		first_job_idx += repeat_cnt;
+	}
+
+	release_work_stealing_pool_results(&pool_results);
+
+	if(false == is_every_job_ok)
+	{
+		return EXIT_FAILURE;
+	}
+
+	bool is_every_scenario_settled = true;
+
+	for(uint32_t scenario_idx = 0U; scenario_idx < STEP_KPI_SCENARIO_CNT; scenario_idx++)
+	{
+		if(false == report_unsettled_scenario(m_step_kpi_scenarios[scenario_idx].name,
+											  results[scenario_idx].unsettled_flags))
+		{
+			is_every_scenario_settled = false;
+		}
+	}
+
+	printf(STEP_KPI_CSV_HEADER "\n");
+
+	for(uint32_t scenario_idx = 0U; scenario_idx < STEP_KPI_SCENARIO_CNT; scenario_idx++)
+	{
+		print_step_kpi_row(stdout, m_step_kpi_scenarios[scenario_idx].name, &results[scenario_idx]);
+	}
+
+	if(NULL != write_baseline_path)
+	{
+		if((false == is_every_scenario_settled) && (false == is_unsettled_allowed))
+		{
+			fprintf(stderr, "%s not written: unsettled scenarios score a limit cycle or saturation instead of "
+					"the step, retune the controller or pass --allow-unsettled\n", write_baseline_path);
+			return EXIT_FAILURE;
+		}
+
+		FILE *baseline_file_ptr = fopen(write_baseline_path, "w");
+
+		if(NULL == baseline_file_ptr)
+		{
+			perror(write_baseline_path);
+			return EXIT_FAILURE;
+		}
+
+		fprintf(baseline_file_ptr, STEP_KPI_CSV_HEADER "\n");
+
+		for(uint32_t scenario_idx = 0U; scenario_idx < STEP_KPI_SCENARIO_CNT; scenario_idx++)
+		{
+			print_step_kpi_row(baseline_file_ptr, m_step_kpi_scenarios[scenario_idx].name, &results[scenario_idx]);
+		}
+
+		fclose(baseline_file_ptr);
+	}
+
+	if(NULL != baseline_path)
+	{
+		return compare_with_baseline(baseline_path, results, threshold);
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static uint32_t get_step_kpi_job_cnt(void)
+{
+	uint32_t job_cnt = 0U;
+
+	for(uint32_t scenario_idx = 0U; scenario_idx < STEP_KPI_SCENARIO_CNT; scenario_idx++)
+	{
+		job_cnt += m_step_kpi_scenarios[scenario_idx].repeat_cnt;
+	}
+
+	return job_cnt;
+}
+
+/**
+ * @brief Maps a job to its scenario, the runs of a scenario are consecutive jobs.
+ */
+static uint32_t get_step_kpi_job_scenario_idx(uint32_t job_idx, uint32_t *repeat_idx_ptr)
+{
+	uint32_t scenario_idx = 0U;
+
+	while(job_idx >= m_step_kpi_scenarios[scenario_idx].repeat_cnt)
+	{
+		job_idx -= m_step_kpi_scenarios[scenario_idx].repeat_cnt;
+		scenario_idx++;
+	}
+
+	*repeat_idx_ptr = job_idx;
+
+	return scenario_idx;
+}
+
+static bool run_step_kpi_job(uint32_t job_idx, void *result_ptr, void *context_ptr)
+{
+	const step_kpi_context_t *step_kpi_context_ptr = (const step_kpi_context_t *)context_ptr;
+	uint32_t repeat_idx;
+	uint32_t scenario_idx = get_step_kpi_job_scenario_idx(job_idx, &repeat_idx);
+	const step_kpi_scenario_t *scenario_ptr = &m_step_kpi_scenarios[scenario_idx];
+	step_kpi_result_t *step_kpi_result_ptr = (step_kpi_result_t *)result_ptr;
+	plant_simulator_cfg_t plant_cfg;
+
+	/* every run of a repeated scenario steps at another controller phase and sees other ADC noise */
+	uint32_t step_ms = scenario_ptr->step_ms + (repeat_idx * STEP_KPI_REPEAT_SHIFT_MS);
+	uint32_t duration_ms = scenario_ptr->duration_ms + (repeat_idx * STEP_KPI_REPEAT_SHIFT_MS);
+
+	if(NULL != scenario_ptr->gains_ptr)
+	{
+		pid_controller_t *pids[2] =
+		{
+			g_buck_converter_config.pid_out_voltage_cotroller_ptr,
+			g_buck_converter_config.pid_out_current_cotroller_ptr,
+		};
+
+		for(uint32_t pid_idx = 0U; pid_idx < 2U; pid_idx++)
+		{
+			pids[pid_idx]->Kp = scenario_ptr->gains_ptr[pid_idx].Kp;
+			pids[pid_idx]->Ki = scenario_ptr->gains_ptr[pid_idx].Ki;
+			pids[pid_idx]->Kd = scenario_ptr->gains_ptr[pid_idx].Kd;
+			pids[pid_idx]->Kaw = scenario_ptr->gains_ptr[pid_idx].Kaw;
+		}
+	}
+
+	get_default_plant_simulator_cfg(&plant_cfg);
+	plant_cfg.model = step_kpi_context_ptr->model;
+	plant_cfg.load_resistance_ohm = scenario_ptr->load_before_ohm;
+
+	if(scenario_ptr->repeat_cnt > 1U)
+	{
+		plant_cfg.adc_noise_counts = STEP_KPI_REPEAT_NOISE_COUNTS;
+		plant_cfg.noise_seed = repeat_idx + 1U;
+	}
+
+	init_plant_simulator(&plant_cfg);
+
+	/* a reference step starts from the discharged output, a load step from the regulated output measured before it */
+	float initial_value = 0.0f;
+	uint8_t unsettled_flags = 0U;
+
+	if(true == scenario_ptr->is_reference_step)
+	{
+		run_plant_simulator(step_ms, NULL, NULL);
+	}
+	else
+	{
+		uint32_t window_ms = step_kpi_context_ptr->steady_window_ms;
+		uint32_t window_start_ms = (step_ms > window_ms) ? (step_ms - window_ms) : 0U;
+
+		step_response_t pre_step_response;
+		step_response_metrics_t pre_step_metrics;
+
+		init_step_kpi_response(&pre_step_response, g_buck_converter_config.v_out_ref, window_start_ms,
+							   window_start_ms, step_kpi_context_ptr);
+		run_plant_simulator(step_ms, handle_step_kpi_sample, &pre_step_response);
+		get_step_response_metrics(&pre_step_response, &pre_step_metrics);
+
+		initial_value = g_buck_converter_config.v_out_ref + pre_step_metrics.steady_state_error;
+
+		if(false == pre_step_metrics.is_settled)
+		{
+			unsettled_flags |= (uint8_t)STEP_KPI_UNSETTLED_BEFORE_STEP_e;
+		}
+	}
+
+	step_response_t step_response;
+	init_step_kpi_response(&step_response, initial_value, step_ms, duration_ms, step_kpi_context_ptr);
+
+	set_plant_load_resistance(scenario_ptr->load_after_ohm);
+	run_plant_simulator(duration_ms - step_ms, handle_step_kpi_sample, &step_response);
+
+	step_response_metrics_t metrics;
+	get_step_response_metrics(&step_response, &metrics);
+	convert_metrics_to_kpis(&metrics, step_kpi_result_ptr->kpis);
+
+	step_kpi_result_ptr->unsettled_flags = unsettled_flags | get_unsettled_flags(&metrics, duration_ms - step_ms);
+
+	/* hashed after the gains of the scenario were applied, so the row is tied to the gains it ran with */
+	step_kpi_result_ptr->config_id = get_controller_config_id();
+	step_kpi_result_ptr->is_over_current_tripped = get_system_overcurrent_error_status();
+
+	return true;
+}
+
+/**
+ * @brief Averages the KPIs of the runs of one scenario.
+ *
+ * A KPI that is NAN or INFINITY in one run stays so in the average, a flag set in one run stays set.
+ */
+static void average_step_kpi_results(const step_kpi_result_t *job_results_ptr, uint32_t job_result_cnt,
+									 step_kpi_result_t *result_ptr)
+{
+	*result_ptr = job_results_ptr[0];
+
+	for(uint32_t kpi_idx = 0U; kpi_idx < STEP_KPI_CNT; kpi_idx++)
+	{
+		double kpi_sum = 0.0;
+
+		for(uint32_t job_result_idx = 0U; job_result_idx < job_result_cnt; job_result_idx++)
+		{
+			kpi_sum += (double)job_results_ptr[job_result_idx].kpis[kpi_idx];
+		}
+
+		result_ptr->kpis[kpi_idx] = (float)(kpi_sum / (double)job_result_cnt);
+	}
+
+	for(uint32_t job_result_idx = 1U; job_result_idx < job_result_cnt; job_result_idx++)
+	{
+		result_ptr->unsettled_flags |= job_results_ptr[job_result_idx].unsettled_flags;
+		result_ptr->is_over_current_tripped |= job_results_ptr[job_result_idx].is_over_current_tripped;
+	}
+}
+
+static bool handle_step_kpi_sample(const plant_simulator_sample_t *sample_ptr, void *context_ptr)
+{
+	step_response_t *step_response_ptr = (step_response_t *)context_ptr;
+
+	add_step_response_sample(step_response_ptr, sample_ptr->time_ms,
+							 sample_ptr->output_voltage_v,
+							 sample_ptr->output_voltage_min_v,
+							 sample_ptr->output_voltage_max_v);
+	add_step_response_duty_sample(step_response_ptr, sample_ptr->time_ms, sample_ptr->duty);
+
+	return true;
+}
+
+static void init_step_kpi_response(step_response_t *step_response_ptr, float initial_value,
+								   uint32_t step_ms, uint32_t end_ms,
+								   const step_kpi_context_t *step_kpi_context_ptr)
+{
+	const pid_controller_t *current_pid_ptr = g_buck_converter_config.pid_out_current_cotroller_ptr;
+	uint32_t steady_window_ms = step_kpi_context_ptr->steady_window_ms;
+
+	step_response_cfg_t step_response_cfg =
+	{
+		.reference = g_buck_converter_config.v_out_ref,
+		.initial_value = initial_value,
+		.settling_band_ratio = step_kpi_context_ptr->settling_band_ratio,
+		.start_ms = step_ms,
+		.steady_state_start_ms = ((end_ms - step_ms) > steady_window_ms) ? (end_ms - steady_window_ms) : step_ms,
+		.duty_min = current_pid_ptr->controller_output_min,
+		.duty_max = current_pid_ptr->controller_output_max,
+		.duty_saturation_margin = STEP_KPI_DUTY_SATURATION_MARGIN,
+	};
+
+	init_step_response(step_response_ptr, &step_response_cfg);
+}
+
+static void convert_metrics_to_kpis(const step_response_metrics_t *metrics_ptr, float *kpis_ptr)
+{
+	kpis_ptr[0] = metrics_ptr->rise_time_ms;
+	kpis_ptr[1] = metrics_ptr->overshoot_percent;
+	kpis_ptr[2] = metrics_ptr->settling_time_ms;
+	kpis_ptr[3] = metrics_ptr->steady_state_error;
+	kpis_ptr[4] = metrics_ptr->ripple_peak_to_peak;
+	kpis_ptr[5] = metrics_ptr->max_deviation;
+	kpis_ptr[6] = metrics_ptr->duty_saturation_time_ms;
+}
+
+/**
+ * @brief Flags a response that did not settle after the step or spent most of the scored time with the duty at a limit.
+ */
+static uint8_t get_unsettled_flags(const step_response_metrics_t *metrics_ptr, uint32_t scored_ms)
+{
+	uint8_t unsettled_flags = 0U;
+
+	if(false == metrics_ptr->is_settled)
+	{
+		unsettled_flags |= (uint8_t)STEP_KPI_UNSETTLED_AFTER_STEP_e;
+	}
+
+	if(metrics_ptr->duty_saturation_time_ms > (STEP_KPI_DUTY_SATURATION_RATIO_MAX * (float)scored_ms))
+	{
+		unsettled_flags |= (uint8_t)STEP_KPI_DUTY_SATURATED_e;
+	}
+
+	return unsettled_flags;
+}
+
+/**
+ * @brief Prints the reasons a scenario is not settled to stderr.
+ *
+ * @return true for a settled scenario.
+ */
+static bool report_unsettled_scenario(const char *scenario_name, uint8_t unsettled_flags)
+{
+	if(0U != (unsettled_flags & (uint8_t)STEP_KPI_UNSETTLED_BEFORE_STEP_e))
+	{
+		fprintf(stderr, "UNSETTLED %s: outside the settling band before the load step\n", scenario_name);
+	}
+
+	if(0U != (unsettled_flags & (uint8_t)STEP_KPI_UNSETTLED_AFTER_STEP_e))
+	{
+		fprintf(stderr, "UNSETTLED %s: outside the settling band inside the steady state window\n", scenario_name);
+	}
+
+	if(0U != (unsettled_flags & (uint8_t)STEP_KPI_DUTY_SATURATED_e))
+	{
+		fprintf(stderr, "UNSETTLED %s: duty at a limit for more than %.0f %% of the scored time\n", scenario_name,
+				(double)(100.0f * STEP_KPI_DUTY_SATURATION_RATIO_MAX));
+	}
+
+	return (0U == unsettled_flags);
+}
+
+/**
+ * @brief Hashes the settings of g_buck_converter_config that shape the step response (FNV-1a).
+ */
+static uint32_t get_controller_config_id(void)
+{
+	const pid_controller_t *pids[2] =
+	{
+		g_buck_converter_config.pid_out_voltage_cotroller_ptr,
+		g_buck_converter_config.pid_out_current_cotroller_ptr,
+	};
+
+	float settings[21];
+	uint32_t setting_cnt = 0U;
+
+	for(uint32_t pid_idx = 0U; pid_idx < 2U; pid_idx++)
+	{
+		settings[setting_cnt++] = pids[pid_idx]->Kp;
+		settings[setting_cnt++] = pids[pid_idx]->Ki;
+		settings[setting_cnt++] = pids[pid_idx]->Kd;
+		settings[setting_cnt++] = pids[pid_idx]->Kaw;
+		settings[setting_cnt++] = pids[pid_idx]->TimeStep;
+		settings[setting_cnt++] = pids[pid_idx]->derivative_filter_time;
+		settings[setting_cnt++] = pids[pid_idx]->setpoint_weight;
+		settings[setting_cnt++] = pids[pid_idx]->controller_output_max;
+		settings[setting_cnt++] = pids[pid_idx]->controller_output_min;
+	}
+
+	settings[setting_cnt++] = g_buck_converter_config.v_out_ref;
+	settings[setting_cnt++] = g_buck_converter_config.i_out_max;
+	settings[setting_cnt++] = (float)g_buck_converter_config.period_time_process_of_controller_ms;
+
+	uint32_t hash = 2166136261UL;
+	const uint8_t *bytes_ptr = (const uint8_t *)settings;
+
+	for(size_t byte_idx = 0U; byte_idx < (setting_cnt * sizeof(float)); byte_idx++)
+	{
+		hash = (hash ^ bytes_ptr[byte_idx]) * 16777619UL;
+	}
+
+	return hash;
+}
+
+static void print_step_kpi_row(FILE *file_ptr, const char *scenario_name, const step_kpi_result_t *result_ptr)
+{
+	fprintf(file_ptr, "%s,%08x", scenario_name, (unsigned)result_ptr->config_id);
+
+	for(uint32_t kpi_idx = 0U; kpi_idx < STEP_KPI_CNT; kpi_idx++)
+	{
+		fprintf(file_ptr, ",%.6g", result_ptr->kpis[kpi_idx]);
+	}
+
+	fprintf(file_ptr, ",%u,%u\n", (unsigned)result_ptr->is_over_current_tripped,
+			(unsigned)(0U == result_ptr->unsettled_flags));
+}
+
+/**
+ * @brief Scores the output voltage and duty columns of a buck_plant_sim CSV.
+ */
+static bool score_plant_csv(const char *input_path, uint32_t step_ms, float initial_value,
+							const step_kpi_context_t *step_kpi_context_ptr)
+{
+	FILE *input_file_ptr = fopen(input_path, "r");
+
+	if(NULL == input_file_ptr)
+	{
+		perror(input_path);
+		return false;
+	}
+
+	char line[512];
+	uint32_t last_time_ms = 0U;
+	long data_offset;
+
+	/* the steady state window is placed at the end, so the last time stamp is needed first */
+	if(NULL == fgets(line, sizeof(line), input_file_ptr))
+	{
+		fprintf(stderr, "%s: empty\n", input_path);
+		fclose(input_file_ptr);
+		return false;
+	}
+
+	data_offset = ftell(input_file_ptr);
+
+	while(NULL != fgets(line, sizeof(line), input_file_ptr))
+	{
+		last_time_ms = (uint32_t)strtoul(line, NULL, 10);
+	}
+
+	step_response_t step_response;
+	init_step_kpi_response(&step_response, initial_value, step_ms, last_time_ms + 1U, step_kpi_context_ptr);
+
+	fseek(input_file_ptr, data_offset, SEEK_SET);
+
+	while(NULL != fgets(line, sizeof(line), input_file_ptr))
+	{
+		float columns[7];
+		char *cursor_ptr = line;
+		uint32_t column_cnt = 0U;
+
+		uint32_t time_ms = (uint32_t)strtoul(cursor_ptr, &cursor_ptr, 10);
+
+		while((column_cnt < 7U) && (',' == *cursor_ptr))
+		{
+			columns[column_cnt++] = strtof(cursor_ptr + 1, &cursor_ptr);
+		}
+
+		if(7U != column_cnt)
+		{
+			fprintf(stderr, "%s: not a buck_plant_sim CSV\n", input_path);
+			fclose(input_file_ptr);
+			return false;
+		}
+
+		/* output_voltage_v, output_voltage_min_v, output_voltage_max_v, ..., duty */
+		add_step_response_sample(&step_response, time_ms, columns[0], columns[1], columns[2]);
+		add_step_response_duty_sample(&step_response, time_ms, columns[5]);
+	}
+
+	fclose(input_file_ptr);
+
+	step_response_metrics_t metrics;
+	step_kpi_result_t result = { 0 };
+
+	get_step_response_metrics(&step_response, &metrics);
+	convert_metrics_to_kpis(&metrics, result.kpis);
+
+	result.config_id = get_controller_config_id();
+	result.unsettled_flags = get_unsettled_flags(&metrics, last_time_ms + 1U - step_ms);
+	report_unsettled_scenario("input", result.unsettled_flags);
+
+	printf(STEP_KPI_CSV_HEADER "\n");
+	print_step_kpi_row(stdout, "input", &result);
+
+	return true;
+}
+
+static bool is_kpi_regressed(const step_kpi_info_t *kpi_info_ptr, float baseline_value,
+							 float value, float threshold)
+{
+	/* NAN marks a metric that does not apply, e.g. the rise time of a load step */
+	if(isnan(baseline_value) || isnan(value))
+	{
+		return (isnan(baseline_value) != isnan(value));
+	}
+
+	if(true == kpi_info_ptr->is_magnitude_compared)
+	{
+		baseline_value = fabsf(baseline_value);
+		value = fabsf(value);
+	}
+
+	if(isinf(value))
+	{
+		return (false == isinf(baseline_value));
+	}
+
+	return (value > ((baseline_value * (1.0f + threshold)) + kpi_info_ptr->absolute_tolerance));
+}
+
+static int compare_with_baseline(const char *baseline_path, const step_kpi_result_t *results_ptr,
+								 float threshold)
+{
+	FILE *baseline_file_ptr = fopen(baseline_path, "r");
+
+	if(NULL == baseline_file_ptr)
+	{
+		perror(baseline_path);
+		return EXIT_FAILURE;
+	}
+
+	char line[512];
+	uint32_t regression_cnt = 0U;
+	uint32_t compared_scenario_cnt = 0U;
+	bool is_config_mismatched = false;
+
+	while(NULL != fgets(line, sizeof(line), baseline_file_ptr))
+	{
+		char *cursor_ptr = strchr(line, ',');
+
+		if((NULL == cursor_ptr) || (0 == strncmp(line, "scenario,", 9U)))
+		{
+			continue;
+		}
+
+		*cursor_ptr = '\0';
+
+		uint32_t scenario_idx = 0U;
+
+		while((scenario_idx < STEP_KPI_SCENARIO_CNT) &&
+			  (0 != strcmp(line, m_step_kpi_scenarios[scenario_idx].name)))
+		{
+			scenario_idx++;
+		}
+
+		if(STEP_KPI_SCENARIO_CNT == scenario_idx)
+		{
+			continue;
+		}
+
+		const step_kpi_result_t *result_ptr = &results_ptr[scenario_idx];
+		uint32_t baseline_config_id = (uint32_t)strtoul(cursor_ptr + 1, &cursor_ptr, 16);
+
+		if(baseline_config_id != result_ptr->config_id)
+		{
+			fprintf(stderr, "%s: %s was recorded for configuration %08x, now %08x\n", baseline_path, line,
+					(unsigned)baseline_config_id, (unsigned)result_ptr->config_id);
+			is_config_mismatched = true;
+			continue;
+		}
+		compared_scenario_cnt++;
+
+		for(uint32_t kpi_idx = 0U; kpi_idx < STEP_KPI_CNT; kpi_idx++)
+		{
+			float baseline_value = strtof(cursor_ptr + 1, &cursor_ptr);
+
+			if(true == is_kpi_regressed(&m_step_kpi_infos[kpi_idx], baseline_value,
+										result_ptr->kpis[kpi_idx], threshold))
+			{
+				fprintf(stderr, "REGRESSION %s %s baseline=%.6g now=%.6g\n", line,
+						m_step_kpi_infos[kpi_idx].name, baseline_value, result_ptr->kpis[kpi_idx]);
+				regression_cnt++;
+			}
+		}
+
+		bool is_baseline_tripped = (0UL != strtoul(cursor_ptr + 1, &cursor_ptr, 10));
+		bool is_baseline_settled = (0UL != strtoul(cursor_ptr + 1, NULL, 10));
+
+		if((true == result_ptr->is_over_current_tripped) && (false == is_baseline_tripped))
+		{
+			fprintf(stderr, "REGRESSION %s over_current_tripped baseline=0 now=1\n", line);
+			regression_cnt++;
+		}
+
+		if((0U != result_ptr->unsettled_flags) && (true == is_baseline_settled))
+		{
+			fprintf(stderr, "REGRESSION %s settled baseline=1 now=0\n", line);
+			regression_cnt++;
+		}
+	}
+
+	fclose(baseline_file_ptr);
+
+	if(true == is_config_mismatched)
+	{
+		fprintf(stderr, "%s was recorded for another controller configuration, "
+				"review the change and record a new baseline with --write-baseline\n", baseline_path);
+		return EXIT_FAILURE;
+	}
+
+	if(STEP_KPI_SCENARIO_CNT != compared_scenario_cnt)
+	{
+		fprintf(stderr, "%s covers %u of %u scenarios\n", baseline_path,
+				(unsigned)compared_scenario_cnt, (unsigned)STEP_KPI_SCENARIO_CNT);
+		return EXIT_FAILURE;
+	}
+
+	fprintf(stderr, "%u KPI regressions against %s (threshold %.3f)\n",
+			(unsigned)regression_cnt, baseline_path, threshold);
+
+	return (0U == regression_cnt) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
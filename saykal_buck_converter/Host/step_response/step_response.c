@@ -0,0 +1,162 @@
+/**
+ * @file step_response.c
+ * @brief Streaming step response metrics for simulated converter traces.
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "step_response.h"
+#include "string.h"
+#include "math.h"
+
+void init_step_response(step_response_t *step_response_ptr, const step_response_cfg_t *cfg_ptr)
+{
+	memset(step_response_ptr, 0, sizeof(*step_response_ptr));
+	step_response_ptr->cfg = *cfg_ptr;
+	step_response_ptr->peak_value = -INFINITY;
+	step_response_ptr->steady_state_min = INFINITY;
+	step_response_ptr->steady_state_max = -INFINITY;
+}
+
+void add_step_response_sample(step_response_t *step_response_ptr,
+							  uint32_t time_ms,
+							  float value,
+							  float value_min,
+							  float value_max)
+{
+	const step_response_cfg_t *cfg_ptr = &step_response_ptr->cfg;
+
+	if(time_ms < cfg_ptr->start_ms)
+	{
+		return;
+	}
+
+	float band = fabsf(cfg_ptr->reference) * cfg_ptr->settling_band_ratio;
+	float step_size = cfg_ptr->reference - cfg_ptr->initial_value;
+
+	step_response_ptr->sample_cnt++;
+	step_response_ptr->last_time_ms = time_ms;
+
+	if(value_max > step_response_ptr->peak_value)
+	{
+		step_response_ptr->peak_value = value_max;
+	}
+
+	float deviation = fmaxf(fabsf(value_max - cfg_ptr->reference), fabsf(value_min - cfg_ptr->reference));
+
+	if(deviation > step_response_ptr->max_deviation)
+	{
+		step_response_ptr->max_deviation = deviation;
+	}
+
+	/* progress of the step in its own direction, 0 at the initial value and 1 at the reference */
+	float progress = (0.0f != step_size) ? ((value - cfg_ptr->initial_value) / step_size) : 0.0f;
+
+	if((false == step_response_ptr->is_rise_started) && (progress >= 0.1f))
+	{
+		step_response_ptr->rise_start_ms = time_ms;
+		step_response_ptr->is_rise_started = true;
+	}
+
+	if((false == step_response_ptr->is_rise_ended) && (progress >= 0.9f))
+	{
+		step_response_ptr->rise_end_ms = time_ms;
+		step_response_ptr->is_rise_ended = true;
+	}
+
+	if((value_min < (cfg_ptr->reference - band)) || (value_max > (cfg_ptr->reference + band)))
+	{
+		step_response_ptr->last_out_of_band_ms = time_ms;
+		step_response_ptr->is_out_of_band_seen = true;
+	}
+
+	if(time_ms >= cfg_ptr->steady_state_start_ms)
+	{
+		if(value_min < step_response_ptr->steady_state_min)
+		{
+			step_response_ptr->steady_state_min = value_min;
+		}
+
+		if(value_max > step_response_ptr->steady_state_max)
+		{
+			step_response_ptr->steady_state_max = value_max;
+		}
+
+		step_response_ptr->steady_state_sum += value;
+		step_response_ptr->steady_state_sample_cnt++;
+	}
+}
+
+void add_step_response_duty_sample(step_response_t *step_response_ptr, uint32_t time_ms, float duty)
+{
+	const step_response_cfg_t *cfg_ptr = &step_response_ptr->cfg;
+
+	if((time_ms < cfg_ptr->start_ms) || (cfg_ptr->duty_max <= cfg_ptr->duty_min))
+	{
+		return;
+	}
+
+	if((duty >= (cfg_ptr->duty_max - cfg_ptr->duty_saturation_margin)) ||
+	   (duty <= (cfg_ptr->duty_min + cfg_ptr->duty_saturation_margin)))
+	{
+		step_response_ptr->duty_saturated_ms++;
+	}
+}
+
+void get_step_response_metrics(const step_response_t *step_response_ptr,
+							   step_response_metrics_t *metrics_ptr)
+{
+	const step_response_cfg_t *cfg_ptr = &step_response_ptr->cfg;
+
+	memset(metrics_ptr, 0, sizeof(*metrics_ptr));
+
+	if(0U == step_response_ptr->sample_cnt)
+	{
+		metrics_ptr->settling_time_ms = INFINITY;
+		metrics_ptr->rise_time_ms = NAN;
+		return;
+	}
+
+	float band = fabsf(cfg_ptr->reference) * cfg_ptr->settling_band_ratio;
+
+	if(fabsf(cfg_ptr->reference - cfg_ptr->initial_value) <= band)
+	{
+		metrics_ptr->rise_time_ms = NAN;
+	}
+	else if(true == step_response_ptr->is_rise_ended)
+	{
+		metrics_ptr->rise_time_ms = (float)(step_response_ptr->rise_end_ms - step_response_ptr->rise_start_ms);
+	}
+	else
+	{
+		metrics_ptr->rise_time_ms = INFINITY;
+	}
+
+	metrics_ptr->max_deviation = step_response_ptr->max_deviation;
+	metrics_ptr->duty_saturation_time_ms = (float)step_response_ptr->duty_saturated_ms;
+
+	if((0.0f != cfg_ptr->reference) && (step_response_ptr->peak_value > cfg_ptr->reference))
+	{
+		metrics_ptr->overshoot_percent =
+			100.0f * (step_response_ptr->peak_value - cfg_ptr->reference) / fabsf(cfg_ptr->reference);
+	}
+
+	/* the response settles one millisecond after it was last seen outside of the band */
+	metrics_ptr->settling_time_ms = (true == step_response_ptr->is_out_of_band_seen) ?
+		(float)(step_response_ptr->last_out_of_band_ms + 1U - cfg_ptr->start_ms) : 0.0f;
+
+	metrics_ptr->is_settled = (false == step_response_ptr->is_out_of_band_seen) ||
+		(step_response_ptr->last_out_of_band_ms < cfg_ptr->steady_state_start_ms);
+
+	if(step_response_ptr->steady_state_sample_cnt > 0U)
+	{
+		metrics_ptr->ripple_peak_to_peak = step_response_ptr->steady_state_max - step_response_ptr->steady_state_min;
+		metrics_ptr->steady_state_error = (float)(step_response_ptr->steady_state_sum /
+			(double)step_response_ptr->steady_state_sample_cnt) - cfg_ptr->reference;
+	}
+
+	if(false == metrics_ptr->is_settled)
+	{
+		metrics_ptr->settling_time_ms = INFINITY;
+	}
+}
@@ -0,0 +1,119 @@
+/**
+ * @file step_response.h
+ * @brief Streaming step response metrics for simulated converter traces.
+ *
+ * Samples are fed one by one, so a trace never has to be stored. The metrics
+ * are measured from the step time start_ms; the steady state window starts at
+ * steady_state_start_ms and ends with the last sample.
+ *
+ * The same accumulator scores reference steps (initial_value differs from the
+ * reference, rise time is measured) and disturbance steps such as load steps
+ * (initial_value equals the reference, the peak deviation is the dip or bump).
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef STEP_RESPONSE_H_
+#define STEP_RESPONSE_H_
+
+#include "stdint.h"
+#include "stdbool.h"
+
+/**
+ * @brief Measurement configuration.
+ */
+typedef struct
+{
+	float reference;						///< Final value the response should settle to
+	float initial_value;					///< Value before the step, the rise time is measured from it
+	float settling_band_ratio;				///< Half width of the settling band relative to the reference (0.02 = 2 %)
+	uint32_t start_ms;						///< Time of the step
+	uint32_t steady_state_start_ms;			///< Start of the window used for ripple and steady state error
+	float duty_min;							///< Lower duty limit of the controller
+	float duty_max;							///< Upper duty limit of the controller, equal limits disable the duty metric
+	float duty_saturation_margin;			///< Distance to a limit still counted as saturated (PWM quantization)
+
+}step_response_cfg_t;
+
+/**
+ * @brief Accumulator state, initialize with init_step_response().
+ */
+typedef struct
+{
+	step_response_cfg_t cfg;
+	uint32_t sample_cnt;
+	uint32_t last_time_ms;
+	uint32_t last_out_of_band_ms;
+	bool is_out_of_band_seen;
+	float peak_value;
+	float max_deviation;
+	uint32_t rise_start_ms;
+	uint32_t rise_end_ms;
+	bool is_rise_started;
+	bool is_rise_ended;
+	uint32_t duty_saturated_ms;
+	float steady_state_min;
+	float steady_state_max;
+	double steady_state_sum;
+	uint32_t steady_state_sample_cnt;
+
+}step_response_t;
+
+/**
+ * @brief Result of a measurement.
+ */
+typedef struct
+{
+	float rise_time_ms;						///< 10 % to 90 % of the step, NAN without a reference step, INFINITY if not reached
+	float overshoot_percent;				///< Peak above the reference in percent of the reference
+	float settling_time_ms;					///< Time from the step until the response stays inside the band
+	float ripple_peak_to_peak;				///< Peak to peak variation inside the steady state window
+	float steady_state_error;				///< Mean of the steady state window minus the reference
+	float max_deviation;					///< Largest distance from the reference after the step
+	float duty_saturation_time_ms;			///< Time after the step the duty spent at one of its limits
+	bool is_settled;						///< Response stayed inside the band for the whole steady state window
+
+}step_response_metrics_t;
+
+/**
+ * @brief Starts a new measurement.
+ *
+ * @param[out] step_response_ptr Accumulator.
+ * @param[in]  cfg_ptr           Measurement configuration.
+ */
+void init_step_response(step_response_t *step_response_ptr, const step_response_cfg_t *cfg_ptr);
+
+/**
+ * @brief Adds one sample of the response.
+ *
+ * @param[in,out] step_response_ptr Accumulator.
+ * @param[in]     time_ms           Sample time, samples must be in time order.
+ * @param[in]     value             Value at the sample time.
+ * @param[in]     value_min         Minimum value since the previous sample.
+ * @param[in]     value_max         Maximum value since the previous sample.
+ */
+void add_step_response_sample(step_response_t *step_response_ptr,
+							  uint32_t time_ms,
+							  float value,
+							  float value_min,
+							  float value_max);
+
+/**
+ * @brief Adds the duty cycle applied during one millisecond after the step.
+ *
+ * @param[in,out] step_response_ptr Accumulator.
+ * @param[in]     time_ms           Sample time.
+ * @param[in]     duty              Applied duty cycle.
+ */
+void add_step_response_duty_sample(step_response_t *step_response_ptr, uint32_t time_ms, float duty);
+
+/**
+ * @brief Computes the metrics of the samples added so far.
+ *
+ * @param[in]  step_response_ptr Accumulator.
+ * @param[out] metrics_ptr       Metrics.
+ */
+void get_step_response_metrics(const step_response_t *step_response_ptr,
+							   step_response_metrics_t *metrics_ptr);
+
+#endif /* STEP_RESPONSE_H_ */
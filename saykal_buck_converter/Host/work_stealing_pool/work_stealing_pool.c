@@ -0,0 +1,345 @@
+/**
+ * @file work_stealing_pool.c
+ * @brief Multi-process work-stealing job pool for the host tools.
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "work_stealing_pool.h"
+#include "stdatomic.h"
+#include "stdio.h"
+#include "string.h"
+#include "unistd.h"
+#include "time.h"
+#include "sys/mman.h"
+#include "sys/wait.h"
+
+/** @brief Upper limit of worker processes. */
+#define WORK_STEALING_WORKER_MAX		256U
+
+/** @brief Cache line size used to keep the ranges of the workers apart. */
+#define WORK_STEALING_CACHE_LINE		64U
+
+/**
+ * @brief Job range of one worker: begin in the upper, end in the lower 32 bits.
+ */
+typedef struct
+{
+	_Atomic uint64_t packed_range;
+	uint8_t padding[WORK_STEALING_CACHE_LINE - sizeof(uint64_t)];
+
+}work_stealing_range_t;
+
+/**
+ * @brief Start of the shared memory mapping.
+ */
+typedef struct
+{
+	work_stealing_range_t ranges[WORK_STEALING_WORKER_MAX];
+	_Atomic uint32_t completed_job_cnt;
+	_Atomic uint32_t stolen_range_cnt;
+
+}work_stealing_shared_t;
+
+static inline uint64_t pack_range(uint32_t range_begin, uint32_t range_end);
+static inline uint32_t get_range_begin(uint64_t packed_range);
+static inline uint32_t get_range_end(uint64_t packed_range);
+static bool pop_own_job(work_stealing_shared_t *shared_ptr, uint32_t worker_idx, uint32_t *job_idx_ptr);
+static bool steal_job_range(work_stealing_shared_t *shared_ptr, uint32_t worker_idx, uint32_t worker_cnt);
+static void execute_job(const work_stealing_pool_cfg_t *pool_cfg_ptr,
+						work_stealing_pool_results_t *results_ptr,
+						uint32_t job_idx);
+static void run_worker(const work_stealing_pool_cfg_t *pool_cfg_ptr,
+					   work_stealing_shared_t *shared_ptr,
+					   work_stealing_pool_results_t *results_ptr,
+					   uint32_t worker_idx,
+					   uint32_t worker_cnt);
+
+bool run_work_stealing_pool(const work_stealing_pool_cfg_t *pool_cfg_ptr,
+							work_stealing_pool_results_t *results_ptr)
+{
+	uint32_t worker_cnt = pool_cfg_ptr->worker_cnt;
+
+	if(0U == worker_cnt)
+	{
+		long online_cores = sysconf(_SC_NPROCESSORS_ONLN);
+		worker_cnt = (online_cores > 0) ? (uint32_t)online_cores : 1U;
+	}
+
+	if(worker_cnt > WORK_STEALING_WORKER_MAX)
+	{
+		worker_cnt = WORK_STEALING_WORKER_MAX;
+	}
+
+	if((worker_cnt > pool_cfg_ptr->job_cnt) && (pool_cfg_ptr->job_cnt > 0U))
+	{
+		worker_cnt = pool_cfg_ptr->job_cnt;
+	}
+
+	size_t states_offset = sizeof(work_stealing_shared_t);
+	size_t results_offset =
+		(states_offset + pool_cfg_ptr->job_cnt + WORK_STEALING_CACHE_LINE - 1U) &
+		~(size_t)(WORK_STEALING_CACHE_LINE - 1U);
+	size_t mapping_size = results_offset + ((size_t)pool_cfg_ptr->job_cnt * pool_cfg_ptr->result_size);
+
+	void *mapping_ptr = mmap(NULL, mapping_size, PROT_READ | PROT_WRITE,
+							 MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+	if(MAP_FAILED == mapping_ptr)
+	{
+		perror("mmap");
+		return false;
+	}
+
+	work_stealing_shared_t *shared_ptr = (work_stealing_shared_t *)mapping_ptr;
+
+	results_ptr->job_states_ptr = (uint8_t *)mapping_ptr + states_offset;
+	results_ptr->results_ptr = (uint8_t *)mapping_ptr + results_offset;
+	results_ptr->mapping_size = mapping_size;
+	results_ptr->stolen_range_cnt = 0U;
+
+	/* equal contiguous ranges to start with, stealing balances the rest */
+	for(uint32_t worker_idx = 0U; worker_idx < worker_cnt; worker_idx++)
+	{
+		uint32_t range_begin = (uint32_t)(((uint64_t)pool_cfg_ptr->job_cnt * worker_idx) / worker_cnt);
+		uint32_t range_end = (uint32_t)(((uint64_t)pool_cfg_ptr->job_cnt * (worker_idx + 1U)) / worker_cnt);
+
+		atomic_store(&shared_ptr->ranges[worker_idx].packed_range, pack_range(range_begin, range_end));
+	}
+
+	fflush(NULL);
+
+	pid_t worker_pids[WORK_STEALING_WORKER_MAX];
+	bool is_pool_ok = true;
+
+	for(uint32_t worker_idx = 0U; worker_idx < worker_cnt; worker_idx++)
+	{
+		worker_pids[worker_idx] = fork();
+
+		if(0 == worker_pids[worker_idx])
+		{
+			run_worker(pool_cfg_ptr, shared_ptr, results_ptr, worker_idx, worker_cnt);
+			_exit(0);
+		}
+		else if(worker_pids[worker_idx] < 0)
+		{
+			perror("fork");
+			is_pool_ok = false;
+			worker_cnt = worker_idx;
+			break;
+		}
+	}
+
+	uint32_t running_worker_cnt = worker_cnt;
+	time_t last_report_s = time(NULL);
+
+	while(running_worker_cnt > 0U)
+	{
+		int worker_status = 0;
+		pid_t finished_pid = waitpid(-1, &worker_status,
+									 (true == pool_cfg_ptr->is_progress_reported) ? WNOHANG : 0);
+
+		if(finished_pid > 0)
+		{
+			running_worker_cnt--;
+
+			if((false == WIFEXITED(worker_status)) || (0 != WEXITSTATUS(worker_status)))
+			{
+				is_pool_ok = false;
+			}
+		}
+		else if(0 == finished_pid)
+		{
+			usleep(10000);
+
+			if(time(NULL) != last_report_s)
+			{
+				last_report_s = time(NULL);
+				fprintf(stderr, "\r%u / %u jobs", (unsigned)atomic_load(&shared_ptr->completed_job_cnt),
+						(unsigned)pool_cfg_ptr->job_cnt);
+			}
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	if(true == pool_cfg_ptr->is_progress_reported)
+	{
+		fprintf(stderr, "\r%u / %u jobs\n", (unsigned)atomic_load(&shared_ptr->completed_job_cnt),
+				(unsigned)pool_cfg_ptr->job_cnt);
+	}
+
+	results_ptr->stolen_range_cnt = atomic_load(&shared_ptr->stolen_range_cnt);
+
+	return is_pool_ok;
+}
+
+void *get_work_stealing_job_result(const work_stealing_pool_results_t *results_ptr,
+								   const work_stealing_pool_cfg_t *pool_cfg_ptr,
+								   uint32_t job_idx)
+{
+	return (uint8_t *)results_ptr->results_ptr + ((size_t)job_idx * pool_cfg_ptr->result_size);
+}
+
+void release_work_stealing_pool_results(work_stealing_pool_results_t *results_ptr)
+{
+	if(NULL != results_ptr->job_states_ptr)
+	{
+		munmap((uint8_t *)results_ptr->job_states_ptr - sizeof(work_stealing_shared_t),
+			   results_ptr->mapping_size);
+	}
+
+	memset(results_ptr, 0, sizeof(*results_ptr));
+}
+
+static inline uint64_t pack_range(uint32_t range_begin, uint32_t range_end)
+{
+	return ((uint64_t)range_begin << 32) | range_end;
+}
+
+static inline uint32_t get_range_begin(uint64_t packed_range)
+{
+	return (uint32_t)(packed_range >> 32);
+}
+
+static inline uint32_t get_range_end(uint64_t packed_range)
+{
+	return (uint32_t)packed_range;
+}
+
+/**
+ * @brief Takes the first job of the own range.
+ */
+static bool pop_own_job(work_stealing_shared_t *shared_ptr, uint32_t worker_idx, uint32_t *job_idx_ptr)
+{
+	_Atomic uint64_t *own_range_ptr = &shared_ptr->ranges[worker_idx].packed_range;
+	uint64_t packed_range = atomic_load(own_range_ptr);
+
+	while(get_range_begin(packed_range) < get_range_end(packed_range))
+	{
+		uint32_t range_begin = get_range_begin(packed_range);
+
+		if(atomic_compare_exchange_weak(own_range_ptr, &packed_range,
+										pack_range(range_begin + 1U, get_range_end(packed_range))))
+		{
+			*job_idx_ptr = range_begin;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Moves the back half of the largest foreign range into the own (empty) range.
+ *
+ * Only a worker with an empty range steals and nobody steals from an empty range,
+ * so the own range can be published with a plain atomic store.
+ *
+ * @retval true  A range was stolen.
+ * @retval false All ranges are empty, the pool is drained.
+ */
+static bool steal_job_range(work_stealing_shared_t *shared_ptr, uint32_t worker_idx, uint32_t worker_cnt)
+{
+	for(;;)
+	{
+		uint32_t victim_idx = worker_cnt;
+		uint32_t victim_job_cnt = 0U;
+		uint64_t victim_range = 0U;
+
+		for(uint32_t candidate_idx = 0U; candidate_idx < worker_cnt; candidate_idx++)
+		{
+			if(candidate_idx == worker_idx)
+			{
+				continue;
+			}
+
+			uint64_t packed_range = atomic_load(&shared_ptr->ranges[candidate_idx].packed_range);
+			uint32_t range_begin = get_range_begin(packed_range);
+			uint32_t range_end = get_range_end(packed_range);
+
+			if((range_end > range_begin) && ((range_end - range_begin) > victim_job_cnt))
+			{
+				victim_idx = candidate_idx;
+				victim_job_cnt = range_end - range_begin;
+				victim_range = packed_range;
+			}
+		}
+
+		if(worker_cnt == victim_idx)
+		{
+			return false;
+		}
+
+		uint32_t range_begin = get_range_begin(victim_range);
+		uint32_t range_end = get_range_end(victim_range);
+		uint32_t stolen_job_cnt = (victim_job_cnt + 1U) / 2U;
+
+		if(atomic_compare_exchange_strong(&shared_ptr->ranges[victim_idx].packed_range, &victim_range,
+										  pack_range(range_begin, range_end - stolen_job_cnt)))
+		{
+			atomic_store(&shared_ptr->ranges[worker_idx].packed_range,
+						 pack_range(range_end - stolen_job_cnt, range_end));
+			atomic_fetch_add(&shared_ptr->stolen_range_cnt, 1U);
+			return true;
+		}
+	}
+}
+
+static void execute_job(const work_stealing_pool_cfg_t *pool_cfg_ptr,
+						work_stealing_pool_results_t *results_ptr,
+						uint32_t job_idx)
+{
+	void *result_ptr = get_work_stealing_job_result(results_ptr, pool_cfg_ptr, job_idx);
+	uint8_t *job_state_ptr = &results_ptr->job_states_ptr[job_idx];
+
+	if(false == pool_cfg_ptr->is_job_isolated)
+	{
+		*job_state_ptr = pool_cfg_ptr->job_func(job_idx, result_ptr, pool_cfg_ptr->context_ptr) ?
+			WORK_STEALING_JOB_OK_e : WORK_STEALING_JOB_FAILED_e;
+		return;
+	}
+
+	pid_t job_pid = fork();
+
+	if(0 == job_pid)
+	{
+		*job_state_ptr = pool_cfg_ptr->job_func(job_idx, result_ptr, pool_cfg_ptr->context_ptr) ?
+			WORK_STEALING_JOB_OK_e : WORK_STEALING_JOB_FAILED_e;
+		_exit(0);
+	}
+
+	int job_status = 0;
+
+	if((job_pid < 0) || (waitpid(job_pid, &job_status, 0) < 0) ||
+	   (false == WIFEXITED(job_status)) || (0 != WEXITSTATUS(job_status)))
+	{
+		*job_state_ptr = WORK_STEALING_JOB_CRASHED_e;
+	}
+}
+
+static void run_worker(const work_stealing_pool_cfg_t *pool_cfg_ptr,
+					   work_stealing_shared_t *shared_ptr,
+					   work_stealing_pool_results_t *results_ptr,
+					   uint32_t worker_idx,
+					   uint32_t worker_cnt)
+{
+	uint32_t job_idx = 0U;
+
+	for(;;)
+	{
+		if(false == pop_own_job(shared_ptr, worker_idx, &job_idx))
+		{
+			if(false == steal_job_range(shared_ptr, worker_idx, worker_cnt))
+			{
+				break;
+			}
+			continue;
+		}
+
+		execute_job(pool_cfg_ptr, results_ptr, job_idx);
+		atomic_fetch_add(&shared_ptr->completed_job_cnt, 1U);
+	}
+}
@@ -0,0 +1,106 @@
+/**
+ * @file work_stealing_pool.h
+ * @brief Multi-process work-stealing job pool for the host tools.
+ *
+ * The firmware keeps its state in module level statics, so two simulations can
+ * not share an address space. The pool therefore runs one worker process per
+ * core. Each worker owns a contiguous range of job indexes in shared memory and
+ * takes jobs from the front of its own range. When its range is empty it steals
+ * the back half of the largest remaining range of another worker. Ranges are
+ * packed into a single 64-bit word and only changed with compare-and-swap, so
+ * no locks are shared between processes.
+ *
+ * Optionally every job runs in its own child process forked from the pristine
+ * worker, so each simulation starts from the firmware reset state and a crashing
+ * job only fails itself.
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef WORK_STEALING_POOL_H_
+#define WORK_STEALING_POOL_H_
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "stddef.h"
+
+/**
+ * @brief Executes one job.
+ *
+ * @param[in]  job_idx     Index of the job (0 .. job_cnt - 1).
+ * @param[out] result_ptr  Zero-initialized shared memory slot of result_size bytes.
+ * @param[in]  context_ptr User context of the pool.
+ * @return true if the job succeeded, false otherwise.
+ */
+typedef bool (*work_stealing_job_func_t)(uint32_t job_idx, void *result_ptr, void *context_ptr);
+
+/**
+ * @brief Final state of a job.
+ */
+typedef enum
+{
+	WORK_STEALING_JOB_NOT_RUN_e,	///< Job was never executed
+	WORK_STEALING_JOB_OK_e,			///< Job function returned true
+	WORK_STEALING_JOB_FAILED_e,		///< Job function returned false
+	WORK_STEALING_JOB_CRASHED_e,	///< Isolated job process terminated abnormally
+
+}work_stealing_job_state_e;
+
+/**
+ * @brief Pool configuration.
+ */
+typedef struct
+{
+	uint32_t job_cnt;						///< Number of jobs
+	uint32_t worker_cnt;					///< Worker processes, 0 selects the number of online cores
+	size_t result_size;						///< Size of the result slot of every job
+	bool is_job_isolated;					///< Run every job in its own forked process
+	bool is_progress_reported;				///< Print progress to stderr once per second
+	work_stealing_job_func_t job_func;		///< Job function
+	void *context_ptr;						///< User context passed to the job function
+
+}work_stealing_pool_cfg_t;
+
+/**
+ * @brief Results of a pool run, located in shared memory.
+ */
+typedef struct
+{
+	void *results_ptr;						///< job_cnt result slots of result_size bytes
+	uint8_t *job_states_ptr;				///< job_cnt work_stealing_job_state_e values
+	uint32_t stolen_range_cnt;				///< Number of successful steals, for diagnostics
+	size_t mapping_size;
+
+}work_stealing_pool_results_t;
+
+/**
+ * @brief Runs all jobs of the pool and waits for them.
+ *
+ * @param[in]  pool_cfg_ptr Pool configuration.
+ * @param[out] results_ptr  Results of the run, release with release_work_stealing_pool_results().
+ * @retval true  All workers ran to completion (individual jobs may still have failed).
+ * @retval false Shared memory could not be mapped or a worker could not be started.
+ */
+bool run_work_stealing_pool(const work_stealing_pool_cfg_t *pool_cfg_ptr,
+							work_stealing_pool_results_t *results_ptr);
+
+/**
+ * @brief Returns the result slot of a job.
+ *
+ * @param[in] results_ptr  Results of the run.
+ * @param[in] pool_cfg_ptr Pool configuration used for the run.
+ * @param[in] job_idx      Job index.
+ * @return void* Result slot of the job.
+ */
+void *get_work_stealing_job_result(const work_stealing_pool_results_t *results_ptr,
+								   const work_stealing_pool_cfg_t *pool_cfg_ptr,
+								   uint32_t job_idx);
+
+/**
+ * @brief Unmaps the shared memory of a pool run.
+ *
+ * @param[in] results_ptr Results of the run.
+ */
+void release_work_stealing_pool_results(work_stealing_pool_results_t *results_ptr);
+
+#endif /* WORK_STEALING_POOL_H_ */
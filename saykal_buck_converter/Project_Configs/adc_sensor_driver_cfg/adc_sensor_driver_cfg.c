@@ -15,20 +15,54 @@ const adc_sensor_driver_config_t g_adc_sensors_configuration[] =
 {
 	[BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID] = {
 		.raw_voltage_factor = 2U, // opamp used input of adc 
-		.read_adc_sensor_raw_voltage_func = read_current_sense_adc_value,
+		.read_adc_sensor_raw_count_func = read_current_sense_adc_raw_count,
 		.reference_voltage_for_zero_output = 2.5f, // reference voltage
-		.sensitivity_volt_per_output_unit = 0.1f
+		.sensitivity_volt_per_output_unit = 0.1f,
+		.scan_channel_idx = BSP_ADC_CURRENT_SENSE_SCAN_IDX,
+		.oversampling_ratio = 1U, // overcurrent protection needs every sample without filter delay
+		.decimation_filter = ADC_SENSOR_DECIMATION_BOXCAR_e,
+		.zero_calibration_sample_cnt = 64U, // measured at start-up with the MOSFET off, 64 ms
+		.zero_calibration_tolerance_v = 0.1f // 1 A, larger offsets point to a current flowing at start-up
 	},
 	[BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID] = {
 		.raw_voltage_factor = 1U,
-		.read_adc_sensor_raw_voltage_func = read_voltage_sense_adc_value,
+		.read_adc_sensor_raw_count_func = read_voltage_sense_adc_raw_count,
 		.reference_voltage_for_zero_output = 0.0f,
-		.sensitivity_volt_per_output_unit = (1.0f/14.54f) // Maximum 48V ölçebilecek şekilde dirençler ayarlandı.
+		.sensitivity_volt_per_output_unit = (1.0f/14.54f), // Maximum 48V ölçebilecek şekilde dirençler ayarlandı.
+		.scan_channel_idx = BSP_ADC_VOLTAGE_SENSE_SCAN_IDX,
+		.oversampling_ratio = 8U, // 0.8 ms per value with the PWM trigger, 1.5 ms filter window
+		.decimation_filter = ADC_SENSOR_DECIMATION_CIC_e,
+		.zero_calibration_sample_cnt = 0U
 	},
 	[TEMPERATURE_LM35_SENSOR_ID] = {
 		.raw_voltage_factor = 1U, // no voltage factor
-		.read_adc_sensor_raw_voltage_func = read_temperature_sense_adc_value,
+		.read_adc_sensor_raw_count_func = read_temperature_sense_adc_raw_count,
 		.reference_voltage_for_zero_output = 0.0f, // 0V -> 0 degree
-		.sensitivity_volt_per_output_unit = 0.01f // 10mV per degree
+		.sensitivity_volt_per_output_unit = 0.01f, // 10mV per degree
+		.scan_channel_idx = BSP_ADC_TEMPERATURE_SENSE_SCAN_IDX,
+		.oversampling_ratio = 16U,
+		.decimation_filter = ADC_SENSOR_DECIMATION_BOXCAR_e,
+		.zero_calibration_sample_cnt = 0U
+	},
+	[BUCK_CONVERTOR_IN_VOLTAGE_RESISTOR_SENSOR_ID] = {
+		.raw_voltage_factor = 1U,
+		.read_adc_sensor_raw_count_func = read_input_voltage_sense_adc_raw_count,
+		.reference_voltage_for_zero_output = 0.0f,
+		.sensitivity_volt_per_output_unit = (1.0f/14.54f), // same divider as the output, 48 V full scale
+		.scan_channel_idx = BSP_ADC_INPUT_VOLTAGE_SENSE_SCAN_IDX,
+		.oversampling_ratio = 8U, // only monitored, filtered like the output voltage
+		.decimation_filter = ADC_SENSOR_DECIMATION_CIC_e,
+		.zero_calibration_sample_cnt = 0U
+	},
+	[BUCK_CONVERTOR_IN_CURRENT_ACS724_SENSOR_ID] = {
+		.raw_voltage_factor = 2U, // opamp used input of adc
+		.read_adc_sensor_raw_count_func = read_input_current_sense_adc_raw_count,
+		.reference_voltage_for_zero_output = 2.5f,
+		.sensitivity_volt_per_output_unit = 0.1f,
+		.scan_channel_idx = BSP_ADC_INPUT_CURRENT_SENSE_SCAN_IDX,
+		.oversampling_ratio = 8U, // averages the input ripple, the protection uses the output current
+		.decimation_filter = ADC_SENSOR_DECIMATION_CIC_e,
+		.zero_calibration_sample_cnt = 64U, // no input current flows while the MOSFET is off
+		.zero_calibration_tolerance_v = 0.1f
 	}
 };
@@ -12,6 +12,20 @@
 #define BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID		    0U
 #define BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID		1U
 #define TEMPERATURE_LM35_SENSOR_ID		                    2U
+#define BUCK_CONVERTOR_IN_VOLTAGE_RESISTOR_SENSOR_ID		3U
+#define BUCK_CONVERTOR_IN_CURRENT_ACS724_SENSOR_ID		    4U
 
-#define TOTAL_ADC_SENSOR_ID						            3U
+#define TOTAL_ADC_SENSOR_ID						            5U
+
+// 1U: every sample read by read_adc_sensor_value is stored by the ADC trace recorder
+#define ADC_SENSOR_TRACE_RECORDING_ENABLED					1U
+
+// millisecond time source of the read_all_adc_sensor_values snapshots
+#define ADC_SENSOR_SNAPSHOT_TIMESTAMP_FUNC					HAL_GetTick
+
+// waits between the start-up zero calibration samples, called with 1 ms
+#define ADC_SENSOR_ZERO_CALIBRATION_DELAY_FUNC				HAL_Delay
+
+// frames in the ring between the DMA interrupt and the frame readers, a power of two
+#define ADC_SENSOR_FRAME_RING_LEN							16U
 #endif /* ADC_SENSOR_DRIVER_CFG_ACS724_CS_CFG_H_ */
@@ -0,0 +1,20 @@
+/*
+ * adc_trace_recorder_cfg.c
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "adc_trace_recorder.h"
+#include "adc_trace_recorder_cfg.h"
+#include "stm32f4xx_hal.h"
+
+static adc_trace_record_t m_adc_trace_records[ADC_TRACE_RECORD_CNT];
+
+const adc_trace_recorder_cfg_t g_adc_trace_recorder_config =
+{
+	.record_buffer_ptr = m_adc_trace_records,
+	.record_capacity = ADC_TRACE_RECORD_CNT,
+	.post_trigger_record_cnt = ADC_TRACE_POST_TRIGGER_RECORD_CNT,
+	.get_timestamp_func = HAL_GetTick,
+	.timestamp_frequency_hz = 1000U,
+};
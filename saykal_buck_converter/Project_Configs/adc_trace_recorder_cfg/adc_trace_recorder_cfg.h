@@ -0,0 +1,15 @@
+/*
+ * adc_trace_recorder_cfg.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef ADC_TRACE_RECORDER_CFG_H_
+#define ADC_TRACE_RECORDER_CFG_H_
+
+// 8 bytes per record, the buffer holds about one second of control loop samples
+#define ADC_TRACE_RECORD_CNT					2048U
+// records kept after an overcurrent or sensor error before the recorder freezes
+#define ADC_TRACE_POST_TRIGGER_RECORD_CNT		256U
+
+#endif /* ADC_TRACE_RECORDER_CFG_H_ */
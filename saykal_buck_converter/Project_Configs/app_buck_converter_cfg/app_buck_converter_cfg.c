@@ -8,13 +8,27 @@
 
 #include "app_buck_converter.h"
 
+// 20 kHz switching periods per control step in the interrupt mode, 0.5 ms
+#define BUCK_CONVERTER_CONTROL_INTERRUPT_DIVIDER	10U
+
+#if (0U != BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED)
+#define BUCK_CONVERTER_CONTROL_STEP_MS	(BUCK_CONVERTER_CONTROL_INTERRUPT_DIVIDER * 0.05f)
+#else
+#define BUCK_CONVERTER_CONTROL_STEP_MS	20
+#endif
+
+// overcurrent persistence before a trip, counted in control steps of either mode
+#define BUCK_CONVERTER_OVER_CURRENT_TIME_MIN_MS	60.0f
+
 static pid_controller_t m_pid_voltage_controller =
 {
 	.Kp = 3,
 	.Ki = 0.02,
 	.Kd = 0.1,
 	.Kaw = 0.02,
-	.TimeStep = 20,
+	.TimeStep = BUCK_CONVERTER_CONTROL_STEP_MS,
+	.derivative_filter_time = BUCK_CONVERTER_CONTROL_STEP_MS, // derivative filtered over about one control step
+	.setpoint_weight = 1.0f,
 	.controller_output_max = 9.96f, // voltage controller output uses as output current reference
 	.controller_output_min = 0.0f, // voltage controller output uses as output current reference
 };
@@ -25,17 +39,24 @@ static pid_controller_t m_pid_current_controller =
 	.Ki = 0.02,
 	.Kd = 0.1,
 	.Kaw = 0.02,
-	.TimeStep = 20,
+	.TimeStep = BUCK_CONVERTER_CONTROL_STEP_MS,
+	.derivative_filter_time = BUCK_CONVERTER_CONTROL_STEP_MS, // derivative filtered over about one control step
+	.setpoint_weight = 1.0f,
 	.controller_output_max = 0.95f, // current controller output uses as output duty
 	.controller_output_min = 0.0f, // current controller output uses as output duty
 };
 
 const buck_converter_cfg_t g_buck_converter_config =
 {
-	.over_current_occurence_time_min = 3,
+	.over_current_occurence_time_min = (uint16_t)((BUCK_CONVERTER_OVER_CURRENT_TIME_MIN_MS / BUCK_CONVERTER_CONTROL_STEP_MS) + 0.5f),
 	.i_out_max = 10.00f,
+	.over_current_trip_factor = 1.5f,
+	.v_out_full_scale_shift = 6U, // 64 V
+	.i_out_full_scale_shift = 8U, // 256 A, headroom of the voltage controller command
+	.duty_full_scale_shift = 6U, // 64, headroom of the current controller command
 	.v_out_ref = 24.0f,
 	.period_time_process_of_controller_ms = 20,
+	.control_interrupt_divider = BUCK_CONVERTER_CONTROL_INTERRUPT_DIVIDER,
 	.pid_out_voltage_cotroller_ptr = &m_pid_voltage_controller,
 	.pid_out_current_cotroller_ptr = &m_pid_current_controller,
 };
@@ -26,6 +26,11 @@ static const can_tx_message_cfg_t m_can_tx_messages_config[] =
 			.id_type = CANID_EXTENDED_e,
 			.message_id = COM_SYSTEM_INFO_MESSAGE_ID,
 		},
+		{
+			.can_id = 0x7A0,
+			.id_type = CANID_EXTENDED_e,
+			.message_id = COM_TIMER_EXEC_STATS_MESSAGE_ID,
+		},
 };
 
 const bsp_can_cfg_t g_bsp_can_configurations =
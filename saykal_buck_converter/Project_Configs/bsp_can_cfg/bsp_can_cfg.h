@@ -8,6 +8,7 @@
 #ifndef BSP_CAN_CFG_BSP_CAN_CFG_H_
 #define BSP_CAN_CFG_BSP_CAN_CFG_H_
 
+#define BSP_CAN_TX_MESSAGE	4U // number of entries in m_can_tx_messages_config
 
 
 #endif /* BSP_CAN_CFG_BSP_CAN_CFG_H_ */
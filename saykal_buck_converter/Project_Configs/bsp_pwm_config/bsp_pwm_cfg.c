@@ -13,9 +13,17 @@ const bsp_pwm_config_t g_bsp_pwm_timer_configs[] =
 	{
 		.timer_instance_ptr = TIM1,
 		.pwm_out_gpio_pin_id_in_bsp_gpio = BUCK_PWM_OUT_PIN_ID,
+		.pwm_timer_prescalar = 0U,
+		.pwm_timer_period = 399U, // 8 MHz timer clock / 400 -> 20 kHz switching frequency
 		.timer_channel_configs = {
 			.total_timer_channel = 1U,
 			.pwm_channels_ptr = &m_bsp_pwm_channel_info
+		},
+		.adc_trigger_config = {
+			.trigger_point = BSP_PWM_ADC_TRIGGER_MID_OFF_TIME_e, // furthest from the switching edges below 50 % duty
+			.trigger_timer_channel = TIM_CHANNEL_2, // TIM1_CC2 is BSP_ADC_PWM_TRIGGER_SOURCE, PA9 is not switched to the timer
+			.reference_pwm_channel_id = PWM_TIMER_ID_FOR_BUCK_MOSFET,
+			.trigger_offset_counts = -15 // centers the 15 cycle current sample window (3.75 us = 30 counts)
 		}
 	}
 
@@ -8,6 +8,7 @@
 
 #include "com_driver.h"
 #include "software_timer_cfg.h"
+#include "stddef.h"
 
 static const com_periodic_send_info_t m_com_periodic_voltage_current_system_info_message =
 {
@@ -104,6 +105,65 @@ static const com_signal_t m_com_signals_of_system_info_message[] =
 	},
 };
 
+static const com_signal_t m_com_signals_of_timer_exec_stats_message[] =
+{
+	{
+		.signal_id = COM_TIMER_EXEC_STATS_ID_SIGNAL_ID,
+		.signal_base_info =
+		{
+			.com_bit_position = 0,
+			.com_bit_size = 8U,
+			.com_signal_endianness = COM_SIGNAL_ENDIANNESS_LITTLE_ENDIAN_e,
+			.com_signal_variable_type = COM_SIGNAL_VARIABLE_UINT8_e,
+		},
+
+	},
+	{
+		.signal_id = COM_TIMER_EXEC_STATS_MIN_SIGNAL_ID, // microseconds
+		.signal_base_info =
+		{
+			.com_bit_position = 8U,
+			.com_bit_size = 16U,
+			.com_signal_endianness = COM_SIGNAL_ENDIANNESS_LITTLE_ENDIAN_e,
+			.com_signal_variable_type = COM_SIGNAL_VARIABLE_UINT16_e,
+		},
+
+	},
+	{
+		.signal_id = COM_TIMER_EXEC_STATS_MEAN_SIGNAL_ID, // microseconds
+		.signal_base_info =
+		{
+			.com_bit_position = 24U,
+			.com_bit_size = 16U,
+			.com_signal_endianness = COM_SIGNAL_ENDIANNESS_LITTLE_ENDIAN_e,
+			.com_signal_variable_type = COM_SIGNAL_VARIABLE_UINT16_e,
+		},
+
+	},
+	{
+		.signal_id = COM_TIMER_EXEC_STATS_MAX_SIGNAL_ID, // microseconds
+		.signal_base_info =
+		{
+			.com_bit_position = 40U,
+			.com_bit_size = 16U,
+			.com_signal_endianness = COM_SIGNAL_ENDIANNESS_LITTLE_ENDIAN_e,
+			.com_signal_variable_type = COM_SIGNAL_VARIABLE_UINT16_e,
+		},
+
+	},
+	{
+		.signal_id = COM_TIMER_EXEC_STATS_LOAD_SIGNAL_ID, // share of the CPU time in 0.1 % steps
+		.signal_base_info =
+		{
+			.com_bit_position = 56U,
+			.com_bit_size = 8U,
+			.com_signal_endianness = COM_SIGNAL_ENDIANNESS_LITTLE_ENDIAN_e,
+			.com_signal_variable_type = COM_SIGNAL_VARIABLE_UINT8_e,
+		},
+
+	},
+};
+
 static const com_message_t m_com_messages[] =
 {
 	{
@@ -133,6 +193,15 @@ static const com_message_t m_com_messages[] =
 		.signals_ptr = m_com_signals_of_system_info_message,
 
 	},
+	{
+		.message_id = COM_TIMER_EXEC_STATS_MESSAGE_ID,
+		.message_data_length = 8U,
+		.total_signal_cnt_in_message = 5U,
+		.transmission_bus_of_message = MESSAGE_BUS_CANBUS_e,
+		.periodic_send_info = NULL, // sent by the system manager after the signals are updated
+		.signals_ptr = m_com_signals_of_timer_exec_stats_message,
+
+	},
 };
 
 const com_configs_t g_com_message_configs =
@@ -11,7 +11,8 @@
 #define COM_BUCK_VOLTAGE_INFO_MESSAGE_ID	0U
 #define COM_BUCK_CURRENT_INFO_MESSAGE_ID	1U
 #define COM_SYSTEM_INFO_MESSAGE_ID			2U
-#define COM_TOTAL_MESSAGE_ID			 	3U
+#define COM_TIMER_EXEC_STATS_MESSAGE_ID		3U
+#define COM_TOTAL_MESSAGE_ID			 	4U
 
 
 
@@ -22,5 +23,14 @@
 #define COM_SYSTEM_TEMPERATURE_SIGNAL_ID	4U
 #define COM_SYSTEM_STATE_SIGNAL_ID			5U
 #define COM_SYSTEM_ERROR_STATE_SIGNAL_ID	6U
-#define COM_TOTAL_SIGNAL_ID					7U
+#define COM_TIMER_EXEC_STATS_ID_SIGNAL_ID	7U
+#define COM_TIMER_EXEC_STATS_MIN_SIGNAL_ID	8U
+#define COM_TIMER_EXEC_STATS_MEAN_SIGNAL_ID	9U
+#define COM_TIMER_EXEC_STATS_MAX_SIGNAL_ID	10U
+#define COM_TIMER_EXEC_STATS_LOAD_SIGNAL_ID	11U
+#define COM_TOTAL_SIGNAL_ID					12U
+
+#define COM_MESSAGE_CNT						COM_TOTAL_MESSAGE_ID
+#define COM_SIGNAL_CNT						COM_TOTAL_SIGNAL_ID
+#define COM_MESSAGE_DATA_LEN_MAX			8U // all messages are classic CAN frames
 #endif /* COM_DRIVER_CFG_COM_DRIVER_CFG_H_ */
@@ -10,6 +10,7 @@
 #include "app_buck_converter.h"
 #include "com_driver.h"
 #include "system_manager.h"
+#include "bsp_cycle_counter.h"
 
 static const software_timer_cfg_t m_software_timers_configs[] =
 {
@@ -25,10 +26,16 @@ static const software_timer_cfg_t m_software_timers_configs[] =
 		.reload_option = TIMER_RELOAD_AUTO_e,
 		.timeout_callback_func = calculate_system_temperature,
 	},
+	{
+		.reload_option = TIMER_RELOAD_PERIODIC_e,
+		.timeout_callback_func = send_software_timer_exec_stats,
+	},
 };
 
 const software_timer_general_cfg_t g_software_timer_general_config =
 {
 	.get_timer_tick_ms_func = HAL_GetTick,
 	.software_timer_cfg_ptr = m_software_timers_configs,
+	.get_cycle_cnt_func = get_bsp_cycle_count,
+	.get_cycle_frequency_hz_func = get_bsp_cycle_counter_frequency_hz,
 };
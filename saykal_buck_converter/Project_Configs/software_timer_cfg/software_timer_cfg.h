@@ -13,6 +13,7 @@
                         //because it is better to send voltage and current information at the same time.
                         // but if it is needed to add any other timer for any com message, it is very easy to make it happen.
 #define SYSTEM_TEMPERATURE_PROCESS_TIMER_ID 2U
-#define SOFTWARE_TIMER_CNT 3U
+#define SYSTEM_TIMER_EXEC_STATS_TIMER_ID 3U // sends the callback execution time statistics over com
+#define SOFTWARE_TIMER_CNT 4U
 
 #endif /* SOFTWARE_TIMER_CFG_SOFTWARE_TIMER_CFG_H_ */
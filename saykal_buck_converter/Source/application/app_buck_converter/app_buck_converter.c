@@ -13,8 +13,10 @@
  *
  * Key features:
  * - Cascaded voltage and current control loop
- * - Periodic control execution via software timer
+ * - Periodic control execution via software timer, or in the ADC interrupt at a
+ *   divider of the switching frequency (BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED)
  * - Overcurrent detection with configurable persistence threshold
+ * - Hardware overcurrent trip by the ADC analog watchdog (BSP_ADC_CURRENT_WATCHDOG_ENABLED)
  * - Robust error handling and protection against sensor or control failures
  *
  * @author Alperen Yazıcı
@@ -27,6 +29,13 @@
 #include "com_driver.h"
 #include "stdbool.h"
 #include "error_manager.h"
+#include "bsp_adc.h"
+
+#if (0U != BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED) && \
+	((0U == BSP_ADC_DMA_SCAN_ENABLED) || (0U == BSP_ADC_PWM_TRIGGER_ENABLED))
+#error "BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED needs the DMA scan and the PWM triggered injected conversions"
+#endif
+
 /**
  * @brief Pointer to the active buck converter configuration.
  */
@@ -35,9 +44,111 @@ static buck_converter_cfg_t *m_buck_converter_cfg = NULL;
 /**
  * @brief Indicates if a critical error (e.g., overcurrent) has been detected.
  *
- * If true, control loop will stop to protect the system.
+ * If true, control loop will stop to protect the system. Also set by the ADC interrupt.
+ */
+static volatile bool is_cricial_error_detected = false;
+
+/**
+ * @brief Set by trip_over_current(), also from the ADC interrupt, reported by the main loop.
+ *
+ * report_over_current() sends over the communication layer and triggers the
+ * trace recorder, neither of which may be entered from an interrupt.
+ */
+static volatile bool m_is_over_current_trip_latched = false;
+
+/**
+ * @brief Set once the main loop reported the latched trip, only used by the main loop.
  */
-static bool is_cricial_error_detected = false;
+static bool m_is_over_current_trip_reported = false;
+
+/**
+ * @brief Set while an input side sensor read fails, the failure is reported once when it starts.
+ */
+static bool m_is_input_sensor_failed = false;
+
+#if (0U != BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED)
+/**
+ * @brief Reader of the frame ring, owned by the control interrupt.
+ */
+static adc_sensor_frame_reader_t m_control_frame_reader;
+
+/**
+ * @brief Output voltage count of the latest frame in 12.4 fixed point, valid once a frame was read.
+ */
+static uint16_t m_control_voltage_raw_count = 0U;
+static bool m_is_control_voltage_valid = false;
+
+/**
+ * @brief Injected conversions since the last control step.
+ */
+static uint16_t m_control_divider_cnt = 0U;
+
+/**
+ * @brief Cleared by the main loop while an output sensor read fails, the interrupt then holds the duty.
+ */
+static volatile bool m_is_output_sensor_ok = false;
+
+/**
+ * @brief Runs the cascaded control loop on every control_interrupt_divider-th injected conversion.
+ *
+ * Runs in the ADC interrupt, see BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED.
+ *
+ * @param[in] current_raw_count Current sense conversion in 12.4 fixed point.
+ */
+static void control_out_voltage_in_interrupt(uint16_t current_raw_count);
+#endif
+
+#if (0U != BUCK_CONVERTER_VOLTAGE_PID_Q31_ENABLED)
+/**
+ * @brief Fixed-point voltage controller, initialized from pid_out_voltage_cotroller_ptr.
+ */
+static pid_controller_q31_t m_pid_out_voltage_q31;
+#else
+/**
+ * @brief Voltage controller, initialized from pid_out_voltage_cotroller_ptr.
+ */
+static pid_controller_v2_t m_pid_out_voltage_v2;
+#endif
+
+#if (0U != BUCK_CONVERTER_CURRENT_PID_Q31_ENABLED)
+/**
+ * @brief Fixed-point current controller, initialized from pid_out_current_cotroller_ptr.
+ */
+static pid_controller_q31_t m_pid_out_current_q31;
+#else
+/**
+ * @brief Current controller, initialized from pid_out_current_cotroller_ptr.
+ */
+static pid_controller_v2_t m_pid_out_current_v2;
+#endif
+
+/**
+ * @brief Steps the voltage controller with the kernel of BUCK_CONVERTER_VOLTAGE_PID_Q31_ENABLED.
+ *
+ * @param[in] sensed_output_voltage Output voltage in volts.
+ * @return float Output current reference in amperes.
+ */
+static float step_out_voltage_controller(float sensed_output_voltage);
+
+/**
+ * @brief Steps the current controller with the kernel of BUCK_CONVERTER_CURRENT_PID_Q31_ENABLED.
+ *
+ * @param[in] sensed_output_current Output current in amperes.
+ * @param[in] i_out_reference       Output current reference in amperes.
+ * @return float Duty of the buck MOSFET.
+ */
+static float step_out_current_controller(float sensed_output_current, float i_out_reference);
+
+/**
+ * @brief Runs one step of the cascaded voltage and current loops and sets the duty.
+ *
+ * Trips the overcurrent protection once the output current exceeded
+ * i_out_max for over_current_occurence_time_min consecutive steps.
+ *
+ * @param[in] sensed_output_voltage Output voltage in volts.
+ * @param[in] sensed_output_current Output current in amperes.
+ */
+static void run_cascaded_control_step(float sensed_output_voltage, float sensed_output_current);
 
 /**
  * @brief Monitors output current and detects overcurrent condition.
@@ -55,6 +166,23 @@ static bool is_cricial_error_detected = false;
 static bool monitor_current_to_detect_over_current(float sensed_output_current ,
 												   float over_current_value,
 												   uint16_t over_current_occurance_time_min);
+
+/**
+ * @brief Stops the buck MOSFET and latches the overcurrent trip.
+ *
+ * Called by the control step, in the ADC interrupt with
+ * BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED, and by the current sense watchdog
+ * (BSP_ADC_CURRENT_WATCHDOG_ENABLED) right after a conversion above
+ * i_out_max * over_current_trip_factor, without waiting for the next control step.
+ * report_over_current_trip() reports the trip from the main loop.
+ */
+static void trip_over_current(void);
+
+/**
+ * @brief Reports a trip latched by trip_over_current() once.
+ */
+static void report_over_current_trip(void);
+
 /**
  * @brief Initializes the buck converter application with the given configuration.
  *
@@ -71,7 +199,57 @@ void init_buck_converter(const buck_converter_cfg_t *buck_converter_cfg_ptr)
 	if(NULL != buck_converter_cfg_ptr)
 	{
 		is_cricial_error_detected = false;
+		m_is_input_sensor_failed = false;
 		m_buck_converter_cfg = (buck_converter_cfg_t*)buck_converter_cfg_ptr;
+
+#if (0U != BUCK_CONVERTER_VOLTAGE_PID_Q31_ENABLED)
+		init_pid_controller_q31(&m_pid_out_voltage_q31,
+								m_buck_converter_cfg->pid_out_voltage_cotroller_ptr,
+								m_buck_converter_cfg->v_out_full_scale_shift,
+								m_buck_converter_cfg->i_out_full_scale_shift);
+#else
+		init_pid_controller_v2(&m_pid_out_voltage_v2, m_buck_converter_cfg->pid_out_voltage_cotroller_ptr);
+#endif
+
+#if (0U != BUCK_CONVERTER_CURRENT_PID_Q31_ENABLED)
+		init_pid_controller_q31(&m_pid_out_current_q31,
+								m_buck_converter_cfg->pid_out_current_cotroller_ptr,
+								m_buck_converter_cfg->i_out_full_scale_shift,
+								m_buck_converter_cfg->duty_full_scale_shift);
+#else
+		init_pid_controller_v2(&m_pid_out_current_v2, m_buck_converter_cfg->pid_out_current_cotroller_ptr);
+#endif
+
+		m_is_over_current_trip_latched = false;
+		m_is_over_current_trip_reported = false;
+
+#if (0U != BSP_ADC_CURRENT_WATCHDOG_ENABLED)
+		// armed before the MOSFET switches, the threshold includes the calibrated zero output
+		register_current_sense_watchdog_callback(trip_over_current);
+
+		if(BSP_ADC_STATE_OK_e != start_current_sense_watchdog(
+			convert_adc_sensor_value_to_raw_count(BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID,
+												  m_buck_converter_cfg->i_out_max *
+												  m_buck_converter_cfg->over_current_trip_factor)))
+		{
+			report_init_error();
+		}
+#endif
+
+#if (0U != BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED)
+		m_control_divider_cnt = 0U;
+		m_is_control_voltage_valid = false;
+		m_is_output_sensor_ok = true;
+		init_adc_sensor_frame_reader(&m_control_frame_reader);
+		register_current_sense_injected_conversion_callback(control_out_voltage_in_interrupt);
+
+		// TIM1 TRGO starts the injected conversions once the PWM runs
+		if(BSP_ADC_STATE_OK_e != start_current_sense_injected_conversion())
+		{
+			report_init_error();
+		}
+#endif
+
 		start_pwm_channel(PWM_TIMER_ID_FOR_BUCK_MOSFET);
 		start_software_timer(BUCK_CONVERTER_PID_SOFTWARE_TIMER_ID ,
 							 m_buck_converter_cfg->period_time_process_of_controller_ms);
@@ -90,9 +268,12 @@ void init_buck_converter(const buck_converter_cfg_t *buck_converter_cfg_ptr)
  * by an inner PID loop to control the output current. The result is translated into a PWM duty cycle
  * to drive the buck converter MOSFET.
  *
- * It reads both output voltage and output current via the ADC sensor driver.
+ * It reads output voltage and output current from one ADC sensor snapshot, so both
+ * are sampled at the same instant.
  *
  * It is called by software timer (BUCK_CONVERTER_PID_SOFTWARE_TIMER_ID) periodically.
+ * With BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED the loop runs in the ADC
+ * interrupt and this function only publishes the sensor values.
  *
  * @retval None
  */
@@ -100,18 +281,27 @@ void control_out_voltage_with_current_limit(software_timer_id_t sw_timer_id)
 {
 	(void)sw_timer_id;
 
+	report_over_current_trip();
+
 	if(true == is_cricial_error_detected)
 	{
 		return; // This is exist for double prevention,
 		//because system will be in ERROR mode when critical error is detected
 	}
 
-	float sensed_output_voltage = 0.0f;
+	adc_sensor_snapshot_t sensor_snapshot;
 
-	adc_sensor_state_e adc_read_state =
-		read_adc_sensor_value(BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID , &sensed_output_voltage);
+	(void)read_all_adc_sensor_values(&sensor_snapshot);
 
-	if(ADC_SENSOR_ERROR_e == adc_read_state)
+#if (0U != BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED)
+	m_is_output_sensor_ok =
+		(ADC_SENSOR_OK_e == sensor_snapshot.states[BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID]) &&
+		(ADC_SENSOR_OK_e == sensor_snapshot.states[BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID]);
+#endif
+
+	float sensed_output_voltage = sensor_snapshot.values[BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID];
+
+	if(ADC_SENSOR_ERROR_e == sensor_snapshot.states[BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID])
 	{
 		report_sensor_error();
 		return;
@@ -119,22 +309,91 @@ void control_out_voltage_with_current_limit(software_timer_id_t sw_timer_id)
 
 	send_signal_over_com(COM_BUCK_OUTPUT_VOLTAGE_SIGNAL_ID,&sensed_output_voltage);
 
-	float i_out_reference = PID_Step(m_buck_converter_cfg->pid_out_voltage_cotroller_ptr,
-									 sensed_output_voltage,
-									 m_buck_converter_cfg->v_out_ref);
+	float sensed_output_current = sensor_snapshot.values[BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID];
+
+	if(ADC_SENSOR_ERROR_e == sensor_snapshot.states[BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID])
+	{
+		report_sensor_error();
+		return;
+	}
+
+	send_signal_over_com(COM_BUCK_OUTPUT_CURRENT_SIGNAL_ID,&sensed_output_current);
+
+	// the input side is only published, a failed read skips its signal and does not stop the control loop
+	bool is_input_voltage_ok = (ADC_SENSOR_OK_e == sensor_snapshot.states[BUCK_CONVERTOR_IN_VOLTAGE_RESISTOR_SENSOR_ID]);
+	bool is_input_current_ok = (ADC_SENSOR_OK_e == sensor_snapshot.states[BUCK_CONVERTOR_IN_CURRENT_ACS724_SENSOR_ID]);
 
-	float sensed_output_current = 0.0f;
+	if(true == is_input_voltage_ok)
+	{
+		send_signal_over_com(COM_BUCK_INPUT_VOLTAGE_SIGNAL_ID,
+							 &sensor_snapshot.values[BUCK_CONVERTOR_IN_VOLTAGE_RESISTOR_SENSOR_ID]);
+	}
 
-	adc_read_state =
-			read_adc_sensor_value(BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID , &sensed_output_current);
+	if(true == is_input_current_ok)
+	{
+		send_signal_over_com(COM_BUCK_INPUT_CURRENT_SIGNAL_ID,
+							 &sensor_snapshot.values[BUCK_CONVERTOR_IN_CURRENT_ACS724_SENSOR_ID]);
+	}
 
-	if(ADC_SENSOR_ERROR_e == adc_read_state)
+	if((true == is_input_voltage_ok) && (true == is_input_current_ok))
+	{
+		m_is_input_sensor_failed = false;
+	}
+	else if(false == m_is_input_sensor_failed)
 	{
+		// reported on the first failed cycle only, a persistent failure would otherwise
+		// re-trigger the trace recorder every control period
+		m_is_input_sensor_failed = true;
 		report_sensor_error();
+	}
+
+#if (0U == BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED)
+	run_cascaded_control_step(sensed_output_voltage, sensed_output_current);
+	report_over_current_trip();
+#endif
+}
+
+#if (0U != BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED)
+static void control_out_voltage_in_interrupt(uint16_t current_raw_count)
+{
+	if(true == is_cricial_error_detected)
+	{
 		return;
 	}
 
-	send_signal_over_com(COM_BUCK_OUTPUT_CURRENT_SIGNAL_ID,&sensed_output_current);
+	m_control_divider_cnt++;
+
+	if(m_control_divider_cnt < m_buck_converter_cfg->control_interrupt_divider)
+	{
+		return;
+	}
+
+	m_control_divider_cnt = 0U;
+
+	adc_sensor_frame_t frame;
+
+	// the newest frame holds the latest decimated output voltage
+	while(true == read_adc_sensor_frame(&m_control_frame_reader, &frame))
+	{
+		m_control_voltage_raw_count = frame.raw_counts[BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID];
+		m_is_control_voltage_valid = true;
+	}
+
+	if((false == m_is_control_voltage_valid) || (false == m_is_output_sensor_ok))
+	{
+		return;
+	}
+
+	run_cascaded_control_step(
+		convert_adc_sensor_raw_count(BUCK_CONVERTOR_OUT_VOLTAGE_RESISTOR_SENSOR_ID, m_control_voltage_raw_count),
+		convert_adc_sensor_raw_count(BUCK_CONVERTOR_OUT_CURRENT_ACS724_SENSOR_ID, current_raw_count));
+}
+#endif
+
+static void run_cascaded_control_step(float sensed_output_voltage, float sensed_output_current)
+{
+	float i_out_reference = step_out_voltage_controller(sensed_output_voltage);
+
 	//TODO : current monitor to detect over current
 	bool is_over_current =
 		monitor_current_to_detect_over_current(sensed_output_current ,
@@ -143,20 +402,45 @@ void control_out_voltage_with_current_limit(software_timer_id_t sw_timer_id)
 
 	if(true == is_over_current)
 	{
-		set_pwm_duty(PWM_TIMER_ID_FOR_BUCK_MOSFET , 0.0f);
-		stop_pwm_channel(PWM_TIMER_ID_FOR_BUCK_MOSFET);
-		report_over_current();
-		is_cricial_error_detected = true;
+		trip_over_current();
 		return;
 	}
 
-	float duty_reference = PID_Step(m_buck_converter_cfg->pid_out_current_cotroller_ptr,
-									sensed_output_current,
-									i_out_reference);
+	float duty_reference = step_out_current_controller(sensed_output_current, i_out_reference);
 
 	set_pwm_duty(PWM_TIMER_ID_FOR_BUCK_MOSFET , duty_reference);
 }
 
+static float step_out_voltage_controller(float sensed_output_voltage)
+{
+#if (0U != BUCK_CONVERTER_VOLTAGE_PID_Q31_ENABLED)
+	uint8_t v_out_shift = m_buck_converter_cfg->v_out_full_scale_shift;
+	int32_t i_out_reference_q31 =
+		PID_Step_q31(&m_pid_out_voltage_q31,
+					 convert_pid_value_to_q31(sensed_output_voltage, v_out_shift),
+					 convert_pid_value_to_q31(m_buck_converter_cfg->v_out_ref, v_out_shift));
+
+	return convert_pid_q31_to_value(i_out_reference_q31, m_buck_converter_cfg->i_out_full_scale_shift);
+#else
+	return PID_Step_v2(&m_pid_out_voltage_v2, sensed_output_voltage, m_buck_converter_cfg->v_out_ref);
+#endif
+}
+
+static float step_out_current_controller(float sensed_output_current, float i_out_reference)
+{
+#if (0U != BUCK_CONVERTER_CURRENT_PID_Q31_ENABLED)
+	uint8_t i_out_shift = m_buck_converter_cfg->i_out_full_scale_shift;
+	int32_t duty_reference_q31 =
+		PID_Step_q31(&m_pid_out_current_q31,
+					 convert_pid_value_to_q31(sensed_output_current, i_out_shift),
+					 convert_pid_value_to_q31(i_out_reference, i_out_shift));
+
+	return convert_pid_q31_to_value(duty_reference_q31, m_buck_converter_cfg->duty_full_scale_shift);
+#else
+	return PID_Step_v2(&m_pid_out_current_v2, sensed_output_current, i_out_reference);
+#endif
+}
+
 static bool monitor_current_to_detect_over_current(float sensed_output_current ,
 												   float over_current_value,
 												   uint16_t over_current_occurance_time_min)
@@ -181,3 +465,20 @@ static bool monitor_current_to_detect_over_current(float sensed_output_current ,
 	return is_over_current_detected;
 
 }
+
+static void trip_over_current(void)
+{
+	set_pwm_duty(PWM_TIMER_ID_FOR_BUCK_MOSFET , 0.0f);
+	stop_pwm_channel(PWM_TIMER_ID_FOR_BUCK_MOSFET);
+	is_cricial_error_detected = true;
+	m_is_over_current_trip_latched = true;
+}
+
+static void report_over_current_trip(void)
+{
+	if((true == m_is_over_current_trip_latched) && (false == m_is_over_current_trip_reported))
+	{
+		m_is_over_current_trip_reported = true;
+		report_over_current();
+	}
+}
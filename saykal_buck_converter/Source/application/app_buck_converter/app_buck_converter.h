@@ -11,6 +11,50 @@
 #include "stdint.h"
 #include "pid_controller.h"
 #include "software_timer.h"
+
+/**
+ * @brief Selects where the cascaded control loop runs.
+ *
+ * @details 1U: the loop runs in the ADC interrupt of the injected current sense
+ * conversion, which TIM1 TRGO starts once per switching period, on every
+ * control_interrupt_divider-th conversion. The output current is the injected
+ * conversion of that period, the output voltage the latest frame of the DMA
+ * scan. The software timer keeps running every
+ * period_time_process_of_controller_ms in the main loop, where it reads all
+ * sensors, publishes them over com and reports the sensor errors; the
+ * interrupt holds the duty while an output sensor read fails. The PID TimeStep
+ * must be the interrupt step. Needs BSP_ADC_DMA_SCAN_ENABLED and
+ * BSP_ADC_PWM_TRIGGER_ENABLED.
+ *
+ * 0U: the software timer runs the loop every period_time_process_of_controller_ms.
+ */
+#ifndef BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED
+#define BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED	0U
+#endif
+
+/**
+ * @brief Selects the kernel of the outer voltage controller.
+ *
+ * @details 1U: PID_Step_q31() on a pid_controller_q31_t initialized from
+ * pid_out_voltage_cotroller_ptr, the output voltage and its reference in Q31 of
+ * 2^v_out_full_scale_shift volts, the current reference in Q31 of
+ * 2^i_out_full_scale_shift amperes. 0U: the float PID_Step_v2().
+ */
+#ifndef BUCK_CONVERTER_VOLTAGE_PID_Q31_ENABLED
+#define BUCK_CONVERTER_VOLTAGE_PID_Q31_ENABLED		0U
+#endif
+
+/**
+ * @brief Selects the kernel of the inner current controller.
+ *
+ * @details 1U: PID_Step_q31() on a pid_controller_q31_t initialized from
+ * pid_out_current_cotroller_ptr, the output current and its reference in Q31
+ * of 2^i_out_full_scale_shift amperes, the duty in Q31. 0U: the float PID_Step_v2().
+ */
+#ifndef BUCK_CONVERTER_CURRENT_PID_Q31_ENABLED
+#define BUCK_CONVERTER_CURRENT_PID_Q31_ENABLED		0U
+#endif
+
 /**
  * @brief Configuration structure for the buck converter control system.
  *
@@ -23,7 +67,9 @@ typedef struct
      * @brief Pointer to the PID controller for output voltage regulation.
      *
      * This controller calculates the desired output current reference based
-     * on the error between measured and target output voltage.
+     * on the error between measured and target output voltage. Holds the
+     * tuning; the controller stepped by the loop is initialized from it by
+     * init_buck_converter().
      */
     pid_controller_t *pid_out_voltage_cotroller_ptr;
 
@@ -32,6 +78,7 @@ typedef struct
      *
      * This controller generates the PWM duty cycle based on the error between
      * measured and target output current (which is derived from the outer voltage loop).
+     * Holds the tuning like pid_out_voltage_cotroller_ptr.
      */
     pid_controller_t *pid_out_current_cotroller_ptr;
 
@@ -39,10 +86,19 @@ typedef struct
      * @brief Period (in milliseconds) to execute the control process.
      *
      * Determines how frequently the control loop should run. It is typically
-     * used by a software timer.
+     * used by a software timer. With BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED
+     * it is the period of the sensor telemetry only.
      */
     uint8_t period_time_process_of_controller_ms;
 
+    /**
+     * @brief Switching periods per control step with BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED.
+     *
+     * The control loop runs at the switching frequency divided by this value,
+     * 0 is treated as 1.
+     */
+    uint16_t control_interrupt_divider;
+
     /**
      * @brief Reference voltage value (in volts) to be maintained at the converter output.
      *
@@ -63,9 +119,48 @@ typedef struct
      *
      * Helps prevent false positives due to short spikes or noise. If overcurrent is
      * detected for at least this number of consecutive cycles, a critical fault is reported.
+     * The cycles are control steps, so the value scales with the step time, see
+     * BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED.
      */
     uint16_t over_current_occurence_time_min;
 
+    /**
+     * @brief Multiple of i_out_max at which the ADC analog watchdog trips at once.
+     *
+     * Used with BSP_ADC_CURRENT_WATCHDOG_ENABLED. A single conversion above
+     * i_out_max * over_current_trip_factor stops the PWM without waiting for the
+     * control loop, the peak limit is kept above the start-up inrush and the
+     * transient peaks that the consecutive sample check above tolerates.
+     */
+    float over_current_trip_factor;
+
+    /**
+     * @brief Output voltage full scale of the fixed-point controllers is 2^v_out_full_scale_shift volts.
+     *
+     * Used with BUCK_CONVERTER_VOLTAGE_PID_Q31_ENABLED. Must exceed the output
+     * voltage and its reference, larger values saturate.
+     */
+    uint8_t v_out_full_scale_shift;
+
+    /**
+     * @brief Output current full scale of the fixed-point controllers is 2^i_out_full_scale_shift amperes.
+     *
+     * Used with BUCK_CONVERTER_VOLTAGE_PID_Q31_ENABLED or
+     * BUCK_CONVERTER_CURRENT_PID_Q31_ENABLED. It is the output full scale of the
+     * voltage controller, so it must also hold its unsaturated command, Kp times
+     * the voltage error plus the integral term, or the fixed-point integral
+     * saturates where the float one keeps winding.
+     */
+    uint8_t i_out_full_scale_shift;
+
+    /**
+     * @brief Duty full scale of the fixed-point current controller is 2^duty_full_scale_shift.
+     *
+     * Used with BUCK_CONVERTER_CURRENT_PID_Q31_ENABLED. Holds the unsaturated
+     * command of the current controller like i_out_full_scale_shift.
+     */
+    uint8_t duty_full_scale_shift;
+
 } buck_converter_cfg_t;
 
 
@@ -93,6 +188,8 @@ void init_buck_converter(const buck_converter_cfg_t *buck_converter_cfg_ptr);
  * It reads both output voltage and output current via the ADC sensor driver.
  *
  * It is called by software timer (BUCK_CONVERTER_PID_SOFTWARE_TIMER_ID) periodically.
+ * With BUCK_CONVERTER_CONTROL_IN_INTERRUPT_ENABLED the loop runs in the ADC
+ * interrupt and this function only publishes the sensor values.
  *
  * @retval None
  */
@@ -2,18 +2,163 @@
 #include "bsp_adc.h"
 #include "error_manager.h"
 
-#define RAW_TO_VOLTAGE_FACTOR	3.3f/4095
+#define RAW_TO_VOLTAGE_FACTOR	BSP_ADC_REFERENCE_VOLTAGE/BSP_ADC_MAX_RAW_COUNT
 
 /** @brief Rank definitions for ADC channels. */
 #define ADC_CHANNEL_FIRST_RANK 1U
 #define ADC_CHANNEL_SECOND_RANK 2U
 #define ADC_CHANNEL_THIRD_RANK 3U
+#define ADC_CHANNEL_FOURTH_RANK 4U
+#define ADC_CHANNEL_FIFTH_RANK 5U
+#define ADC_CHANNEL_SIXTH_RANK 6U
+#define ADC_CHANNEL_SEVENTH_RANK 7U
+
+/** @brief Scan sequences held by the DMA buffer, two blocks. */
+#define ADC_SCAN_SEQUENCE_CNT (2U * BSP_ADC_SCAN_BLOCK_SEQUENCE_CNT)
+
+/** @brief Conversions held by the DMA buffer. */
+#define ADC_SCAN_BUFFER_LEN (ADC_SCAN_SEQUENCE_CNT * BSP_ADC_SCAN_CHANNEL_CNT)
+
+/** @brief Fraction bits of the supply scale. */
+#define ADC_SUPPLY_SCALE_FRACTION_BITS 16U
+
+/** @brief Supply scale of a supply at exactly BSP_ADC_REFERENCE_VOLTAGE. */
+#define ADC_SUPPLY_SCALE_ONE (1UL << ADC_SUPPLY_SCALE_FRACTION_BITS)
 
 /** 
  * @brief ADC handle for ADC1. 
  */
 static ADC_HandleTypeDef m_hadc1;
 
+/**
+ * @brief Receiver of the injected current sense conversions.
+ */
+static volatile adc_injected_conversion_cb_func_t m_injected_conversion_cb_func = NULL;
+
+/**
+ * @brief Receiver of the current sense watchdog trips.
+ */
+static volatile adc_watchdog_cb_func_t m_watchdog_cb_func = NULL;
+
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+/**
+ * @brief DMA handle of the ADC1 request (DMA2 Stream0 Channel0).
+ */
+static DMA_HandleTypeDef m_hdma_adc1;
+
+/**
+ * @brief Two blocks of scan sequences, written by the DMA in circular mode.
+ */
+static volatile uint16_t m_adc_scan_buffer[ADC_SCAN_BUFFER_LEN];
+
+/**
+ * @brief Receiver of the completed scan blocks.
+ */
+static volatile adc_scan_block_cb_func_t m_scan_block_cb_func = NULL;
+
+/**
+ * @brief Overrun reported by the ADC interrupt, which clears the overrun flag.
+ */
+static volatile bool m_is_scan_overrun = false;
+
+/**
+ * @brief Copy of the sequence returned by the scan reads while m_is_scan_sequence_held is set.
+ */
+static uint16_t m_held_scan_sequence[BSP_ADC_SCAN_CHANNEL_CNT];
+static bool m_is_scan_sequence_held = false;
+
+#if (0U != BSP_ADC_SUPPLY_COMPENSATION_ENABLED)
+/**
+ * @brief Multiplier of the compensated counts, Q16.16, written by the DMA interrupt.
+ */
+static volatile uint32_t m_supply_scale_q16 = ADC_SUPPLY_SCALE_ONE;
+
+/**
+ * @brief Filtered VREFINT and MCU temperature counts in 12.4 fixed point,
+ *        times 2^BSP_ADC_SUPPLY_FILTER_SHIFT, 0 before the first block.
+ */
+static volatile uint32_t m_vrefint_count_filter = 0U;
+static volatile uint32_t m_mcu_temperature_count_filter = 0U;
+
+/**
+ * @brief VREFINT_CAL in 12.4 fixed point, scaled from VREFINT_CAL_VREF to
+ *        BSP_ADC_REFERENCE_VOLTAGE, in Q16.16: the scale is this divided by the VREFINT count.
+ */
+static uint64_t m_vrefint_cal_count_q16 = 0U;
+
+/**
+ * @brief Plausible VREFINT counts in 12.4 fixed point, from BSP_ADC_SUPPLY_VOLTAGE_MAX/MIN.
+ */
+static uint32_t m_vrefint_count_min = 0U;
+static uint32_t m_vrefint_count_max = 0U;
+
+/**
+ * @brief Reads the factory calibration of VREFINT and derives the plausible counts.
+ */
+static void init_adc_supply_compensation();
+
+/**
+ * @brief Filters the VREFINT and temperature sensor counts of a block and updates the supply scale.
+ *
+ * @param[in] block_ptr Completed block of m_adc_scan_buffer.
+ */
+static void update_adc_supply_compensation(const volatile uint16_t *block_ptr);
+
+/**
+ * @brief Configures the internal reference VREFINT on rank 6.
+ */
+static void configure_vrefint_adc_channel();
+
+/**
+ * @brief Configures the MCU temperature sensor on rank 7.
+ */
+static void configure_mcu_temperature_adc_channel();
+#endif
+
+/**
+ * @brief Configures the DMA stream of ADC1 and links it to the ADC handle.
+ */
+static void init_adc_scan_dma();
+
+/**
+ * @brief Returns the index of the latest complete sequence in m_adc_scan_buffer.
+ */
+static uint32_t get_latest_scan_sequence_idx();
+
+/**
+ * @brief Passes a completed block of m_adc_scan_buffer to the registered receiver.
+ *
+ * @param[in] block_idx 0 for the first half of the buffer, 1 for the second.
+ */
+static void pass_adc_scan_block(uint32_t block_idx);
+
+/**
+ * @brief Starts the scan of all channels into m_adc_scan_buffer.
+ * @note  The sequence repeats back to back, or on every PWM trigger with
+ *        BSP_ADC_PWM_TRIGGER_ENABLED.
+ */
+static void start_adc_scan();
+
+/**
+ * @brief Returns the conversion of a rank in the latest complete sequence of the scan.
+ *
+ * @param[in]  rank          Rank of the channel (ADC_CHANNEL_xxx_RANK).
+ * @param[out] raw_count_ptr Pointer to store the raw count in 12.4 fixed point.
+ * @retval BSP_ADC_STATE_OK_e if the scan is running.
+ * @retval BSP_ADC_STATE_ERROR_e if the scan stopped, it is restarted for the next read.
+ */
+static bsp_adc_status_e read_scanned_adc_raw_count(uint32_t rank, uint16_t *raw_count_ptr);
+#else
+/**
+ * @brief Converts the channel configured on rank 1 once and waits up to 5 ms for it.
+ *
+ * @param[out] raw_count_ptr Pointer to store the raw count in 12.4 fixed point.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+static bsp_adc_status_e read_polled_adc_raw_count(uint16_t *raw_count_ptr);
+#endif
+
 /**
  * @brief Configures the ADC channel used for current sensing.
  * @note  This function is used internally before reading current sensing value.
@@ -32,6 +177,35 @@ static void configure_voltage_sense_adc_channel();
  */
 static void configure_temperature_sense_adc_channel();
 
+/**
+ * @brief Configures the ADC channel used for input voltage sensing.
+ * @note  This function is used internally before reading input voltage sensing value.
+ */
+static void configure_input_voltage_sense_adc_channel();
+
+/**
+ * @brief Configures the ADC channel used for input current sensing.
+ * @note  This function is used internally before reading input current sensing value.
+ */
+static void configure_input_current_sense_adc_channel();
+
+#if (0U != BSP_ADC_CURRENT_WATCHDOG_ENABLED)
+/**
+ * @brief Converts a compensated 12.4 fixed point count back to a conversion result.
+ *
+ * @param[in] raw_count Count like the read functions return it.
+ * @return uint32_t Conversion result at the supply voltage measured now, 0..BSP_ADC_MAX_RAW_COUNT.
+ */
+static uint32_t convert_bsp_adc_raw_count_to_conversion(uint16_t raw_count);
+#endif
+
+/**
+ * @brief Configures the current sense channel as the only injected channel.
+ * @note  The injected trigger is TIM1 TRGO with BSP_ADC_PWM_TRIGGER_ENABLED,
+ *        software otherwise.
+ */
+static void configure_current_sense_injected_adc_channel();
+
 /**
  * @brief Initializes the ADC peripheral with predefined settings.
  *
@@ -48,44 +222,73 @@ void init_bsp_adc()
     m_hadc1.Init.ClockPrescaler = ADC_CLOCK_SYNC_PCLK_DIV2;
     m_hadc1.Init.Resolution = ADC_RESOLUTION_12B;
     m_hadc1.Init.ScanConvMode = ENABLE;
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED) && (0U == BSP_ADC_PWM_TRIGGER_ENABLED)
+    m_hadc1.Init.ContinuousConvMode = ENABLE;
+#else
     m_hadc1.Init.ContinuousConvMode = DISABLE;
+#endif
     m_hadc1.Init.DiscontinuousConvMode = DISABLE;
+#if (0U != BSP_ADC_PWM_TRIGGER_ENABLED)
+    m_hadc1.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_RISING;
+    m_hadc1.Init.ExternalTrigConv = BSP_ADC_PWM_TRIGGER_SOURCE;
+#else
     m_hadc1.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_NONE;
     m_hadc1.Init.ExternalTrigConv = ADC_SOFTWARE_START;
+#endif
     m_hadc1.Init.DataAlign = ADC_DATAALIGN_RIGHT;
-    m_hadc1.Init.NbrOfConversion = 3U;
+    m_hadc1.Init.NbrOfConversion = BSP_ADC_SCAN_CHANNEL_CNT;
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+    m_hadc1.Init.DMAContinuousRequests = ENABLE;
+    m_hadc1.Init.EOCSelection = ADC_EOC_SEQ_CONV;
+#else
     m_hadc1.Init.DMAContinuousRequests = DISABLE;
     m_hadc1.Init.EOCSelection = ADC_EOC_SINGLE_CONV;
+#endif
     if (HAL_ADC_Init(&m_hadc1) != HAL_OK)
     {
     	report_init_error();
     }
 
+    configure_current_sense_injected_adc_channel();
+
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+    // the sequence is configured once, the read functions no longer touch it
+    configure_current_sense_adc_channel();
+    configure_voltage_sense_adc_channel();
+    configure_temperature_sense_adc_channel();
+    configure_input_voltage_sense_adc_channel();
+    configure_input_current_sense_adc_channel();
+#if (0U != BSP_ADC_SUPPLY_COMPENSATION_ENABLED)
+    configure_vrefint_adc_channel();
+    configure_mcu_temperature_adc_channel();
+    init_adc_supply_compensation();
+#endif
+
+    init_adc_scan_dma();
+    start_adc_scan();
+
+    HAL_NVIC_SetPriority(DMA2_Stream0_IRQn, BSP_ADC_DMA_IRQ_PRIORITY, 0U);
+    HAL_NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+#endif
 }
 
 /**
  * @brief Reads the ADC value from the current sense channel.
  *
- * @param[out] raw_value Pointer to store the ADC voltage value.
+ * @param[out] voltage_value_ptr Pointer to store the ADC voltage value.
  * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
  * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
  */
 bsp_adc_status_e read_current_sense_adc_value(float *voltage_value_ptr)
 {
-    bsp_adc_status_e read_status = BSP_ADC_STATE_ERROR_e;
-    configure_current_sense_adc_channel();
-    HAL_ADC_Start(&m_hadc1);
-    HAL_StatusTypeDef poll_state =
-        HAL_ADC_PollForConversion(&m_hadc1,5U);
+    uint16_t raw_count = 0U;
+    bsp_adc_status_e read_status = read_current_sense_adc_raw_count(&raw_count);
 
-    if(HAL_OK == poll_state)
+    if(BSP_ADC_STATE_OK_e == read_status)
     {
-    	*voltage_value_ptr = RAW_TO_VOLTAGE_FACTOR * HAL_ADC_GetValue(&m_hadc1);
-        read_status = BSP_ADC_STATE_OK_e;
+        *voltage_value_ptr = convert_bsp_adc_oversampled_count_to_voltage(raw_count);
     }
 
-    HAL_ADC_Stop(&m_hadc1);
-
     return read_status;
 }
 
@@ -98,20 +301,14 @@ bsp_adc_status_e read_current_sense_adc_value(float *voltage_value_ptr)
  */
 bsp_adc_status_e read_voltage_sense_adc_value(float *voltage_value_ptr)
 {
-    bsp_adc_status_e read_status = BSP_ADC_STATE_ERROR_e;
-    configure_voltage_sense_adc_channel();
-    HAL_ADC_Start(&m_hadc1);
-    HAL_StatusTypeDef poll_state =
-        HAL_ADC_PollForConversion(&m_hadc1,5U);
+    uint16_t raw_count = 0U;
+    bsp_adc_status_e read_status = read_voltage_sense_adc_raw_count(&raw_count);
 
-    if(HAL_OK == poll_state)
+    if(BSP_ADC_STATE_OK_e == read_status)
     {
-    	*voltage_value_ptr = RAW_TO_VOLTAGE_FACTOR * HAL_ADC_GetValue(&m_hadc1);
-        read_status = BSP_ADC_STATE_OK_e;
+        *voltage_value_ptr = convert_bsp_adc_oversampled_count_to_voltage(raw_count);
     }
 
-    HAL_ADC_Stop(&m_hadc1);
-
     return read_status;
 }
 
@@ -124,23 +321,480 @@ bsp_adc_status_e read_voltage_sense_adc_value(float *voltage_value_ptr)
  */
 bsp_adc_status_e read_temperature_sense_adc_value(float *voltage_value_ptr)
 {
-    bsp_adc_status_e read_status = BSP_ADC_STATE_ERROR_e;
-    configure_temperature_sense_adc_channel();
-    HAL_ADC_Start(&m_hadc1);
-    HAL_StatusTypeDef poll_state =
-        HAL_ADC_PollForConversion(&m_hadc1,5U);
+    uint16_t raw_count = 0U;
+    bsp_adc_status_e read_status = read_temperature_sense_adc_raw_count(&raw_count);
 
-    if(HAL_OK == poll_state)
+    if(BSP_ADC_STATE_OK_e == read_status)
     {
-    	*voltage_value_ptr = RAW_TO_VOLTAGE_FACTOR * HAL_ADC_GetValue(&m_hadc1);
-        read_status = BSP_ADC_STATE_OK_e;
+        *voltage_value_ptr = convert_bsp_adc_oversampled_count_to_voltage(raw_count);
     }
 
-    HAL_ADC_Stop(&m_hadc1);
+    return read_status;
+}
+
+/**
+ * @brief Reads the ADC value from the input voltage sense channel.
+ *
+ * @param[out] voltage_value_ptr Pointer to store the ADC voltage value.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+bsp_adc_status_e read_input_voltage_sense_adc_value(float *voltage_value_ptr)
+{
+    uint16_t raw_count = 0U;
+    bsp_adc_status_e read_status = read_input_voltage_sense_adc_raw_count(&raw_count);
+
+    if(BSP_ADC_STATE_OK_e == read_status)
+    {
+        *voltage_value_ptr = convert_bsp_adc_oversampled_count_to_voltage(raw_count);
+    }
+
+    return read_status;
+}
+
+/**
+ * @brief Reads the ADC value from the input current sense channel.
+ *
+ * @param[out] voltage_value_ptr Pointer to store the ADC voltage value.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+bsp_adc_status_e read_input_current_sense_adc_value(float *voltage_value_ptr)
+{
+    uint16_t raw_count = 0U;
+    bsp_adc_status_e read_status = read_input_current_sense_adc_raw_count(&raw_count);
+
+    if(BSP_ADC_STATE_OK_e == read_status)
+    {
+        *voltage_value_ptr = convert_bsp_adc_oversampled_count_to_voltage(raw_count);
+    }
 
     return read_status;
 }
 
+/**
+ * @brief Reads the conversion result of the current sense channel.
+ *
+ * @param[out] raw_count_ptr Pointer to store the raw count in 12.4 fixed point.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+bsp_adc_status_e read_current_sense_adc_raw_count(uint16_t *raw_count_ptr)
+{
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+    return read_scanned_adc_raw_count(ADC_CHANNEL_FIRST_RANK, raw_count_ptr);
+#else
+    configure_current_sense_adc_channel();
+    return read_polled_adc_raw_count(raw_count_ptr);
+#endif
+}
+
+/**
+ * @brief Reads the conversion result of the voltage sense channel.
+ *
+ * @param[out] raw_count_ptr Pointer to store the raw count in 12.4 fixed point.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+bsp_adc_status_e read_voltage_sense_adc_raw_count(uint16_t *raw_count_ptr)
+{
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+    return read_scanned_adc_raw_count(ADC_CHANNEL_SECOND_RANK, raw_count_ptr);
+#else
+    configure_voltage_sense_adc_channel();
+    return read_polled_adc_raw_count(raw_count_ptr);
+#endif
+}
+
+/**
+ * @brief Reads the conversion result of the temperature sense channel.
+ *
+ * @param[out] raw_count_ptr Pointer to store the raw count in 12.4 fixed point.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+bsp_adc_status_e read_temperature_sense_adc_raw_count(uint16_t *raw_count_ptr)
+{
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+    return read_scanned_adc_raw_count(ADC_CHANNEL_THIRD_RANK, raw_count_ptr);
+#else
+    configure_temperature_sense_adc_channel();
+    return read_polled_adc_raw_count(raw_count_ptr);
+#endif
+}
+
+/**
+ * @brief Reads the conversion result of the input voltage sense channel.
+ *
+ * @param[out] raw_count_ptr Pointer to store the raw count in 12.4 fixed point.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+bsp_adc_status_e read_input_voltage_sense_adc_raw_count(uint16_t *raw_count_ptr)
+{
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+    return read_scanned_adc_raw_count(ADC_CHANNEL_FOURTH_RANK, raw_count_ptr);
+#else
+    configure_input_voltage_sense_adc_channel();
+    return read_polled_adc_raw_count(raw_count_ptr);
+#endif
+}
+
+/**
+ * @brief Reads the conversion result of the input current sense channel.
+ *
+ * @param[out] raw_count_ptr Pointer to store the raw count in 12.4 fixed point.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+bsp_adc_status_e read_input_current_sense_adc_raw_count(uint16_t *raw_count_ptr)
+{
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+    return read_scanned_adc_raw_count(ADC_CHANNEL_FIFTH_RANK, raw_count_ptr);
+#else
+    configure_input_current_sense_adc_channel();
+    return read_polled_adc_raw_count(raw_count_ptr);
+#endif
+}
+
+/**
+ * @brief Makes the read functions return one scan sequence until release_adc_scan_sequence().
+ */
+void hold_adc_scan_sequence()
+{
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+    // copied, the DMA keeps writing the circular buffer during the hold
+    const volatile uint16_t *sequence_ptr =
+        &m_adc_scan_buffer[get_latest_scan_sequence_idx() * BSP_ADC_SCAN_CHANNEL_CNT];
+
+    for(uint32_t channel_idx = 0U; channel_idx < BSP_ADC_SCAN_CHANNEL_CNT; channel_idx++)
+    {
+        m_held_scan_sequence[channel_idx] = sequence_ptr[channel_idx];
+    }
+
+    m_is_scan_sequence_held = true;
+#endif
+}
+
+/**
+ * @brief Lets the read functions return the latest scan sequence again.
+ */
+void release_adc_scan_sequence()
+{
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+    m_is_scan_sequence_held = false;
+#endif
+}
+
+/**
+ * @brief Registers the receiver of the injected current sense conversions.
+ *
+ * @param[in] callback_func Receiver, NULL to unregister.
+ */
+void register_current_sense_injected_conversion_callback(adc_injected_conversion_cb_func_t callback_func)
+{
+    m_injected_conversion_cb_func = callback_func;
+}
+
+/**
+ * @brief Starts the injected conversions of the current sense channel.
+ *
+ * @retval BSP_ADC_STATE_OK_e if the conversions started.
+ * @retval BSP_ADC_STATE_ERROR_e if the ADC runs in polling mode or did not start.
+ */
+bsp_adc_status_e start_current_sense_injected_conversion()
+{
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+    HAL_NVIC_SetPriority(ADC_IRQn, BSP_ADC_IRQ_PRIORITY, 0U);
+    HAL_NVIC_EnableIRQ(ADC_IRQn);
+
+    if (HAL_ADCEx_InjectedStart_IT(&m_hadc1) != HAL_OK)
+    {
+        return BSP_ADC_STATE_ERROR_e;
+    }
+
+    return BSP_ADC_STATE_OK_e;
+#else
+    return BSP_ADC_STATE_ERROR_e;
+#endif
+}
+
+/**
+ * @brief Stops the injected conversion interrupt, the regular scan keeps running.
+ * @note  HAL_ADCEx_InjectedStop_IT() would refuse to stop while the regular
+ *        scan runs, so only the interrupt is disabled.
+ */
+void stop_current_sense_injected_conversion()
+{
+    __HAL_ADC_DISABLE_IT(&m_hadc1, ADC_IT_JEOC);
+}
+
+/**
+ * @brief Registers the receiver of the current sense watchdog trips.
+ *
+ * @param[in] callback_func Receiver, NULL to unregister.
+ */
+void register_current_sense_watchdog_callback(adc_watchdog_cb_func_t callback_func)
+{
+    m_watchdog_cb_func = callback_func;
+}
+
+/**
+ * @brief Starts the analog watchdog on the current sense channel.
+ *
+ * @param[in] high_threshold_raw_count Highest raw count without a trip, 12.4 fixed point.
+ * @retval BSP_ADC_STATE_OK_e if the watchdog is running.
+ * @retval BSP_ADC_STATE_ERROR_e if it is disabled or the ADC refused the configuration.
+ */
+bsp_adc_status_e start_current_sense_watchdog(uint16_t high_threshold_raw_count)
+{
+#if (0U != BSP_ADC_CURRENT_WATCHDOG_ENABLED)
+    ADC_AnalogWDGConfTypeDef watchdog_config = {0};
+    watchdog_config.WatchdogMode = ADC_ANALOGWATCHDOG_SINGLE_REG;
+    watchdog_config.Channel = ADC_CHANNEL_1;
+    watchdog_config.HighThreshold = convert_bsp_adc_raw_count_to_conversion(high_threshold_raw_count);
+    watchdog_config.LowThreshold = 0U;
+    watchdog_config.ITMode = ENABLE;
+
+    __HAL_ADC_CLEAR_FLAG(&m_hadc1, ADC_FLAG_AWD);
+
+    if (HAL_ADC_AnalogWDGConfig(&m_hadc1, &watchdog_config) != HAL_OK)
+    {
+        return BSP_ADC_STATE_ERROR_e;
+    }
+
+    HAL_NVIC_SetPriority(ADC_IRQn, BSP_ADC_IRQ_PRIORITY, 0U);
+    HAL_NVIC_EnableIRQ(ADC_IRQn);
+
+    return BSP_ADC_STATE_OK_e;
+#else
+    (void)high_threshold_raw_count;
+    return BSP_ADC_STATE_ERROR_e;
+#endif
+}
+
+/**
+ * @brief Stops the watchdog interrupt of the current sense channel.
+ */
+void stop_current_sense_watchdog()
+{
+    __HAL_ADC_DISABLE_IT(&m_hadc1, ADC_IT_AWD);
+}
+
+/**
+ * @brief Serves the ADC interrupt, called from ADC_IRQHandler().
+ */
+void handle_bsp_adc_interrupt()
+{
+    HAL_ADC_IRQHandler(&m_hadc1);
+}
+
+/**
+ * @brief Passes an injected conversion to the registered receiver.
+ *
+ * @param[in] hadc ADC handle of the interrupt.
+ */
+void HAL_ADCEx_InjectedConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    adc_injected_conversion_cb_func_t callback_func = m_injected_conversion_cb_func;
+
+    if((&m_hadc1 == hadc) && (NULL != callback_func))
+    {
+        callback_func(compensate_bsp_adc_raw_count(
+            HAL_ADCEx_InjectedGetValue(hadc, ADC_INJECTED_RANK_1) << BSP_ADC_OVERSAMPLING_SHIFT));
+    }
+}
+
+/**
+ * @brief Latches a current sense watchdog trip and passes it to the registered receiver.
+ *
+ * @param[in] hadc ADC handle of the interrupt.
+ */
+void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef *hadc)
+{
+    adc_watchdog_cb_func_t callback_func = m_watchdog_cb_func;
+
+    if(&m_hadc1 == hadc)
+    {
+        // every further conversion above the threshold would interrupt again
+        __HAL_ADC_DISABLE_IT(hadc, ADC_IT_AWD);
+
+        if(NULL != callback_func)
+        {
+            callback_func();
+        }
+    }
+}
+
+/**
+ * @brief Registers the receiver of the completed DMA scan blocks.
+ *
+ * @param[in] callback_func Receiver, NULL to unregister.
+ */
+void register_adc_scan_block_callback(adc_scan_block_cb_func_t callback_func)
+{
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+    m_scan_block_cb_func = callback_func;
+#else
+    (void)callback_func;
+#endif
+}
+
+/**
+ * @brief Serves the DMA interrupt of the scan, called from DMA2_Stream0_IRQHandler().
+ */
+void handle_bsp_adc_dma_interrupt()
+{
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+    HAL_DMA_IRQHandler(&m_hdma_adc1);
+#endif
+}
+
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+/**
+ * @brief Passes the first half of the scan buffer, the DMA fills the second.
+ *
+ * @param[in] hadc ADC handle of the DMA transfer.
+ */
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if(&m_hadc1 == hadc)
+    {
+        pass_adc_scan_block(0U);
+    }
+}
+
+/**
+ * @brief Passes the second half of the scan buffer, the DMA wrapped to the first.
+ *
+ * @param[in] hadc ADC handle of the DMA transfer.
+ */
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if(&m_hadc1 == hadc)
+    {
+        pass_adc_scan_block(1U);
+    }
+}
+
+/**
+ * @brief Keeps an overrun reported by the ADC interrupt for the next scan read.
+ *
+ * @param[in] hadc ADC handle of the interrupt.
+ */
+void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc)
+{
+    if(&m_hadc1 == hadc)
+    {
+        m_is_scan_overrun = true;
+    }
+}
+#endif
+
+/**
+ * @brief Scales a 12.4 fixed point count by the measured supply voltage.
+ *
+ * @param[in] raw_count Count in 12.4 fixed point.
+ * @return uint16_t Compensated count in 12.4 fixed point, saturated to 0xFFFF.
+ */
+uint16_t compensate_bsp_adc_raw_count(uint32_t raw_count)
+{
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED) && (0U != BSP_ADC_SUPPLY_COMPENSATION_ENABLED)
+	uint32_t compensated_count = (uint32_t)((((uint64_t)raw_count * m_supply_scale_q16) +
+		(ADC_SUPPLY_SCALE_ONE / 2U)) >> ADC_SUPPLY_SCALE_FRACTION_BITS);
+
+	return (compensated_count > UINT16_MAX) ? UINT16_MAX : (uint16_t)compensated_count;
+#else
+	return (raw_count > UINT16_MAX) ? UINT16_MAX : (uint16_t)raw_count;
+#endif
+}
+
+/**
+ * @brief Returns the analog supply voltage VDDA measured with VREFINT.
+ *
+ * @return float Filtered VDDA.
+ */
+float get_bsp_adc_supply_voltage()
+{
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED) && (0U != BSP_ADC_SUPPLY_COMPENSATION_ENABLED)
+	return (BSP_ADC_REFERENCE_VOLTAGE * m_supply_scale_q16) / ADC_SUPPLY_SCALE_ONE;
+#else
+	return BSP_ADC_REFERENCE_VOLTAGE;
+#endif
+}
+
+/**
+ * @brief Reads the die temperature of the MCU from its factory calibrated sensor.
+ *
+ * @param[out] temperature_ptr Pointer to store the temperature in degrees Celsius.
+ * @retval BSP_ADC_STATE_OK_e if a filtered count is available.
+ * @retval BSP_ADC_STATE_ERROR_e otherwise.
+ */
+bsp_adc_status_e read_mcu_temperature(float *temperature_ptr)
+{
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED) && (0U != BSP_ADC_SUPPLY_COMPENSATION_ENABLED)
+	int32_t cal1_count = (int32_t)*TEMPSENSOR_CAL1_ADDR;
+	int32_t cal2_count = (int32_t)*TEMPSENSOR_CAL2_ADDR;
+
+	if((0U == m_mcu_temperature_count_filter) || (cal1_count == cal2_count))
+	{
+		return BSP_ADC_STATE_ERROR_e;
+	}
+
+	// TS_CAL1 and TS_CAL2 are taken at VDDA = TEMPSENSOR_CAL_VREFANALOG
+	float sensor_count = (float)compensate_bsp_adc_raw_count(
+		m_mcu_temperature_count_filter >> BSP_ADC_SUPPLY_FILTER_SHIFT) / (1U << BSP_ADC_OVERSAMPLING_SHIFT);
+	sensor_count *= (BSP_ADC_REFERENCE_VOLTAGE * 1000.0f) / (float)TEMPSENSOR_CAL_VREFANALOG;
+
+	*temperature_ptr = (float)TEMPSENSOR_CAL1_TEMP +
+		(((sensor_count - (float)cal1_count) * (float)(TEMPSENSOR_CAL2_TEMP - TEMPSENSOR_CAL1_TEMP)) /
+		 (float)(cal2_count - cal1_count));
+
+	return BSP_ADC_STATE_OK_e;
+#else
+	(void)temperature_ptr;
+	return BSP_ADC_STATE_ERROR_e;
+#endif
+}
+
+/**
+ * @brief Converts a raw ADC conversion result to the voltage at the ADC pin.
+ *
+ * @param[in] raw_count Conversion result in counts (0..BSP_ADC_MAX_RAW_COUNT).
+ * @return float Voltage at the ADC pin.
+ */
+float convert_bsp_adc_raw_count_to_voltage(uint32_t raw_count)
+{
+	return RAW_TO_VOLTAGE_FACTOR * raw_count;
+}
+
+/**
+ * @brief Converts an oversampled count to the voltage at the ADC pin.
+ *
+ * @param[in] oversampled_count Raw count shifted left by BSP_ADC_OVERSAMPLING_SHIFT.
+ * @return float Voltage at the ADC pin.
+ */
+float convert_bsp_adc_oversampled_count_to_voltage(uint32_t oversampled_count)
+{
+	return (RAW_TO_VOLTAGE_FACTOR * oversampled_count) / (1U << BSP_ADC_OVERSAMPLING_SHIFT);
+}
+
+#if (0U != BSP_ADC_CURRENT_WATCHDOG_ENABLED)
+static uint32_t convert_bsp_adc_raw_count_to_conversion(uint16_t raw_count)
+{
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED) && (0U != BSP_ADC_SUPPLY_COMPENSATION_ENABLED)
+	uint32_t supply_scale_q16 = m_supply_scale_q16;
+	uint32_t oversampled_count = (uint32_t)((((uint64_t)raw_count << ADC_SUPPLY_SCALE_FRACTION_BITS) +
+		(supply_scale_q16 / 2U)) / supply_scale_q16);
+#else
+	uint32_t oversampled_count = raw_count;
+#endif
+	uint32_t conversion = (oversampled_count + (1UL << (BSP_ADC_OVERSAMPLING_SHIFT - 1U))) >> BSP_ADC_OVERSAMPLING_SHIFT;
+
+	return (conversion > BSP_ADC_MAX_RAW_COUNT) ? BSP_ADC_MAX_RAW_COUNT : conversion;
+}
+#endif
+
 /**
  * @brief Configures the ADC channel and sampling time for current sensing.
  * @note  Sets the rank and channel to ADC_CHANNEL_1 with a short sampling time.
@@ -195,3 +849,268 @@ static void configure_temperature_sense_adc_channel()
     }
 }
 
+/**
+ * @brief Configures the ADC channel and sampling time for input voltage sensing.
+ * @note  Sets the rank and channel to ADC_CHANNEL_4 (PA4) with the shortest sampling
+ *        time, enough for a source impedance up to 10 kOhm at 4 MHz, so the
+ *        sequence still fits in two switching periods.
+ */
+static void configure_input_voltage_sense_adc_channel()
+{
+    ADC_ChannelConfTypeDef sConfig = {0};
+    sConfig.Channel = ADC_CHANNEL_4;
+    sConfig.Rank = ADC_CHANNEL_FOURTH_RANK;
+    sConfig.SamplingTime = ADC_SAMPLETIME_3CYCLES;
+    if (HAL_ADC_ConfigChannel(&m_hadc1, &sConfig) != HAL_OK)
+    {
+        report_init_error();
+    }
+}
+
+/**
+ * @brief Configures the ADC channel and sampling time for input current sensing.
+ * @note  Sets the rank and channel to ADC_CHANNEL_5 (PA5) with the shortest sampling
+ *        time, the channel is driven by the opamp like the output current.
+ */
+static void configure_input_current_sense_adc_channel()
+{
+    ADC_ChannelConfTypeDef sConfig = {0};
+    sConfig.Channel = ADC_CHANNEL_5;
+    sConfig.Rank = ADC_CHANNEL_FIFTH_RANK;
+    sConfig.SamplingTime = ADC_SAMPLETIME_3CYCLES;
+    if (HAL_ADC_ConfigChannel(&m_hadc1, &sConfig) != HAL_OK)
+    {
+        report_init_error();
+    }
+}
+
+/**
+ * @brief Configures the current sense channel as the only injected channel.
+ * @note  Same sampling time as the regular current sense rank.
+ */
+static void configure_current_sense_injected_adc_channel()
+{
+    ADC_InjectionConfTypeDef sConfigInjected = {0};
+    sConfigInjected.InjectedChannel = ADC_CHANNEL_1;
+    sConfigInjected.InjectedRank = ADC_INJECTED_RANK_1;
+    sConfigInjected.InjectedNbrOfConversion = 1U;
+    sConfigInjected.InjectedSamplingTime = ADC_SAMPLETIME_15CYCLES;
+    sConfigInjected.InjectedOffset = 0U;
+    sConfigInjected.AutoInjectedConv = DISABLE;
+    sConfigInjected.InjectedDiscontinuousConvMode = DISABLE;
+#if (0U != BSP_ADC_PWM_TRIGGER_ENABLED)
+    sConfigInjected.ExternalTrigInjecConv = ADC_EXTERNALTRIGINJECCONV_T1_TRGO;
+    sConfigInjected.ExternalTrigInjecConvEdge = ADC_EXTERNALTRIGINJECCONVEDGE_RISING;
+#else
+    sConfigInjected.ExternalTrigInjecConv = ADC_INJECTED_SOFTWARE_START;
+    sConfigInjected.ExternalTrigInjecConvEdge = ADC_EXTERNALTRIGINJECCONVEDGE_NONE;
+#endif
+    if (HAL_ADCEx_InjectedConfigChannel(&m_hadc1, &sConfigInjected) != HAL_OK)
+    {
+        report_init_error();
+    }
+}
+
+
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+/**
+ * @brief Configures DMA2 Stream0 Channel0 for the ADC1 requests.
+ * @note  Peripheral to memory, one halfword per conversion, circular over both blocks.
+ */
+static void init_adc_scan_dma()
+{
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    m_hdma_adc1.Instance = DMA2_Stream0;
+    m_hdma_adc1.Init.Channel = DMA_CHANNEL_0;
+    m_hdma_adc1.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    m_hdma_adc1.Init.PeriphInc = DMA_PINC_DISABLE;
+    m_hdma_adc1.Init.MemInc = DMA_MINC_ENABLE;
+    m_hdma_adc1.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    m_hdma_adc1.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+    m_hdma_adc1.Init.Mode = DMA_CIRCULAR;
+    m_hdma_adc1.Init.Priority = DMA_PRIORITY_HIGH;
+    m_hdma_adc1.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&m_hdma_adc1) != HAL_OK)
+    {
+        report_init_error();
+    }
+
+    __HAL_LINKDMA(&m_hadc1, DMA_Handle, m_hdma_adc1);
+}
+
+/**
+ * @brief Starts the scan, the first sequence is converted within microseconds,
+ *        or at the first PWM trigger.
+ * @note  HAL_ADC_Start_DMA() enables the half and full transfer interrupts of
+ *        the DMA and the overrun interrupt of the ADC. The ADC line is enabled
+ *        by start_current_sense_injected_conversion(), from then on the
+ *        interrupt reports an overrun through HAL_ADC_ErrorCallback().
+ */
+static void start_adc_scan()
+{
+    m_is_scan_overrun = false;
+    m_is_scan_sequence_held = false;
+
+    if (HAL_ADC_Start_DMA(&m_hadc1, (uint32_t *)m_adc_scan_buffer, ADC_SCAN_BUFFER_LEN) != HAL_OK)
+    {
+        report_init_error();
+    }
+}
+
+static bsp_adc_status_e read_scanned_adc_raw_count(uint32_t rank, uint16_t *raw_count_ptr)
+{
+    if((true == m_is_scan_overrun) || (true == __HAL_ADC_GET_FLAG(&m_hadc1, ADC_FLAG_OVR)) ||
+       (0U == (m_hdma_adc1.Instance->CR & DMA_SxCR_EN)))
+    {
+        // an overrun stops the DMA requests, restart the sequence for the next read
+        HAL_ADC_Stop_DMA(&m_hadc1);
+        __HAL_ADC_CLEAR_FLAG(&m_hadc1, ADC_FLAG_OVR);
+        start_adc_scan();
+
+        return BSP_ADC_STATE_ERROR_e;
+    }
+
+    uint16_t raw_count = (true == m_is_scan_sequence_held) ? m_held_scan_sequence[rank - 1U] :
+        m_adc_scan_buffer[(get_latest_scan_sequence_idx() * BSP_ADC_SCAN_CHANNEL_CNT) + rank - 1U];
+
+    *raw_count_ptr = compensate_bsp_adc_raw_count((uint32_t)raw_count << BSP_ADC_OVERSAMPLING_SHIFT);
+
+    return BSP_ADC_STATE_OK_e;
+}
+
+static uint32_t get_latest_scan_sequence_idx()
+{
+    // NDTR counts down the conversions left until the DMA wraps to the start
+    uint32_t written_cnt = ADC_SCAN_BUFFER_LEN - m_hdma_adc1.Instance->NDTR;
+
+    return ((written_cnt / BSP_ADC_SCAN_CHANNEL_CNT) + ADC_SCAN_SEQUENCE_CNT - 1U) % ADC_SCAN_SEQUENCE_CNT;
+}
+
+static void pass_adc_scan_block(uint32_t block_idx)
+{
+    const volatile uint16_t *block_ptr =
+        &m_adc_scan_buffer[block_idx * BSP_ADC_SCAN_BLOCK_SEQUENCE_CNT * BSP_ADC_SCAN_CHANNEL_CNT];
+    adc_scan_block_cb_func_t callback_func = m_scan_block_cb_func;
+
+#if (0U != BSP_ADC_SUPPLY_COMPENSATION_ENABLED)
+    // the receiver compensates the block with the scale of its own VREFINT samples
+    update_adc_supply_compensation(block_ptr);
+#endif
+
+    if(NULL != callback_func)
+    {
+        callback_func(block_ptr, BSP_ADC_SCAN_BLOCK_SEQUENCE_CNT);
+    }
+}
+
+#if (0U != BSP_ADC_SUPPLY_COMPENSATION_ENABLED)
+static void init_adc_supply_compensation()
+{
+    // VDDA = VREFINT_CAL_VREF * VREFINT_CAL / VREFINT count, scale = VDDA / BSP_ADC_REFERENCE_VOLTAGE
+    double vrefint_cal_count = (double)(*VREFINT_CAL_ADDR) * (double)(1U << BSP_ADC_OVERSAMPLING_SHIFT) *
+                               ((double)VREFINT_CAL_VREF / (1000.0 * (double)BSP_ADC_REFERENCE_VOLTAGE));
+
+    m_vrefint_cal_count_q16 = (uint64_t)((vrefint_cal_count * (double)ADC_SUPPLY_SCALE_ONE) + 0.5);
+    m_vrefint_count_min = (uint32_t)((vrefint_cal_count * BSP_ADC_REFERENCE_VOLTAGE) / BSP_ADC_SUPPLY_VOLTAGE_MAX);
+    m_vrefint_count_max = (uint32_t)((vrefint_cal_count * BSP_ADC_REFERENCE_VOLTAGE) / BSP_ADC_SUPPLY_VOLTAGE_MIN);
+
+    m_supply_scale_q16 = ADC_SUPPLY_SCALE_ONE;
+    m_vrefint_count_filter = 0U;
+    m_mcu_temperature_count_filter = 0U;
+}
+
+static void update_adc_supply_compensation(const volatile uint16_t *block_ptr)
+{
+    uint32_t vrefint_count_sum = 0U;
+    uint32_t mcu_temperature_count_sum = 0U;
+
+    for(uint32_t sequence_idx = 0U; sequence_idx < BSP_ADC_SCAN_BLOCK_SEQUENCE_CNT; sequence_idx++)
+    {
+        vrefint_count_sum += block_ptr[(sequence_idx * BSP_ADC_SCAN_CHANNEL_CNT) + BSP_ADC_VREFINT_SCAN_IDX];
+        mcu_temperature_count_sum +=
+            block_ptr[(sequence_idx * BSP_ADC_SCAN_CHANNEL_CNT) + BSP_ADC_MCU_TEMPERATURE_SCAN_IDX];
+    }
+
+    // block averages in 12.4 fixed point
+    uint32_t vrefint_count = (vrefint_count_sum << BSP_ADC_OVERSAMPLING_SHIFT) / BSP_ADC_SCAN_BLOCK_SEQUENCE_CNT;
+    uint32_t mcu_temperature_count =
+        (mcu_temperature_count_sum << BSP_ADC_OVERSAMPLING_SHIFT) / BSP_ADC_SCAN_BLOCK_SEQUENCE_CNT;
+
+    if((vrefint_count < m_vrefint_count_min) || (vrefint_count > m_vrefint_count_max))
+    {
+        // VREFINT not converted yet or VDDA out of its range, keep the last scale
+        return;
+    }
+
+    uint32_t vrefint_count_filter = m_vrefint_count_filter;
+    uint32_t mcu_temperature_count_filter = m_mcu_temperature_count_filter;
+
+    if(0U == vrefint_count_filter)
+    {
+        vrefint_count_filter = vrefint_count << BSP_ADC_SUPPLY_FILTER_SHIFT;
+        mcu_temperature_count_filter = mcu_temperature_count << BSP_ADC_SUPPLY_FILTER_SHIFT;
+    }
+    else
+    {
+        vrefint_count_filter += vrefint_count - (vrefint_count_filter >> BSP_ADC_SUPPLY_FILTER_SHIFT);
+        mcu_temperature_count_filter +=
+            mcu_temperature_count - (mcu_temperature_count_filter >> BSP_ADC_SUPPLY_FILTER_SHIFT);
+    }
+
+    m_vrefint_count_filter = vrefint_count_filter;
+    m_mcu_temperature_count_filter = mcu_temperature_count_filter;
+    m_supply_scale_q16 = (uint32_t)(m_vrefint_cal_count_q16 / (vrefint_count_filter >> BSP_ADC_SUPPLY_FILTER_SHIFT));
+}
+
+/**
+ * @brief Configures VREFINT on rank 6, HAL_ADC_ConfigChannel() sets TSVREFE.
+ * @note  The datasheet asks for at least 10 us of sampling, 14 us at 4 MHz.
+ */
+static void configure_vrefint_adc_channel()
+{
+    ADC_ChannelConfTypeDef sConfig = {0};
+    sConfig.Channel = ADC_CHANNEL_VREFINT;
+    sConfig.Rank = ADC_CHANNEL_SIXTH_RANK;
+    sConfig.SamplingTime = ADC_SAMPLETIME_56CYCLES;
+    if (HAL_ADC_ConfigChannel(&m_hadc1, &sConfig) != HAL_OK)
+    {
+        report_init_error();
+    }
+}
+
+/**
+ * @brief Configures the MCU temperature sensor on rank 7.
+ * @note  The datasheet asks for at least 10 us of sampling, 14 us at 4 MHz.
+ */
+static void configure_mcu_temperature_adc_channel()
+{
+    ADC_ChannelConfTypeDef sConfig = {0};
+    sConfig.Channel = ADC_CHANNEL_TEMPSENSOR;
+    sConfig.Rank = ADC_CHANNEL_SEVENTH_RANK;
+    sConfig.SamplingTime = ADC_SAMPLETIME_56CYCLES;
+    if (HAL_ADC_ConfigChannel(&m_hadc1, &sConfig) != HAL_OK)
+    {
+        report_init_error();
+    }
+}
+#endif
+#else
+static bsp_adc_status_e read_polled_adc_raw_count(uint16_t *raw_count_ptr)
+{
+    bsp_adc_status_e read_status = BSP_ADC_STATE_ERROR_e;
+    HAL_ADC_Start(&m_hadc1);
+    HAL_StatusTypeDef poll_state =
+        HAL_ADC_PollForConversion(&m_hadc1,5U);
+
+    if(HAL_OK == poll_state)
+    {
+        *raw_count_ptr = (uint16_t)(HAL_ADC_GetValue(&m_hadc1) << BSP_ADC_OVERSAMPLING_SHIFT);
+        read_status = BSP_ADC_STATE_OK_e;
+    }
+
+    HAL_ADC_Stop(&m_hadc1);
+
+    return read_status;
+}
+#endif
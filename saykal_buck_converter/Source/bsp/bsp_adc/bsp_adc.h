@@ -12,18 +12,185 @@
 #include "stm32f4xx_hal.h"
 
 
+/** @brief Largest conversion result of the 12-bit ADC. */
+#define BSP_ADC_MAX_RAW_COUNT	4095U
+
+/** @brief Pin voltage of BSP_ADC_MAX_RAW_COUNT, VREF+ of the board. */
+#define BSP_ADC_REFERENCE_VOLTAGE	3.3f
+
+/** @brief Fraction bits of an oversampled count, a 12.4 fixed point raw count. */
+#define BSP_ADC_OVERSAMPLING_SHIFT		4U
+
+/** @brief Resolution of an oversampled count. */
+#define BSP_ADC_OVERSAMPLED_COUNT_BITS	16U
+
+/** @brief Position of each channel in a sequence of a scan block. */
+#define BSP_ADC_CURRENT_SENSE_SCAN_IDX		0U
+#define BSP_ADC_VOLTAGE_SENSE_SCAN_IDX		1U
+#define BSP_ADC_TEMPERATURE_SENSE_SCAN_IDX	2U
+#define BSP_ADC_INPUT_VOLTAGE_SENSE_SCAN_IDX	3U
+#define BSP_ADC_INPUT_CURRENT_SENSE_SCAN_IDX	4U
+#define BSP_ADC_VREFINT_SCAN_IDX			5U
+#define BSP_ADC_MCU_TEMPERATURE_SCAN_IDX	6U
+
+/**
+ * @brief Selects how the read functions acquire the sensor channels.
+ *
+ * @details 1U: ADC1 scans channels 1/2/3/4/5 repeatedly and DMA2 Stream0 copies
+ * every conversion into a RAM buffer in circular mode. The buffer holds two
+ * blocks of BSP_ADC_SCAN_BLOCK_SEQUENCE_CNT sequences; the DMA half and full
+ * transfer interrupts pass every completed block to the scan block callback
+ * while the DMA fills the other one. A read returns the latest complete
+ * sequence of its channel in constant time and never blocks. The ADC
+ * interrupt only runs once the injected conversions or the current sense
+ * watchdog are started.
+ * A read reports BSP_ADC_STATE_ERROR_e and restarts the scan if the ADC
+ * overran or the DMA stream stopped.
+ *
+ * 0U (default): every read configures its channel, starts one conversion and polls for
+ * it with a 5 ms timeout.
+ */
+#ifndef BSP_ADC_DMA_SCAN_ENABLED
+#define BSP_ADC_DMA_SCAN_ENABLED	0U
+#endif
+
+/**
+ * @brief Selects what starts the conversions.
+ *
+ * @details 1U: the regular sequence starts on the rising edge of
+ * BSP_ADC_PWM_TRIGGER_SOURCE, the compare channel bsp_pwm places in the middle
+ * of the on or off time of the buck MOSFET (bsp_pwm_adc_trigger_config_t).
+ * Every sample is taken at the same point of the switching period, where the
+ * triangular ripple crosses its average. With the DMA scan the sequence is
+ * converted once per trigger instead of back to back. The sequence takes
+ * 249 ADC clocks (62 us at 4 MHz), 385 ADC clocks (96 us) with
+ * BSP_ADC_SUPPLY_COMPENSATION_ENABLED, longer than the 50 us switching period,
+ * and a trigger during a conversion is ignored, so every second period is sampled.
+ * Without the DMA scan a read waits up to one switching period for the trigger.
+ * No conversion happens before init_bsp_pwm() started the trigger channel.
+ *
+ * 0U (default): conversions are started by software.
+ */
+#ifndef BSP_ADC_PWM_TRIGGER_ENABLED
+#define BSP_ADC_PWM_TRIGGER_ENABLED	0U
+#endif
+
+/**
+ * @brief Selects whether the conversions are corrected for the actual VDDA.
+ *
+ * @details 1U: the DMA scan converts the internal reference VREFINT and the MCU
+ * temperature sensor after the sensor channels. Every completed block moves a
+ * filtered VREFINT count towards the block average and derives the supply scale
+ * from it and the factory calibration VREFINT_CAL, taken at VDDA = 3.3 V. The
+ * raw counts of the read functions and of compensate_bsp_adc_raw_count() are
+ * multiplied by this scale, so they are the counts of an ADC referenced to
+ * exactly BSP_ADC_REFERENCE_VOLTAGE. The scale is updated in the DMA interrupt,
+ * a read only multiplies by it. Both internal channels need 10 us of sampling
+ * time. Needs BSP_ADC_DMA_SCAN_ENABLED, the polling reads keep the nominal
+ * reference.
+ *
+ * 0U (default): counts are referenced to BSP_ADC_REFERENCE_VOLTAGE as converted.
+ */
+#ifndef BSP_ADC_SUPPLY_COMPENSATION_ENABLED
+#define BSP_ADC_SUPPLY_COMPENSATION_ENABLED	0U
+#endif
+
+/** @brief Each block moves the filtered VREFINT count by 1/2^shift of its distance to the block average. */
+#ifndef BSP_ADC_SUPPLY_FILTER_SHIFT
+#define BSP_ADC_SUPPLY_FILTER_SHIFT	4U
+#endif
+
+/** @brief VDDA range of the STM32F407, a VREFINT average outside it leaves the scale unchanged. */
+#define BSP_ADC_SUPPLY_VOLTAGE_MIN	1.8f
+#define BSP_ADC_SUPPLY_VOLTAGE_MAX	3.6f
+
+/** @brief Number of channels in the regular sequence. */
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED) && (0U != BSP_ADC_SUPPLY_COMPENSATION_ENABLED)
+#define BSP_ADC_SCAN_CHANNEL_CNT			7U
+#else
+#define BSP_ADC_SCAN_CHANNEL_CNT			5U
+#endif
+
+/**
+ * @brief Selects whether the ADC1 analog watchdog guards the current sense channel.
+ *
+ * @details 1U: start_current_sense_watchdog() programs the analog watchdog on
+ * the regular conversions of the current sense channel. A conversion above the
+ * threshold raises the ADC interrupt, which calls the registered callback
+ * within one conversion, at the latest one scan sequence (100 us with the PWM
+ * trigger) after the current crossed the threshold. The watchdog flags every
+ * conversion above the threshold, so the interrupt disables itself before the
+ * callback: a trip is latched until the watchdog is started again.
+ *
+ * 0U (default): start_current_sense_watchdog() fails, only the software overcurrent monitor protects.
+ */
+#ifndef BSP_ADC_CURRENT_WATCHDOG_ENABLED
+#define BSP_ADC_CURRENT_WATCHDOG_ENABLED	0U
+#endif
+
+/** @brief External trigger of the regular sequence, the trigger_timer_channel of bsp_pwm. */
+#ifndef BSP_ADC_PWM_TRIGGER_SOURCE
+#define BSP_ADC_PWM_TRIGGER_SOURCE	ADC_EXTERNALTRIGCONV_T1_CC2
+#endif
+
+/** @brief NVIC preemption priority of the ADC interrupt, above SysTick (TICK_INT_PRIORITY 15). */
+#ifndef BSP_ADC_IRQ_PRIORITY
+#define BSP_ADC_IRQ_PRIORITY	0U
+#endif
+
+/**
+ * @brief Scan sequences per DMA half buffer, passed to the scan block callback at once.
+ *
+ * @details With the PWM trigger a sequence is converted every 100 us, so a
+ * block of 8 interrupts every 0.8 ms instead of once per conversion.
+ */
+#ifndef BSP_ADC_SCAN_BLOCK_SEQUENCE_CNT
+#define BSP_ADC_SCAN_BLOCK_SEQUENCE_CNT	8U
+#endif
+
+/** @brief NVIC preemption priority of the DMA interrupt, below the injected current sense. */
+#ifndef BSP_ADC_DMA_IRQ_PRIORITY
+#define BSP_ADC_DMA_IRQ_PRIORITY	1U
+#endif
+
 typedef enum{
     BSP_ADC_STATE_OK_e,
     BSP_ADC_STATE_ERROR_e,
 
 }bsp_adc_status_e;
 
+/**
+ * @brief Receives an injected current sense conversion, runs in the ADC interrupt.
+ *
+ * @param[in] raw_count Conversion result in 12.4 fixed point, compensated like
+ *                      compensate_bsp_adc_raw_count(), so it converts with the
+ *                      raw count functions of the sensor driver without a float.
+ */
+typedef void (*adc_injected_conversion_cb_func_t)(uint16_t raw_count);
+
+/**
+ * @brief Receives a trip of the current sense watchdog, runs in the ADC interrupt.
+ */
+typedef void (*adc_watchdog_cb_func_t)(void);
+
+/**
+ * @brief Receives a completed block of the DMA scan, runs in the DMA interrupt.
+ *
+ * @param[in] block_ptr    Raw counts of sequence_cnt sequences, the count of
+ *                         channel BSP_ADC_xxx_SCAN_IDX of sequence n is
+ *                         block_ptr[n * BSP_ADC_SCAN_CHANNEL_CNT + BSP_ADC_xxx_SCAN_IDX].
+ *                         The DMA overwrites the block after the next block completed.
+ * @param[in] sequence_cnt Number of sequences in the block, oldest first.
+ */
+typedef void (*adc_scan_block_cb_func_t)(const volatile uint16_t *block_ptr, uint32_t sequence_cnt);
+
 
 /**
  * @brief Initializes the ADC peripheral with predefined settings.
  *
  * This function configures ADC1 for multi-channel operation with 12-bit resolution
  * and sets various parameters such as scan mode, trigger source, and number of conversions.
+ * With BSP_ADC_DMA_SCAN_ENABLED it also configures the DMA and starts the scan.
  * 
  * @retval None
  */
@@ -56,4 +223,214 @@ bsp_adc_status_e read_voltage_sense_adc_value(float *voltage_value_ptr);
  */
 bsp_adc_status_e read_temperature_sense_adc_value(float *voltage_value_ptr);
 
+/**
+ * @brief Reads the ADC value from the input voltage sense channel.
+ *
+ * @param[out] voltage_value_ptr Pointer to store the ADC voltage value.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+bsp_adc_status_e read_input_voltage_sense_adc_value(float *voltage_value_ptr);
+
+/**
+ * @brief Reads the ADC value from the input current sense channel.
+ *
+ * @param[out] voltage_value_ptr Pointer to store the ADC voltage value.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+bsp_adc_status_e read_input_current_sense_adc_value(float *voltage_value_ptr);
+
+/**
+ * @brief Reads the conversion result of the current sense channel.
+ *
+ * The raw count functions return the conversion result shifted left by
+ * BSP_ADC_OVERSAMPLING_SHIFT, the 12.4 fixed point scale of the oversampled
+ * values, so raw and oversampled counts convert with the same coefficients.
+ * They read the same conversion as the voltage functions.
+ *
+ * @param[out] raw_count_ptr Pointer to store the raw count in 12.4 fixed point.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+bsp_adc_status_e read_current_sense_adc_raw_count(uint16_t *raw_count_ptr);
+
+/**
+ * @brief Reads the conversion result of the voltage sense channel.
+ *
+ * @param[out] raw_count_ptr Pointer to store the raw count in 12.4 fixed point.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+bsp_adc_status_e read_voltage_sense_adc_raw_count(uint16_t *raw_count_ptr);
+
+/**
+ * @brief Reads the conversion result of the temperature sense channel.
+ *
+ * @param[out] raw_count_ptr Pointer to store the raw count in 12.4 fixed point.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+bsp_adc_status_e read_temperature_sense_adc_raw_count(uint16_t *raw_count_ptr);
+
+/**
+ * @brief Reads the conversion result of the input voltage sense channel.
+ *
+ * @param[out] raw_count_ptr Pointer to store the raw count in 12.4 fixed point.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+bsp_adc_status_e read_input_voltage_sense_adc_raw_count(uint16_t *raw_count_ptr);
+
+/**
+ * @brief Reads the conversion result of the input current sense channel.
+ *
+ * @param[out] raw_count_ptr Pointer to store the raw count in 12.4 fixed point.
+ * @retval BSP_ADC_STATE_OK_e if the conversion is successful.
+ * @retval BSP_ADC_STATE_ERROR_e if the conversion fails.
+ */
+bsp_adc_status_e read_input_current_sense_adc_raw_count(uint16_t *raw_count_ptr);
+
+/**
+ * @brief Makes the read functions return one scan sequence until release_adc_scan_sequence().
+ *
+ * Copies the latest complete sequence of the DMA scan, so channels read one
+ * after another come from the same conversion sequence however long the reads
+ * take. Called with interrupts masked, the copy belongs to the same instant as
+ * the state of the DMA interrupt read in that section. A scan restart after an
+ * error ends the hold. Without BSP_ADC_DMA_SCAN_ENABLED it does nothing.
+ */
+void hold_adc_scan_sequence();
+
+/**
+ * @brief Lets the read functions return the latest scan sequence again.
+ */
+void release_adc_scan_sequence();
+
+/**
+ * @brief Registers the receiver of the injected current sense conversions.
+ *
+ * @param[in] callback_func Receiver, NULL to unregister.
+ */
+void register_current_sense_injected_conversion_callback(adc_injected_conversion_cb_func_t callback_func);
+
+/**
+ * @brief Starts the injected conversions of the current sense channel.
+ *
+ * The current channel is also the only injected channel. An injected trigger
+ * interrupts a running regular conversion, converts the injected channel and
+ * then restarts the interrupted regular conversion, so the sample reaches the
+ * callback 27 ADC clocks (6.75 us) after the trigger even while the temperature
+ * channel is converting. With BSP_ADC_PWM_TRIGGER_ENABLED the injected group is
+ * started by TIM1 TRGO, the same point of the switching period as the regular
+ * scan, and converts on every period; otherwise one conversion is started by
+ * software and the interrupt is disabled after it.
+ *
+ * @retval BSP_ADC_STATE_OK_e if the conversions started.
+ * @retval BSP_ADC_STATE_ERROR_e without BSP_ADC_DMA_SCAN_ENABLED, the polling
+ *         reads switch the ADC off after every conversion.
+ */
+bsp_adc_status_e start_current_sense_injected_conversion();
+
+/**
+ * @brief Stops the injected conversion interrupt, the regular scan keeps running.
+ */
+void stop_current_sense_injected_conversion();
+
+/**
+ * @brief Registers the receiver of the current sense watchdog trips.
+ *
+ * @param[in] callback_func Receiver, NULL to unregister.
+ */
+void register_current_sense_watchdog_callback(adc_watchdog_cb_func_t callback_func);
+
+/**
+ * @brief Starts the analog watchdog on the current sense channel.
+ *
+ * The threshold is given like the raw counts of the read functions and is
+ * converted back to a conversion result with the supply voltage measured now,
+ * see BSP_ADC_CURRENT_WATCHDOG_ENABLED. Works with the DMA scan and with the
+ * polling reads, which convert the current sense channel on every read.
+ *
+ * @param[in] high_threshold_raw_count Highest raw count without a trip, 12.4 fixed point.
+ * @retval BSP_ADC_STATE_OK_e if the watchdog is running.
+ * @retval BSP_ADC_STATE_ERROR_e without BSP_ADC_CURRENT_WATCHDOG_ENABLED or if the ADC refused the configuration.
+ */
+bsp_adc_status_e start_current_sense_watchdog(uint16_t high_threshold_raw_count);
+
+/**
+ * @brief Stops the watchdog interrupt of the current sense channel.
+ */
+void stop_current_sense_watchdog();
+
+/**
+ * @brief Serves the ADC interrupt, called from ADC_IRQHandler().
+ */
+void handle_bsp_adc_interrupt();
+
+/**
+ * @brief Registers the receiver of the completed DMA scan blocks.
+ *
+ * @param[in] callback_func Receiver, NULL to unregister.
+ */
+void register_adc_scan_block_callback(adc_scan_block_cb_func_t callback_func);
+
+/**
+ * @brief Serves the DMA interrupt of the scan, called from DMA2_Stream0_IRQHandler().
+ */
+void handle_bsp_adc_dma_interrupt();
+
+/**
+ * @brief Scales a 12.4 fixed point count by the measured supply voltage.
+ *
+ * Converts a count of the DMA scan buffer to the count of an ADC referenced to
+ * exactly BSP_ADC_REFERENCE_VOLTAGE, one 32 x 32 bit multiply. Before the first
+ * VREFINT average and without BSP_ADC_SUPPLY_COMPENSATION_ENABLED the count is
+ * returned unchanged. The read functions return compensated counts already.
+ *
+ * @param[in] raw_count Count in 12.4 fixed point.
+ * @return uint16_t Compensated count in 12.4 fixed point, saturated to 0xFFFF.
+ */
+uint16_t compensate_bsp_adc_raw_count(uint32_t raw_count);
+
+/**
+ * @brief Returns the analog supply voltage VDDA measured with VREFINT.
+ *
+ * @return float Filtered VDDA, BSP_ADC_REFERENCE_VOLTAGE before the first
+ *         VREFINT average and without BSP_ADC_SUPPLY_COMPENSATION_ENABLED.
+ */
+float get_bsp_adc_supply_voltage();
+
+/**
+ * @brief Reads the die temperature of the MCU from its factory calibrated sensor.
+ *
+ * The filtered sensor count is compensated for VDDA and interpolated between
+ * the calibration points TS_CAL1 (30 C) and TS_CAL2 (110 C).
+ *
+ * @param[out] temperature_ptr Pointer to store the temperature in degrees Celsius.
+ * @retval BSP_ADC_STATE_OK_e if a filtered count is available.
+ * @retval BSP_ADC_STATE_ERROR_e before the first block of the scan and without
+ *         BSP_ADC_SUPPLY_COMPENSATION_ENABLED.
+ */
+bsp_adc_status_e read_mcu_temperature(float *temperature_ptr);
+
+/**
+ * @brief Converts a raw ADC conversion result to the voltage at the ADC pin.
+ *
+ * The read functions convert 12.4 fixed point counts with
+ * convert_bsp_adc_oversampled_count_to_voltage() instead.
+ *
+ * @param[in] raw_count Conversion result in counts (0..BSP_ADC_MAX_RAW_COUNT).
+ * @return float Voltage at the ADC pin.
+ */
+float convert_bsp_adc_raw_count_to_voltage(uint32_t raw_count);
+
+/**
+ * @brief Converts an oversampled count to the voltage at the ADC pin.
+ *
+ * @param[in] oversampled_count Raw count shifted left by BSP_ADC_OVERSAMPLING_SHIFT.
+ * @return float Voltage at the ADC pin.
+ */
+float convert_bsp_adc_oversampled_count_to_voltage(uint32_t oversampled_count);
+
 #endif /* BSP_ADC_H_ */
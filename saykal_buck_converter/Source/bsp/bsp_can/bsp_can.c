@@ -38,13 +38,9 @@ static uint32_t m_mailbox = 0U;
  * @param[in]  message_id             Message identifier to search for.
  * @param[out] tx_message_cfg_ptr     Pointer to store found message configuration.
  * @return true if message is found, false otherwise.
- *
- * @note The current function does not return the pointer correctly
- * because `tx_message_cfg_ptr` is passed by value. Consider changing
- * to `can_tx_message_cfg_t **` for proper use.
  */
 static bool find_message_id_from_config(uint16_t message_id,
-										const can_tx_message_cfg_t *tx_message_cfg_ptr);
+										const can_tx_message_cfg_t **tx_message_cfg_ptr);
 
 /**
  * @brief Initializes the CAN hardware with given configuration.
@@ -105,9 +101,9 @@ void send_message_over_canbus(uint16_t message_id,
 							  uint8_t *message_data_ptr ,
 							  uint16_t data_len)
 {
-	can_tx_message_cfg_t *tx_message_cfg_ptr = NULL;
+	const can_tx_message_cfg_t *tx_message_cfg_ptr = NULL;
 
-	bool is_msg_found = find_message_id_from_config(message_id,tx_message_cfg_ptr);
+	bool is_msg_found = find_message_id_from_config(message_id,&tx_message_cfg_ptr);
 
 	if(false == is_msg_found)
 	{
@@ -146,13 +142,9 @@ void send_message_over_canbus(uint16_t message_id,
  * @param[in]  message_id             Message identifier to search for.
  * @param[out] tx_message_cfg_ptr     Pointer to store found message configuration.
  * @return true if message is found, false otherwise.
- *
- * @note The current function does not return the pointer correctly
- * because `tx_message_cfg_ptr` is passed by value. Consider changing
- * to `can_tx_message_cfg_t **` for proper use.
  */
 static bool find_message_id_from_config(uint16_t message_id,
-										const can_tx_message_cfg_t *tx_message_cfg_ptr)
+										const can_tx_message_cfg_t **tx_message_cfg_ptr)
 {
 	bool is_message_found = false;
 
@@ -167,7 +159,7 @@ static bool find_message_id_from_config(uint16_t message_id,
 		{
 			is_message_found = true;
 
-			tx_message_cfg_ptr =
+			*tx_message_cfg_ptr =
 				&m_bsp_can_config_ptr->tx_messages_ptr[tx_can_cfg_idx];
 		}
 	}
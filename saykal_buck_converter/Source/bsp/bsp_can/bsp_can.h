@@ -10,6 +10,7 @@
 
 #include "stdint.h"
 #include "stm32f4xx_hal.h"
+#include "bsp_can_cfg.h"
 
 /**
  * @brief Defines the type of CAN Identifier format.
@@ -0,0 +1,26 @@
+/**
+ * @file bsp_cycle_counter.c
+ * @brief Free running core cycle counter (DWT CYCCNT of the Cortex-M4).
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "bsp_cycle_counter.h"
+#include "stm32f4xx_hal.h"
+
+void init_bsp_cycle_counter(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0U;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t get_bsp_cycle_count(void)
+{
+	return DWT->CYCCNT;
+}
+
+uint32_t get_bsp_cycle_counter_frequency_hz(void)
+{
+	return HAL_RCC_GetHCLKFreq();
+}
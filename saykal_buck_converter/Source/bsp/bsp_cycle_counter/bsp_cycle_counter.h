@@ -0,0 +1,35 @@
+/**
+ * @file bsp_cycle_counter.h
+ * @brief Free running core cycle counter (DWT CYCCNT of the Cortex-M4).
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef BSP_CYCLE_COUNTER_H_
+#define BSP_CYCLE_COUNTER_H_
+
+#include "stdint.h"
+
+/**
+ * @brief Enables the trace unit and starts the DWT cycle counter from zero.
+ */
+void init_bsp_cycle_counter(void);
+
+/**
+ * @brief Returns the current value of the cycle counter.
+ *
+ * The counter wraps around every 2^32 cycles; the unsigned difference of two
+ * readings is the elapsed cycle count as long as less than one wrap passed.
+ *
+ * @return uint32_t Core clock cycles since init_bsp_cycle_counter().
+ */
+uint32_t get_bsp_cycle_count(void);
+
+/**
+ * @brief Returns the frequency the cycle counter runs at.
+ *
+ * @return uint32_t Core clock (HCLK) frequency in Hz.
+ */
+uint32_t get_bsp_cycle_counter_frequency_hz(void);
+
+#endif /* BSP_CYCLE_COUNTER_H_ */
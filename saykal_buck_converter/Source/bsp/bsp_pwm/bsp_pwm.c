@@ -60,6 +60,31 @@ static void set_capture_compare_register_of_pwm_channel(uint8_t timer_config_idx
  */
 static void init_timer_pwm_channels(uint8_t timer_idx_of_pwm_channels);
 
+/**
+ * @brief Returns the TRGO source that follows the ADC trigger channel of a timer.
+ * 
+ * @param[in] timer_config_idx Timer index.
+ * @return TIM_TRGO_OCxREF of the trigger channel, TIM_TRGO_RESET without an ADC trigger.
+ */
+static uint32_t get_adc_trigger_output_of_timer(uint8_t timer_config_idx);
+
+/**
+ * @brief Configures and starts the compare channel that triggers the ADC.
+ * @note  Starting the channel also starts the counter, so the ADC is triggered
+ *        while the PWM outputs are stopped.
+ * 
+ * @param[in] timer_config_idx Timer index.
+ */
+static void init_adc_trigger_channel(uint8_t timer_config_idx);
+
+/**
+ * @brief Moves the ADC trigger of a timer to the middle of the on or off time.
+ * 
+ * @param[in] timer_config_idx Timer index.
+ * @param[in] on_time_counts CCR value of the reference PWM channel.
+ */
+static void update_adc_trigger_point(uint8_t timer_config_idx, uint32_t on_time_counts);
+
 /**
  * @brief Initializes all configured PWM timers and GPIOs.
  * 
@@ -98,7 +123,7 @@ void init_bsp_pwm(const bsp_pwm_config_t *bsp_pwm_configs_ptr)
 	  {
 	    report_init_error(); // TODO: gerçek error handler ekle
 	  }
-	  sMasterConfig.MasterOutputTrigger = TIM_TRGO_RESET;
+	  sMasterConfig.MasterOutputTrigger = get_adc_trigger_output_of_timer(pwm_timer_idx);
 	  sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
 	  if (HAL_TIMEx_MasterConfigSynchronization(&m_htim[pwm_timer_idx], &sMasterConfig) != HAL_OK)
 	  {
@@ -106,6 +131,7 @@ void init_bsp_pwm(const bsp_pwm_config_t *bsp_pwm_configs_ptr)
 	  }
 
 	  init_timer_pwm_channels(pwm_timer_idx);
+	  init_adc_trigger_channel(pwm_timer_idx);
 	  
 	  sBreakDeadTimeConfig.OffStateRunMode = TIM_OSSR_DISABLE;
 	  sBreakDeadTimeConfig.OffStateIDLEMode = TIM_OSSI_DISABLE;
@@ -194,6 +220,8 @@ void stop_pwm_channel(bsp_pwm_channel_idx_t bsp_pwm_channel)
  * 
  * @param[in] bsp_pwm_channel PWM channel to set.
  * @param[in] duty_rate Duty cycle to set (range: 0.0 to 1.0).
+ * @note  The CCR of the ADC trigger channel is written right after the duty,
+ *        both are preloaded and take effect on the same update event.
  */
 void set_pwm_duty(bsp_pwm_channel_idx_t bsp_pwm_channel, 
 				  float duty_rate)
@@ -230,6 +258,12 @@ void set_pwm_duty(bsp_pwm_channel_idx_t bsp_pwm_channel,
 		set_capture_compare_register_of_pwm_channel(timer_config_idx,
 													timer_channel_id,
 													calculated_pwm_value);
+
+		if(bsp_pwm_channel == m_last_bsp_pwm_config_ptr[timer_config_idx].
+			adc_trigger_config.reference_pwm_channel_id)
+		{
+			update_adc_trigger_point(timer_config_idx, calculated_pwm_value);
+		}
 	}
 	else
 	{
@@ -323,3 +357,121 @@ static void init_timer_pwm_channels(uint8_t timer_idx_of_pwm_channels)
 		}
 	}
 }
+
+static uint32_t get_adc_trigger_output_of_timer(uint8_t timer_config_idx)
+{
+	const bsp_pwm_adc_trigger_config_t *trigger_config_ptr =
+		&m_last_bsp_pwm_config_ptr[timer_config_idx].adc_trigger_config;
+
+	if(BSP_PWM_ADC_TRIGGER_NONE_e == trigger_config_ptr->trigger_point)
+	{
+		return TIM_TRGO_RESET;
+	}
+
+	uint32_t trigger_output = TIM_TRGO_RESET;
+
+	switch(trigger_config_ptr->trigger_timer_channel)
+	{
+		case TIM_CHANNEL_1:
+		{
+			trigger_output = TIM_TRGO_OC1REF;
+			break;
+		}
+		case TIM_CHANNEL_2:
+		{
+			trigger_output = TIM_TRGO_OC2REF;
+			break;
+		}
+		case TIM_CHANNEL_3:
+		{
+			trigger_output = TIM_TRGO_OC3REF;
+			break;
+		}
+		case TIM_CHANNEL_4:
+		{
+			trigger_output = TIM_TRGO_OC4REF;
+			break;
+		}
+		default:
+		{
+			report_init_error();
+			break;
+		}
+	}
+
+	return trigger_output;
+}
+
+static void init_adc_trigger_channel(uint8_t timer_config_idx)
+{
+	const bsp_pwm_adc_trigger_config_t *trigger_config_ptr =
+		&m_last_bsp_pwm_config_ptr[timer_config_idx].adc_trigger_config;
+
+	if(BSP_PWM_ADC_TRIGGER_NONE_e == trigger_config_ptr->trigger_point)
+	{
+		return;
+	}
+
+	// PWM mode 2: OCxREF rises at the compare match, no GPIO is mapped to the channel
+	TIM_OC_InitTypeDef sConfigOC = {0};
+	sConfigOC.OCMode = TIM_OCMODE_PWM2;
+	sConfigOC.Pulse = 0;
+	sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
+	sConfigOC.OCNPolarity = TIM_OCNPOLARITY_HIGH;
+	sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+	sConfigOC.OCIdleState = TIM_OCIDLESTATE_RESET;
+	sConfigOC.OCNIdleState = TIM_OCNIDLESTATE_RESET;
+	if (HAL_TIM_PWM_ConfigChannel(&m_htim[timer_config_idx], &sConfigOC,
+								  trigger_config_ptr->trigger_timer_channel) != HAL_OK)
+	{
+		report_init_error();
+	}
+
+	// the PWM outputs start with 0 duty
+	update_adc_trigger_point(timer_config_idx, 0U);
+
+	if (HAL_TIM_PWM_Start(&m_htim[timer_config_idx], trigger_config_ptr->trigger_timer_channel) != HAL_OK)
+	{
+		report_init_error();
+	}
+}
+
+static void update_adc_trigger_point(uint8_t timer_config_idx, uint32_t on_time_counts)
+{
+	const bsp_pwm_config_t *timer_config_ptr = &m_last_bsp_pwm_config_ptr[timer_config_idx];
+	const bsp_pwm_adc_trigger_config_t *trigger_config_ptr = &timer_config_ptr->adc_trigger_config;
+
+	int32_t trigger_counts = 0;
+
+	if(BSP_PWM_ADC_TRIGGER_MID_ON_TIME_e == trigger_config_ptr->trigger_point)
+	{
+		trigger_counts = (int32_t)(on_time_counts / 2U);
+	}
+	else if(BSP_PWM_ADC_TRIGGER_MID_OFF_TIME_e == trigger_config_ptr->trigger_point)
+	{
+		// off time lasts from the compare match to the end of the period (ARR + 1 counts)
+		trigger_counts = (int32_t)((on_time_counts + timer_config_ptr->pwm_timer_period + 1U) / 2U);
+	}
+	else
+	{
+		return;
+	}
+
+	trigger_counts += trigger_config_ptr->trigger_offset_counts;
+
+	// in PWM mode 2 a compare value of 0 keeps OCxREF high, so it never rises
+	// and TRGO stops; a value above ARR never matches; ARR - 1 keeps the edge
+	// inside the period
+	if(trigger_counts < 1)
+	{
+		trigger_counts = 1;
+	}
+	else if(trigger_counts > ((int32_t)timer_config_ptr->pwm_timer_period - 1))
+	{
+		trigger_counts = (int32_t)timer_config_ptr->pwm_timer_period - 1;
+	}
+
+	set_capture_compare_register_of_pwm_channel(timer_config_idx,
+												trigger_config_ptr->trigger_timer_channel,
+												(uint32_t)trigger_counts);
+}
@@ -32,6 +32,34 @@ typedef struct
 
 }bsp_pwm_timer_channel_config_t;
 
+/**
+ * @brief Point of the switching period at which the timer starts the ADC conversions.
+ */
+typedef enum
+{
+	BSP_PWM_ADC_TRIGGER_NONE_e = 0,			///< The timer does not trigger the ADC
+	BSP_PWM_ADC_TRIGGER_MID_ON_TIME_e,		///< Middle of the on-time of the reference channel
+	BSP_PWM_ADC_TRIGGER_MID_OFF_TIME_e,		///< Middle of the off-time of the reference channel
+
+}bsp_pwm_adc_trigger_point_e;
+
+/**
+ * @brief ADC trigger generated by a spare compare channel of the PWM timer.
+ *
+ * The compare channel runs in PWM mode 2 without an output pin, so both its
+ * compare event (TIMx_CCy trigger of the regular ADC group) and its OCyREF
+ * rising edge (selected as TRGO for the injected group) occur at the trigger
+ * point. set_pwm_duty() of the reference channel moves the trigger point with
+ * the on-time.
+ */
+typedef struct
+{
+	bsp_pwm_adc_trigger_point_e trigger_point;
+	uint32_t trigger_timer_channel;					///< Compare channel (TIM_CHANNEL_x), must not be a PWM output
+	bsp_pwm_channel_idx_t reference_pwm_channel_id;	///< PWM channel whose on-time places the trigger
+	int32_t trigger_offset_counts;					///< Added to the mid point, e.g. minus half the ADC sampling time
+
+}bsp_pwm_adc_trigger_config_t;
 
 typedef struct
 {
@@ -41,6 +69,7 @@ typedef struct
 	uint32_t pwm_timer_prescalar;
 	uint32_t pwm_timer_period;
 	uint32_t pwm_timer_counter_direction_mode;
+	bsp_pwm_adc_trigger_config_t adc_trigger_config; ///< Zero initialized: no ADC trigger
 
 }bsp_pwm_config_t;
 
@@ -69,6 +98,9 @@ void stop_pwm_channel(bsp_pwm_channel_idx_t bsp_pwm_channel);
 /**
  * @brief Sets the duty cycle of a specific PWM channel.
  *
+ * If the channel is the reference of an ADC trigger, the trigger point follows
+ * the new on-time.
+ *
  * @param[in] bsp_pwm_channel PWM channel to set.
  * @param[in] duty_rate Duty cycle to set (range: 0.0 to 1.0).
  */
@@ -1,15 +1,202 @@
 
 
 #include "adc_sensor_driver.h"
-
+#include "adc_trace_recorder.h"
 #include "error_manager.h"
+#include "string.h"
+
+#ifndef ADC_SENSOR_TRACE_RECORDING_ENABLED
+#define ADC_SENSOR_TRACE_RECORDING_ENABLED 0U
+#endif
+
+#ifndef ADC_SENSOR_SNAPSHOT_TIMESTAMP_FUNC
+#define ADC_SENSOR_SNAPSHOT_TIMESTAMP_FUNC HAL_GetTick
+#endif
+
+#ifndef ADC_SENSOR_ZERO_CALIBRATION_DELAY_FUNC
+#define ADC_SENSOR_ZERO_CALIBRATION_DELAY_FUNC HAL_Delay
+#endif
+
+#ifndef ADC_SENSOR_FRAME_RING_LEN
+#define ADC_SENSOR_FRAME_RING_LEN 16U
+#endif
+
+_Static_assert((ADC_SENSOR_FRAME_RING_LEN >= 2U) &&
+			   (0U == (ADC_SENSOR_FRAME_RING_LEN & (ADC_SENSOR_FRAME_RING_LEN - 1U))),
+			   "ADC_SENSOR_FRAME_RING_LEN must be a power of two");
+
+
+/** @brief Integrator and comb stages of the CIC decimation filter. */
+#define ADC_SENSOR_CIC_ORDER	2U
+
+/**
+ * @brief State of the decimation filter of one sensor.
+ *
+ * The integrators wrap around modulo 2^32; the combs remove the wrap again as
+ * long as the output gain times BSP_ADC_MAX_RAW_COUNT fits in 32 bits.
+ */
+typedef struct
+{
+	uint32_t integrators[ADC_SENSOR_CIC_ORDER];
+	uint32_t comb_delays[ADC_SENSOR_CIC_ORDER];
+	uint32_t order;							///< 1 for the boxcar, ADC_SENSOR_CIC_ORDER for the CIC
+	uint32_t gain;							///< oversampling_ratio ^ order
+	uint32_t sample_cnt;					///< Samples since the previous output
+	uint32_t output_cnt;					///< Outputs since start, the first order - 1 are not settled
+
+}adc_sensor_decimator_t;
+
+/** @brief Fraction bits of the fixed point gain and offset. */
+#define ADC_SENSOR_COEFFICIENT_FRACTION_BITS	32U
 
+/** @brief Fraction bits of the fixed point sensor values. */
+#define ADC_SENSOR_VALUE_FRACTION_BITS			16U
 
 /**
  * @brief Pointer to the configuration array holding all ADC sensors parameters.
  */
 static const adc_sensor_driver_config_t *m_adc_sensor_driver_configs_ptr = NULL;
 
+/**
+ * @brief Conversion of a raw count in 12.4 fixed point to the sensor value,
+ *        sensor_value = raw_count * gain + offset, folded by init_adc_sensor_driver().
+ */
+static float m_sensor_gains[TOTAL_ADC_SENSOR_ID];
+static float m_sensor_offsets[TOTAL_ADC_SENSOR_ID];
+
+/**
+ * @brief m_sensor_gains and m_sensor_offsets in Q32.32 fixed point.
+ */
+static int64_t m_sensor_gains_q32[TOTAL_ADC_SENSOR_ID];
+static int64_t m_sensor_offsets_q32[TOTAL_ADC_SENSOR_ID];
+
+/**
+ * @brief Measured raw count of a zero sensor value, 0 while reference_voltage_for_zero_output is used.
+ */
+static uint16_t m_sensor_zero_counts[TOTAL_ADC_SENSOR_ID];
+
+/**
+ * @brief Calibration table of every sensor, NULL for the linear conversion.
+ */
+static const adc_sensor_calibration_lut_t *m_sensor_calibration_luts[TOTAL_ADC_SENSOR_ID];
+
+/**
+ * @brief Count added to a raw count before the table lookup, moves the measured
+ *        zero count onto the zero count the table was made for.
+ */
+static int32_t m_sensor_lut_count_offsets[TOTAL_ADC_SENSOR_ID];
+
+/**
+ * @brief Frames pushed by the DMA interrupt, slot read_cnt % ADC_SENSOR_FRAME_RING_LEN
+ *        holds frame read_cnt.
+ */
+static adc_sensor_frame_t m_frame_ring[ADC_SENSOR_FRAME_RING_LEN];
+
+/**
+ * @brief Frames pushed since initialization, only written by the DMA interrupt.
+ *
+ * It is incremented after the frame is complete, so the frames below it are
+ * readable until the interrupt wraps around onto them.
+ */
+static volatile uint32_t m_frame_write_cnt = 0U;
+
+/**
+ * @brief Returns the voltage at the sensor output per raw count of a sensor.
+ *
+ * @param[in] config_ptr Configuration of the sensor.
+ * @return double Volts per count, one count is 1/2^BSP_ADC_OVERSAMPLING_SHIFT of an ADC LSB.
+ */
+static double get_adc_sensor_volt_per_count(const adc_sensor_driver_config_t *config_ptr);
+
+/**
+ * @brief Folds the configuration and zero count of a sensor into its gain and offset.
+ *
+ * @param[in] sensor_id Sensor to fold.
+ */
+static void fold_adc_sensor_coefficients(uint8_t sensor_id);
+
+/**
+ * @brief Interpolates the calibration table of a sensor at a raw count.
+ *
+ * @param[in] sensor_id Sensor with a calibration table.
+ * @param[in] raw_count Raw count of read_adc_sensor_raw_count().
+ * @return int32_t Sensor value in Q16.16 fixed point.
+ */
+static int32_t interpolate_adc_sensor_calibration_lut(uint8_t sensor_id, uint16_t raw_count);
+
+/**
+ * @brief Finds the raw count at which the calibration table of a sensor reaches a value.
+ *
+ * @param[in] sensor_id    Sensor with a calibration table.
+ * @param[in] sensor_value Sensor value in the unit of the sensor.
+ * @return int64_t Raw count of the first segment holding the value, the nearer
+ *         end of the table if no segment does.
+ */
+static int64_t find_adc_sensor_calibration_lut_count(uint8_t sensor_id, float sensor_value);
+
+/**
+ * @brief Checks the calibration table of a sensor against the raw count range.
+ *
+ * @param[in] lut_ptr Calibration table, NULL is valid.
+ * @retval true  The table can be used.
+ * @retval false The table is malformed.
+ */
+static bool is_adc_sensor_calibration_lut_valid(const adc_sensor_calibration_lut_t *lut_ptr);
+
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+/**
+ * @brief Scan sequences converted since initialization.
+ */
+static uint32_t m_scan_sequence_cnt = 0U;
+
+/**
+ * @brief Decimation filters, only used by the DMA interrupt.
+ */
+static adc_sensor_decimator_t m_decimators[TOTAL_ADC_SENSOR_ID];
+
+/**
+ * @brief Latest decimated value of every oversampled sensor in 12.4 fixed point counts.
+ */
+static volatile uint16_t m_oversampled_counts[TOTAL_ADC_SENSOR_ID];
+
+/**
+ * @brief Set once the decimation filter of a sensor has settled.
+ */
+static volatile bool m_is_oversampled_count_valid[TOTAL_ADC_SENSOR_ID];
+
+/**
+ * @brief Decimated values copied together with the held scan sequence by
+ *        read_all_adc_sensor_values(), returned while m_is_oversampled_count_held is set.
+ */
+static uint16_t m_held_oversampled_counts[TOTAL_ADC_SENSOR_ID];
+static bool m_is_held_oversampled_count_valid[TOTAL_ADC_SENSOR_ID];
+static bool m_is_oversampled_count_held = false;
+
+/**
+ * @brief Feeds a completed DMA scan block into the decimation filters.
+ *
+ * @param[in] block_ptr    Raw counts of the block, see adc_scan_block_cb_func_t.
+ * @param[in] sequence_cnt Number of sequences in the block.
+ */
+static void decimate_adc_scan_block(const volatile uint16_t *block_ptr, uint32_t sequence_cnt);
+
+/**
+ * @brief Feeds one sample into the decimation filter of a sensor.
+ *
+ * @param[in] sensor_id Sensor of the filter.
+ * @param[in] raw_count Sample in counts.
+ */
+static void decimate_adc_sample(uint8_t sensor_id, uint32_t raw_count);
+
+/**
+ * @brief Pushes the frame of a completed DMA scan block into the frame ring.
+ *
+ * @param[in] block_ptr    Raw counts of the block, see adc_scan_block_cb_func_t.
+ * @param[in] sequence_cnt Number of sequences in the block.
+ */
+static void push_adc_sensor_frame(const volatile uint16_t *block_ptr, uint32_t sequence_cnt);
+#endif
+
 /**
  * @brief Initializes the ADC sensor driver with the provided configuration.
  * 
@@ -17,6 +204,8 @@ static const adc_sensor_driver_config_t *m_adc_sensor_driver_configs_ptr = NULL;
  * that contain the necessary calibration and function references to read and convert
  * sensor values.
  * 
+ * It also starts the decimation filters of the oversampled sensors.
+ * 
  * @param[in] adc_sensors_config Pointer to an array of ADC sensor driver configuration structures.
  *                               Must not be NULL.
  * 
@@ -30,20 +219,63 @@ void init_adc_sensor_driver(const adc_sensor_driver_config_t *adc_sensors_config
 		return;
 	}
 
+	for(uint8_t sensor_id = 0U; sensor_id < TOTAL_ADC_SENSOR_ID; sensor_id++)
+	{
+		if((adc_sensors_config[sensor_id].oversampling_ratio > ADC_SENSOR_OVERSAMPLING_RATIO_MAX) ||
+		   (adc_sensors_config[sensor_id].scan_channel_idx >= BSP_ADC_SCAN_CHANNEL_CNT) ||
+		   (0.0f == adc_sensors_config[sensor_id].sensitivity_volt_per_output_unit) ||
+		   (false == is_adc_sensor_calibration_lut_valid(adc_sensors_config[sensor_id].calibration_lut_ptr)))
+		{
+			report_development_error();
+			return;
+		}
+	}
+
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+	register_adc_scan_block_callback(NULL);
+#endif
+
 	m_adc_sensor_driver_configs_ptr = adc_sensors_config;
+
+	for(uint8_t sensor_id = 0U; sensor_id < TOTAL_ADC_SENSOR_ID; sensor_id++)
+	{
+		m_sensor_zero_counts[sensor_id] = 0U;
+		fold_adc_sensor_coefficients(sensor_id);
+	}
+	m_frame_write_cnt = 0U;
+
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+	m_scan_sequence_cnt = 0U;
+	memset(m_decimators, 0, sizeof(m_decimators));
+
+	for(uint8_t sensor_id = 0U; sensor_id < TOTAL_ADC_SENSOR_ID; sensor_id++)
+	{
+		adc_sensor_decimator_t *decimator_ptr = &m_decimators[sensor_id];
+		uint32_t oversampling_ratio = adc_sensors_config[sensor_id].oversampling_ratio;
+
+		decimator_ptr->order = (ADC_SENSOR_DECIMATION_CIC_e == adc_sensors_config[sensor_id].decimation_filter) ?
+			ADC_SENSOR_CIC_ORDER : 1U;
+		decimator_ptr->gain = 1U;
+
+		for(uint32_t stage_idx = 0U; stage_idx < decimator_ptr->order; stage_idx++)
+		{
+			decimator_ptr->gain *= oversampling_ratio;
+		}
+
+		m_oversampled_counts[sensor_id] = 0U;
+		m_is_oversampled_count_valid[sensor_id] = false;
+	}
+
+	register_adc_scan_block_callback(decimate_adc_scan_block);
+#endif
 }
 
 /**
  * @brief Reads and converts the ADC sensor value for a given sensor ID.
  * 
- * This function uses the function pointer defined in the configuration to obtain the raw voltage
- * value from the hardware ADC, then applies scaling and offset to convert it into a physical
- * sensor value (e.g., temperature, current, etc.).
- * 
- * The conversion is done using the following formula:
- * @code
- *     sensor_value = ((raw_voltage * raw_voltage_factor) - reference_voltage) / sensitivity
- * @endcode
+ * This function uses the function pointer defined in the configuration to obtain the raw count
+ * from the hardware ADC, then applies the gain and offset folded at initialization to convert
+ * it into a physical sensor value (e.g., temperature, current, etc.).
  * 
  * @param[in]  sensor_id         Index of the sensor in the configuration array (used as a unique ID).
  * @param[out] sensor_value_ptr Pointer to a float variable where the calculated sensor value will be stored.
@@ -53,29 +285,666 @@ void init_adc_sensor_driver(const adc_sensor_driver_config_t *adc_sensors_config
  */
 adc_sensor_state_e read_adc_sensor_value(uint8_t sensor_id , float *sensor_value_ptr)
 {
-	float read_data_for_adc_raw_voltage = 0.0f;
-	bsp_adc_status_e raw_voltage_read_state = m_adc_sensor_driver_configs_ptr[sensor_id].
-	read_adc_sensor_raw_voltage_func(&read_data_for_adc_raw_voltage);
+	if(NULL == sensor_value_ptr)
+	{
+		report_development_error();
+		return ADC_SENSOR_ERROR_e;
+	}
+
+	uint16_t raw_count = 0U;
+	adc_sensor_state_e success_status = read_adc_sensor_raw_count(sensor_id, &raw_count);
+
+	if(ADC_SENSOR_OK_e == success_status)
+	{
+		*sensor_value_ptr = convert_adc_sensor_raw_count(sensor_id, raw_count);
+	}
+
+	return success_status;
+}
+
+/**
+ * @brief Reads the raw count a sensor value is converted from.
+ *
+ * @param[in]  sensor_id     Index of the sensor in the configuration array.
+ * @param[out] raw_count_ptr Pointer to store the raw count. Must not be NULL.
+ *
+ * @retval ADC_SENSOR_OK_e if the count was read.
+ * @retval ADC_SENSOR_ERROR_e if the ADC read failed, the driver is not
+ *         initialized or the sensor ID is out of range.
+ */
+adc_sensor_state_e read_adc_sensor_raw_count(uint8_t sensor_id, uint16_t *raw_count_ptr)
+{
+	if((NULL == m_adc_sensor_driver_configs_ptr) || (sensor_id >= TOTAL_ADC_SENSOR_ID) ||
+	   (NULL == raw_count_ptr))
+	{
+		report_development_error();
+		return ADC_SENSOR_ERROR_e;
+	}
 
-	float raw_voltage_factor = m_adc_sensor_driver_configs_ptr[sensor_id].raw_voltage_factor;
-	float voltage_ref = m_adc_sensor_driver_configs_ptr[sensor_id].reference_voltage_for_zero_output;
-	float volt_per_output_unit = m_adc_sensor_driver_configs_ptr[sensor_id].sensitivity_volt_per_output_unit;
+	uint16_t raw_count = 0U;
+	bsp_adc_status_e raw_count_read_state = m_adc_sensor_driver_configs_ptr[sensor_id].
+	read_adc_sensor_raw_count_func(&raw_count);
 
 	adc_sensor_state_e success_status = ADC_SENSOR_OK_e;
 
-	if(BSP_ADC_STATE_OK_e == raw_voltage_read_state)
+	if(BSP_ADC_STATE_OK_e == raw_count_read_state)
 	{
-		*sensor_value_ptr =
-			((read_data_for_adc_raw_voltage*raw_voltage_factor) - voltage_ref) / volt_per_output_unit;
+		// the status and the overrun restart stay with the read function
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+		if(m_adc_sensor_driver_configs_ptr[sensor_id].oversampling_ratio > 1U)
+		{
+			if(true == m_is_oversampled_count_held)
+			{
+				if(true == m_is_held_oversampled_count_valid[sensor_id])
+				{
+					raw_count = m_held_oversampled_counts[sensor_id];
+				}
+			}
+			else if(true == m_is_oversampled_count_valid[sensor_id])
+			{
+				raw_count = m_oversampled_counts[sensor_id];
+			}
+		}
+#endif
 
+		*raw_count_ptr = raw_count;
+
+#if (0U != ADC_SENSOR_TRACE_RECORDING_ENABLED)
+		record_adc_trace_sample(sensor_id, ADC_TRACE_SAMPLE_OK_e, raw_count);
+#endif
 	}
 	else
 	{
 		// low level notified an error already. It is not necessary in here.
 		success_status = ADC_SENSOR_ERROR_e;
+
+#if (0U != ADC_SENSOR_TRACE_RECORDING_ENABLED)
+		record_adc_trace_sample(sensor_id, ADC_TRACE_SAMPLE_ERROR_e, 0U);
+#endif
 	}
 
 	return success_status;
 }
 
+/**
+ * @brief Converts a raw count of a sensor with one float multiply-add.
+ *
+ * @param[in] sensor_id Index of the sensor in the configuration array.
+ * @param[in] raw_count Raw count of read_adc_sensor_raw_count().
+ * @return float Sensor value in the unit of the sensor.
+ */
+float convert_adc_sensor_raw_count(uint8_t sensor_id, uint16_t raw_count)
+{
+	if(sensor_id >= TOTAL_ADC_SENSOR_ID)
+	{
+		report_development_error();
+		return 0.0f;
+	}
+
+	if(NULL != m_sensor_calibration_luts[sensor_id])
+	{
+		return (float)interpolate_adc_sensor_calibration_lut(sensor_id, raw_count) *
+			   (1.0f / (float)(1UL << ADC_SENSOR_VALUE_FRACTION_BITS));
+	}
+
+	return ((float)raw_count * m_sensor_gains[sensor_id]) + m_sensor_offsets[sensor_id];
+}
+
+/**
+ * @brief Converts a raw count of a sensor with one 64-bit integer multiply-add.
+ *
+ * @param[in] sensor_id Index of the sensor in the configuration array.
+ * @param[in] raw_count Raw count of read_adc_sensor_raw_count().
+ * @return int32_t Sensor value in the unit of the sensor, Q16.16 fixed point.
+ */
+int32_t convert_adc_sensor_raw_count_q16(uint8_t sensor_id, uint16_t raw_count)
+{
+	if(sensor_id >= TOTAL_ADC_SENSOR_ID)
+	{
+		report_development_error();
+		return 0;
+	}
+
+	if(NULL != m_sensor_calibration_luts[sensor_id])
+	{
+		return interpolate_adc_sensor_calibration_lut(sensor_id, raw_count);
+	}
+
+	int64_t sensor_value_q32 = ((int64_t)raw_count * m_sensor_gains_q32[sensor_id]) + m_sensor_offsets_q32[sensor_id];
+
+	return (int32_t)(sensor_value_q32 >> (ADC_SENSOR_COEFFICIENT_FRACTION_BITS - ADC_SENSOR_VALUE_FRACTION_BITS));
+}
+
+/**
+ * @brief Converts a sensor value back to the raw count it is read from.
+ *
+ * @param[in] sensor_id    Index of the sensor in the configuration array.
+ * @param[in] sensor_value Sensor value in the unit of the sensor.
+ * @return uint16_t Raw count in 12.4 fixed point, saturated to 0..UINT16_MAX.
+ */
+uint16_t convert_adc_sensor_value_to_raw_count(uint8_t sensor_id, float sensor_value)
+{
+	if(sensor_id >= TOTAL_ADC_SENSOR_ID)
+	{
+		report_development_error();
+		return 0U;
+	}
+
+	int64_t raw_count = 0;
+
+	if(NULL != m_sensor_calibration_luts[sensor_id])
+	{
+		raw_count = find_adc_sensor_calibration_lut_count(sensor_id, sensor_value);
+	}
+	else if(0.0f != m_sensor_gains[sensor_id])
+	{
+		double exact_raw_count = ((double)sensor_value - (double)m_sensor_offsets[sensor_id]) /
+								 (double)m_sensor_gains[sensor_id];
+
+		if(exact_raw_count > (double)UINT16_MAX)
+		{
+			exact_raw_count = (double)UINT16_MAX;
+		}
+		else if(exact_raw_count < 0.0)
+		{
+			exact_raw_count = 0.0;
+		}
+
+		raw_count = (int64_t)(exact_raw_count + 0.5);
+	}
+
+	if(raw_count < 0)
+	{
+		raw_count = 0;
+	}
+	else if(raw_count > (int64_t)UINT16_MAX)
+	{
+		raw_count = (int64_t)UINT16_MAX;
+	}
+
+	return (uint16_t)raw_count;
+}
+
+/**
+ * @brief Reads every configured sensor into one snapshot.
+ *
+ * @param[out] snapshot_ptr Snapshot to fill. Must not be NULL.
+ *
+ * @retval ADC_SENSOR_OK_e if every sensor was read.
+ * @retval ADC_SENSOR_ERROR_e if any sensor failed, see snapshot_ptr->states.
+ */
+adc_sensor_state_e read_all_adc_sensor_values(adc_sensor_snapshot_t *snapshot_ptr)
+{
+	if(NULL == snapshot_ptr)
+	{
+		report_development_error();
+		return ADC_SENSOR_ERROR_e;
+	}
+
+	adc_sensor_state_e snapshot_state = ADC_SENSOR_OK_e;
+
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+	// the DMA interrupt decimates and writes the scan buffer, the held sequence
+	// and the decimated counts are copied at once so they belong together
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	hold_adc_scan_sequence();
+
+	for(uint8_t sensor_id = 0U; sensor_id < TOTAL_ADC_SENSOR_ID; sensor_id++)
+	{
+		m_held_oversampled_counts[sensor_id] = m_oversampled_counts[sensor_id];
+		m_is_held_oversampled_count_valid[sensor_id] = m_is_oversampled_count_valid[sensor_id];
+	}
+
+	m_is_oversampled_count_held = true;
+	__set_PRIMASK(primask);
+#else
+	hold_adc_scan_sequence();
+#endif
+	snapshot_ptr->timestamp_ms = ADC_SENSOR_SNAPSHOT_TIMESTAMP_FUNC();
+
+	for(uint8_t sensor_id = 0U; sensor_id < TOTAL_ADC_SENSOR_ID; sensor_id++)
+	{
+		snapshot_ptr->values[sensor_id] = 0.0f;
+		snapshot_ptr->states[sensor_id] = read_adc_sensor_value(sensor_id, &snapshot_ptr->values[sensor_id]);
+
+		if(ADC_SENSOR_OK_e != snapshot_ptr->states[sensor_id])
+		{
+			snapshot_state = ADC_SENSOR_ERROR_e;
+		}
+	}
+
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+	m_is_oversampled_count_held = false;
+#endif
+	release_adc_scan_sequence();
+
+	return snapshot_state;
+}
+
+/**
+ * @brief Measures the zero output of every sensor with a zero_calibration_sample_cnt.
+ *
+ * The samples are read with the configured read functions directly, so they
+ * are neither decimated nor recorded by the ADC trace.
+ *
+ * @retval ADC_SENSOR_OK_e if every sensor was calibrated.
+ * @retval ADC_SENSOR_ERROR_e if any sensor keeps its configured reference.
+ */
+adc_sensor_state_e calibrate_adc_sensor_zero_counts(void)
+{
+	if(NULL == m_adc_sensor_driver_configs_ptr)
+	{
+		report_development_error();
+		return ADC_SENSOR_ERROR_e;
+	}
+
+	uint32_t count_sums[TOTAL_ADC_SENSOR_ID] = {0U};
+	bool is_read_failed[TOTAL_ADC_SENSOR_ID] = {false};
+	uint32_t calibration_sample_cnt = 0U;
+
+	for(uint8_t sensor_id = 0U; sensor_id < TOTAL_ADC_SENSOR_ID; sensor_id++)
+	{
+		if(m_adc_sensor_driver_configs_ptr[sensor_id].zero_calibration_sample_cnt > calibration_sample_cnt)
+		{
+			calibration_sample_cnt = m_adc_sensor_driver_configs_ptr[sensor_id].zero_calibration_sample_cnt;
+		}
+	}
+
+	for(uint32_t sample_idx = 0U; sample_idx < calibration_sample_cnt; sample_idx++)
+	{
+		// the first wait lets the scan convert after initialization, one sample per
+		// millisecond then averages the noise of many PWM periods
+		ADC_SENSOR_ZERO_CALIBRATION_DELAY_FUNC(1U);
+
+		for(uint8_t sensor_id = 0U; sensor_id < TOTAL_ADC_SENSOR_ID; sensor_id++)
+		{
+			const adc_sensor_driver_config_t *config_ptr = &m_adc_sensor_driver_configs_ptr[sensor_id];
+			uint16_t raw_count = 0U;
+
+			if(sample_idx >= config_ptr->zero_calibration_sample_cnt)
+			{
+				continue;
+			}
+
+			if(BSP_ADC_STATE_OK_e == config_ptr->read_adc_sensor_raw_count_func(&raw_count))
+			{
+				count_sums[sensor_id] += raw_count;
+			}
+			else
+			{
+				is_read_failed[sensor_id] = true;
+			}
+		}
+	}
+
+	adc_sensor_state_e calibration_state = ADC_SENSOR_OK_e;
+
+	for(uint8_t sensor_id = 0U; sensor_id < TOTAL_ADC_SENSOR_ID; sensor_id++)
+	{
+		const adc_sensor_driver_config_t *config_ptr = &m_adc_sensor_driver_configs_ptr[sensor_id];
+		uint32_t sample_cnt = config_ptr->zero_calibration_sample_cnt;
+
+		if(0U == sample_cnt)
+		{
+			continue;
+		}
+
+		uint16_t zero_count = (uint16_t)((count_sums[sensor_id] + (sample_cnt / 2U)) / sample_cnt);
+		double zero_deviation_v = ((double)zero_count * get_adc_sensor_volt_per_count(config_ptr)) -
+								  (double)config_ptr->reference_voltage_for_zero_output;
+
+		if((true == is_read_failed[sensor_id]) || (0U == zero_count) ||
+		   (zero_deviation_v > (double)config_ptr->zero_calibration_tolerance_v) ||
+		   (zero_deviation_v < -(double)config_ptr->zero_calibration_tolerance_v))
+		{
+			calibration_state = ADC_SENSOR_ERROR_e;
+			continue;
+		}
+
+		set_adc_sensor_zero_count(sensor_id, zero_count);
+	}
+
+	return calibration_state;
+}
+
+/**
+ * @brief Sets the zero output count of a sensor, e.g. to the count of a recording.
+ *
+ * @param[in] sensor_id  Index of the sensor in the configuration array.
+ * @param[in] zero_count Raw count of a zero sensor value in 12.4 fixed point
+ *                       counts, 0 returns to reference_voltage_for_zero_output.
+ */
+void set_adc_sensor_zero_count(uint8_t sensor_id, uint16_t zero_count)
+{
+	if((NULL == m_adc_sensor_driver_configs_ptr) || (sensor_id >= TOTAL_ADC_SENSOR_ID))
+	{
+		report_development_error();
+		return;
+	}
+
+	m_sensor_zero_counts[sensor_id] = zero_count;
+	fold_adc_sensor_coefficients(sensor_id);
+
+#if (0U != ADC_SENSOR_TRACE_RECORDING_ENABLED)
+	set_adc_trace_zero_count(sensor_id, zero_count);
+#endif
+}
+
+/**
+ * @brief Returns the zero output count a sensor was calibrated to.
+ *
+ * @param[in] sensor_id Index of the sensor in the configuration array.
+ * @return uint16_t Raw count of a zero sensor value, 0 if the sensor uses
+ *         reference_voltage_for_zero_output.
+ */
+uint16_t get_adc_sensor_zero_count(uint8_t sensor_id)
+{
+	if(sensor_id >= TOTAL_ADC_SENSOR_ID)
+	{
+		report_development_error();
+		return 0U;
+	}
+
+	return m_sensor_zero_counts[sensor_id];
+}
+
+/**
+ * @brief Starts a consumer of the frame ring at the next frame to be pushed.
+ *
+ * @param[out] reader_ptr Reader to start. Must not be NULL.
+ */
+void init_adc_sensor_frame_reader(adc_sensor_frame_reader_t *reader_ptr)
+{
+	if(NULL == reader_ptr)
+	{
+		report_development_error();
+		return;
+	}
+
+	reader_ptr->read_cnt = m_frame_write_cnt;
+	reader_ptr->lost_frame_cnt = 0U;
+}
+
+/**
+ * @brief Copies the oldest frame a consumer has not read yet.
+ *
+ * @param[in,out] reader_ptr Reader of the consumer. Must not be NULL.
+ * @param[out]    frame_ptr  Frame to fill. Must not be NULL.
+ *
+ * @retval true  A frame was copied.
+ * @retval false No new frame, or the frame was overwritten during the copy.
+ */
+bool read_adc_sensor_frame(adc_sensor_frame_reader_t *reader_ptr, adc_sensor_frame_t *frame_ptr)
+{
+	if((NULL == reader_ptr) || (NULL == frame_ptr))
+	{
+		report_development_error();
+		return false;
+	}
+
+	uint32_t write_cnt = m_frame_write_cnt;
+	uint32_t unread_frame_cnt = write_cnt - reader_ptr->read_cnt;
+
+	if(0U == unread_frame_cnt)
+	{
+		return false;
+	}
+
+	// the slot the interrupt writes next is not readable, the ring holds LEN - 1 frames
+	if(unread_frame_cnt >= ADC_SENSOR_FRAME_RING_LEN)
+	{
+		reader_ptr->lost_frame_cnt += unread_frame_cnt - (ADC_SENSOR_FRAME_RING_LEN - 1U);
+		reader_ptr->read_cnt = write_cnt - (ADC_SENSOR_FRAME_RING_LEN - 1U);
+	}
+
+	__DMB();
+	*frame_ptr = m_frame_ring[reader_ptr->read_cnt & (ADC_SENSOR_FRAME_RING_LEN - 1U)];
+	__DMB();
+
+	// the copy is intact as long as the interrupt did not reach its slot meanwhile
+	if((m_frame_write_cnt - reader_ptr->read_cnt) >= ADC_SENSOR_FRAME_RING_LEN)
+	{
+		reader_ptr->lost_frame_cnt++;
+		reader_ptr->read_cnt++;
+		return false;
+	}
+
+	reader_ptr->read_cnt++;
+
+	return true;
+}
+
+static double get_adc_sensor_volt_per_count(const adc_sensor_driver_config_t *config_ptr)
+{
+	return ((double)BSP_ADC_REFERENCE_VOLTAGE * config_ptr->raw_voltage_factor) /
+		   ((double)BSP_ADC_MAX_RAW_COUNT * (double)(1U << BSP_ADC_OVERSAMPLING_SHIFT));
+}
 
+static void fold_adc_sensor_coefficients(uint8_t sensor_id)
+{
+	const adc_sensor_driver_config_t *config_ptr = &m_adc_sensor_driver_configs_ptr[sensor_id];
+
+	double gain = get_adc_sensor_volt_per_count(config_ptr) / config_ptr->sensitivity_volt_per_output_unit;
+	double gain_q32 = gain * (double)(1ULL << ADC_SENSOR_COEFFICIENT_FRACTION_BITS);
+
+	m_sensor_gains[sensor_id] = (float)gain;
+	m_sensor_gains_q32[sensor_id] = (int64_t)(gain_q32 + ((gain_q32 < 0.0) ? -0.5 : 0.5));
+
+	if(0U != m_sensor_zero_counts[sensor_id])
+	{
+		// sensor_value = (raw_count - zero_count) * gain
+		m_sensor_offsets[sensor_id] = (float)(-(double)m_sensor_zero_counts[sensor_id] * gain);
+		m_sensor_offsets_q32[sensor_id] = -((int64_t)m_sensor_zero_counts[sensor_id] * m_sensor_gains_q32[sensor_id]);
+	}
+	else
+	{
+		double offset = -(double)config_ptr->reference_voltage_for_zero_output /
+						config_ptr->sensitivity_volt_per_output_unit;
+		double offset_q32 = offset * (double)(1ULL << ADC_SENSOR_COEFFICIENT_FRACTION_BITS);
+
+		m_sensor_offsets[sensor_id] = (float)offset;
+		m_sensor_offsets_q32[sensor_id] = (int64_t)(offset_q32 + ((offset_q32 < 0.0) ? -0.5 : 0.5));
+	}
+
+	m_sensor_calibration_luts[sensor_id] = config_ptr->calibration_lut_ptr;
+	m_sensor_lut_count_offsets[sensor_id] = 0;
+
+	if(0U != m_sensor_zero_counts[sensor_id])
+	{
+		double reference_zero_count = (double)config_ptr->reference_voltage_for_zero_output /
+									  get_adc_sensor_volt_per_count(config_ptr);
+
+		m_sensor_lut_count_offsets[sensor_id] =
+			(int32_t)(reference_zero_count + 0.5) - (int32_t)m_sensor_zero_counts[sensor_id];
+	}
+}
+
+static int32_t interpolate_adc_sensor_calibration_lut(uint8_t sensor_id, uint16_t raw_count)
+{
+	const adc_sensor_calibration_lut_t *lut_ptr = m_sensor_calibration_luts[sensor_id];
+	int32_t lut_count = (int32_t)raw_count + m_sensor_lut_count_offsets[sensor_id];
+
+	if(lut_count < 0)
+	{
+		lut_count = 0;
+	}
+	else if(lut_count > (int32_t)UINT16_MAX)
+	{
+		lut_count = (int32_t)UINT16_MAX;
+	}
+
+	// the point count covers UINT16_MAX >> grid_shift + 1, so the upper point always exists
+	uint32_t point_idx = (uint32_t)lut_count >> lut_ptr->grid_shift;
+	uint32_t fraction = (uint32_t)lut_count & ((1UL << lut_ptr->grid_shift) - 1UL);
+	int32_t lower_value = lut_ptr->values_q16_ptr[point_idx];
+	int32_t upper_value = lut_ptr->values_q16_ptr[point_idx + 1U];
+
+	return lower_value + (int32_t)((((int64_t)upper_value - lower_value) * (int64_t)fraction) >> lut_ptr->grid_shift);
+}
+
+static int64_t find_adc_sensor_calibration_lut_count(uint8_t sensor_id, float sensor_value)
+{
+	const adc_sensor_calibration_lut_t *lut_ptr = m_sensor_calibration_luts[sensor_id];
+	double scaled_value = (double)sensor_value * (double)(1UL << ADC_SENSOR_VALUE_FRACTION_BITS);
+
+	// every table value is an int32_t, a value beyond that range lies outside the table anyway
+	if(scaled_value > (double)INT32_MAX)
+	{
+		scaled_value = (double)INT32_MAX;
+	}
+	else if(scaled_value < (double)INT32_MIN)
+	{
+		scaled_value = (double)INT32_MIN;
+	}
+
+	int64_t value_q16 = (int64_t)(scaled_value + ((scaled_value < 0.0) ? -0.5 : 0.5));
+	int64_t first_value = lut_ptr->values_q16_ptr[0];
+	int64_t last_value = lut_ptr->values_q16_ptr[lut_ptr->point_cnt - 1U];
+	int64_t first_distance = (value_q16 > first_value) ? (value_q16 - first_value) : (first_value - value_q16);
+	int64_t last_distance = (value_q16 > last_value) ? (value_q16 - last_value) : (last_value - value_q16);
+	int64_t lut_count = (first_distance <= last_distance) ? 0 : (int64_t)UINT16_MAX;
+
+	for(uint32_t point_idx = 0U; (point_idx + 1U) < lut_ptr->point_cnt; point_idx++)
+	{
+		int64_t lower_value = lut_ptr->values_q16_ptr[point_idx];
+		int64_t upper_value = lut_ptr->values_q16_ptr[point_idx + 1U];
+
+		// the table may fall as well as rise
+		if(((value_q16 < lower_value) || (value_q16 > upper_value)) &&
+		   ((value_q16 > lower_value) || (value_q16 < upper_value)))
+		{
+			continue;
+		}
+
+		lut_count = (int64_t)point_idx << lut_ptr->grid_shift;
+
+		if(upper_value != lower_value)
+		{
+			lut_count += ((value_q16 - lower_value) * ((int64_t)1 << lut_ptr->grid_shift)) / (upper_value - lower_value);
+		}
+
+		break;
+	}
+
+	return lut_count - m_sensor_lut_count_offsets[sensor_id];
+}
+
+static bool is_adc_sensor_calibration_lut_valid(const adc_sensor_calibration_lut_t *lut_ptr)
+{
+	if(NULL == lut_ptr)
+	{
+		return true;
+	}
+
+	return (NULL != lut_ptr->values_q16_ptr) &&
+		   (lut_ptr->grid_shift >= 1U) &&
+		   (lut_ptr->grid_shift <= ADC_SENSOR_CALIBRATION_LUT_GRID_SHIFT_MAX) &&
+		   (ADC_SENSOR_CALIBRATION_LUT_POINT_CNT(lut_ptr->grid_shift) == lut_ptr->point_cnt);
+}
+
+#if (0U != BSP_ADC_DMA_SCAN_ENABLED)
+static void decimate_adc_scan_block(const volatile uint16_t *block_ptr, uint32_t sequence_cnt)
+{
+	for(uint8_t sensor_id = 0U; sensor_id < TOTAL_ADC_SENSOR_ID; sensor_id++)
+	{
+		const adc_sensor_driver_config_t *config_ptr = &m_adc_sensor_driver_configs_ptr[sensor_id];
+
+		if(config_ptr->oversampling_ratio <= 1U)
+		{
+			continue;
+		}
+
+		for(uint32_t sequence_idx = 0U; sequence_idx < sequence_cnt; sequence_idx++)
+		{
+			decimate_adc_sample(sensor_id,
+				block_ptr[(sequence_idx * BSP_ADC_SCAN_CHANNEL_CNT) + config_ptr->scan_channel_idx]);
+		}
+	}
+
+	push_adc_sensor_frame(block_ptr, sequence_cnt);
+}
+
+static void push_adc_sensor_frame(const volatile uint16_t *block_ptr, uint32_t sequence_cnt)
+{
+	if(0U == sequence_cnt)
+	{
+		return;
+	}
+
+	m_scan_sequence_cnt += sequence_cnt;
+
+	uint32_t write_cnt = m_frame_write_cnt;
+	adc_sensor_frame_t *frame_ptr = &m_frame_ring[write_cnt & (ADC_SENSOR_FRAME_RING_LEN - 1U)];
+	const volatile uint16_t *sequence_ptr = &block_ptr[(sequence_cnt - 1U) * BSP_ADC_SCAN_CHANNEL_CNT];
+
+	frame_ptr->timestamp_ms = ADC_SENSOR_SNAPSHOT_TIMESTAMP_FUNC();
+	frame_ptr->scan_sequence_cnt = m_scan_sequence_cnt;
+
+	for(uint8_t sensor_id = 0U; sensor_id < TOTAL_ADC_SENSOR_ID; sensor_id++)
+	{
+		const adc_sensor_driver_config_t *config_ptr = &m_adc_sensor_driver_configs_ptr[sensor_id];
+
+		if((config_ptr->oversampling_ratio > 1U) && (true == m_is_oversampled_count_valid[sensor_id]))
+		{
+			frame_ptr->raw_counts[sensor_id] = m_oversampled_counts[sensor_id];
+		}
+		else
+		{
+			frame_ptr->raw_counts[sensor_id] = compensate_bsp_adc_raw_count(
+				(uint32_t)sequence_ptr[config_ptr->scan_channel_idx] << BSP_ADC_OVERSAMPLING_SHIFT);
+		}
+	}
+
+	// the frame must be complete before the readers see it
+	__DMB();
+	m_frame_write_cnt = write_cnt + 1U;
+}
+
+static void decimate_adc_sample(uint8_t sensor_id, uint32_t raw_count)
+{
+	adc_sensor_decimator_t *decimator_ptr = &m_decimators[sensor_id];
+
+	uint32_t stage_value = raw_count;
+
+	for(uint32_t stage_idx = 0U; stage_idx < decimator_ptr->order; stage_idx++)
+	{
+		decimator_ptr->integrators[stage_idx] += stage_value;
+		stage_value = decimator_ptr->integrators[stage_idx];
+	}
+
+	decimator_ptr->sample_cnt++;
+
+	if(decimator_ptr->sample_cnt < m_adc_sensor_driver_configs_ptr[sensor_id].oversampling_ratio)
+	{
+		return;
+	}
+
+	decimator_ptr->sample_cnt = 0U;
+
+	// the combs run at the decimated rate, a delay of one output is R samples
+	for(uint32_t stage_idx = 0U; stage_idx < decimator_ptr->order; stage_idx++)
+	{
+		uint32_t comb_input = stage_value;
+		stage_value = comb_input - decimator_ptr->comb_delays[stage_idx];
+		decimator_ptr->comb_delays[stage_idx] = comb_input;
+	}
+
+	if(decimator_ptr->output_cnt < decimator_ptr->order)
+	{
+		// the comb delays still hold the start value of the integrators
+		decimator_ptr->output_cnt++;
+
+		if(decimator_ptr->output_cnt < decimator_ptr->order)
+		{
+			return;
+		}
+	}
+
+	// the block holds uncompensated counts, the read functions return compensated ones
+	m_oversampled_counts[sensor_id] = compensate_bsp_adc_raw_count(((stage_value << BSP_ADC_OVERSAMPLING_SHIFT) +
+		(decimator_ptr->gain / 2U)) / decimator_ptr->gain);
+	m_is_oversampled_count_valid[sensor_id] = true;
+}
+#endif
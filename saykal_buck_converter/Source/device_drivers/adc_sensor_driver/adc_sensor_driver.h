@@ -10,9 +10,13 @@
 
 #include "bsp_adc.h"
 #include "adc_sensor_driver_cfg.h"
+#include "stdbool.h"
 
 
-typedef bsp_adc_status_e (*read_sensor_adc_raw_value_function_t)(float *raw_value_ptr);
+/**
+ * @brief Reads the raw count of a sensor in 12.4 fixed point, see read_current_sense_adc_raw_count().
+ */
+typedef bsp_adc_status_e (*read_sensor_adc_raw_count_function_t)(uint16_t *raw_count_ptr);
 
 typedef enum
 {
@@ -22,14 +26,110 @@ typedef enum
 }adc_sensor_state_e;
 
 
+/**
+ * @brief Largest oversampling_ratio, keeps the CIC integrators within 32 bits.
+ */
+#define ADC_SENSOR_OVERSAMPLING_RATIO_MAX	64U
+
+/**
+ * @brief Decimation filter of an oversampled sensor.
+ */
+typedef enum
+{
+	ADC_SENSOR_DECIMATION_BOXCAR_e,	///< Mean of oversampling_ratio consecutive samples
+	ADC_SENSOR_DECIMATION_CIC_e,	///< Second order CIC (sinc^2) over 2 x oversampling_ratio - 1 samples
+
+}adc_sensor_decimation_filter_e;
+
+/**
+ * @brief Points of a calibration table with 2^grid_shift raw counts between two
+ *        points, covering every 16-bit raw count and the upper neighbour of the last one.
+ */
+#define ADC_SENSOR_CALIBRATION_LUT_POINT_CNT(grid_shift)	((UINT16_MAX >> (grid_shift)) + 2U)
+
+/**
+ * @brief Largest grid_shift of a calibration table, at least two points are interpolated.
+ */
+#define ADC_SENSOR_CALIBRATION_LUT_GRID_SHIFT_MAX	15U
+
+/**
+ * @brief Converts a sensor value into a calibration table entry, Q16.16 fixed point.
+ */
+#define ADC_SENSOR_CALIBRATION_LUT_VALUE(value)	\
+	((int32_t)(((value) * 65536.0) + (((value) < 0.0) ? -0.5 : 0.5)))
+
+/**
+ * @brief Piecewise-linear conversion of a sensor on a uniform raw count grid.
+ *
+ * Point n holds the sensor value at the raw count n << grid_shift of a sensor
+ * whose zero output is reference_voltage_for_zero_output. A raw count is
+ * converted by indexing the point below it with a shift and interpolating
+ * towards the next point, without any search. For example a table with
+ * 1024 counts (64 ADC LSBs) between points:
+ * @code
+ *     static const int32_t m_divider_lut_values[ADC_SENSOR_CALIBRATION_LUT_POINT_CNT(10U)] =
+ *     {
+ *         ADC_SENSOR_CALIBRATION_LUT_VALUE(0.0), ADC_SENSOR_CALIBRATION_LUT_VALUE(0.749), ...
+ *     };
+ *
+ *     static const adc_sensor_calibration_lut_t m_divider_lut =
+ *     {
+ *         .values_q16_ptr = m_divider_lut_values,
+ *         .point_cnt = ADC_SENSOR_CALIBRATION_LUT_POINT_CNT(10U),
+ *         .grid_shift = 10U
+ *     };
+ * @endcode
+ */
+typedef struct{
+	const int32_t *values_q16_ptr;			///< Sensor value of every point, Q16.16 fixed point
+	uint16_t point_cnt;						///< Entries of values_q16_ptr, ADC_SENSOR_CALIBRATION_LUT_POINT_CNT(grid_shift)
+	uint8_t grid_shift;						///< log2 of the raw counts between two points, 1..ADC_SENSOR_CALIBRATION_LUT_GRID_SHIFT_MAX
+
+}adc_sensor_calibration_lut_t;
+
 typedef struct{
-	read_sensor_adc_raw_value_function_t read_adc_sensor_raw_voltage_func;
+	read_sensor_adc_raw_count_function_t read_adc_sensor_raw_count_func;
 	float sensitivity_volt_per_output_unit;
 	float raw_voltage_factor;
 	float reference_voltage_for_zero_output;
+	uint8_t scan_channel_idx;				///< Channel of the sensor in the DMA scan (BSP_ADC_xxx_SCAN_IDX)
+	uint8_t oversampling_ratio;				///< Scan samples per decimated value, 0 or 1 reads the latest sample
+	adc_sensor_decimation_filter_e decimation_filter;
+	uint16_t zero_calibration_sample_cnt;	///< Samples averaged by calibrate_adc_sensor_zero_counts(), 0 keeps reference_voltage_for_zero_output
+	float zero_calibration_tolerance_v;		///< Largest accepted distance of the measured zero output from reference_voltage_for_zero_output
+	const adc_sensor_calibration_lut_t *calibration_lut_ptr;	///< Replaces the linear conversion if not NULL
 
 }adc_sensor_driver_config_t;
 
+/**
+ * @brief Values of all sensors taken from the same ADC scan sequence.
+ */
+typedef struct{
+	uint32_t timestamp_ms;							///< ADC_SENSOR_SNAPSHOT_TIMESTAMP_FUNC at the acquisition
+	float values[TOTAL_ADC_SENSOR_ID];				///< Sensor values, valid where states is ADC_SENSOR_OK_e
+	adc_sensor_state_e states[TOTAL_ADC_SENSOR_ID];	///< Read state of every sensor
+
+}adc_sensor_snapshot_t;
+
+/**
+ * @brief Raw counts of all sensors pushed by the DMA interrupt for every scan block.
+ */
+typedef struct{
+	uint32_t timestamp_ms;							///< ADC_SENSOR_SNAPSHOT_TIMESTAMP_FUNC at the end of the block
+	uint32_t scan_sequence_cnt;						///< Scan sequences converted since initialization, including this one
+	uint16_t raw_counts[TOTAL_ADC_SENSOR_ID];		///< 12.4 fixed point counts, see read_adc_sensor_raw_count()
+
+}adc_sensor_frame_t;
+
+/**
+ * @brief Read cursor of one consumer of the frame ring, owned by the consumer.
+ */
+typedef struct{
+	uint32_t read_cnt;								///< Frames pushed before the next frame to read
+	uint32_t lost_frame_cnt;						///< Frames overwritten before this consumer read them
+
+}adc_sensor_frame_reader_t;
+
 
 /**
  * @brief Initializes the ADC sensor driver with the provided configuration.
@@ -38,6 +138,14 @@ typedef struct{
  * that contain the necessary calibration and function references to read and convert
  * sensor values.
  * 
+ * With BSP_ADC_DMA_SCAN_ENABLED every sensor with an oversampling_ratio above 1
+ * is decimated in the DMA interrupt: each completed scan block feeds the
+ * samples of its scan channel into the decimation filter, which outputs one
+ * 16-bit value (12.4 fixed point counts) per oversampling_ratio samples.
+ * Averaging N samples of uncorrelated noise lowers it by sqrt(N), the CIC
+ * filter additionally attenuates the switching ripple with a sinc^2 response.
+ * Without the DMA scan the ratio is ignored.
+ *
  * @param[in] adc_sensors_config Pointer to an array of ADC sensor driver configuration structures.
  *                               Must not be NULL.
  * 
@@ -56,6 +164,15 @@ void init_adc_sensor_driver(const adc_sensor_driver_config_t *adc_sensors_config
  * @code
  *     sensor_value = ((raw_voltage * raw_voltage_factor) - reference_voltage) / sensitivity
  * @endcode
+ *
+ * An oversampled sensor uses the latest decimated value as raw_voltage, or
+ * the latest sample until the filter produced its first value. A sensor
+ * calibrated by calibrate_adc_sensor_zero_counts() uses the measured zero
+ * output instead of reference_voltage.
+ * The formula is folded into one gain and offset per sensor at initialization,
+ * the read is read_adc_sensor_raw_count() followed by convert_adc_sensor_raw_count().
+ * A sensor with a calibration_lut_ptr is converted by its table instead; the
+ * linear parameters then only serve the zero calibration.
  * 
  * @param[in]  sensor_id         Index of the sensor in the configuration array (used as a unique ID).
  * @param[out] sensor_value_ptr Pointer to a float variable where the calculated sensor value will be stored.
@@ -65,5 +182,143 @@ void init_adc_sensor_driver(const adc_sensor_driver_config_t *adc_sensors_config
  */
 adc_sensor_state_e read_adc_sensor_value(uint8_t sensor_id , float *sensor_value_ptr);
 
+/**
+ * @brief Reads the raw count a sensor value is converted from.
+ *
+ * The count is the latest decimated value of an oversampled sensor, otherwise
+ * the latest conversion; either way in 12.4 fixed point counts compensated for
+ * the supply voltage (compensate_bsp_adc_raw_count()). The sample is recorded
+ * by the ADC trace.
+ *
+ * @param[in]  sensor_id     Index of the sensor in the configuration array.
+ * @param[out] raw_count_ptr Pointer to store the raw count. Must not be NULL.
+ *
+ * @retval ADC_SENSOR_OK_e if the count was read.
+ * @retval ADC_SENSOR_ERROR_e if the ADC read failed, the driver is not
+ *         initialized or the sensor ID is out of range.
+ */
+adc_sensor_state_e read_adc_sensor_raw_count(uint8_t sensor_id, uint16_t *raw_count_ptr);
+
+/**
+ * @brief Converts a raw count of a sensor with one float multiply-add.
+ *
+ * A sensor with a calibration table interpolates between two table points
+ * instead, see adc_sensor_calibration_lut_t.
+ *
+ * @param[in] sensor_id Index of the sensor in the configuration array.
+ * @param[in] raw_count Raw count of read_adc_sensor_raw_count().
+ * @return float Sensor value in the unit of the sensor, 0 for an out of range sensor ID.
+ */
+float convert_adc_sensor_raw_count(uint8_t sensor_id, uint16_t raw_count);
+
+/**
+ * @brief Converts a raw count of a sensor with one 64-bit integer multiply-add.
+ *
+ * The gain and offset are held in Q32.32, so the result has the precision of
+ * the float conversion without any floating point operation. A calibration
+ * table is interpolated in integers as well.
+ *
+ * @param[in] sensor_id Index of the sensor in the configuration array.
+ * @param[in] raw_count Raw count of read_adc_sensor_raw_count().
+ * @return int32_t Sensor value in the unit of the sensor, Q16.16 fixed point, 0
+ *         for an out of range sensor ID.
+ */
+int32_t convert_adc_sensor_raw_count_q16(uint8_t sensor_id, uint16_t raw_count);
+
+/**
+ * @brief Converts a sensor value back to the raw count it is read from.
+ *
+ * The inverse of convert_adc_sensor_raw_count(), including the calibrated zero
+ * output and the calibration table, e.g. to program a hardware threshold. A
+ * table is searched point by point, so it is meant for initialization.
+ *
+ * @param[in] sensor_id    Index of the sensor in the configuration array.
+ * @param[in] sensor_value Sensor value in the unit of the sensor.
+ * @return uint16_t Raw count in 12.4 fixed point, saturated to 0..UINT16_MAX.
+ */
+uint16_t convert_adc_sensor_value_to_raw_count(uint8_t sensor_id, float sensor_value);
+
+/**
+ * @brief Measures the zero output of every sensor with a zero_calibration_sample_cnt.
+ *
+ * Must be called while the measured quantity is zero, e.g. the output current
+ * before the MOSFET PWM starts. Takes one sample of every calibrated sensor per
+ * millisecond with ADC_SENSOR_ZERO_CALIBRATION_DELAY_FUNC, so it blocks for the
+ * largest zero_calibration_sample_cnt in milliseconds. The mean count replaces
+ * reference_voltage_for_zero_output in the conversion of the sensor, unless a
+ * read failed or the mean is more than zero_calibration_tolerance_v away from
+ * it; such a sensor keeps the configured reference. The calibration table of a
+ * sensor is shifted by the distance of the measured zero count from the count
+ * of reference_voltage_for_zero_output.
+ *
+ * @retval ADC_SENSOR_OK_e if every sensor was calibrated.
+ * @retval ADC_SENSOR_ERROR_e if any sensor keeps its configured reference.
+ */
+adc_sensor_state_e calibrate_adc_sensor_zero_counts(void);
+
+/**
+ * @brief Sets the zero output count of a sensor, e.g. to the count of a recording.
+ *
+ * @param[in] sensor_id  Index of the sensor in the configuration array.
+ * @param[in] zero_count Raw count of a zero sensor value in 12.4 fixed point
+ *                       counts, 0 returns to reference_voltage_for_zero_output.
+ */
+void set_adc_sensor_zero_count(uint8_t sensor_id, uint16_t zero_count);
+
+/**
+ * @brief Returns the zero output count a sensor was calibrated to.
+ *
+ * @param[in] sensor_id Index of the sensor in the configuration array.
+ * @return uint16_t Raw count of a zero sensor value, 0 if the sensor uses
+ *         reference_voltage_for_zero_output.
+ */
+uint16_t get_adc_sensor_zero_count(uint8_t sensor_id);
+
+/**
+ * @brief Reads every configured sensor into one snapshot.
+ *
+ * With BSP_ADC_DMA_SCAN_ENABLED all sensors without oversampling come from a
+ * copy of one scan sequence, so the output voltage and current belong to the
+ * same instant. Oversampled sensors return their decimated value of that
+ * moment, copied together with the sequence, so no sensor changes while the
+ * snapshot is converted. Each sensor is converted like read_adc_sensor_value()
+ * and recorded by the trace.
+ *
+ * @param[out] snapshot_ptr Snapshot to fill. Must not be NULL.
+ *
+ * @retval ADC_SENSOR_OK_e if every sensor was read.
+ * @retval ADC_SENSOR_ERROR_e if any sensor failed, see snapshot_ptr->states.
+ */
+adc_sensor_state_e read_all_adc_sensor_values(adc_sensor_snapshot_t *snapshot_ptr);
+
+/**
+ * @brief Starts a consumer of the frame ring at the next frame to be pushed.
+ *
+ * With BSP_ADC_DMA_SCAN_ENABLED the DMA interrupt pushes one frame per
+ * completed scan block into a ring of ADC_SENSOR_FRAME_RING_LEN frames: the
+ * last sequence of the block for sensors without oversampling, the latest
+ * decimated value otherwise. The interrupt never waits for the consumers, each
+ * consumer (control loop, telemetry, temperature task, ...) reads at its own
+ * rate with its own reader and no lock. Without the DMA scan no frame is pushed.
+ *
+ * @param[out] reader_ptr Reader to start. Must not be NULL.
+ */
+void init_adc_sensor_frame_reader(adc_sensor_frame_reader_t *reader_ptr);
+
+/**
+ * @brief Copies the oldest frame a consumer has not read yet.
+ *
+ * A consumer more than ADC_SENSOR_FRAME_RING_LEN - 1 frames behind skips to
+ * the oldest frame still in the ring; the skipped frames are added to
+ * lost_frame_cnt. A frame the interrupt overwrote during the copy is counted
+ * as lost as well and not returned, so a returned frame is never torn.
+ *
+ * @param[in,out] reader_ptr Reader of the consumer. Must not be NULL.
+ * @param[out]    frame_ptr  Frame to fill. Must not be NULL.
+ *
+ * @retval true  A frame was copied.
+ * @retval false No new frame, or the frame was overwritten during the copy.
+ */
+bool read_adc_sensor_frame(adc_sensor_frame_reader_t *reader_ptr, adc_sensor_frame_t *frame_ptr);
 
 #endif /* ADC_SENSOR_DRIVER_CS_H_ */
@@ -0,0 +1,260 @@
+/**
+ * @file adc_trace_recorder.c
+ * @brief Black box recorder of the raw ADC sensor samples.
+ *
+ * The ring buffer is addressed with free running write and read counters, the
+ * buffer index is the counter modulo the capacity. The write counter is only
+ * written by the producer, the interrupt recording the samples, the read
+ * counter and the overwritten count only by the consumer in the main loop.
+ * The producer always overwrites the oldest record. The consumer skips the
+ * records the producer already overwrote and, after copying, drops the copied
+ * records the producer may have overwritten during the copy.
+ *
+ * @date Oct 17, 2026
+ */
+
+#include "adc_trace_recorder.h"
+#include "adc_sensor_driver_cfg.h"
+#include "error_manager.h"
+#include "stddef.h"
+#include "string.h"
+
+/** @brief Resolution of the recorded counts, 12-bit ADC counts with 4 oversampling fraction bits. */
+#define ADC_TRACE_RAW_COUNT_BITS	16U
+
+_Static_assert(TOTAL_ADC_SENSOR_ID <= ADC_TRACE_ZERO_COUNT_CNT,
+			   "the trace file header holds ADC_TRACE_ZERO_COUNT_CNT zero counts");
+
+/**
+ * @brief Active recorder configuration, NULL before initialization.
+ */
+static const adc_trace_recorder_cfg_t *m_adc_trace_recorder_cfg_ptr = NULL;
+
+/**
+ * @brief Number of records written since initialization.
+ */
+static volatile uint32_t m_adc_trace_write_cnt = 0U;
+
+/**
+ * @brief Number of records read or skipped since initialization, written by the consumer only.
+ */
+static uint32_t m_adc_trace_read_cnt = 0U;
+
+/**
+ * @brief Records overwritten before they were read, written by the consumer only.
+ */
+static uint32_t m_adc_trace_overwritten_cnt = 0U;
+
+/**
+ * @brief Skips the records the producer overwrote since the last read.
+ *
+ * @param[in] write_cnt Write counter sampled by the consumer.
+ */
+static void skip_overwritten_adc_trace_records(uint32_t write_cnt);
+
+/**
+ * @brief Records still stored before the recorder freezes, valid while triggered.
+ */
+static uint32_t m_adc_trace_post_trigger_remaining_cnt = 0U;
+
+static bool m_is_adc_trace_triggered = false;
+
+static volatile bool m_is_adc_trace_frozen = false;
+
+/**
+ * @brief Zero output counts the sensors were calibrated to, 0 if not calibrated.
+ */
+static uint16_t m_adc_trace_zero_counts[TOTAL_ADC_SENSOR_ID];
+
+void init_adc_trace_recorder(const adc_trace_recorder_cfg_t *recorder_cfg_ptr)
+{
+	if((NULL == recorder_cfg_ptr) ||
+	   (NULL == recorder_cfg_ptr->record_buffer_ptr) ||
+	   (0U == recorder_cfg_ptr->record_capacity) ||
+	   (NULL == recorder_cfg_ptr->get_timestamp_func))
+	{
+		report_development_error();
+		return;
+	}
+
+	m_adc_trace_write_cnt = 0U;
+	m_adc_trace_read_cnt = 0U;
+	m_adc_trace_overwritten_cnt = 0U;
+	m_adc_trace_post_trigger_remaining_cnt = 0U;
+	m_is_adc_trace_triggered = false;
+	m_is_adc_trace_frozen = false;
+	memset(m_adc_trace_zero_counts, 0, sizeof(m_adc_trace_zero_counts));
+	m_adc_trace_recorder_cfg_ptr = recorder_cfg_ptr;
+}
+
+void record_adc_trace_sample(uint8_t sensor_id, adc_trace_sample_status_e status, uint16_t raw_count)
+{
+	const adc_trace_recorder_cfg_t *recorder_cfg_ptr = m_adc_trace_recorder_cfg_ptr;
+
+	if((NULL == recorder_cfg_ptr) || (true == m_is_adc_trace_frozen))
+	{
+		return;
+	}
+
+	uint32_t write_cnt = m_adc_trace_write_cnt;
+
+	adc_trace_record_t *record_ptr =
+		&recorder_cfg_ptr->record_buffer_ptr[write_cnt % recorder_cfg_ptr->record_capacity];
+
+	record_ptr->timestamp = recorder_cfg_ptr->get_timestamp_func();
+	record_ptr->raw_count = raw_count;
+	record_ptr->sensor_id = sensor_id;
+	record_ptr->status = (uint8_t)status;
+
+	m_adc_trace_write_cnt = write_cnt + 1U;
+
+	if(true == m_is_adc_trace_triggered)
+	{
+		if(0U == m_adc_trace_post_trigger_remaining_cnt)
+		{
+			m_is_adc_trace_frozen = true;
+		}
+		else
+		{
+			m_adc_trace_post_trigger_remaining_cnt--;
+		}
+	}
+}
+
+void set_adc_trace_zero_count(uint8_t sensor_id, uint16_t zero_count)
+{
+	if(sensor_id >= TOTAL_ADC_SENSOR_ID)
+	{
+		report_development_error();
+		return;
+	}
+
+	m_adc_trace_zero_counts[sensor_id] = zero_count;
+}
+
+void trigger_adc_trace_recorder(void)
+{
+	if((NULL == m_adc_trace_recorder_cfg_ptr) || (true == m_is_adc_trace_triggered))
+	{
+		return;
+	}
+
+	m_adc_trace_post_trigger_remaining_cnt = m_adc_trace_recorder_cfg_ptr->post_trigger_record_cnt;
+	m_is_adc_trace_triggered = true;
+
+	if(0U == m_adc_trace_post_trigger_remaining_cnt)
+	{
+		m_is_adc_trace_frozen = true;
+	}
+}
+
+void restart_adc_trace_recorder(void)
+{
+	m_is_adc_trace_triggered = false;
+	m_is_adc_trace_frozen = false;
+}
+
+bool is_adc_trace_recorder_frozen(void)
+{
+	return m_is_adc_trace_frozen;
+}
+
+uint32_t read_adc_trace_records(adc_trace_record_t *records_ptr, uint32_t max_record_cnt)
+{
+	const adc_trace_recorder_cfg_t *recorder_cfg_ptr = m_adc_trace_recorder_cfg_ptr;
+
+	if(NULL == records_ptr)
+	{
+		report_development_error();
+		return 0U;
+	}
+
+	if(NULL == recorder_cfg_ptr)
+	{
+		return 0U;
+	}
+
+	uint32_t capacity = recorder_cfg_ptr->record_capacity;
+	uint32_t copy_cnt = 0U;
+	uint32_t torn_cnt = 0U;
+
+	// repeats only when the producer overwrote every copied record meanwhile
+	do
+	{
+		skip_overwritten_adc_trace_records(m_adc_trace_write_cnt);
+
+		uint32_t read_cnt = m_adc_trace_read_cnt;
+		uint32_t available_cnt = m_adc_trace_write_cnt - read_cnt;
+		copy_cnt = (available_cnt < max_record_cnt) ? available_cnt : max_record_cnt;
+
+		for(uint32_t record_idx = 0U; record_idx < copy_cnt; record_idx++)
+		{
+			records_ptr[record_idx] = recorder_cfg_ptr->record_buffer_ptr[(read_cnt + record_idx) % capacity];
+		}
+
+		// the record at the write counter may be written right now, so only the
+		// records after write_cnt - capacity are known to be intact
+		uint32_t write_cnt = m_adc_trace_write_cnt;
+		torn_cnt = 0U;
+
+		if((write_cnt - read_cnt) >= capacity)
+		{
+			torn_cnt = (write_cnt - read_cnt) - capacity + 1U;
+			torn_cnt = (torn_cnt < copy_cnt) ? torn_cnt : copy_cnt;
+		}
+
+		m_adc_trace_overwritten_cnt += torn_cnt;
+		m_adc_trace_read_cnt = read_cnt + copy_cnt;
+
+	} while((0U != copy_cnt) && (torn_cnt == copy_cnt));
+
+	if(0U != torn_cnt)
+	{
+		memmove(records_ptr, &records_ptr[torn_cnt], (copy_cnt - torn_cnt) * sizeof(adc_trace_record_t));
+	}
+
+	return copy_cnt - torn_cnt;
+}
+
+void get_adc_trace_file_header(adc_trace_file_header_t *header_ptr)
+{
+	if(NULL == header_ptr)
+	{
+		report_development_error();
+		return;
+	}
+
+	memset(header_ptr, 0, sizeof(*header_ptr));
+
+	header_ptr->magic = ADC_TRACE_FILE_MAGIC;
+	header_ptr->version = ADC_TRACE_FILE_VERSION;
+	header_ptr->header_size = (uint16_t)sizeof(adc_trace_file_header_t);
+	header_ptr->record_size = (uint16_t)sizeof(adc_trace_record_t);
+	header_ptr->sensor_cnt = TOTAL_ADC_SENSOR_ID;
+	header_ptr->raw_count_bits = ADC_TRACE_RAW_COUNT_BITS;
+	memcpy(header_ptr->zero_counts, m_adc_trace_zero_counts, sizeof(m_adc_trace_zero_counts));
+
+	if(NULL != m_adc_trace_recorder_cfg_ptr)
+	{
+		uint32_t write_cnt = m_adc_trace_write_cnt;
+
+		skip_overwritten_adc_trace_records(write_cnt);
+
+		header_ptr->timestamp_frequency_hz = m_adc_trace_recorder_cfg_ptr->timestamp_frequency_hz;
+		header_ptr->record_cnt = write_cnt - m_adc_trace_read_cnt;
+	}
+
+	header_ptr->overwritten_record_cnt = m_adc_trace_overwritten_cnt;
+}
+
+static void skip_overwritten_adc_trace_records(uint32_t write_cnt)
+{
+	uint32_t capacity = m_adc_trace_recorder_cfg_ptr->record_capacity;
+	uint32_t stored_cnt = write_cnt - m_adc_trace_read_cnt;
+
+	if(stored_cnt > capacity)
+	{
+		m_adc_trace_overwritten_cnt += stored_cnt - capacity;
+		m_adc_trace_read_cnt = write_cnt - capacity;
+	}
+}
@@ -0,0 +1,160 @@
+/**
+ * @file adc_trace_recorder.h
+ * @brief Black box recorder of the raw ADC sensor samples.
+ *
+ * Every sample read by the ADC sensor driver is stored as a fixed size record
+ * holding its timestamp, sensor ID, read status and the count the driver
+ * converted, a 12-bit ADC count with 4 fraction bits of oversampling. Records
+ * are kept in a RAM ring buffer that overwrites the oldest record, so the
+ * buffer always holds the history leading up to now. When an incident is
+ * reported the recorder keeps recording a configured number of records and
+ * then freezes, so the buffer holds the samples before and after the incident.
+ *
+ * The records, preceded by the header returned by get_adc_trace_file_header(),
+ * form an ADC trace file: a little-endian, naturally aligned array of fixed size
+ * records that the host build memory maps and replays sample by sample through
+ * the unchanged control loop.
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef ADC_TRACE_RECORDER_H_
+#define ADC_TRACE_RECORDER_H_
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "adc_trace_recorder_cfg.h"
+
+/** @brief "ADCT" read as a little-endian 32-bit word. */
+#define ADC_TRACE_FILE_MAGIC		0x54434441UL
+
+/** @brief Format version, incremented on incompatible changes. */
+#define ADC_TRACE_FILE_VERSION		3U
+
+/** @brief Sensors whose zero count fits in the file header. */
+#define ADC_TRACE_ZERO_COUNT_CNT	8U
+
+/**
+ * @brief Read status of a recorded sample.
+ */
+typedef enum
+{
+	ADC_TRACE_SAMPLE_OK_e = 0,		///< Conversion succeeded, raw_count is valid
+	ADC_TRACE_SAMPLE_ERROR_e = 1,	///< Conversion failed, raw_count is 0
+
+}adc_trace_sample_status_e;
+
+/**
+ * @brief Header at the start of an ADC trace file.
+ */
+typedef struct
+{
+	uint32_t magic;							///< ADC_TRACE_FILE_MAGIC
+	uint16_t version;						///< ADC_TRACE_FILE_VERSION
+	uint16_t header_size;					///< sizeof(adc_trace_file_header_t), offset of the first record
+	uint16_t record_size;					///< sizeof(adc_trace_record_t)
+	uint8_t sensor_cnt;						///< TOTAL_ADC_SENSOR_ID of the recording firmware
+	uint8_t raw_count_bits;					///< Resolution of raw_count, ADC resolution plus oversampling fraction bits
+	uint32_t timestamp_frequency_hz;		///< Frequency of the record timestamps
+	uint32_t record_cnt;					///< Number of records, 0 if the writer did not know it
+	uint32_t overwritten_record_cnt;		///< Records lost before the first record of the file
+	uint16_t zero_counts[ADC_TRACE_ZERO_COUNT_CNT];	///< Calibrated zero output count of every sensor, 0 if not calibrated
+
+}adc_trace_file_header_t;
+
+/**
+ * @brief One recorded sample.
+ */
+typedef struct
+{
+	uint32_t timestamp;						///< Time of the read in timestamp ticks
+	uint16_t raw_count;						///< Conversion result in counts of raw_count_bits
+	uint8_t sensor_id;						///< Sensor ID of adc_sensor_driver_cfg.h
+	uint8_t status;							///< adc_trace_sample_status_e
+
+}adc_trace_record_t;
+
+/**
+ * @brief Returns the current timestamp of the records.
+ */
+typedef uint32_t (*get_adc_trace_timestamp_func_t)(void);
+
+/**
+ * @brief Configuration of the recorder.
+ */
+typedef struct
+{
+	adc_trace_record_t *record_buffer_ptr;				///< Ring buffer of record_capacity records
+	uint32_t record_capacity;							///< Number of records in the ring buffer
+	uint32_t post_trigger_record_cnt;					///< Records stored after an incident before freezing
+	get_adc_trace_timestamp_func_t get_timestamp_func;	///< Timestamp source
+	uint32_t timestamp_frequency_hz;					///< Frequency of get_timestamp_func
+
+}adc_trace_recorder_cfg_t;
+
+/**
+ * @brief Initializes the recorder and empties the ring buffer.
+ *
+ * @param[in] recorder_cfg_ptr Recorder configuration. Must not be NULL.
+ */
+void init_adc_trace_recorder(const adc_trace_recorder_cfg_t *recorder_cfg_ptr);
+
+/**
+ * @brief Stores one sample, overwriting the oldest record if the buffer is full.
+ *
+ * Does nothing before initialization or after the recorder froze.
+ *
+ * @param[in] sensor_id Sensor ID of adc_sensor_driver_cfg.h.
+ * @param[in] status    Read status of the sample.
+ * @param[in] raw_count Count the driver converted, 12.4 fixed point ADC counts.
+ */
+void record_adc_trace_sample(uint8_t sensor_id, adc_trace_sample_status_e status, uint16_t raw_count);
+
+/**
+ * @brief Stores the zero output count a sensor was calibrated to at start-up.
+ *
+ * The count is written to the file header, so a replay converts the recorded
+ * counts with the same offset.
+ *
+ * @param[in] sensor_id  Sensor ID of adc_sensor_driver_cfg.h.
+ * @param[in] zero_count Zero output count, 12.4 fixed point ADC counts.
+ */
+void set_adc_trace_zero_count(uint8_t sensor_id, uint16_t zero_count);
+
+/**
+ * @brief Reports an incident: the recorder freezes after post_trigger_record_cnt more records.
+ *
+ * Only the first incident after initialization or a restart is taken into account.
+ */
+void trigger_adc_trace_recorder(void);
+
+/**
+ * @brief Clears a trigger and resumes recording, keeping the stored records.
+ */
+void restart_adc_trace_recorder(void);
+
+/**
+ * @brief Returns whether the recorder froze after an incident.
+ *
+ * @retval true  No more samples are recorded.
+ * @retval false Samples are recorded.
+ */
+bool is_adc_trace_recorder_frozen(void);
+
+/**
+ * @brief Moves the oldest records out of the ring buffer.
+ *
+ * @param[out] records_ptr    Destination of the records, oldest first.
+ * @param[in]  max_record_cnt Capacity of the destination.
+ * @return uint32_t Number of records copied.
+ */
+uint32_t read_adc_trace_records(adc_trace_record_t *records_ptr, uint32_t max_record_cnt);
+
+/**
+ * @brief Fills the header of a trace file holding the records currently buffered.
+ *
+ * @param[out] header_ptr Header to fill.
+ */
+void get_adc_trace_file_header(adc_trace_file_header_t *header_ptr);
+
+#endif /* ADC_TRACE_RECORDER_H_ */
@@ -17,16 +17,31 @@ typedef struct{
 
 }software_timer_t;
 
+typedef struct{
+
+	uint64_t total_cycles;
+	uint32_t call_cnt;
+	uint32_t min_cycles;
+	uint32_t max_cycles;
+
+}software_timer_exec_record_t;
+
 #ifndef SOFTWARE_TIMER_CNT
 #define SOFTWARE_TIMER_CNT 0U
 #endif
 
 static software_timer_t m_software_timers[SOFTWARE_TIMER_CNT];
 
+static software_timer_exec_record_t m_software_timer_exec_records[SOFTWARE_TIMER_CNT];
+
+static uint32_t m_software_timer_exec_stats_reset_tick;
+
 static software_timer_general_cfg_t *m_software_timer_general_config_ptr;
 
 static void timer_timeout_process(software_timer_id_t sw_timer_id);
 
+static void record_timer_exec_cycles(software_timer_id_t sw_timer_id, uint32_t exec_cycles);
+
 void init_software_timer_module(const software_timer_general_cfg_t *timer_general_cfg_ptr)
 {
 	if(NULL == timer_general_cfg_ptr)
@@ -35,6 +50,8 @@ void init_software_timer_module(const software_timer_general_cfg_t *timer_genera
 		return;
 	}
 	m_software_timer_general_config_ptr = (software_timer_general_cfg_t*)timer_general_cfg_ptr;
+
+	reset_software_timer_exec_stats();
 }
 
 void start_software_timer(software_timer_id_t sw_timer_id,uint32_t timeout_value)
@@ -65,8 +82,18 @@ void stop_software_timer(software_timer_id_t sw_timer_id)
 
 void run_all_software_timers(void)
 {
+	uint32_t current_tick = m_software_timer_general_config_ptr->get_timer_tick_ms_func();
+
 	for(uint8_t timer_idx = 0U; timer_idx < SOFTWARE_TIMER_CNT; timer_idx++)
 	{
+		// unsigned subtraction keeps the elapsed time correct across tick wraparound
+		if((TIMER_STATE_RUNNING_e == m_software_timers[timer_idx].state) &&
+		   ((current_tick - m_software_timers[timer_idx].start_tick) >=
+			m_software_timers[timer_idx].timeout_value))
+		{
+			m_software_timers[timer_idx].state = TIMER_STATE_TIMEOUT_e;
+		}
+
 		if(TIMER_STATE_TIMEOUT_e == m_software_timers[timer_idx].state)
 		{
 			timer_timeout_process(timer_idx);
@@ -85,6 +112,54 @@ timer_state_e check_status_of_software_timer(software_timer_id_t sw_timer_id)
 	return m_software_timers[sw_timer_id].state;
 }
 
+bool get_software_timer_exec_stats(software_timer_id_t sw_timer_id,
+								   software_timer_exec_stats_t *exec_stats_ptr)
+{
+	if((sw_timer_id >= SOFTWARE_TIMER_CNT) || (NULL == exec_stats_ptr))
+	{
+		report_development_error();
+		return false;
+	}
+
+	if((NULL == m_software_timer_general_config_ptr) ||
+	   (NULL == m_software_timer_general_config_ptr->get_cycle_cnt_func))
+	{
+		return false;
+	}
+
+	const software_timer_exec_record_t *exec_record_ptr = &m_software_timer_exec_records[sw_timer_id];
+
+	exec_stats_ptr->call_cnt = exec_record_ptr->call_cnt;
+	exec_stats_ptr->min_cycles = (0U == exec_record_ptr->call_cnt) ? 0U : exec_record_ptr->min_cycles;
+	exec_stats_ptr->max_cycles = exec_record_ptr->max_cycles;
+	exec_stats_ptr->mean_cycles = (0U == exec_record_ptr->call_cnt) ? 0U :
+		(uint32_t)(exec_record_ptr->total_cycles / exec_record_ptr->call_cnt);
+	exec_stats_ptr->total_cycles = exec_record_ptr->total_cycles;
+	exec_stats_ptr->measured_time_ms =
+		m_software_timer_general_config_ptr->get_timer_tick_ms_func() - m_software_timer_exec_stats_reset_tick;
+	exec_stats_ptr->cycle_frequency_hz =
+		(NULL != m_software_timer_general_config_ptr->get_cycle_frequency_hz_func) ?
+		m_software_timer_general_config_ptr->get_cycle_frequency_hz_func() : 0U;
+
+	return true;
+}
+
+void reset_software_timer_exec_stats(void)
+{
+	if(NULL != m_software_timer_general_config_ptr)
+	{
+		m_software_timer_exec_stats_reset_tick = m_software_timer_general_config_ptr->get_timer_tick_ms_func();
+	}
+
+	for(uint8_t timer_idx = 0U; timer_idx < SOFTWARE_TIMER_CNT; timer_idx++)
+	{
+		m_software_timer_exec_records[timer_idx].total_cycles = 0U;
+		m_software_timer_exec_records[timer_idx].call_cnt = 0U;
+		m_software_timer_exec_records[timer_idx].min_cycles = UINT32_MAX;
+		m_software_timer_exec_records[timer_idx].max_cycles = 0U;
+	}
+}
+
 static void timer_timeout_process(software_timer_id_t sw_timer_id)
 {
 	timer_timeout_cb_func_t timer_callback_func =
@@ -93,7 +168,22 @@ static void timer_timeout_process(software_timer_id_t sw_timer_id)
 
 	if(NULL != timer_callback_func)
 	{
-		timer_callback_func(sw_timer_id);
+		get_timer_cycle_cnt_func_t get_cycle_cnt_func =
+				m_software_timer_general_config_ptr->get_cycle_cnt_func;
+
+		if(NULL != get_cycle_cnt_func)
+		{
+			uint32_t start_cycle = get_cycle_cnt_func();
+
+			timer_callback_func(sw_timer_id);
+
+			// unsigned subtraction keeps the cycle count correct across counter wraparound
+			record_timer_exec_cycles(sw_timer_id, get_cycle_cnt_func() - start_cycle);
+		}
+		else
+		{
+			timer_callback_func(sw_timer_id);
+		}
 	}
 
 	timer_reload_option_e timer_reload_option =
@@ -121,3 +211,21 @@ static void timer_timeout_process(software_timer_id_t sw_timer_id)
 		/* MISRA */
 	}
 }
+
+static void record_timer_exec_cycles(software_timer_id_t sw_timer_id, uint32_t exec_cycles)
+{
+	software_timer_exec_record_t *exec_record_ptr = &m_software_timer_exec_records[sw_timer_id];
+
+	exec_record_ptr->total_cycles += exec_cycles;
+	exec_record_ptr->call_cnt++;
+
+	if(exec_cycles < exec_record_ptr->min_cycles)
+	{
+		exec_record_ptr->min_cycles = exec_cycles;
+	}
+
+	if(exec_cycles > exec_record_ptr->max_cycles)
+	{
+		exec_record_ptr->max_cycles = exec_cycles;
+	}
+}
@@ -9,12 +9,17 @@
 #define SOFTWARE_TIMER_SOFTWARE_TIMER_H_
 
 #include "stdint.h"
+#include "stdbool.h"
 #include "software_timer_cfg.h"
 
 
 
 typedef uint32_t (*get_timer_tick_ms_func_t)(void);
 
+typedef uint32_t (*get_timer_cycle_cnt_func_t)(void); // free running cycle counter, wraps at 2^32
+
+typedef uint32_t (*get_timer_cycle_frequency_hz_func_t)(void);
+
 typedef uint8_t software_timer_id_t;
 
 typedef void (*timer_timeout_cb_func_t)(software_timer_id_t sw_timer_id);
@@ -47,9 +52,26 @@ typedef struct{
 
 	const software_timer_cfg_t *software_timer_cfg_ptr;
 	get_timer_tick_ms_func_t get_timer_tick_ms_func;
+	get_timer_cycle_cnt_func_t get_cycle_cnt_func; // optional, NULL disables the callback execution time statistics
+	get_timer_cycle_frequency_hz_func_t get_cycle_frequency_hz_func;
 
 }software_timer_general_cfg_t;
 
+/**
+ * @brief Execution time statistics of the timeout callback of one software timer.
+ */
+typedef struct{
+
+	uint32_t call_cnt;				///< Number of measured callback executions
+	uint32_t min_cycles;			///< Shortest execution, 0 if call_cnt is 0
+	uint32_t max_cycles;			///< Longest execution
+	uint32_t mean_cycles;			///< Mean execution
+	uint64_t total_cycles;			///< Sum of all executions
+	uint32_t measured_time_ms;		///< Time since start-up or the last reset, for the share of the CPU time
+	uint32_t cycle_frequency_hz;	///< Cycle counter frequency to convert the cycles to time
+
+}software_timer_exec_stats_t;
+
 void init_software_timer_module(const software_timer_general_cfg_t *timer_general_cfg_ptr);
 
 void start_software_timer(software_timer_id_t sw_timer_id,uint32_t timeout_value);
@@ -60,4 +82,20 @@ void run_all_software_timers(void);
 
 timer_state_e check_status_of_software_timer(software_timer_id_t sw_timer_id);
 
+/**
+ * @brief Returns the execution time statistics of the timeout callback of a timer.
+ *
+ * @param[in]  sw_timer_id    Software timer id.
+ * @param[out] exec_stats_ptr Statistics since start-up or the last reset.
+ * @retval true  Statistics are valid.
+ * @retval false Invalid id or no cycle counter configured.
+ */
+bool get_software_timer_exec_stats(software_timer_id_t sw_timer_id,
+								   software_timer_exec_stats_t *exec_stats_ptr);
+
+/**
+ * @brief Clears the execution time statistics of all timers.
+ */
+void reset_software_timer_exec_stats(void);
+
 #endif /* SOFTWARE_TIMER_SOFTWARE_TIMER_H_ */
@@ -1,5 +1,15 @@
 
 #include "pid_controller.h"
+#include "pid_saturating_math.h"
+
+// Largest gain shift, keeps the product shift of mul_pid_q31() positive
+#define PID_Q31_GAIN_SHIFT_MAX      30U
+
+static float clamp_pid_output(float value, float output_min, float output_max);
+static int32_t clamp_pid_output_q31(int32_t value, int32_t output_min, int32_t output_max);
+static int32_t mul_pid_q31(int32_t value, int32_t gain_q31, uint8_t gain_shift);
+static int32_t get_pid_weighted_error_q31(const pid_controller_q31_t *pid_q31_ptr,
+                                          int32_t sensed_value, int32_t reference_point);
 
 float PID_Step(pid_controller_t *pid_parameters_ptr, float sensed_value, float reference_point)
 {
@@ -19,7 +29,7 @@ float PID_Step(pid_controller_t *pid_parameters_ptr, float sensed_value, float r
         (pid_parameters_ptr->command_sat_prev - pid_parameters_ptr->command_prev)*
         pid_parameters_ptr->TimeStep;
     
-    /* Derivative term calculation using filtered derivative method */
+    /* Derivative term calculation, unfiltered difference of the error */
     derivation_measure = (calculated_error - pid_parameters_ptr->error_previous )/(pid_parameters_ptr->TimeStep);
     pid_parameters_ptr->error_previous = calculated_error;
 
@@ -49,3 +59,232 @@ float PID_Step(pid_controller_t *pid_parameters_ptr, float sensed_value, float r
     return command_sat;
 }
 
+
+void init_pid_controller_v2(pid_controller_v2_t *pid_v2_ptr, const pid_controller_t *pid_parameters_ptr)
+{
+    float derivative_time = pid_parameters_ptr->derivative_filter_time + pid_parameters_ptr->TimeStep;
+
+    pid_v2_ptr->Kp = pid_parameters_ptr->Kp;
+    pid_v2_ptr->setpoint_weight = pid_parameters_ptr->setpoint_weight;
+    pid_v2_ptr->Ki_step = pid_parameters_ptr->Ki * pid_parameters_ptr->TimeStep;
+    pid_v2_ptr->Kaw_step = pid_parameters_ptr->Kaw * pid_parameters_ptr->TimeStep;
+    pid_v2_ptr->derivative_pole = pid_parameters_ptr->derivative_filter_time / derivative_time;
+    pid_v2_ptr->Kd_step = pid_parameters_ptr->Kd / derivative_time;
+    pid_v2_ptr->controller_output_max = pid_parameters_ptr->controller_output_max;
+    pid_v2_ptr->controller_output_min = pid_parameters_ptr->controller_output_min;
+    pid_v2_ptr->integral = 0.0f;
+    pid_v2_ptr->derivative = 0.0f;
+    pid_v2_ptr->sensed_previous = 0.0f;
+    pid_v2_ptr->windup = 0.0f;
+}
+
+float PID_Step_v2(pid_controller_v2_t *pid_v2_ptr, float sensed_value, float reference_point)
+{
+    float command;
+    float command_sat;
+
+    /* Integral term calculation - including anti-windup */
+    pid_v2_ptr->integral += pid_v2_ptr->Ki_step * (reference_point - sensed_value) +
+                            pid_v2_ptr->Kaw_step * pid_v2_ptr->windup;
+
+    /* Filtered derivative of the measurement, a reference step does not kick it */
+    pid_v2_ptr->derivative = pid_v2_ptr->derivative_pole * pid_v2_ptr->derivative -
+                             pid_v2_ptr->Kd_step * (sensed_value - pid_v2_ptr->sensed_previous);
+    pid_v2_ptr->sensed_previous = sensed_value;
+
+    /* Summing the 3 terms, the proportional term with the weighted reference */
+    command = pid_v2_ptr->Kp * (pid_v2_ptr->setpoint_weight * reference_point - sensed_value) +
+              pid_v2_ptr->integral + pid_v2_ptr->derivative;
+
+    command_sat = clamp_pid_output(command, pid_v2_ptr->controller_output_min, pid_v2_ptr->controller_output_max);
+
+    /* Remember the saturation of this step for the anti-windup of the next one */
+    pid_v2_ptr->windup = command_sat - command;
+
+    return command_sat;
+}
+
+void reset_pid_controller_v2(pid_controller_v2_t *pid_v2_ptr, float sensed_value,
+                             float reference_point, float controller_output)
+{
+    float command = clamp_pid_output(controller_output, pid_v2_ptr->controller_output_min,
+                                     pid_v2_ptr->controller_output_max);
+
+    pid_v2_ptr->integral = command - pid_v2_ptr->Kp * (pid_v2_ptr->setpoint_weight * reference_point - sensed_value);
+    pid_v2_ptr->derivative = 0.0f;
+    pid_v2_ptr->sensed_previous = sensed_value;
+    pid_v2_ptr->windup = 0.0f;
+}
+
+void init_pid_controller_q31(pid_controller_q31_t *pid_q31_ptr, const pid_controller_t *pid_parameters_ptr,
+                             uint8_t input_shift, uint8_t output_shift)
+{
+    float scale_ratio = (float)(1UL << input_shift) / (float)(1UL << output_shift);
+    float derivative_time = pid_parameters_ptr->derivative_filter_time + pid_parameters_ptr->TimeStep;
+    float gains[4];
+    float gain_max = 0.0f;
+    uint8_t gain_shift = 0U;
+
+    gains[0] = pid_parameters_ptr->Kp * scale_ratio;
+    gains[1] = pid_parameters_ptr->Ki * pid_parameters_ptr->TimeStep * scale_ratio;
+    gains[2] = (pid_parameters_ptr->Kd / derivative_time) * scale_ratio;
+    gains[3] = pid_parameters_ptr->Kaw * pid_parameters_ptr->TimeStep;
+
+    for (uint8_t gain_idx = 0U; gain_idx < 4U; gain_idx++)
+    {
+        float gain_abs = (gains[gain_idx] < 0.0f) ? -gains[gain_idx] : gains[gain_idx];
+
+        if (gain_abs > gain_max)
+        {
+            gain_max = gain_abs;
+        }
+    }
+
+    /* Smallest common exponent that brings every gain below 1 */
+    while ((gain_shift < PID_Q31_GAIN_SHIFT_MAX) && (gain_max >= (float)(1UL << gain_shift)))
+    {
+        gain_shift++;
+    }
+
+    pid_q31_ptr->Kp_q31 = convert_pid_value_to_q31(gains[0], gain_shift);
+    pid_q31_ptr->Ki_q31 = convert_pid_value_to_q31(gains[1], gain_shift);
+    pid_q31_ptr->Kd_q31 = convert_pid_value_to_q31(gains[2], gain_shift);
+    pid_q31_ptr->Kaw_q31 = convert_pid_value_to_q31(gains[3], gain_shift);
+    pid_q31_ptr->setpoint_weight_q31 = convert_pid_value_to_q31(pid_parameters_ptr->setpoint_weight, 0U);
+    pid_q31_ptr->derivative_pole_q31 =
+        convert_pid_value_to_q31(pid_parameters_ptr->derivative_filter_time / derivative_time, 0U);
+    pid_q31_ptr->gain_shift = gain_shift;
+    pid_q31_ptr->controller_output_max = convert_pid_value_to_q31(pid_parameters_ptr->controller_output_max, output_shift);
+    pid_q31_ptr->controller_output_min = convert_pid_value_to_q31(pid_parameters_ptr->controller_output_min, output_shift);
+    pid_q31_ptr->integral = 0;
+    pid_q31_ptr->derivative = 0;
+    pid_q31_ptr->sensed_previous = 0;
+    pid_q31_ptr->windup = 0;
+}
+
+int32_t PID_Step_q31(pid_controller_q31_t *pid_q31_ptr, int32_t sensed_value, int32_t reference_point)
+{
+    int32_t command;
+    int32_t command_sat;
+    uint8_t gain_shift = pid_q31_ptr->gain_shift;
+
+    /* Integral term calculation - including anti-windup */
+    pid_q31_ptr->integral = add_pid_q31_saturated(pid_q31_ptr->integral,
+        add_pid_q31_saturated(mul_pid_q31(sub_pid_q31_saturated(reference_point, sensed_value),
+                                          pid_q31_ptr->Ki_q31, gain_shift),
+                              mul_pid_q31(pid_q31_ptr->windup, pid_q31_ptr->Kaw_q31, gain_shift)));
+
+    /* Filtered derivative of the measurement, a reference step does not kick it */
+    pid_q31_ptr->derivative =
+        sub_pid_q31_saturated(mul_pid_q31(pid_q31_ptr->derivative, pid_q31_ptr->derivative_pole_q31, 0U),
+                              mul_pid_q31(sub_pid_q31_saturated(sensed_value, pid_q31_ptr->sensed_previous),
+                                          pid_q31_ptr->Kd_q31, gain_shift));
+    pid_q31_ptr->sensed_previous = sensed_value;
+
+    /* Summing the 3 terms, the proportional term with the weighted reference */
+    command = add_pid_q31_saturated(
+        add_pid_q31_saturated(mul_pid_q31(get_pid_weighted_error_q31(pid_q31_ptr, sensed_value, reference_point),
+                                          pid_q31_ptr->Kp_q31, gain_shift),
+                              pid_q31_ptr->integral),
+        pid_q31_ptr->derivative);
+
+    command_sat = clamp_pid_output_q31(command, pid_q31_ptr->controller_output_min, pid_q31_ptr->controller_output_max);
+
+    /* Remember the saturation of this step for the anti-windup of the next one */
+    pid_q31_ptr->windup = sub_pid_q31_saturated(command_sat, command);
+
+    return command_sat;
+}
+
+void reset_pid_controller_q31(pid_controller_q31_t *pid_q31_ptr, int32_t sensed_value,
+                              int32_t reference_point, int32_t controller_output)
+{
+    uint8_t gain_shift = pid_q31_ptr->gain_shift;
+    int32_t command = clamp_pid_output_q31(controller_output, pid_q31_ptr->controller_output_min,
+                                           pid_q31_ptr->controller_output_max);
+
+    pid_q31_ptr->integral =
+        sub_pid_q31_saturated(command,
+                              mul_pid_q31(get_pid_weighted_error_q31(pid_q31_ptr, sensed_value, reference_point),
+                                          pid_q31_ptr->Kp_q31, gain_shift));
+    pid_q31_ptr->derivative = 0;
+    pid_q31_ptr->sensed_previous = sensed_value;
+    pid_q31_ptr->windup = 0;
+}
+
+int32_t convert_pid_value_to_q31(float value, uint8_t full_scale_shift)
+{
+    float value_scaled = value * (2147483648.0f / (float)(1UL << full_scale_shift));
+
+    if (value_scaled >= 2147483648.0f)
+    {
+        return INT32_MAX;
+    }
+    else if (value_scaled <= -2147483648.0f)
+    {
+        return INT32_MIN;
+    }
+
+    return (int32_t)(value_scaled + ((value_scaled < 0.0f) ? -0.5f : 0.5f));
+}
+
+float convert_pid_q31_to_value(int32_t value_q31, uint8_t full_scale_shift)
+{
+    return (float)value_q31 * ((float)(1UL << full_scale_shift) / 2147483648.0f);
+}
+
+static float clamp_pid_output(float value, float output_min, float output_max)
+{
+    if (value > output_max)
+    {
+        return output_max;
+    }
+    else if (value < output_min)
+    {
+        return output_min;
+    }
+
+    return value;
+}
+
+static int32_t clamp_pid_output_q31(int32_t value, int32_t output_min, int32_t output_max)
+{
+    if (value > output_max)
+    {
+        return output_max;
+    }
+    else if (value < output_min)
+    {
+        return output_min;
+    }
+
+    return value;
+}
+
+/**
+ * @brief Returns setpoint_weight * reference_point - sensed_value, saturating.
+ */
+static int32_t get_pid_weighted_error_q31(const pid_controller_q31_t *pid_q31_ptr,
+                                          int32_t sensed_value, int32_t reference_point)
+{
+    return sub_pid_q31_saturated(mul_pid_q31(reference_point, pid_q31_ptr->setpoint_weight_q31, 0U), sensed_value);
+}
+
+/**
+ * @brief Multiplies a Q31 value by a gain of Q31 mantissa and exponent gain_shift, saturating.
+ */
+static int32_t mul_pid_q31(int32_t value, int32_t gain_q31, uint8_t gain_shift)
+{
+    int64_t product = ((int64_t)value * gain_q31) >> (31U - gain_shift);
+
+    if (product > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    else if (product < INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+
+    return (int32_t)product;
+}
@@ -8,6 +8,8 @@
 #ifndef PID_CONTROLLER_PID_CONTROLLER_H_
 #define PID_CONTROLLER_PID_CONTROLLER_H_
 
+#include "stdint.h"
+
 typedef struct
 {
     float Kp;              // Proportional gain constant
@@ -15,6 +17,8 @@ typedef struct
     float Kd;              // Derivative gain constant
     float Kaw;             // Anti-windup gain constant
     float TimeStep;               // Time step
+    float derivative_filter_time; // Time constant of the derivative filter, unit of TimeStep, 0 for none (v2 and q31)
+    float setpoint_weight;        // Weight of the reference in the proportional term, 0 .. 1 (v2 and q31)
     float controller_output_max;             // Max controller_output
     float controller_output_min;             // Min controller_output
     float integral;        // Integral term
@@ -24,7 +28,154 @@ typedef struct
 
 }pid_controller_t;
 
+/**
+ * @brief Discrete controller of PID_Step_v2(), initialized from the tuning of a pid_controller_t.
+ *
+ * The control law is
+ *
+ *   u = Kp * (setpoint_weight * r - y) + I + D
+ *
+ * with the derivative acting on the measurement y only, through a first-order
+ * filter of time constant Tf = derivative_filter_time (backward Euler):
+ *
+ *   D[k] = Tf / (Tf + TimeStep) * D[k-1] - Kd / (Tf + TimeStep) * (y[k] - y[k-1])
+ *
+ * so a step of the reference r kicks neither the derivative nor, with a
+ * setpoint_weight below 1, the full proportional term. The integral uses the
+ * back-calculation anti-windup of PID_Step(). The coefficients are computed
+ * once at initialization, a step takes no division.
+ */
+typedef struct
+{
+    float Kp;                       // Proportional gain
+    float setpoint_weight;          // Weight of the reference in the proportional term
+    float Ki_step;                  // Ki * TimeStep
+    float Kaw_step;                 // Kaw * TimeStep
+    float derivative_pole;          // Tf / (Tf + TimeStep)
+    float Kd_step;                  // Kd / (Tf + TimeStep)
+    float controller_output_max;    // Max controller_output
+    float controller_output_min;    // Min controller_output
+    float integral;                 // Integral term
+    float derivative;               // Filtered derivative term
+    float sensed_previous;          // Previous measurement
+    float windup;                   // Previous saturated minus unsaturated controller_output
+
+}pid_controller_v2_t;
+
+/**
+ * @brief Fixed-point form of PID_Step_v2(), stepped by PID_Step_q31().
+ *
+ * Signals are Q31 fractions of a power-of-two full scale: a value v of a
+ * signal with full scale shift s is v / 2^s * 2^31. The gains are Q31
+ * mantissas scaled by 2^gain_shift, with TimeStep and the ratio of the input
+ * and output full scales folded in at initialization, so a step takes only
+ * 64-bit integer multiplies and saturating 32-bit additions.
+ *
+ * The kernel tracks PID_Step_v2(), not PID_Step(): the derivative acts on the
+ * filtered measurement and the reference is weighted, so its outputs match a
+ * pid_controller_v2_t of the same tuning, see Host/pid_q31_test.
+ */
+typedef struct
+{
+    int32_t Kp_q31;                 // Kp * input/output full scale ratio
+    int32_t Ki_q31;                 // Ki * TimeStep * input/output full scale ratio
+    int32_t Kd_q31;                 // Kd / (Tf + TimeStep) * input/output full scale ratio
+    int32_t Kaw_q31;                // Kaw * TimeStep
+    int32_t derivative_pole_q31;    // Tf / (Tf + TimeStep), plain Q31
+    int32_t setpoint_weight_q31;    // setpoint_weight, plain Q31 so at most 1
+    uint8_t gain_shift;             // Common exponent of the gains
+    int32_t controller_output_max;  // Max controller_output, Q31 of the output full scale
+    int32_t controller_output_min;  // Min controller_output, Q31 of the output full scale
+    int32_t integral;               // Integral term
+    int32_t derivative;             // Filtered derivative term
+    int32_t sensed_previous;        // Previous measurement
+    int32_t windup;                 // Previous saturated minus unsaturated controller_output
+
+}pid_controller_q31_t;
+
 
 float PID_Step(pid_controller_t *pid_parameters_ptr, float sensed_value, float reference_point);
 
+/**
+ * @brief Computes the discrete coefficients of a controller and clears its state.
+ *
+ * @param[out] pid_v2_ptr         Controller to initialize.
+ * @param[in]  pid_parameters_ptr Gains, TimeStep, derivative filter, setpoint weight and output limits.
+ */
+void init_pid_controller_v2(pid_controller_v2_t *pid_v2_ptr, const pid_controller_t *pid_parameters_ptr);
+
+/**
+ * @brief Steps the control law of pid_controller_v2_t.
+ *
+ * @param[in,out] pid_v2_ptr      Controller initialized by init_pid_controller_v2().
+ * @param[in]     sensed_value    Measurement.
+ * @param[in]     reference_point Reference.
+ * @return float Saturated controller output.
+ */
+float PID_Step_v2(pid_controller_v2_t *pid_v2_ptr, float sensed_value, float reference_point);
+
+/**
+ * @brief Restarts a controller so that its next output continues from controller_output.
+ *
+ * The integral absorbs the difference between controller_output and the
+ * proportional term of the given measurement and reference, the derivative
+ * filter restarts from the measurement, so taking over from another
+ * controller or a manually held output causes no bump.
+ *
+ * @param[in,out] pid_v2_ptr        Controller initialized by init_pid_controller_v2().
+ * @param[in]     sensed_value      Current measurement.
+ * @param[in]     reference_point   Current reference.
+ * @param[in]     controller_output Output to continue from, clamped to the output limits.
+ */
+void reset_pid_controller_v2(pid_controller_v2_t *pid_v2_ptr, float sensed_value,
+                             float reference_point, float controller_output);
+
+/**
+ * @brief Initializes a fixed-point controller from the tuning of a float controller.
+ *
+ * The state is cleared. Gains too large for the Q31 format saturate. The
+ * output full scale must hold the unsaturated command, not only the output
+ * limits, or the integral saturates where the float integral keeps winding.
+ *
+ * @param[out] pid_q31_ptr        Fixed-point controller to initialize.
+ * @param[in]  pid_parameters_ptr Gains, TimeStep, derivative filter, setpoint weight and output limits.
+ * @param[in]  input_shift        Full scale shift of the sensed value and reference point.
+ * @param[in]  output_shift       Full scale shift of the controller output.
+ */
+void init_pid_controller_q31(pid_controller_q31_t *pid_q31_ptr, const pid_controller_t *pid_parameters_ptr,
+                             uint8_t input_shift, uint8_t output_shift);
+
+/**
+ * @brief Fixed-point PID_Step_v2(), the same control law with saturating arithmetic.
+ *
+ * Takes a constant number of cycles and no floating point instruction.
+ *
+ * @param[in,out] pid_q31_ptr     Controller initialized by init_pid_controller_q31().
+ * @param[in]     sensed_value    Q31 of the input full scale.
+ * @param[in]     reference_point Q31 of the input full scale.
+ * @return int32_t Saturated controller output, Q31 of the output full scale.
+ */
+int32_t PID_Step_q31(pid_controller_q31_t *pid_q31_ptr, int32_t sensed_value, int32_t reference_point);
+
+/**
+ * @brief Fixed-point reset_pid_controller_v2().
+ *
+ * @param[in,out] pid_q31_ptr       Controller initialized by init_pid_controller_q31().
+ * @param[in]     sensed_value      Q31 of the input full scale.
+ * @param[in]     reference_point   Q31 of the input full scale.
+ * @param[in]     controller_output Q31 of the output full scale, clamped to the output limits.
+ */
+void reset_pid_controller_q31(pid_controller_q31_t *pid_q31_ptr, int32_t sensed_value,
+                              int32_t reference_point, int32_t controller_output);
+
+/**
+ * @brief Converts a value to a Q31 fraction of the full scale 2^full_scale_shift, saturating.
+ */
+int32_t convert_pid_value_to_q31(float value, uint8_t full_scale_shift);
+
+/**
+ * @brief Converts a Q31 fraction of the full scale 2^full_scale_shift to a value.
+ */
+float convert_pid_q31_to_value(int32_t value_q31, uint8_t full_scale_shift);
+
 #endif /* PID_CONTROLLER_PID_CONTROLLER_H_ */
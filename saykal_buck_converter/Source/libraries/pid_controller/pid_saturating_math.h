@@ -0,0 +1,49 @@
+/**
+ * @file pid_saturating_math.h
+ * @brief Saturating 32-bit additions of the Q31 PID kernel.
+ *
+ * Cores with the DSP extension (Cortex-M4) execute each addition as one QADD
+ * or QSUB instruction through the ACLE intrinsics of arm_acle.h. Other targets,
+ * including the host build, use the portable 64-bit form with the same result.
+ *
+ * @date Oct 17, 2026
+ */
+
+#ifndef PID_CONTROLLER_PID_SATURATING_MATH_H_
+#define PID_CONTROLLER_PID_SATURATING_MATH_H_
+
+#include "stdint.h"
+
+#if defined(__ARM_FEATURE_DSP)
+#include "arm_acle.h"
+#endif
+
+/**
+ * @brief Returns op1 + op2 saturated to INT32_MIN .. INT32_MAX.
+ */
+static inline int32_t add_pid_q31_saturated(int32_t op1, int32_t op2)
+{
+#if defined(__ARM_FEATURE_DSP)
+    return __qadd(op1, op2);
+#else
+    int64_t result = (int64_t)op1 + op2;
+
+    return (result > INT32_MAX) ? INT32_MAX : ((result < INT32_MIN) ? INT32_MIN : (int32_t)result);
+#endif
+}
+
+/**
+ * @brief Returns op1 - op2 saturated to INT32_MIN .. INT32_MAX.
+ */
+static inline int32_t sub_pid_q31_saturated(int32_t op1, int32_t op2)
+{
+#if defined(__ARM_FEATURE_DSP)
+    return __qsub(op1, op2);
+#else
+    int64_t result = (int64_t)op1 - op2;
+
+    return (result > INT32_MAX) ? INT32_MAX : ((result < INT32_MIN) ? INT32_MIN : (int32_t)result);
+#endif
+}
+
+#endif /* PID_CONTROLLER_PID_SATURATING_MATH_H_ */
@@ -12,9 +12,86 @@
 
 #include "error_manager.h"
 #include "com_driver.h"
+#include "adc_trace_recorder.h"
+#include "stm32f4xx_hal.h"
 
-///< Stores the system error flags as a bitfield.
-uint8_t m_system_errors = 0U;
+///< Stores the system error flags as a bitfield, also set from interrupts.
+volatile uint8_t m_system_errors = 0U;
+
+///< Set by a report from an interrupt, publish_pending_system_errors() sends the status.
+static volatile bool m_is_error_publish_pending = false;
+
+///< Set by a report from an interrupt, publish_pending_system_errors() triggers the trace recorder.
+static volatile bool m_is_trace_trigger_pending = false;
+
+/**
+ * @brief Sends the error status and optionally triggers the trace recorder.
+ *
+ * The com message buffer and the trace recorder are not reentrant, so a report
+ * from an interrupt only latches the request for publish_pending_system_errors().
+ *
+ * @param[in] is_trace_triggered True to freeze the ADC trace as well.
+ */
+static void publish_system_errors(bool is_trace_triggered);
+
+/**
+ * @brief Sets one bit of the system error status.
+ *
+ * The read-modify-write runs with interrupts masked, so a bit set by an
+ * interrupt, e.g. a development error in the ADC interrupt, is not lost.
+ *
+ * @param[in] error_type Index of the bit (ERROR_TYPE_xxx).
+ */
+static void set_system_error_bit(uint8_t error_type)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	m_system_errors |= (uint8_t)(1U << error_type);
+	__set_PRIMASK(primask);
+}
+
+static void publish_system_errors(bool is_trace_triggered)
+{
+	if(0U != __get_IPSR())
+	{
+		m_is_error_publish_pending = true;
+
+		if(true == is_trace_triggered)
+		{
+			m_is_trace_trigger_pending = true;
+		}
+
+		return;
+	}
+
+	send_signal_over_com(COM_SYSTEM_ERROR_STATE_SIGNAL_ID,(uint8_t*)&m_system_errors);
+
+	if(true == is_trace_triggered)
+	{
+		trigger_adc_trace_recorder();
+	}
+}
+
+/**
+ * @brief Publishes the reports latched by interrupts, called by the main loop.
+ *
+ * A flag is cleared before its action, so a report raised meanwhile stays latched.
+ */
+void publish_pending_system_errors(void)
+{
+	if(true == m_is_error_publish_pending)
+	{
+		m_is_error_publish_pending = false;
+		send_signal_over_com(COM_SYSTEM_ERROR_STATE_SIGNAL_ID,(uint8_t*)&m_system_errors);
+	}
+
+	if(true == m_is_trace_trigger_pending)
+	{
+		m_is_trace_trigger_pending = false;
+		trigger_adc_trace_recorder();
+	}
+}
 
 /**
  * @brief Reports a sensor-related error.
@@ -24,9 +101,9 @@ uint8_t m_system_errors = 0U;
  */
 void report_sensor_error(void)
 {
-	m_system_errors |= (1U << ERROR_TYPE_SENSOR);
+	set_system_error_bit(ERROR_TYPE_SENSOR);
 
-	send_signal_over_com(COM_SYSTEM_ERROR_STATE_SIGNAL_ID,&m_system_errors);
+	publish_system_errors(true);
 }
 
 /**
@@ -37,9 +114,9 @@ void report_sensor_error(void)
  */
 void report_development_error(void)
 {
-	m_system_errors |= (1U << ERROR_TYPE_DEVELOPMENT);
+	set_system_error_bit(ERROR_TYPE_DEVELOPMENT);
 
-	send_signal_over_com(COM_SYSTEM_ERROR_STATE_SIGNAL_ID,&m_system_errors);
+	publish_system_errors(false);
 }
 
 /**
@@ -49,9 +126,9 @@ void report_development_error(void)
  */
 void report_over_current(void)
 {
-	m_system_errors |= (1U << ERROR_TYPE_OVERCURRENT);
+	set_system_error_bit(ERROR_TYPE_OVERCURRENT);
 
-	send_signal_over_com(COM_SYSTEM_ERROR_STATE_SIGNAL_ID,&m_system_errors);
+	publish_system_errors(true);
 }
 
 /**
@@ -62,9 +139,9 @@ void report_over_current(void)
  */
 void report_init_error(void)
 {
-	m_system_errors |= (1U << ERROR_TYPE_INITIALIZE);
+	set_system_error_bit(ERROR_TYPE_INITIALIZE);
 
-	send_signal_over_com(COM_SYSTEM_ERROR_STATE_SIGNAL_ID,&m_system_errors);
+	publish_system_errors(false);
 }
 
 /**
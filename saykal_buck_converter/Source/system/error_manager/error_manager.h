@@ -74,6 +74,15 @@ void report_over_current(void);
  */
 void report_init_error(void);
 
+/**
+ * @brief Publishes the reports made from interrupts.
+ *
+ * A report from an interrupt sets its error bit at once, but sending the
+ * status and triggering the trace recorder are left to this function, which
+ * the main loop calls on every pass.
+ */
+void publish_pending_system_errors(void);
+
 /**
  * @brief Returns the current system error status.
  * 
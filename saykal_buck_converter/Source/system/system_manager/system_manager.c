@@ -12,27 +12,22 @@
 #include "bsp_gpio.h"
 #include "bsp_pwm.h"
 #include "bsp_can.h"
+#include "bsp_cycle_counter.h"
 #include "software_timer.h"
 #include "adc_sensor_driver.h"
+#include "adc_trace_recorder.h"
 #include "com_driver.h"
 #include "app_buck_converter.h"
 
 /**
- * @brief Defines the operating states of the system.
+ * @brief Current state of the system.
  */
-typedef enum{
-	SYSTEM_STATE_INIT_e = 0,            /**< System initialization phase */
-	SYSTEM_STATE_RUNNING_e = 1,        /**< Normal operation phase */
-	SYSTEM_STATE_ERROR_e = 2 ,          /**< Critical error occurred */
-	SYSTEM_STATE_SAFE_RUNNING_e = 3,   /**< Safe mode, only communication is active */
-	SYSTEM_STATE_IDLE_e = 4,           /**< Idle state, power-saving or inactive */
-
-} system_state_e;
+static system_state_e m_system_state = SYSTEM_STATE_INIT_e;
 
 /**
- * @brief Current state of the system.
+ * @brief Software timer whose statistics are sent next by send_software_timer_exec_stats().
  */
-static system_state_e m_system_state = SYSTEM_STATE_INIT_e;
+static software_timer_id_t m_exec_stats_next_timer_id = 0U;
 
 /**
  * @brief External GPIO pin configuration table.
@@ -74,6 +69,14 @@ extern const software_timer_general_cfg_t g_software_timer_general_config;
  */
 extern const adc_sensor_driver_config_t g_adc_sensors_configuration[];
 
+/**
+ * @brief ADC trace recorder configuration.
+ *
+ * @details Ring buffer and timestamp source of the black box that stores the
+ * raw samples of all ADC sensors.
+ */
+extern const adc_trace_recorder_cfg_t g_adc_trace_recorder_config;
+
 /**
  * @brief Communication module configuration structure.
  *
@@ -113,6 +116,11 @@ static uint16_t scale_temperature_for_send_over_com(float temperature,
 													float zero_offset,
 													float factor);
 
+/**
+ * @brief Converts a cycle count to microseconds saturated to 16 bits.
+ */
+static uint16_t convert_cycles_to_saturated_us(uint32_t cycles, uint32_t cycle_frequency_hz);
+
 /**
  * @brief Executes the system's main state machine.
  *
@@ -122,6 +130,8 @@ static uint16_t scale_temperature_for_send_over_com(float temperature,
  */
 void run_state_machine_of_system_manager(void)
 {
+	publish_pending_system_errors();
+
 	switch(m_system_state)
 	{
 		case SYSTEM_STATE_IDLE_e:
@@ -133,13 +143,22 @@ void run_state_machine_of_system_manager(void)
 		{
 			HAL_Init();
 			SystemClock_Config();
+			init_bsp_cycle_counter();
 			init_bsp_gpio(g_pin_cfg_container);
 			init_bsp_adc();
 			init_bsp_pwm(g_bsp_pwm_timer_configs);
 			init_bsp_can(&g_bsp_can_configurations);
 			init_software_timer_module(&g_software_timer_general_config);
+			init_adc_trace_recorder(&g_adc_trace_recorder_config);
 			init_adc_sensor_driver(g_adc_sensors_configuration);
 			init_com_driver(&g_com_message_configs);
+
+			// the MOSFET PWM is not started yet, so the output current is zero
+			if(ADC_SENSOR_OK_e != calibrate_adc_sensor_zero_counts())
+			{
+				report_init_error();
+			}
+
 			init_buck_converter(&g_buck_converter_config);
 
 			send_signal_over_com(COM_SYSTEM_STATE_SIGNAL_ID,(uint8_t*)&m_system_state);
@@ -148,6 +167,11 @@ void run_state_machine_of_system_manager(void)
 			start_software_timer(SYSTEM_TEMPERATURE_PROCESS_TIMER_ID,
 								 SYSTEM_TEMPERATURE_SENSE_PERIOD_MS);
 
+#if (0U != SYSTEM_TIMER_EXEC_STATS_MESSAGE_ENABLED)
+			start_software_timer(SYSTEM_TIMER_EXEC_STATS_TIMER_ID,
+								 SYSTEM_TIMER_EXEC_STATS_SEND_PERIOD_MS);
+#endif
+
 			m_system_state = SYSTEM_STATE_RUNNING_e;
 
 			break;
@@ -198,6 +222,16 @@ void run_state_machine_of_system_manager(void)
 	}
 }
 
+/**
+ * @brief Returns the current state of the system state machine.
+ *
+ * @return system_state_e Current state.
+ */
+system_state_e get_system_state(void)
+{
+	return m_system_state;
+}
+
 /**
  * @brief Reads and sends system temperature over communication interface.
  *
@@ -220,6 +254,66 @@ void calculate_system_temperature(software_timer_id_t sw_timer_id )
 	send_signal_over_com(COM_SYSTEM_TEMPERATURE_SIGNAL_ID,&raw_com_value);
 }
 
+/**
+ * @brief Sends the callback execution time statistics of the next software timer.
+ *
+ * @param[in] sw_timer_id ID of the software timer triggering the transmission.
+ */
+void send_software_timer_exec_stats(software_timer_id_t sw_timer_id)
+{
+	(void)sw_timer_id;
+
+	software_timer_exec_stats_t exec_stats;
+	software_timer_id_t stats_timer_id = m_exec_stats_next_timer_id;
+
+	m_exec_stats_next_timer_id = (software_timer_id_t)((stats_timer_id + 1U) % SOFTWARE_TIMER_CNT);
+
+	if(false == get_software_timer_exec_stats(stats_timer_id, &exec_stats))
+	{
+		return;
+	}
+
+	uint16_t min_us = convert_cycles_to_saturated_us(exec_stats.min_cycles, exec_stats.cycle_frequency_hz);
+	uint16_t mean_us = convert_cycles_to_saturated_us(exec_stats.mean_cycles, exec_stats.cycle_frequency_hz);
+	uint16_t max_us = convert_cycles_to_saturated_us(exec_stats.max_cycles, exec_stats.cycle_frequency_hz);
+	uint8_t load_permille = 0U;
+
+	if((0U != exec_stats.measured_time_ms) && (0U != exec_stats.cycle_frequency_hz))
+	{
+		uint64_t measured_cycles = ((uint64_t)exec_stats.measured_time_ms * exec_stats.cycle_frequency_hz) / 1000U;
+		uint64_t load = (exec_stats.total_cycles * 1000U) / measured_cycles;
+
+		load_permille = (load > UINT8_MAX) ? UINT8_MAX : (uint8_t)load;
+	}
+
+	send_signal_over_com(COM_TIMER_EXEC_STATS_ID_SIGNAL_ID, &stats_timer_id);
+	send_signal_over_com(COM_TIMER_EXEC_STATS_MIN_SIGNAL_ID, &min_us);
+	send_signal_over_com(COM_TIMER_EXEC_STATS_MEAN_SIGNAL_ID, &mean_us);
+	send_signal_over_com(COM_TIMER_EXEC_STATS_MAX_SIGNAL_ID, &max_us);
+	send_signal_over_com(COM_TIMER_EXEC_STATS_LOAD_SIGNAL_ID, &load_permille);
+	trigger_send_of_message(COM_TIMER_EXEC_STATS_MESSAGE_ID);
+}
+
+/**
+ * @brief Converts a cycle count to microseconds saturated to 16 bits.
+ *
+ * @param[in] cycles             Cycle count.
+ * @param[in] cycle_frequency_hz Frequency of the cycle counter.
+ *
+ * @return uint16_t              Microseconds, UINT16_MAX if out of range or the frequency is unknown.
+ */
+static uint16_t convert_cycles_to_saturated_us(uint32_t cycles, uint32_t cycle_frequency_hz)
+{
+	if(0U == cycle_frequency_hz)
+	{
+		return UINT16_MAX;
+	}
+
+	uint64_t time_us = ((uint64_t)cycles * 1000000U) / cycle_frequency_hz;
+
+	return (time_us > UINT16_MAX) ? UINT16_MAX : (uint16_t)time_us;
+}
+
 /**
  * @brief Scales a float temperature value to a 16-bit unsigned integer for communication.
  *
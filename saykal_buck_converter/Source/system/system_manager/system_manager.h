@@ -45,6 +45,34 @@
  */
 #define SYSTEM_TEMPERATURE_SCALE_FACTOR			0.1f
 
+/**
+ * @brief Enables the diagnostic CAN message with the callback execution time statistics.
+ *
+ * @details Set to 0U to keep the statistics local, they stay readable with
+ * get_software_timer_exec_stats().
+ */
+#define SYSTEM_TIMER_EXEC_STATS_MESSAGE_ENABLED	1U
+
+/**
+ * @brief Period of the diagnostic message in milliseconds.
+ *
+ * @details Every message carries the statistics of one software timer, the timers
+ * are sent in turn.
+ */
+#define SYSTEM_TIMER_EXEC_STATS_SEND_PERIOD_MS	250U
+
+/**
+ * @brief Defines the operating states of the system.
+ */
+typedef enum{
+	SYSTEM_STATE_INIT_e = 0,            /**< System initialization phase */
+	SYSTEM_STATE_RUNNING_e = 1,        /**< Normal operation phase */
+	SYSTEM_STATE_ERROR_e = 2 ,          /**< Critical error occurred */
+	SYSTEM_STATE_SAFE_RUNNING_e = 3,   /**< Safe mode, only communication is active */
+	SYSTEM_STATE_IDLE_e = 4,           /**< Idle state, power-saving or inactive */
+
+} system_state_e;
+
 /**
  * @brief Executes the system's main state machine.
  *
@@ -54,6 +82,16 @@
  */
 void run_state_machine_of_system_manager(void);
 
+/**
+ * @brief Returns the current state of the system state machine.
+ *
+ * @details Lets diagnostics and host tools observe whether a fault has stopped
+ * the converter.
+ *
+ * @return system_state_e Current state.
+ */
+system_state_e get_system_state(void);
+
 /**
  * @brief Reads and sends system temperature over communication interface.
  *
@@ -64,4 +102,14 @@ void run_state_machine_of_system_manager(void);
  */
 void calculate_system_temperature(software_timer_id_t sw_timer_id);
 
+/**
+ * @brief Sends the callback execution time statistics of the next software timer.
+ *
+ * @param[in] sw_timer_id ID of the software timer triggering the transmission.
+ *
+ * @details Times are sent in microseconds saturated to 16 bits, the share of the
+ * CPU time in 0.1 % steps saturated to 8 bits.
+ */
+void send_software_timer_exec_stats(software_timer_id_t sw_timer_id);
+
 #endif /* SYSTEM_MANAGER_H_ */